@@ -77,7 +77,7 @@ TEST(App, Filtering)
     
 
     //*** RXMesh Impl
-    filtering_rxmesh(rxmesh_static, Verts, ground_truth, max_neighbour_size);
+    filtering_rxmesh(rxmesh_static, Verts, ground_truth);
 
     // Release allocation
     ground_truth.release();
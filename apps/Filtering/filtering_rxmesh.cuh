@@ -4,6 +4,7 @@
 
 #include "filtering_rxmesh_kernel.cuh"
 #include "rxmesh/rxmesh_attribute.h"
+#include "rxmesh/rxmesh_kring.h"
 #include "rxmesh/util/report.h"
 #include "rxmesh/util/timer.h"
 
@@ -13,18 +14,10 @@
 template <typename T, uint32_t patchSize>
 void filtering_rxmesh(RXMESH::RXMeshStatic<patchSize>&  rxmesh_static,
                       std::vector<std::vector<T>>&      Verts,
-                      const RXMESH::RXMeshAttribute<T>& ground_truth,
-                      const size_t                      max_neighbour_size)
+                      const RXMESH::RXMeshAttribute<T>& ground_truth)
 {
     using namespace RXMESH;
 
-    constexpr uint32_t maxVVSize = 20 * 4;
-
-    ASSERT_GE(maxVVSize, max_neighbour_size)
-        << " Max #neighbour per vertex (as per OpenMesh calculation) is "
-           "greater than maxVVSize. Should increase maxVVSize to "
-        << max_neighbour_size << " to avoid illegal memory access";
-
     // Report
     Report report("Filtering_RXMesh");
     report.command_line(Arg.argc, Arg.argv);
@@ -78,6 +71,17 @@ void filtering_rxmesh(RXMESH::RXMeshStatic<patchSize>&  rxmesh_static,
     LaunchBox<filter_block_threads> filter_launch_box;
     rxmesh_static.prepare_launch_box(RXMESH::Op::VV, filter_launch_box, true);
 
+    // every thread gathers the neighbourhood of one vertex
+    ASSERT_GE(filter_block_threads,
+              rxmesh_static.get_per_patch_max_owned_vertices())
+        << " filter_block_threads should be at least the max number of owned "
+           "vertices per patch";
+
+    // scratch storage for the neighbourhoods. It grows if it overflows
+    KRingArena arena;
+    arena.init(rxmesh_static.get_num_patches(),
+               rxmesh_static.get_per_patch_max_owned_vertices());
+
     // double buffer
     RXMeshAttribute<T>* double_buffer[2] = {&coords, &filtered_coord};
 
@@ -97,11 +101,22 @@ void filtering_rxmesh(RXMESH::RXMeshStatic<patchSize>&  rxmesh_static,
                vn_launch_box.smem_bytes_dyn, stream>>>(
                 rxmesh_static.get_context(), *double_buffer[d], vertex_normal);
 
-        bilateral_filtering<T, filter_block_threads, maxVVSize>
-            <<<filter_launch_box.blocks, filter_block_threads,
-               filter_launch_box.smem_bytes_dyn, stream>>>(
-                rxmesh_static.get_context(), *double_buffer[d],
-                *double_buffer[!d], vertex_normal);
+        while (true) {
+            arena.reset(stream);
+            bilateral_filtering<T, filter_block_threads>
+                <<<filter_launch_box.blocks, filter_block_threads,
+                   filter_launch_box.smem_bytes_dyn, stream>>>(
+                    rxmesh_static.get_context(), *double_buffer[d],
+                    *double_buffer[!d], vertex_normal, arena);
+            if (!arena.is_overflown(stream)) {
+                break;
+            }
+            arena.grow();
+            RXMESH_TRACE(
+                "filtering_rxmesh() k-ring arena overflow pool grown to {} "
+                "chunks",
+                arena.get_num_overflow_chunks());
+        }
 
         d = !d;
         CUDA_ERROR(cudaStreamSynchronize(stream));
@@ -142,7 +157,10 @@ void filtering_rxmesh(RXMESH::RXMeshStatic<patchSize>&  rxmesh_static,
 
     EXPECT_TRUE(passed);
 
+    report.add_member("kring_arena (mb)", arena.get_device_storage_mb());
+
     // Release allocation
+    arena.release();
     filtered_coord.release();
     coords.release();
     vertex_normal.release();
@@ -1,4 +1,5 @@
 #include "rxmesh/rxmesh_attribute.h"
+#include "rxmesh/rxmesh_kring.h"
 
 /**
  * compute_sigma_c()
@@ -30,10 +31,7 @@ __device__ __inline__ T compute_sigma_c_sq(
  */
 template <typename T>
 __device__ __inline__ T compute_sigma_s_sq(
-    const uint32_t                    v_id,
-    const uint32_t                    vv[],
-    const uint8_t                     num_vv,
-    uint32_t                          thread_vertex,
+    const RXMESH::KRing&              ring,
     const RXMESH::Vector<3, T>&       v,
     const RXMESH::Vector<3, T>&       n,
     const RXMESH::RXMeshAttribute<T>& input_coords)
@@ -42,17 +40,17 @@ __device__ __inline__ T compute_sigma_s_sq(
     T sum = 0;
     T sum_sqs = 0;
 
-    for (uint32_t i = 0; i < num_vv; ++i) {
-        RXMESH::Vector<3, T> q(input_coords(vv[i], 0), input_coords(vv[i], 1),
-                               input_coords(vv[i], 2));
+    ring.for_each([&](uint32_t vv_id) {
+        RXMESH::Vector<3, T> q(input_coords(vv_id, 0), input_coords(vv_id, 1),
+                               input_coords(vv_id, 2));
 
         q -= v;
         T t = dot(q, n);
         t = sqrt(t * t);
         sum += t;
         sum_sqs += t * t;
-    }
-    T c = static_cast<T>(num_vv);
+    });
+    T c = static_cast<T>(ring.size());
     T sigma_s = (sum_sqs / c) - ((sum * sum) / (c * c));
     sigma_s = (sigma_s < 1.0e-20) ? (sigma_s + 1.0e-20) : sigma_s;
     return sigma_s;
@@ -24,6 +24,7 @@ struct arg
     bool        shuffle = false;
     bool        sort = false;
     uint32_t    num_seeds = 1;
+    uint32_t    num_sources = 16;
 
 } Arg;
 
@@ -91,12 +92,9 @@ TEST(App, GEODESIC)
 
     // Save a map from vertex id to topleset (number of hops from
     // (closest?) source). It's used by OpenMesh to help construct
-    // sorted_index and limit. We keep it for RXMesh because it is
-    // used to quickly determine whether or not a vertex is within
-    // the "update band".
+    // sorted_index and limit.
     RXMeshAttribute<uint32_t> toplesets("toplesets");
-    toplesets.init(Verts.size(), 1u,
-                   RXMESH::HOST);  // will move() to DEVICE later
+    toplesets.init(Verts.size(), 1u, RXMESH::HOST);
 
 
     std::vector<uint32_t> sorted_index;
@@ -108,17 +106,121 @@ TEST(App, GEODESIC)
     //                     ground_truth.operator->(),
     //                     ground_truth.operator->());
 
-    // Now that OpenMesh has calculated the toplesets,
-    // move to DEVICE -- it's needed by RXMesh version
-    toplesets.move(RXMESH::HOST, RXMESH::DEVICE);
-
 
     //*** RXMesh Impl
+    // RXMesh computes its own toplesets on the device. We keep them on the
+    // host as well to compare against OpenMesh. The toplesets are used to
+    // quickly determine whether or not a vertex is within the "update band"
+    RXMeshAttribute<uint32_t> rxmesh_toplesets("rxmesh_toplesets");
+    rxmesh_toplesets.init(Verts.size(), 1u, RXMESH::LOCATION_ALL);
+    std::vector<uint32_t> rxmesh_sorted_index;
+    std::vector<uint32_t> rxmesh_limits;
+    float                 toplesets_time = rxmesh_static.compute_toplesets(
+        h_seeds, rxmesh_toplesets, rxmesh_sorted_index, rxmesh_limits);
+    RXMESH_TRACE("RXMesh: Computing toplesets took {} (ms)", toplesets_time);
+
+    EXPECT_EQ(rxmesh_limits, limits);
+    for (uint32_t v = 0; v < Verts.size(); ++v) {
+        EXPECT_EQ(rxmesh_toplesets(v), toplesets(v));
+    }
+
     EXPECT_TRUE(geodesic_rxmesh(rxmesh_static, Faces, Verts, h_seeds,
-                                ground_truth, sorted_index, limits, toplesets))
+                                ground_truth, rxmesh_sorted_index,
+                                rxmesh_limits, rxmesh_toplesets))
         << "RXMesh failed!!";
 
 
+    // Release allocation
+    ground_truth.release();
+    toplesets.release();
+    rxmesh_toplesets.release();
+}
+
+TEST(App, GEODESIC_BATCHED)
+{
+    using namespace RXMESH;
+    using dataT = float;
+
+    if (Arg.shuffle) {
+        ASSERT_FALSE(Arg.sort) << " cannot shuffle and sort at the same time!";
+    }
+
+    // Select device
+    cuda_query(Arg.device_id);
+
+    // Load mesh
+    std::vector<std::vector<dataT>>    Verts;
+    std::vector<std::vector<uint32_t>> Faces;
+
+    ASSERT_TRUE(import_obj(Arg.obj_file_name, Verts, Faces));
+
+    if (Arg.shuffle) {
+        shuffle_obj(Faces, Verts);
+    }
+
+    RXMeshStatic<PATCH_SIZE> rxmesh_static(Faces, Verts, Arg.sort, false);
+    ASSERT_TRUE(rxmesh_static.is_closed()) << "Geodesic only works on watertight/closed manifold mesh without boundaries";
+    ASSERT_TRUE(rxmesh_static.is_edge_manifold())<< "Geodesic only works on watertight/closed manifold mesh without boundaries";
+
+    TriMesh input_mesh;
+    if (Arg.sort || Arg.shuffle) {
+        export_obj(Faces, Verts, "temp.obj", false);
+        ASSERT_TRUE(OpenMesh::IO::read_mesh(input_mesh, "temp.obj"));
+    } else {
+        ASSERT_TRUE(OpenMesh::IO::read_mesh(input_mesh, Arg.obj_file_name));
+    }
+
+    // Generate one seed per source
+    const uint32_t        num_sources = Arg.num_sources;
+    std::vector<uint32_t> h_sources(num_sources);
+    std::random_device    dev;
+    std::mt19937          rng(dev());
+    std::uniform_int_distribution<std::mt19937::result_type> dist(
+        0, rxmesh_static.get_num_vertices() - 1);
+    for (auto& s : h_sources) {
+        s = dist(rng);
+    }
+
+    //*** OpenMesh Impl
+    // toplesets come from RXMesh and the ground truth from OpenMesh.
+    // ground truth and toplesets of all sources where source k is stored in
+    // attribute k
+    RXMeshAttribute<dataT> ground_truth;
+    ground_truth.init(Verts.size(), num_sources, RXMESH::HOST);
+    RXMeshAttribute<uint32_t> toplesets("toplesets");
+    toplesets.init(Verts.size(), num_sources, RXMESH::HOST);
+    std::vector<std::vector<uint32_t>> limits(num_sources);
+
+    {
+        RXMeshAttribute<dataT> single_gt;
+        single_gt.init(Verts.size(), 1u, RXMESH::HOST);
+        RXMeshAttribute<uint32_t> single_toplesets;
+        single_toplesets.init(Verts.size(), 1u, RXMESH::LOCATION_ALL);
+        std::vector<uint32_t> sorted_index;
+
+        for (uint32_t k = 0; k < num_sources; ++k) {
+            std::vector<uint32_t> seed = {h_sources[k]};
+            rxmesh_static.compute_toplesets(seed, single_toplesets,
+                                            sorted_index, limits[k]);
+            uint32_t iter = 0;
+            toplesets_propagation(input_mesh, seed, limits[k], sorted_index,
+                                  single_gt, iter);
+            for (uint32_t v = 0; v < Verts.size(); ++v) {
+                ground_truth(v, k) = single_gt(v);
+                toplesets(v, k) = single_toplesets(v);
+            }
+        }
+        single_gt.release();
+        single_toplesets.release();
+    }
+
+    toplesets.move(RXMESH::HOST, RXMESH::DEVICE);
+
+    //*** RXMesh Impl
+    EXPECT_TRUE(geodesic_rxmesh_batched(rxmesh_static, Verts, h_sources,
+                                        ground_truth, limits, toplesets))
+        << "RXMesh batched failed!!";
+
     // Release allocation
     ground_truth.release();
     toplesets.release();
@@ -144,10 +246,11 @@ int main(int argc, char** argv)
                         "              Hint: Only accepts OBJ files\n"
                         " -o:          JSON file output folder. Default is {} \n"
                        // "-num_seeds:   Number of input seeds. Default is {}\n"                        
+                        " -num_sources: Number of sources (distance fields) of the batched test. Default is {}\n"
                         " -s:          Shuffle input. Default is false.\n"
                         " -p:          Sort input using patching output. Default is false.\n"
                         " -device_id:  GPU device ID. Default is {}",
-            Arg.obj_file_name, Arg.output_folder ,Arg.num_seeds, Arg.device_id);
+            Arg.obj_file_name, Arg.output_folder ,Arg.num_sources, Arg.device_id);
             // clang-format on
             exit(EXIT_SUCCESS);
         }
@@ -170,6 +273,10 @@ int main(int argc, char** argv)
             Arg.device_id =
                 atoi(get_cmd_option(argv, argv + argc, "-device_id"));
         }
+        if (cmd_option_exists(argv, argc + argv, "-num_sources")) {
+            Arg.num_sources =
+                atoi(get_cmd_option(argv, argv + argc, "-num_sources"));
+        }
         // if (cmd_option_exists(argv, argc + argv, "-num_seeds")) {
         //    Arg.num_seeds =
         //        atoi(get_cmd_option(argv, argv + argc, "-num_seeds"));
@@ -179,6 +286,7 @@ int main(int argc, char** argv)
     RXMESH_TRACE("input= {}", Arg.obj_file_name);
     RXMESH_TRACE("output_folder= {}", Arg.output_folder);
     RXMESH_TRACE("num_seeds= {}", Arg.num_seeds);
+    RXMESH_TRACE("num_sources= {}", Arg.num_sources);
     RXMESH_TRACE("device_id= {}", Arg.device_id);
 
     return RUN_ALL_TESTS();
@@ -126,6 +126,177 @@ __launch_bounds__(blockThreads) __global__ static void relax_ptp_rxmesh(
     };
 
 
+    query_block_dispatcher<Op::VV, blockThreads>(context, geo_lambda,
+                                                 in_active_set, true);
+}
+
+
+/**
+ * ptp_triangle()
+ */
+template <typename T>
+__device__ __inline__ void ptp_triangle(const RXMESH::Vector<3, T>& x0,
+                                        const RXMESH::Vector<3, T>& x1,
+                                        T                           Q[2][2])
+{
+    // the part of update_step() that only depends on the triangle geometry
+    // and thus can be shared by all distance fields
+    using namespace RXMESH;
+    T q[2][2];
+    q[0][0] = dot(x0, x0);
+    q[0][1] = dot(x0, x1);
+    q[1][0] = dot(x1, x0);
+    q[1][1] = dot(x1, x1);
+
+    T det = q[0][0] * q[1][1] - q[0][1] * q[1][0];
+    Q[0][0] = q[1][1] / det;
+    Q[0][1] = -q[0][1] / det;
+    Q[1][0] = -q[1][0] / det;
+    Q[1][1] = q[0][0] / det;
+}
+
+/**
+ * ptp_solve()
+ */
+template <typename T>
+__device__ __inline__ T ptp_solve(const RXMESH::Vector<3, T>& x0,
+                                  const RXMESH::Vector<3, T>& x1,
+                                  const T                     x0_norm,
+                                  const T                     x1_norm,
+                                  const T                     Q[2][2],
+                                  const T                     t0,
+                                  const T                     t1,
+                                  const T                     infinity_val)
+{
+    // the distance-dependent part of update_step() given the triangle
+    // geometry from ptp_triangle() and the distance of the two other vertices
+    using namespace RXMESH;
+    const T sum_Q = Q[0][0] + Q[0][1] + Q[1][0] + Q[1][1];
+    T       delta = t0 * (Q[0][0] + Q[1][0]) + t1 * (Q[0][1] + Q[1][1]);
+    T       dis = delta * delta -
+            sum_Q * (t0 * t0 * Q[0][0] + t0 * t1 * (Q[1][0] + Q[0][1]) +
+                     t1 * t1 * Q[1][1] - 1);
+    T p = (delta + std::sqrt(dis)) / sum_Q;
+
+    const T            tp0 = t0 - p;
+    const T            tp1 = t1 - p;
+    const Vector<3, T> n = (x0 * Q[0][0] + x1 * Q[1][0]) * tp0 +
+                           (x0 * Q[0][1] + x1 * Q[1][1]) * tp1;
+    const T cond0 = dot(x0, n);
+    const T cond1 = dot(x1, n);
+    const T c0 = cond0 * Q[0][0] + cond1 * Q[0][1];
+    const T c1 = cond0 * Q[1][0] + cond1 * Q[1][1];
+
+    if (t0 == infinity_val || t1 == infinity_val || dis < 0 || c0 >= 0 ||
+        c1 >= 0) {
+        const T dp0 = t0 + x0_norm;
+        const T dp1 = t1 + x1_norm;
+        p = (dp1 < dp0) ? dp1 : dp0;
+    }
+    return p;
+}
+
+/**
+ * relax_ptp_rxmesh_batched()
+ */
+template <typename T, uint32_t blockThreads>
+__launch_bounds__(blockThreads) __global__
+    static void relax_ptp_rxmesh_batched(
+        const RXMESH::RXMeshContext             context,
+        const RXMESH::RXMeshAttribute<T>        coords,
+        RXMESH::RXMeshAttribute<T>              new_geo_dist,
+        const RXMESH::RXMeshAttribute<T>        old_geo_dist,
+        const RXMESH::RXMeshAttribute<uint32_t> toplesets,
+        const uint2*                            d_bands,
+        uint32_t*                               d_error,
+        const T                                 infinity_val,
+        const T                                 error_tol)
+{
+    // Relax K independent distance fields in one sweep. geo_dist and
+    // toplesets store K attributes per vertex (one per source) such that
+    // the K values of a vertex are stored contiguously. d_bands[k] is the
+    // update band [x, y) of source k where converged sources have an empty
+    // band and are not touched. The one-ring query and the triangle
+    // geometry are shared by all sources
+    using namespace RXMESH;
+
+    const uint32_t num_sources = toplesets.get_num_attribute_per_element();
+
+    auto in_band = [&](const uint32_t p_id, const uint32_t k) {
+        const uint32_t my_band = toplesets(p_id, k);
+        return my_band >= d_bands[k].x && my_band < d_bands[k].y;
+    };
+
+    auto in_active_set = [&](uint32_t p_id) {
+        for (uint32_t k = 0; k < num_sources; ++k) {
+            if (in_band(p_id, k)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto geo_lambda = [&](uint32_t p_id, RXMeshIterator& iter) {
+        for (uint32_t k = 0; k < num_sources; ++k) {
+            if (in_band(p_id, k)) {
+                new_geo_dist(p_id, k) = old_geo_dist(p_id, k);
+            }
+        }
+
+        const Vector<3, T> v0(coords(p_id, 0), coords(p_id, 1),
+                              coords(p_id, 2));
+
+        // this is the last vertex in the one-ring (before r_id)
+        uint32_t     q_id = iter.back();
+        Vector<3, T> x0 =
+            Vector<3, T>(coords(q_id, 0), coords(q_id, 1), coords(q_id, 2)) -
+            v0;
+        T x0_norm = x0.norm();
+
+        // one-ring enumeration
+        for (uint32_t v = 0; v < iter.size(); ++v) {
+            // the current one ring vertex
+            const uint32_t     r_id = iter[v];
+            const Vector<3, T> x1 = Vector<3, T>(coords(r_id, 0),
+                                                 coords(r_id, 1),
+                                                 coords(r_id, 2)) -
+                                    v0;
+            const T x1_norm = x1.norm();
+
+            T Q[2][2];
+            ptp_triangle(x0, x1, Q);
+
+            for (uint32_t k = 0; k < num_sources; ++k) {
+                if (!in_band(p_id, k)) {
+                    continue;
+                }
+                T dist = ptp_solve(x0, x1, x0_norm, x1_norm, Q,
+                                   old_geo_dist(q_id, k),
+                                   old_geo_dist(r_id, k), infinity_val);
+                if (dist < new_geo_dist(p_id, k)) {
+                    new_geo_dist(p_id, k) = dist;
+                }
+            }
+
+            q_id = r_id;
+            x0 = x1;
+            x0_norm = x1_norm;
+        }
+
+        for (uint32_t k = 0; k < num_sources; ++k) {
+            if (toplesets(p_id, k) == d_bands[k].x &&
+                d_bands[k].x < d_bands[k].y) {
+                const T current_dist = old_geo_dist(p_id, k);
+                T       error =
+                    fabs(new_geo_dist(p_id, k) - current_dist) / current_dist;
+                if (error < error_tol) {
+                    atomicAdd(d_error + k, 1);
+                }
+            }
+        }
+    };
+
+
     query_block_dispatcher<Op::VV, blockThreads>(context, geo_lambda,
                                                  in_active_set, true);
 }
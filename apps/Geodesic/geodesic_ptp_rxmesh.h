@@ -154,4 +154,217 @@ inline bool geodesic_rxmesh(RXMESH::RXMeshStatic<patchSize>&    rxmesh_static,
                  "Geodesic_RXMesh_" + extract_file_name(Arg.obj_file_name));
 
     return is_passed;
-}
\ No newline at end of file
+}
+template <typename T, uint32_t patchSize>
+inline bool geodesic_rxmesh_batched(
+    RXMESH::RXMeshStatic<patchSize>&          rxmesh_static,
+    std::vector<std::vector<T>>&              Verts,
+    const std::vector<uint32_t>&              h_sources,
+    const RXMESH::RXMeshAttribute<T>&         ground_truth,
+    const std::vector<std::vector<uint32_t>>& h_limits,
+    const RXMESH::RXMeshAttribute<uint32_t>&  toplesets)
+{
+    // Compute K = h_sources.size() distance fields (one per source) in one
+    // sweep. ground_truth and toplesets store K attributes per vertex and
+    // h_limits[k] are the toplesets limits of source k. Each source runs its
+    // own PTP band and stops independently once its band converges
+    using namespace RXMESH;
+    constexpr uint32_t blockThreads = 256;
+
+    const uint32_t num_sources = static_cast<uint32_t>(h_sources.size());
+    const uint32_t num_vertices = rxmesh_static.get_num_vertices();
+
+    // Report
+    Report report("Geodesic_RXMesh_Batched");
+    report.command_line(Arg.argc, Arg.argv);
+    report.device();
+    report.system();
+    report.model_data(Arg.obj_file_name, rxmesh_static);
+    report.add_member("seeds", h_sources);
+    report.add_member("num_sources", num_sources);
+    report.add_member("method", std::string("RXMesh"));
+    std::string order = "default";
+    if (Arg.shuffle) {
+        order = "shuffle";
+    } else if (Arg.sort) {
+        order = "sorted";
+    }
+    report.add_member("input_order", order);
+
+
+    // input coords
+    RXMESH::RXMeshAttribute<T> input_coord;
+    input_coord.set_name("coord");
+    input_coord.init(Verts.size(), 3u, RXMESH::LOCATION_ALL);
+    for (uint32_t i = 0; i < Verts.size(); ++i) {
+        for (uint32_t j = 0; j < Verts[i].size(); ++j) {
+            input_coord(i, j) = Verts[i][j];
+        }
+    }
+    input_coord.change_layout(RXMESH::HOST);
+    input_coord.move(RXMESH::HOST, RXMESH::DEVICE);
+
+    // RXMesh launch box
+    LaunchBox<blockThreads> launch_box;
+    rxmesh_static.prepare_launch_box(RXMESH::Op::VV, launch_box, false, true);
+
+
+    // Geodesic distance of all sources interleaved per vertex (AoS) such
+    // that one vertex's K distances are contiguous
+    RXMeshAttribute<T> rxmesh_geo;
+    rxmesh_geo.set_name("geo");
+    rxmesh_geo.init(num_vertices, num_sources, RXMESH::LOCATION_ALL,
+                    RXMESH::AoS);
+    rxmesh_geo.reset(std::numeric_limits<T>::infinity(), RXMESH::HOST);
+    for (uint32_t k = 0; k < num_sources; ++k) {
+        rxmesh_geo(h_sources[k], k) = 0;
+    }
+    rxmesh_geo.move(RXMESH::HOST, RXMESH::DEVICE);
+
+    // second buffer for geodesic distance for double buffering
+    RXMeshAttribute<T> rxmesh_geo_2;
+    rxmesh_geo_2.set_name("geo_2");
+    rxmesh_geo_2.init(num_vertices, num_sources, RXMESH::LOCATION_ALL,
+                      RXMESH::AoS);
+    rxmesh_geo_2.copy(rxmesh_geo, RXMESH::DEVICE, RXMESH::DEVICE);
+
+    // per-source band and error
+    std::vector<uint2>    h_bands(num_sources);
+    std::vector<uint32_t> h_error(num_sources, 0);
+    uint2*                d_bands(nullptr);
+    uint32_t*             d_error(nullptr);
+    CUDA_ERROR(cudaMalloc((void**)&d_bands, num_sources * sizeof(uint2)));
+    CUDA_ERROR(cudaMalloc((void**)&d_error, num_sources * sizeof(uint32_t)));
+    CUDA_ERROR(cudaMemset(d_error, 0, num_sources * sizeof(uint32_t)));
+
+    // per-source PTP state
+    std::vector<uint32_t> h_i(num_sources, 1), h_j(num_sources, 2),
+        h_iter(num_sources, 0);
+    // the buffer that holds the final result of a source once it stops
+    std::vector<uint32_t> h_final_d(num_sources, 0);
+    std::vector<bool>     h_active(num_sources, true);
+    uint32_t              num_active = num_sources;
+
+    // double buffer
+    RXMeshAttribute<T>* double_buffer[2] = {&rxmesh_geo, &rxmesh_geo_2};
+
+    // start time
+    GPUTimer timer;
+    timer.start();
+
+    // actual computation
+    uint32_t d = 0;
+    uint32_t sweep = 0;
+    while (num_active > 0) {
+        sweep++;
+        for (uint32_t k = 0; k < num_sources; ++k) {
+            if (h_active[k]) {
+                h_iter[k]++;
+                if (h_i[k] < (h_j[k] / 2)) {
+                    h_i[k] = h_j[k] / 2;
+                }
+                h_bands[k] = make_uint2(h_i[k], h_j[k]);
+            } else {
+                h_bands[k] = make_uint2(0, 0);
+            }
+        }
+        CUDA_ERROR(cudaMemcpy(d_bands, h_bands.data(),
+                              num_sources * sizeof(uint2),
+                              cudaMemcpyHostToDevice));
+
+        // compute new geodesic
+        relax_ptp_rxmesh_batched<T, blockThreads>
+            <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+                rxmesh_static.get_context(), input_coord, *double_buffer[!d],
+                *double_buffer[d], toplesets, d_bands, d_error,
+                std::numeric_limits<T>::infinity(), T(1e-3));
+
+        CUDA_ERROR(cudaMemcpy(h_error.data(), d_error,
+                              num_sources * sizeof(uint32_t),
+                              cudaMemcpyDeviceToHost));
+        CUDA_ERROR(cudaMemset(d_error, 0, num_sources * sizeof(uint32_t)));
+
+        for (uint32_t k = 0; k < num_sources; ++k) {
+            if (!h_active[k]) {
+                continue;
+            }
+            const std::vector<uint32_t>& limits = h_limits[k];
+            const uint32_t n_cond = limits[h_i[k] + 1] - limits[h_i[k]];
+            if (n_cond == h_error[k]) {
+                h_i[k]++;
+            }
+            if (h_j[k] < limits.size() - 1) {
+                h_j[k]++;
+            }
+            // early termination of this source
+            if (h_i[k] >= h_j[k] || h_iter[k] >= 2 * limits.size()) {
+                h_active[k] = false;
+                h_final_d[k] = !d;
+                num_active--;
+            }
+        }
+
+        d = !d;
+    }
+
+    timer.stop();
+    CUDA_ERROR(cudaDeviceSynchronize());
+    CUDA_ERROR(cudaGetLastError());
+    CUDA_ERROR(cudaProfilerStop());
+
+    // gather each source from the buffer it finished in
+    rxmesh_geo.move(RXMESH::DEVICE, RXMESH::HOST);
+    rxmesh_geo_2.move(RXMESH::DEVICE, RXMESH::HOST);
+
+    // verify
+    bool     is_passed = true;
+    uint32_t max_iter = 0;
+    for (uint32_t k = 0; k < num_sources; ++k) {
+        const RXMeshAttribute<T>& geo = *double_buffer[h_final_d[k]];
+        T                         err = 0;
+        for (uint32_t v = 0; v < num_vertices; ++v) {
+            if (ground_truth(v, k) > EPS) {
+                err += std::abs(geo(v, k) - ground_truth(v, k)) /
+                       ground_truth(v, k);
+            }
+        }
+        err /= T(num_vertices);
+        if (err >= 10E-2) {
+            is_passed = false;
+            RXMESH_WARN(
+                "Geodesic_RXMesh_Batched source {} (vertex {}) err= {} -- "
+                "#iter= {}",
+                k, h_sources[k], err, h_iter[k]);
+        }
+        max_iter = std::max(max_iter, h_iter[k]);
+    }
+
+    RXMESH_TRACE(
+        "Geodesic_RXMesh_Batched took {} (ms) for {} sources ({} (ms) per "
+        "source) -- #sweeps= {}",
+        timer.elapsed_millis(), num_sources,
+        timer.elapsed_millis() / float(num_sources), sweep);
+
+    // Release allocation
+    rxmesh_geo.release();
+    rxmesh_geo_2.release();
+    input_coord.release();
+    GPU_FREE(d_bands);
+    GPU_FREE(d_error);
+
+    // Finalize report
+    report.add_member("num_sweeps", sweep);
+    report.add_member("max_num_iter_taken", max_iter);
+    report.add_member("time_per_source_ms",
+                      double(timer.elapsed_millis()) / double(num_sources));
+    TestData td;
+    td.test_name = "GeodesicBatched";
+    td.time_ms.push_back(timer.elapsed_millis());
+    td.passed.push_back(is_passed);
+    report.add_test(td);
+    report.write(
+        Arg.output_folder + "/rxmesh",
+        "Geodesic_RXMesh_Batched_" + extract_file_name(Arg.obj_file_name));
+
+    return is_passed;
+}
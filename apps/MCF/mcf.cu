@@ -22,6 +22,8 @@ struct arg
     float       cg_tolerance = 1e-6;
     uint32_t    max_num_cg_iter = 1000;
     bool        use_uniform_laplace = false;
+    std::string preconditioner = "none";
+    bool        use_assembled = false;
     char**      argv;
     int         argc;
     bool        shuffle = false;
@@ -83,6 +85,15 @@ TEST(App, MCF)
     //*** RXMesh Impl
     mcf_rxmesh(rxmesh_static, Verts, ground_truth);
 
+    //*** RXMesh Impl with pipelined CG
+    mcf_rxmesh_pipelined(rxmesh_static, Verts, ground_truth);
+
+    //*** RXMesh Impl with 8 right-hand sides solved together
+    mcf_rxmesh_multi_rhs<dataT, 8>(rxmesh_static, Verts, ground_truth);
+
+    //*** Matrix-free vs. assembled matvec
+    mcf_matvec_benchmark(rxmesh_static, Faces, Verts);
+
 
     // Release allocation
     ground_truth.release();
@@ -110,10 +121,12 @@ int main(int argc, char** argv)
                         "                     Hint: should be between (0.001, 1) for cotan Laplace or between (1, 100) for uniform Laplace\n"
                         " -eps:               Conjugate gradient tolerance. Default is {}\n"
                         " -max_cg_iter:       Conjugate gradient maximum number of iterations. Default is {}\n"
+                        " -precond:           Conjugate gradient preconditioner (none, jacobi, block_jacobi). Default is {}\n"
+                        " -assembled:         Assemble the system matrix in CSR format instead of the matrix-free matvec. Default is {}\n"
                         " -s:                 Shuffle input. Default is false.\n"
                         " -p:                 Sort input using patching output. Default is false\n"
                         " -device_id:         GPU device ID. Default is {}",
-            Arg.obj_file_name, Arg.output_folder,  (Arg.use_uniform_laplace? "true" : "false"), Arg.time_step, Arg.cg_tolerance, Arg.max_num_cg_iter, Arg.device_id);
+            Arg.obj_file_name, Arg.output_folder,  (Arg.use_uniform_laplace? "true" : "false"), Arg.time_step, Arg.cg_tolerance, Arg.max_num_cg_iter, Arg.preconditioner, (Arg.use_assembled? "true" : "false"), Arg.device_id);
             // clang-format on
             exit(EXIT_SUCCESS);
         }
@@ -138,6 +151,13 @@ int main(int argc, char** argv)
             Arg.cg_tolerance =
                 std::atof(get_cmd_option(argv, argv + argc, "-eps"));
         }
+        if (cmd_option_exists(argv, argc + argv, "-precond")) {
+            Arg.preconditioner =
+                std::string(get_cmd_option(argv, argv + argc, "-precond"));
+        }
+        if (cmd_option_exists(argv, argc + argv, "-assembled")) {
+            Arg.use_assembled = true;
+        }
         if (cmd_option_exists(argv, argc + argv, "-uniform_laplace")) {
             Arg.use_uniform_laplace = true;
         }
@@ -158,6 +178,8 @@ int main(int argc, char** argv)
     RXMESH_TRACE("max_num_cg_iter= {}", Arg.max_num_cg_iter);
     RXMESH_TRACE("cg_tolerance= {0:f}", Arg.cg_tolerance);
     RXMESH_TRACE("use_uniform_laplace= {}", Arg.use_uniform_laplace);
+    RXMESH_TRACE("preconditioner= {}", Arg.preconditioner);
+    RXMESH_TRACE("use_assembled= {}", Arg.use_assembled);
     RXMESH_TRACE("time_step= {0:f}", Arg.time_step);
     RXMESH_TRACE("device_id= {}", Arg.device_id);
 
@@ -1,7 +1,7 @@
 #pragma once
 #include "../common/openmesh_report.h"
 #include "../common/openmesh_trimesh.h"
-#include "mcf_util.h"
+#include "rxmesh/util/cotan_weights.h"
 #include "rxmesh/rxmesh_attribute.h"
 #include "rxmesh/util/timer.h"
 #include "rxmesh/util/vector.h"
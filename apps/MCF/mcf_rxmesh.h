@@ -1,8 +1,11 @@
 #pragma once
 
 #include <cuda_profiler_api.h>
+#include <map>
+#include <string>
 #include "mcf_rxmesh_kernel.cuh"
 #include "rxmesh/rxmesh_attribute.h"
+#include "rxmesh/rxmesh_attribute_expr.h"
 #include "rxmesh/rxmesh_static.h"
 #include "rxmesh/util/report.h"
 #include "rxmesh/util/timer.h"
@@ -36,6 +39,8 @@ void mcf_rxmesh(RXMESH::RXMeshStatic<patchSize>&   rxmesh_static,
     report.add_member("use_uniform_laplace", Arg.use_uniform_laplace);
     report.add_member("max_num_cg_iter", Arg.max_num_cg_iter);
     report.add_member("blockThreads", blockThreads);
+    report.add_member("preconditioner", Arg.preconditioner);
+    report.add_member("assembled", Arg.use_assembled);
 
     ASSERT_TRUE(rxmesh_static.is_closed())
         << "mcf_rxmesh only takes watertight/closed mesh without boundaries";
@@ -52,35 +57,30 @@ void mcf_rxmesh(RXMESH::RXMeshStatic<patchSize>&   rxmesh_static,
     input_coord.change_layout(RXMESH::HOST);
     input_coord.move(RXMESH::HOST, RXMESH::DEVICE);
 
+    // CG vectors are owned by rxmesh_static (and allocated from its arena)
     // S in CG
-    RXMeshAttribute<T> S;
-    S.set_name("S");
-    S.init(rxmesh_static.get_num_vertices(), 3u, RXMESH::DEVICE, RXMESH::SoA);
+    auto& S = rxmesh_static.template add_vertex_attribute<T>(
+        "S", 3u, RXMESH::DEVICE, RXMESH::SoA);
     S.reset(0.0, RXMESH::DEVICE);
 
     // P in CG
-    RXMeshAttribute<T> P;
-    P.set_name("P");
-    P.init(rxmesh_static.get_num_vertices(), 3u, RXMESH::DEVICE, RXMESH::SoA);
+    auto& P = rxmesh_static.template add_vertex_attribute<T>(
+        "P", 3u, RXMESH::DEVICE, RXMESH::SoA);
     P.reset(0.0, RXMESH::DEVICE);
 
     // R in CG
-    RXMeshAttribute<T> R;
-    R.set_name("P");
-    R.init(rxmesh_static.get_num_vertices(), 3u, RXMESH::DEVICE, RXMESH::SoA);
+    auto& R = rxmesh_static.template add_vertex_attribute<T>(
+        "R", 3u, RXMESH::DEVICE, RXMESH::SoA);
     R.reset(0.0, RXMESH::DEVICE);
 
     // B in CG
-    RXMeshAttribute<T> B;
-    B.set_name("B");
-    B.init(rxmesh_static.get_num_vertices(), 3u, RXMESH::DEVICE, RXMESH::SoA);
+    auto& B = rxmesh_static.template add_vertex_attribute<T>(
+        "B", 3u, RXMESH::DEVICE, RXMESH::SoA);
     B.reset(0.0, RXMESH::DEVICE);
 
     // X in CG
-    RXMeshAttribute<T> X;
-    X.set_name("X");
-    X.init(rxmesh_static.get_num_vertices(), 3u, RXMESH::LOCATION_ALL,
-           RXMESH::SoA);
+    auto& X = rxmesh_static.template add_vertex_attribute<T>(
+        "X", 3u, RXMESH::LOCATION_ALL, RXMESH::SoA);
     X.copy(input_coord, RXMESH::HOST, RXMESH::DEVICE);
 
     // RXMesh launch box
@@ -93,18 +93,133 @@ void mcf_rxmesh(RXMESH::RXMeshStatic<patchSize>&   rxmesh_static,
         <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
             rxmesh_static.get_context(), X, B, Arg.use_uniform_laplace);
 
+    // Preconditioner
+    const bool use_jacobi = (Arg.preconditioner == "jacobi");
+    const bool use_block_jacobi = (Arg.preconditioner == "block_jacobi");
+    if (!use_jacobi && !use_block_jacobi && Arg.preconditioner != "none") {
+        RXMESH_ERROR("mcf_rxmesh() unknown preconditioner {}",
+                     Arg.preconditioner);
+    }
+
+    // Z = M^{-1} R in PCG. Without preconditioner, Z is just R
+    RXMeshAttribute<T> Z;
+    Z.set_name("Z");
+    RXMeshAttribute<T>* Z_ptr = &R;
+
+    // Jacobi: the diagonal of the system matrix
+    RXMeshAttribute<T> D;
+    D.set_name("D");
+
+    // block Jacobi: one dense block per patch that holds the Cholesky factor
+    // of the patch's owned-vertex subsystem in packed lower triangle format
+    T*             d_blocks(nullptr);
+    const uint32_t max_owned = rxmesh_static.get_per_patch_max_owned_vertices();
+    const uint32_t block_stride = max_owned * (max_owned + 1) / 2;
+
+    auto apply_precond = [&]() {
+        // z = M^{-1} r
+        if (use_jacobi) {
+            jacobi_apply<T><<<DIVIDE_UP(rxmesh_static.get_num_vertices(),
+                                        blockThreads),
+                              blockThreads>>>(rxmesh_static.get_num_vertices(),
+                                              D, R, Z);
+        } else if (use_block_jacobi) {
+            block_jacobi_apply<T><<<rxmesh_static.get_num_patches(),
+                                    blockThreads, 3 * max_owned * sizeof(T)>>>(
+                rxmesh_static.get_context(), d_blocks, block_stride, R, Z);
+        }
+    };
+
+    GPUTimer precond_timer;
+    precond_timer.start();
+    if (use_jacobi || use_block_jacobi) {
+        Z.init(rxmesh_static.get_num_vertices(), 3u, RXMESH::DEVICE,
+               RXMESH::SoA);
+        Z.reset(0.0, RXMESH::DEVICE);
+        Z_ptr = &Z;
+    }
+    if (use_jacobi) {
+        D.init(rxmesh_static.get_num_vertices(), 1u, RXMESH::DEVICE);
+        mcf_diagonal<T, blockThreads>
+            <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+                rxmesh_static.get_context(), input_coord, D,
+                Arg.use_uniform_laplace, Arg.time_step);
+    }
+    if (use_block_jacobi) {
+        uint32_t* d_local_id(nullptr);
+        CUDA_ERROR(cudaMalloc((void**)&d_local_id,
+                              rxmesh_static.get_num_vertices() *
+                                  sizeof(uint32_t)));
+        const size_t blocks_bytes = size_t(rxmesh_static.get_num_patches()) *
+                                    size_t(block_stride) * sizeof(T);
+        CUDA_ERROR(cudaMalloc((void**)&d_blocks, blocks_bytes));
+        CUDA_ERROR(cudaMemset(d_blocks, 0, blocks_bytes));
+
+        block_jacobi_local_id<<<rxmesh_static.get_num_patches(),
+                                blockThreads>>>(rxmesh_static.get_context(),
+                                                d_local_id);
+        block_jacobi_assemble<T, blockThreads>
+            <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+                rxmesh_static.get_context(), input_coord, d_local_id,
+                d_blocks, block_stride, Arg.use_uniform_laplace,
+                Arg.time_step);
+        block_jacobi_factor<T>
+            <<<rxmesh_static.get_num_patches(), blockThreads>>>(
+                rxmesh_static.get_context(), d_blocks, block_stride);
+        GPU_FREE(d_local_id);
+        report.add_member("block_jacobi_storage (mb)",
+                          double(blocks_bytes) / double(1024 * 1024));
+    }
+    precond_timer.stop();
+    CUDA_ERROR(cudaDeviceSynchronize());
+    CUDA_ERROR(cudaGetLastError());
+
+    // Assembled system matrix A = M + dt*L. Without it, A is applied
+    // matrix-free by mcf_matvec
+    CSRMatrix<T>       A;
+    RXMeshAttribute<T> mass;
+    mass.set_name("mass");
+    GPUTimer assembly_timer;
+    assembly_timer.start();
+    if (Arg.use_assembled) {
+        mass.init(rxmesh_static.get_num_vertices(), 1u, RXMESH::DEVICE);
+        rxmesh_static.template assemble_laplacian<T, blockThreads>(
+            input_coord, A, &mass, Arg.use_uniform_laplace, true);
+        mcf_system_from_laplacian<T>
+            <<<DIVIDE_UP(A.get_num_rows(), blockThreads), blockThreads>>>(
+                A, mass, Arg.use_uniform_laplace, Arg.time_step);
+        report.add_member("assembled_storage (mb)",
+                          A.get_device_storage_mb());
+    }
+    assembly_timer.stop();
+    CUDA_ERROR(cudaDeviceSynchronize());
+    CUDA_ERROR(cudaGetLastError());
+
+    auto matvec = [&](const RXMeshAttribute<T>& in, RXMeshAttribute<T>& out) {
+        // out = A*in
+        if (Arg.use_assembled) {
+            A.multiply(in, out);
+        } else {
+            mcf_matvec<T, blockThreads>
+                <<<launch_box.blocks, blockThreads,
+                   launch_box.smem_bytes_dyn>>>(rxmesh_static.get_context(),
+                                                input_coord, in, out,
+                                                Arg.use_uniform_laplace,
+                                                Arg.time_step);
+        }
+    };
+
     // CG scalars
-    Vector<3, T> alpha(T(0)), beta(T(0)), delta_new(T(0)), delta_old(T(0)),
-        ones(T(1));
+    Vector<3, T> alpha(T(0)), beta(T(0)), delta_new(T(0)), delta_old(T(0));
+
+    // element-wise CG updates and reductions fused in one pass
+    FusedEvaluator<T> fused;
 
     GPUTimer timer;
     timer.start();
 
     // s = Ax
-    mcf_matvec<T, blockThreads>
-        <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
-            rxmesh_static.get_context(), input_coord, X, S,
-            Arg.use_uniform_laplace, Arg.time_step);
+    matvec(X, S);
 
     // r = b - s = b - Ax
     // p=r
@@ -113,8 +228,19 @@ void mcf_rxmesh(RXMESH::RXMeshStatic<patchSize>&   rxmesh_static,
     init_PR<T><<<num_blocks, blockThreads>>>(rxmesh_static.get_num_vertices(),
                                              B, S, R, P);
 
-    // delta_new = <r,r>
-    R.reduce(delta_new, RXMESH::NORM2);
+    // z = M^{-1} r
+    // p = z
+    if (Z_ptr != &R) {
+        apply_precond();
+        P.copy(Z, RXMESH::DEVICE, RXMESH::DEVICE);
+    }
+
+    // delta_new = <r,z>
+    if (Z_ptr != &R) {
+        R.reduce(delta_new, RXMESH::DOT, Z_ptr);
+    } else {
+        R.reduce(delta_new, RXMESH::NORM2);
+    }
 
     const Vector<3, T> delta_0(delta_new);
 
@@ -122,31 +248,32 @@ void mcf_rxmesh(RXMESH::RXMeshStatic<patchSize>&   rxmesh_static,
 
     while (num_cg_iter_taken < Arg.max_num_cg_iter) {
         // s = Ap
-
-        mcf_matvec<T, blockThreads>
-            <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
-                rxmesh_static.get_context(), input_coord, P, S,
-                Arg.use_uniform_laplace, Arg.time_step);
+        matvec(P, S);
 
         // alpha = delta_new / <s,p>
         S.reduce(alpha, RXMESH::DOT, &P);
 
         alpha = delta_new / alpha;
 
-        // x =  x + alpha*p
-        X.axpy(P, alpha, ones);
-
-        // r = r - alpha*s
-        R.axpy(S, -alpha, ones);
-
-
         // delta_old = delta_new
-        CUDA_ERROR(cudaStreamSynchronize(0));
         delta_old = delta_new;
 
+        // x =  x + alpha*p
+        // r = r - alpha*s
+        // in one pass along with delta_new = <r,r> when there is no
+        // preconditioner
+        if (Z_ptr != &R) {
+            fused.evaluate(RXMESH::DEVICE, fused_add(X, alpha * P),
+                           fused_sub(R, alpha * S));
 
-        // delta_new = <r,r>
-        R.reduce(delta_new, RXMESH::NORM2);
+            // z = M^{-1} r
+            // delta_new = <r,z>
+            apply_precond();
+            R.reduce(delta_new, RXMESH::DOT, Z_ptr);
+        } else {
+            fused.evaluate(RXMESH::DEVICE, fused_add(X, alpha * P),
+                           fused_sub(R, alpha * S), fused_norm2(R, delta_new));
+        }
 
         CUDA_ERROR(cudaStreamSynchronize(0));
 
@@ -161,8 +288,8 @@ void mcf_rxmesh(RXMESH::RXMeshStatic<patchSize>&   rxmesh_static,
         // beta = delta_new/delta_old
         beta = delta_new / delta_old;
 
-        // p = beta*p + r
-        P.axpy(R, ones, beta);
+        // p = beta*p + z
+        fused.evaluate(RXMESH::DEVICE, fused_assign(P, *Z_ptr + beta * P));
 
         ++num_cg_iter_taken;
 
@@ -176,9 +303,14 @@ void mcf_rxmesh(RXMESH::RXMeshStatic<patchSize>&   rxmesh_static,
 
 
     RXMESH_TRACE(
-        "mcf_rxmesh() took {} (ms) and {} iterations (i.e., {} ms/iter) ",
+        "mcf_rxmesh() took {} (ms) and {} iterations (i.e., {} ms/iter) "
+        "with {} preconditioner (setup took {} ms) and {} matrix (assembly "
+        "took {} ms)",
         timer.elapsed_millis(), num_cg_iter_taken,
-        timer.elapsed_millis() / float(num_cg_iter_taken));
+        timer.elapsed_millis() / float(num_cg_iter_taken), Arg.preconditioner,
+        precond_timer.elapsed_millis(),
+        (Arg.use_assembled ? "assembled" : "matrix-free"),
+        assembly_timer.elapsed_millis());
 
     // move output to host
     X.move(RXMESH::DEVICE, RXMESH::HOST);
@@ -202,6 +334,471 @@ void mcf_rxmesh(RXMESH::RXMeshStatic<patchSize>&   rxmesh_static,
         }
     }
 
+    EXPECT_TRUE(passed);
+    rxmesh_static.log_attributes_memory();
+    report.add_member("attributes_device_storage (mb)",
+                      rxmesh_static.get_attributes_storage_mb(RXMESH::DEVICE));
+
+    // Release allocation
+    for (const char* name : {"X", "B", "S", "R", "P"}) {
+        rxmesh_static.remove_attribute(name);
+    }
+    Z.release();
+    D.release();
+    GPU_FREE(d_blocks);
+    A.release();
+    mass.release();
+    input_coord.release();
+    fused.release();
+
+    // Finalize report
+    report.add_member("start_residual", to_string(delta_0));
+    report.add_member("end_residual", to_string(delta_new));
+    report.add_member("num_cg_iter_taken", num_cg_iter_taken);
+    report.add_member("total_time (ms)", timer.elapsed_millis());
+    report.add_member("precond_setup_time (ms)", precond_timer.elapsed_millis());
+    report.add_member("assembly_time (ms)", assembly_timer.elapsed_millis());
+    report.add_member("time_to_solution (ms)",
+                      timer.elapsed_millis() + precond_timer.elapsed_millis() +
+                          assembly_timer.elapsed_millis());
+    TestData td;
+    td.test_name = "MCF";
+    td.time_ms.push_back(timer.elapsed_millis() / float(num_cg_iter_taken));
+    td.passed.push_back(passed);
+    report.add_test(td);
+    report.write(Arg.output_folder + "/rxmesh",
+                 "MCF_RXMesh_" + extract_file_name(Arg.obj_file_name));
+}
+template <typename T, uint32_t patchSize>
+void mcf_rxmesh_pipelined(RXMESH::RXMeshStatic<patchSize>&   rxmesh_static,
+                          const std::vector<std::vector<T>>& Verts,
+                          const RXMESH::RXMeshAttribute<T>&  ground_truth)
+{
+    // Pipelined (Chronopoulos-Gear) CG where each iteration is two sweeps:
+    // one kernel for all vector updates and one kernel for the matvec fused
+    // with the two dot products. The host reads back the six scalars (dots
+    // for the three coordinates) once per iteration
+    using namespace RXMESH;
+    constexpr uint32_t blockThreads = 256;
+
+    // Report
+    Report report("MCF_RXMesh_Pipelined");
+    report.command_line(Arg.argc, Arg.argv);
+    report.device();
+    report.system();
+    report.model_data(Arg.obj_file_name, rxmesh_static);
+    report.add_member("method", std::string("RXMesh_PipelinedCG"));
+    std::string order = "default";
+    if (Arg.shuffle) {
+        order = "shuffle";
+    } else if (Arg.sort) {
+        order = "sorted";
+    }
+    report.add_member("input_order", order);
+    report.add_member("time_step", Arg.time_step);
+    report.add_member("cg_tolerance", Arg.cg_tolerance);
+    report.add_member("use_uniform_laplace", Arg.use_uniform_laplace);
+    report.add_member("max_num_cg_iter", Arg.max_num_cg_iter);
+    report.add_member("blockThreads", blockThreads);
+
+    ASSERT_TRUE(rxmesh_static.is_closed())
+        << "mcf_rxmesh only takes watertight/closed mesh without boundaries";
+
+    const uint32_t num_vertices = rxmesh_static.get_num_vertices();
+
+    // Different attributes used throughout the application
+    RXMeshAttribute<T> input_coord;
+    input_coord.set_name("coord");
+    input_coord.init(Verts.size(), 3u, RXMESH::LOCATION_ALL);
+    for (uint32_t i = 0; i < Verts.size(); ++i) {
+        for (uint32_t j = 0; j < Verts[i].size(); ++j) {
+            input_coord(i, j) = Verts[i][j];
+        }
+    }
+    input_coord.change_layout(RXMESH::HOST);
+    input_coord.move(RXMESH::HOST, RXMESH::DEVICE);
+
+    // S in CG (i.e., A*P)
+    RXMeshAttribute<T> S;
+    S.set_name("S");
+    S.init(num_vertices, 3u, RXMESH::DEVICE, RXMESH::SoA);
+    S.reset(0.0, RXMESH::DEVICE);
+
+    // W in CG (i.e., A*R)
+    RXMeshAttribute<T> W;
+    W.set_name("W");
+    W.init(num_vertices, 3u, RXMESH::DEVICE, RXMESH::SoA);
+    W.reset(0.0, RXMESH::DEVICE);
+
+    // P in CG
+    RXMeshAttribute<T> P;
+    P.set_name("P");
+    P.init(num_vertices, 3u, RXMESH::DEVICE, RXMESH::SoA);
+    P.reset(0.0, RXMESH::DEVICE);
+
+    // R in CG
+    RXMeshAttribute<T> R;
+    R.set_name("R");
+    R.init(num_vertices, 3u, RXMESH::DEVICE, RXMESH::SoA);
+    R.reset(0.0, RXMESH::DEVICE);
+
+    // B in CG
+    RXMeshAttribute<T> B;
+    B.set_name("B");
+    B.init(num_vertices, 3u, RXMESH::DEVICE, RXMESH::SoA);
+    B.reset(0.0, RXMESH::DEVICE);
+
+    // X in CG
+    RXMeshAttribute<T> X;
+    X.set_name("X");
+    X.init(num_vertices, 3u, RXMESH::LOCATION_ALL, RXMESH::SoA);
+    X.copy(input_coord, RXMESH::HOST, RXMESH::DEVICE);
+
+    // <r,r> and <w,r> for the three coordinates
+    T *d_dots(nullptr), h_dots[6];
+    CUDA_ERROR(cudaMalloc((void**)&d_dots, 6 * sizeof(T)));
+
+    // RXMesh launch box
+    LaunchBox<blockThreads> launch_box;
+    rxmesh_static.prepare_launch_box(RXMESH::Op::VV, launch_box, false, true);
+
+    const uint32_t num_blocks = DIVIDE_UP(num_vertices, blockThreads);
+
+    // init kernel to initialize RHS (B)
+    init_B<T, blockThreads>
+        <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+            rxmesh_static.get_context(), X, B, Arg.use_uniform_laplace);
+
+    // CG scalars
+    Vector<3, T> alpha(T(0)), beta(T(0)), gamma(T(0)), delta(T(0));
+
+    GPUTimer timer;
+    timer.start();
+
+    // s = Ax
+    mcf_matvec<T, blockThreads>
+        <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+            rxmesh_static.get_context(), input_coord, X, S,
+            Arg.use_uniform_laplace, Arg.time_step);
+
+    // r = b - s = b - Ax
+    init_PR<T><<<num_blocks, blockThreads>>>(num_vertices, B, S, R, P);
+
+    // since beta is zero in the first iteration, p = r and s = w
+    S.reset(0.0, RXMESH::DEVICE);
+
+    // w = Ar, gamma = <r,r>, delta = <w,r>
+    auto matvec_dot = [&](Vector<3, T>& g, Vector<3, T>& d) {
+        CUDA_ERROR(cudaMemsetAsync(d_dots, 0, 6 * sizeof(T)));
+        mcf_matvec_dot<T, blockThreads>
+            <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+                rxmesh_static.get_context(), input_coord, R, W,
+                Arg.use_uniform_laplace, Arg.time_step, d_dots);
+        CUDA_ERROR(cudaMemcpy(
+            h_dots, d_dots, 6 * sizeof(T), cudaMemcpyDeviceToHost));
+        for (uint32_t i = 0; i < 3; ++i) {
+            g[i] = h_dots[i];
+            d[i] = h_dots[3 + i];
+        }
+    };
+
+    matvec_dot(gamma, delta);
+    alpha = gamma / delta;
+
+    const Vector<3, T> delta_0(gamma);
+
+    uint32_t num_cg_iter_taken = 0;
+
+    while (num_cg_iter_taken < Arg.max_num_cg_iter) {
+        // p = r + beta*p, s = w + beta*s, x = x + alpha*p, r = r - alpha*s
+        pipelined_cg_update<T><<<num_blocks, blockThreads>>>(
+            num_vertices, alpha, beta, W, P, S, X, R);
+
+        // w = Ar, gamma = <r,r>, delta = <w,r>
+        Vector<3, T> gamma_new, delta_new;
+        matvec_dot(gamma_new, delta_new);
+
+        // exit if error is getting too low across three coordinates
+        if (gamma_new[0] < Arg.cg_tolerance * Arg.cg_tolerance * delta_0[0] &&
+            gamma_new[1] < Arg.cg_tolerance * Arg.cg_tolerance * delta_0[1] &&
+            gamma_new[2] < Arg.cg_tolerance * Arg.cg_tolerance * delta_0[2]) {
+            gamma = gamma_new;
+            break;
+        }
+
+        // beta = gamma_new / gamma
+        // alpha = gamma_new / (delta - beta * gamma_new / alpha)
+        for (uint32_t i = 0; i < 3; ++i) {
+            beta[i] = gamma_new[i] / gamma[i];
+            alpha[i] = gamma_new[i] /
+                       (delta_new[i] - beta[i] * gamma_new[i] / alpha[i]);
+        }
+        gamma = gamma_new;
+
+        ++num_cg_iter_taken;
+    }
+
+    timer.stop();
+    CUDA_ERROR(cudaDeviceSynchronize());
+    CUDA_ERROR(cudaGetLastError());
+    CUDA_ERROR(cudaProfilerStop());
+
+    RXMESH_TRACE(
+        "mcf_rxmesh_pipelined() took {} (ms) and {} iterations (i.e., {} "
+        "ms/iter) ",
+        timer.elapsed_millis(), num_cg_iter_taken,
+        timer.elapsed_millis() / float(num_cg_iter_taken));
+
+    // move output to host
+    X.move(RXMESH::DEVICE, RXMESH::HOST);
+
+    // Verify
+    bool    passed = true;
+    const T tol = 0.001;
+    for (uint32_t v = 0; v < X.get_num_mesh_elements(); ++v) {
+        if (std::fabs(X(v, 0) - ground_truth(v, 0)) >
+                tol * std::fabs(ground_truth(v, 0)) ||
+            std::fabs(X(v, 1) - ground_truth(v, 1)) >
+                tol * std::fabs(ground_truth(v, 1)) ||
+            std::fabs(X(v, 2) - ground_truth(v, 2)) >
+                tol * std::fabs(ground_truth(v, 2))) {
+            passed = false;
+            break;
+        }
+    }
+
+    EXPECT_TRUE(passed);
+    // Release allocation
+    X.release();
+    B.release();
+    S.release();
+    W.release();
+    R.release();
+    P.release();
+    input_coord.release();
+    GPU_FREE(d_dots);
+
+    // Finalize report
+    report.add_member("start_residual", to_string(delta_0));
+    report.add_member("end_residual", to_string(gamma));
+    report.add_member("num_cg_iter_taken", num_cg_iter_taken);
+    report.add_member("total_time (ms)", timer.elapsed_millis());
+    report.add_member("ms_per_iter",
+                      timer.elapsed_millis() / float(num_cg_iter_taken));
+    TestData td;
+    td.test_name = "MCF_PipelinedCG";
+    td.time_ms.push_back(timer.elapsed_millis() / float(num_cg_iter_taken));
+    td.passed.push_back(passed);
+    report.add_test(td);
+    report.write(
+        Arg.output_folder + "/rxmesh",
+        "MCF_RXMesh_Pipelined_" + extract_file_name(Arg.obj_file_name));
+}
+
+template <typename T, uint32_t K, uint32_t patchSize>
+void mcf_rxmesh_multi_rhs(RXMESH::RXMeshStatic<patchSize>&   rxmesh_static,
+                          const std::vector<std::vector<T>>& Verts,
+                          const RXMESH::RXMeshAttribute<T>&  ground_truth)
+{
+    // Solve the MCF system for K right-hand sides at once. All CG vectors
+    // store the K columns interleaved per vertex (AoS) so that one matvec
+    // computes the edge weights once and applies them to all K columns.
+    // Each column runs its own CG scalars and stops updating once it
+    // converges. Here, column k is the coordinate k%3 scaled by (1 + k/3)
+    // (standing in for other per-vertex fields e.g., normals or colors)
+    // such that every column can be checked against the ground truth
+    using namespace RXMESH;
+    constexpr uint32_t blockThreads = 256;
+
+    // Report
+    Report report("MCF_RXMesh_MultiRHS");
+    report.command_line(Arg.argc, Arg.argv);
+    report.device();
+    report.system();
+    report.model_data(Arg.obj_file_name, rxmesh_static);
+    report.add_member("method", std::string("RXMesh_MultiRHS"));
+    std::string order = "default";
+    if (Arg.shuffle) {
+        order = "shuffle";
+    } else if (Arg.sort) {
+        order = "sorted";
+    }
+    report.add_member("input_order", order);
+    report.add_member("time_step", Arg.time_step);
+    report.add_member("cg_tolerance", Arg.cg_tolerance);
+    report.add_member("use_uniform_laplace", Arg.use_uniform_laplace);
+    report.add_member("max_num_cg_iter", Arg.max_num_cg_iter);
+    report.add_member("blockThreads", blockThreads);
+    report.add_member("num_rhs", K);
+
+    ASSERT_TRUE(rxmesh_static.is_closed())
+        << "mcf_rxmesh only takes watertight/closed mesh without boundaries";
+
+    const uint32_t num_vertices = rxmesh_static.get_num_vertices();
+
+    auto column_scale = [](const uint32_t k) { return T(1 + k / 3); };
+
+    RXMeshAttribute<T> input_coord;
+    input_coord.set_name("coord");
+    input_coord.init(Verts.size(), 3u, RXMESH::LOCATION_ALL);
+    for (uint32_t i = 0; i < Verts.size(); ++i) {
+        for (uint32_t j = 0; j < Verts[i].size(); ++j) {
+            input_coord(i, j) = Verts[i][j];
+        }
+    }
+    input_coord.change_layout(RXMESH::HOST);
+    input_coord.move(RXMESH::HOST, RXMESH::DEVICE);
+
+    // X in CG initialized with the K fields
+    RXMeshAttribute<T> X;
+    X.set_name("X");
+    X.init(num_vertices, K, RXMESH::LOCATION_ALL, RXMESH::AoS);
+    for (uint32_t v = 0; v < num_vertices; ++v) {
+        for (uint32_t k = 0; k < K; ++k) {
+            X(v, k) = Verts[v][k % 3] * column_scale(k);
+        }
+    }
+    X.move(RXMESH::HOST, RXMESH::DEVICE);
+
+    // S, P, R, B in CG
+    RXMeshAttribute<T> S, P, R, B;
+    S.set_name("S");
+    P.set_name("P");
+    R.set_name("R");
+    B.set_name("B");
+    for (RXMeshAttribute<T>* attr : {&S, &P, &R, &B}) {
+        attr->init(num_vertices, K, RXMESH::DEVICE, RXMESH::AoS);
+        attr->reset(0.0, RXMESH::DEVICE);
+    }
+
+    // per-column dot products
+    T *d_dots(nullptr), h_dots[K];
+    CUDA_ERROR(cudaMalloc((void**)&d_dots, K * sizeof(T)));
+
+    auto dot = [&](const RXMeshAttribute<T>& a, const RXMeshAttribute<T>& b,
+                   Vector<K, T>& out) {
+        CUDA_ERROR(cudaMemsetAsync(d_dots, 0, K * sizeof(T)));
+        multi_dot<T, K, blockThreads>
+            <<<DIVIDE_UP(num_vertices, blockThreads), blockThreads>>>(
+                num_vertices, a, b, d_dots);
+        CUDA_ERROR(cudaMemcpy(
+            h_dots, d_dots, K * sizeof(T), cudaMemcpyDeviceToHost));
+        for (uint32_t k = 0; k < K; ++k) {
+            out[k] = h_dots[k];
+        }
+    };
+
+    // RXMesh launch box
+    LaunchBox<blockThreads> launch_box;
+    rxmesh_static.prepare_launch_box(RXMESH::Op::VV, launch_box, false, true);
+
+    const uint32_t num_blocks = DIVIDE_UP(num_vertices, blockThreads);
+
+    init_B_multi<T, K, blockThreads>
+        <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+            rxmesh_static.get_context(), input_coord, X, B,
+            Arg.use_uniform_laplace);
+
+    // CG scalars
+    Vector<K, T> alpha(T(0)), beta(T(0)), delta_new(T(0)), delta_old(T(0)),
+        s_dot_p(T(0));
+    std::vector<bool> converged(K, false);
+
+    GPUTimer timer;
+    timer.start();
+
+    // s = Ax
+    mcf_matvec_multi<T, K, blockThreads>
+        <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+            rxmesh_static.get_context(), input_coord, X, S,
+            Arg.use_uniform_laplace, Arg.time_step);
+
+    // r = b - s = b - Ax
+    // p = r
+    R.copy(B, RXMESH::DEVICE, RXMESH::DEVICE);
+    R.axpy(S, Vector<K, T>(T(-1)), Vector<K, T>(T(1)));
+    P.copy(R, RXMESH::DEVICE, RXMESH::DEVICE);
+
+    // delta_new = <r,r>
+    dot(R, R, delta_new);
+
+    const Vector<K, T> delta_0(delta_new);
+
+    uint32_t num_cg_iter_taken = 0;
+
+    while (num_cg_iter_taken < Arg.max_num_cg_iter) {
+        // s = Ap
+        mcf_matvec_multi<T, K, blockThreads>
+            <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+                rxmesh_static.get_context(), input_coord, P, S,
+                Arg.use_uniform_laplace, Arg.time_step);
+
+        // alpha = delta_new / <s,p>
+        dot(S, P, s_dot_p);
+        for (uint32_t k = 0; k < K; ++k) {
+            alpha[k] = converged[k] ? T(0) : delta_new[k] / s_dot_p[k];
+        }
+
+        // x = x + alpha*p
+        // r = r - alpha*s
+        multi_cg_update_xr<T, K><<<num_blocks, blockThreads>>>(
+            num_vertices, alpha, P, S, X, R);
+
+        // delta_new = <r,r>
+        delta_old = delta_new;
+        dot(R, R, delta_new);
+
+        // exit if error is getting too low across all columns
+        bool all_converged = true;
+        for (uint32_t k = 0; k < K; ++k) {
+            converged[k] = converged[k] ||
+                           delta_new[k] < Arg.cg_tolerance * Arg.cg_tolerance *
+                                              delta_0[k];
+            all_converged = all_converged && converged[k];
+        }
+        if (all_converged) {
+            break;
+        }
+
+        // beta = delta_new/delta_old
+        for (uint32_t k = 0; k < K; ++k) {
+            beta[k] = converged[k] ? T(0) : delta_new[k] / delta_old[k];
+        }
+
+        // p = r + beta*p
+        multi_cg_update_p<T, K>
+            <<<num_blocks, blockThreads>>>(num_vertices, beta, R, P);
+
+        ++num_cg_iter_taken;
+    }
+
+    timer.stop();
+    CUDA_ERROR(cudaDeviceSynchronize());
+    CUDA_ERROR(cudaGetLastError());
+    CUDA_ERROR(cudaProfilerStop());
+
+    RXMESH_TRACE(
+        "mcf_rxmesh_multi_rhs() took {} (ms) for {} right-hand sides (i.e., {} "
+        "ms per rhs) and {} iterations (i.e., {} ms/iter) ",
+        timer.elapsed_millis(), K, timer.elapsed_millis() / float(K),
+        num_cg_iter_taken, timer.elapsed_millis() / float(num_cg_iter_taken));
+
+    // move output to host
+    X.move(RXMESH::DEVICE, RXMESH::HOST);
+
+    // Verify
+    bool    passed = true;
+    const T tol = 0.001;
+    for (uint32_t v = 0; v < X.get_num_mesh_elements() && passed; ++v) {
+        for (uint32_t k = 0; k < K; ++k) {
+            const T gt = ground_truth(v, k % 3) * column_scale(k);
+            if (std::fabs(X(v, k) - gt) > tol * std::fabs(gt)) {
+                passed = false;
+                break;
+            }
+        }
+    }
+
     EXPECT_TRUE(passed);
     // Release allocation
     X.release();
@@ -210,17 +807,367 @@ void mcf_rxmesh(RXMESH::RXMeshStatic<patchSize>&   rxmesh_static,
     R.release();
     P.release();
     input_coord.release();
+    GPU_FREE(d_dots);
 
     // Finalize report
     report.add_member("start_residual", to_string(delta_0));
     report.add_member("end_residual", to_string(delta_new));
     report.add_member("num_cg_iter_taken", num_cg_iter_taken);
     report.add_member("total_time (ms)", timer.elapsed_millis());
+    report.add_member("time_per_rhs (ms)", timer.elapsed_millis() / float(K));
     TestData td;
-    td.test_name = "MCF";
+    td.test_name = "MCF_MultiRHS";
     td.time_ms.push_back(timer.elapsed_millis() / float(num_cg_iter_taken));
     td.passed.push_back(passed);
     report.add_test(td);
-    report.write(Arg.output_folder + "/rxmesh",
-                 "MCF_RXMesh_" + extract_file_name(Arg.obj_file_name));
-}
\ No newline at end of file
+    report.write(
+        Arg.output_folder + "/rxmesh",
+        "MCF_RXMesh_MultiRHS_" + extract_file_name(Arg.obj_file_name));
+}
+
+/**
+ * midpoint_subdivide()
+ */
+template <typename T>
+void midpoint_subdivide(std::vector<std::vector<uint32_t>>& Faces,
+                        std::vector<std::vector<T>>&        Verts)
+{
+    // split every triangle into four by inserting its edge midpoints (the
+    // orientation is kept). Used to get meshes of increasing size from one
+    // input
+    std::map<std::pair<uint32_t, uint32_t>, uint32_t> midpoints;
+
+    auto midpoint = [&](const uint32_t a, const uint32_t b) {
+        const auto key = std::make_pair(std::min(a, b), std::max(a, b));
+        auto       it = midpoints.find(key);
+        if (it != midpoints.end()) {
+            return it->second;
+        }
+        const uint32_t id = static_cast<uint32_t>(Verts.size());
+        std::vector<T> m(3);
+        for (uint32_t j = 0; j < 3; ++j) {
+            m[j] = T(0.5) * (Verts[a][j] + Verts[b][j]);
+        }
+        Verts.push_back(m);
+        midpoints.emplace(key, id);
+        return id;
+    };
+
+    std::vector<std::vector<uint32_t>> sub_faces;
+    sub_faces.reserve(4 * Faces.size());
+    for (const auto& f : Faces) {
+        const uint32_t m01 = midpoint(f[0], f[1]);
+        const uint32_t m12 = midpoint(f[1], f[2]);
+        const uint32_t m20 = midpoint(f[2], f[0]);
+        sub_faces.push_back({f[0], m01, m20});
+        sub_faces.push_back({m01, f[1], m12});
+        sub_faces.push_back({m20, m12, f[2]});
+        sub_faces.push_back({m01, m12, m20});
+    }
+    Faces.swap(sub_faces);
+}
+
+/**
+ * mcf_matvec_crossover()
+ */
+template <typename T, uint32_t patchSize>
+uint32_t mcf_matvec_crossover(RXMESH::RXMeshStatic<patchSize>&   rxmesh_static,
+                              const std::vector<std::vector<T>>& Verts,
+                              const uint32_t                     level,
+                              RXMESH::Report&                    report)
+{
+    // CG does one matvec per iteration. For every num_iter in the sweep, we
+    // time num_iter matrix-free matvecs against the assembly plus num_iter
+    // SpMVs with the assembled matrix (both are measured, not extrapolated).
+    // Returns the smallest num_iter in the sweep for which the assembled path
+    // is faster (zero if it never is)
+    using namespace RXMESH;
+    constexpr uint32_t          blockThreads = 256;
+    const std::vector<uint32_t> num_iter_sweep = {1,   10,  25,  50,
+                                                  100, 250, 500, 1000};
+
+    const uint32_t num_vertices = rxmesh_static.get_num_vertices();
+
+    RXMeshAttribute<T> coords;
+    coords.set_name("coord");
+    coords.init(num_vertices, 3u, RXMESH::LOCATION_ALL);
+    for (uint32_t i = 0; i < num_vertices; ++i) {
+        for (uint32_t j = 0; j < 3; ++j) {
+            coords(i, j) = Verts[i][j];
+        }
+    }
+    coords.move(RXMESH::HOST, RXMESH::DEVICE);
+
+    RXMeshAttribute<T> X, S;
+    X.init(num_vertices, 3u, RXMESH::DEVICE, RXMESH::SoA);
+    X.copy(coords, RXMESH::HOST, RXMESH::DEVICE);
+    S.init(num_vertices, 3u, RXMESH::DEVICE, RXMESH::SoA);
+
+    LaunchBox<blockThreads> launch_box;
+    rxmesh_static.prepare_launch_box(RXMESH::Op::VV, launch_box, false, true);
+
+    // matrix-free. The timer is stopped (and read) at every num_iter in the
+    // sweep without restarting it
+    TestData td_mf;
+    td_mf.test_name = "MCF_Matvec_MatrixFree_L" + std::to_string(level);
+    GPUTimer mf_timer;
+    mf_timer.start();
+    for (uint32_t i = 1, n = 0; n < num_iter_sweep.size(); ++i) {
+        mcf_matvec<T, blockThreads>
+            <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+                rxmesh_static.get_context(), coords, X, S,
+                Arg.use_uniform_laplace, Arg.time_step);
+        if (i == num_iter_sweep[n]) {
+            mf_timer.stop();
+            td_mf.time_ms.push_back(mf_timer.elapsed_millis());
+            ++n;
+        }
+    }
+    CUDA_ERROR(cudaGetLastError());
+
+    // assembled (the timer includes the assembly)
+    TestData td_asm;
+    td_asm.test_name = "MCF_Matvec_Assembled_L" + std::to_string(level);
+    CSRMatrix<T>       A;
+    RXMeshAttribute<T> mass;
+    mass.init(num_vertices, 1u, RXMESH::DEVICE);
+    GPUTimer asm_timer;
+    asm_timer.start();
+    rxmesh_static.template assemble_laplacian<T, blockThreads>(
+        coords, A, &mass, Arg.use_uniform_laplace, true);
+    mcf_system_from_laplacian<T>
+        <<<DIVIDE_UP(A.get_num_rows(), blockThreads), blockThreads>>>(
+            A, mass, Arg.use_uniform_laplace, Arg.time_step);
+    asm_timer.stop();
+    const float assembly_ms = asm_timer.elapsed_millis();
+    for (uint32_t i = 1, n = 0; n < num_iter_sweep.size(); ++i) {
+        A.multiply(X, S);
+        if (i == num_iter_sweep[n]) {
+            asm_timer.stop();
+            td_asm.time_ms.push_back(asm_timer.elapsed_millis());
+            ++n;
+        }
+    }
+    CUDA_ERROR(cudaGetLastError());
+
+    uint32_t crossover = 0;
+    for (uint32_t n = 0; n < num_iter_sweep.size(); ++n) {
+        const bool assembled_wins = td_asm.time_ms[n] < td_mf.time_ms[n];
+        if (assembled_wins && crossover == 0) {
+            crossover = num_iter_sweep[n];
+        }
+        RXMESH_TRACE(
+            "mcf_matvec_crossover() level {} ({} vertices) {} iterations: "
+            "matrix-free {} (ms), assembled {} (ms) -> {}",
+            level, num_vertices, num_iter_sweep[n], td_mf.time_ms[n],
+            td_asm.time_ms[n], assembled_wins ? "assembled" : "matrix-free");
+    }
+    RXMESH_TRACE(
+        "mcf_matvec_crossover() level {} ({} vertices) assembly {} (ms), "
+        "assembled pays off from {} iterations",
+        level, num_vertices, assembly_ms,
+        (crossover == 0) ? std::string("never (in the sweep)") :
+                           std::to_string(crossover));
+
+    const std::string prefix = "L" + std::to_string(level) + "_";
+    report.add_member(prefix + "num_vertices", num_vertices);
+    report.add_member(prefix + "num_faces", rxmesh_static.get_num_faces());
+    report.add_member(prefix + "assembly_time (ms)", assembly_ms);
+    report.add_member(prefix + "assembled_storage (mb)",
+                      A.get_device_storage_mb());
+    report.add_member(prefix + "crossover_num_iter", crossover);
+    td_mf.passed.push_back(true);
+    td_asm.passed.push_back(true);
+    report.add_test(td_mf);
+    report.add_test(td_asm);
+
+    A.release();
+    mass.release();
+    X.release();
+    S.release();
+    coords.release();
+
+    return crossover;
+}
+
+template <typename T, uint32_t patchSize>
+void mcf_matvec_benchmark(
+    RXMESH::RXMeshStatic<patchSize>&          rxmesh_static,
+    const std::vector<std::vector<uint32_t>>& Faces,
+    const std::vector<std::vector<T>>&        Verts)
+{
+    // Compare the matrix-free matvec against the SpMV with the assembled
+    // system matrix. Assembly is a one-time cost so the assembled path only
+    // pays off after enough CG iterations. We find that crossover for the
+    // input mesh and for num_levels midpoint subdivisions of it (each one
+    // has 4x the faces) to see how it moves with the mesh size
+    using namespace RXMESH;
+    constexpr uint32_t blockThreads = 256;
+    constexpr uint32_t num_runs = 100;
+    constexpr uint32_t num_levels = 2;
+
+    // Report
+    Report report("MCF_Matvec_Benchmark");
+    report.command_line(Arg.argc, Arg.argv);
+    report.device();
+    report.system();
+    report.model_data(Arg.obj_file_name, rxmesh_static);
+    report.add_member("method", std::string("RXMesh"));
+    report.add_member("time_step", Arg.time_step);
+    report.add_member("use_uniform_laplace", Arg.use_uniform_laplace);
+    report.add_member("blockThreads", blockThreads);
+    report.add_member("num_runs", num_runs);
+    report.add_member("num_subdivision_levels", num_levels);
+
+    const uint32_t num_vertices = rxmesh_static.get_num_vertices();
+
+    RXMeshAttribute<T> input_coord;
+    input_coord.set_name("coord");
+    input_coord.init(Verts.size(), 3u, RXMESH::LOCATION_ALL);
+    for (uint32_t i = 0; i < Verts.size(); ++i) {
+        for (uint32_t j = 0; j < Verts[i].size(); ++j) {
+            input_coord(i, j) = Verts[i][j];
+        }
+    }
+    input_coord.change_layout(RXMESH::HOST);
+    input_coord.move(RXMESH::HOST, RXMESH::DEVICE);
+
+    RXMeshAttribute<T> X;
+    X.set_name("X");
+    X.init(num_vertices, 3u, RXMESH::DEVICE, RXMESH::SoA);
+    X.copy(input_coord, RXMESH::HOST, RXMESH::DEVICE);
+
+    RXMeshAttribute<T> S_mf;
+    S_mf.set_name("S_mf");
+    S_mf.init(num_vertices, 3u, RXMESH::LOCATION_ALL, RXMESH::SoA);
+
+    RXMeshAttribute<T> S_asm;
+    S_asm.set_name("S_asm");
+    S_asm.init(num_vertices, 3u, RXMESH::LOCATION_ALL, RXMESH::SoA);
+
+    LaunchBox<blockThreads> launch_box;
+    rxmesh_static.prepare_launch_box(RXMESH::Op::VV, launch_box, false, true);
+
+    // both matvecs should give the same product
+    CSRMatrix<T>       A;
+    RXMeshAttribute<T> mass;
+    mass.set_name("mass");
+    mass.init(num_vertices, 1u, RXMESH::DEVICE);
+    rxmesh_static.template assemble_laplacian<T, blockThreads>(
+        input_coord, A, &mass, Arg.use_uniform_laplace, true);
+    mcf_system_from_laplacian<T>
+        <<<DIVIDE_UP(A.get_num_rows(), blockThreads), blockThreads>>>(
+            A, mass, Arg.use_uniform_laplace, Arg.time_step);
+    mcf_matvec<T, blockThreads>
+        <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+            rxmesh_static.get_context(), input_coord, X, S_mf,
+            Arg.use_uniform_laplace, Arg.time_step);
+    A.multiply(X, S_asm);
+    CUDA_ERROR(cudaDeviceSynchronize());
+    CUDA_ERROR(cudaGetLastError());
+
+    S_mf.move(RXMESH::DEVICE, RXMESH::HOST);
+    S_asm.move(RXMESH::DEVICE, RXMESH::HOST);
+    bool    passed = true;
+    const T tol = 0.001;
+    for (uint32_t v = 0; v < num_vertices && passed; ++v) {
+        for (uint32_t j = 0; j < 3; ++j) {
+            if (std::fabs(S_mf(v, j) - S_asm(v, j)) >
+                tol * std::max(std::fabs(S_mf(v, j)), T(1))) {
+                passed = false;
+                break;
+            }
+        }
+    }
+    EXPECT_TRUE(passed);
+    A.release();
+    mass.release();
+
+    // matrix-free matvec with the coordinates, input, and output stored as
+    // AoS, SoA, and AoSoA
+    const std::vector<std::pair<layoutT, std::string>> layouts = {
+        {AoS, "AoS"}, {SoA, "SoA"}, {AoSoA, "AoSoA"}};
+    std::vector<TestData> layout_td;
+    for (const auto& layout : layouts) {
+        RXMeshAttribute<T> coord_l, X_l, S_l;
+        coord_l.init(num_vertices, 3u, RXMESH::LOCATION_ALL, layout.first);
+        X_l.init(num_vertices, 3u, RXMESH::LOCATION_ALL, layout.first);
+        S_l.init(num_vertices, 3u, RXMESH::LOCATION_ALL, layout.first);
+        for (uint32_t v = 0; v < num_vertices; ++v) {
+            for (uint32_t j = 0; j < 3; ++j) {
+                coord_l(v, j) = input_coord(v, j);
+                X_l(v, j) = input_coord(v, j);
+            }
+        }
+        coord_l.move(RXMESH::HOST, RXMESH::DEVICE);
+        X_l.move(RXMESH::HOST, RXMESH::DEVICE);
+
+        GPUTimer timer;
+        timer.start();
+        for (uint32_t i = 0; i < num_runs; ++i) {
+            mcf_matvec<T, blockThreads>
+                <<<launch_box.blocks, blockThreads,
+                   launch_box.smem_bytes_dyn>>>(
+                    rxmesh_static.get_context(), coord_l, X_l, S_l,
+                    Arg.use_uniform_laplace, Arg.time_step);
+        }
+        timer.stop();
+        CUDA_ERROR(cudaDeviceSynchronize());
+        CUDA_ERROR(cudaGetLastError());
+
+        S_l.move(RXMESH::DEVICE, RXMESH::HOST);
+        bool layout_passed = true;
+        for (uint32_t v = 0; v < num_vertices && layout_passed; ++v) {
+            for (uint32_t j = 0; j < 3; ++j) {
+                if (std::fabs(S_l(v, j) - S_mf(v, j)) >
+                    tol * std::max(std::fabs(S_mf(v, j)), T(1))) {
+                    layout_passed = false;
+                    break;
+                }
+            }
+        }
+        EXPECT_TRUE(layout_passed) << layout.second;
+
+        TestData td_l;
+        td_l.test_name = "MCF_Matvec_" + layout.second;
+        td_l.time_ms.push_back(timer.elapsed_millis() / float(num_runs));
+        td_l.passed.push_back(layout_passed);
+        layout_td.push_back(td_l);
+
+        RXMESH_TRACE("mcf_matvec_benchmark() matrix-free {} {} (ms/matvec)",
+                     layout.second, td_l.time_ms.back());
+
+        coord_l.release();
+        X_l.release();
+        S_l.release();
+    }
+
+    // crossover by mesh size (input and its subdivisions) and by number of
+    // CG iterations
+    mcf_matvec_crossover(rxmesh_static, Verts, 0, report);
+    std::vector<std::vector<uint32_t>> sub_faces(Faces);
+    std::vector<std::vector<T>>        sub_verts(Verts);
+    for (uint32_t level = 1; level <= num_levels; ++level) {
+        midpoint_subdivide(sub_faces, sub_verts);
+        RXMeshStatic<patchSize> sub_rxmesh(sub_faces, sub_verts, false, true);
+        mcf_matvec_crossover(sub_rxmesh, sub_verts, level, report);
+    }
+
+    // Release allocation
+    X.release();
+    S_mf.release();
+    S_asm.release();
+    input_coord.release();
+
+    // Finalize report
+    TestData td;
+    td.test_name = "MCF_Matvec";
+    td.passed.push_back(passed);
+    report.add_test(td);
+    for (auto& td_l : layout_td) {
+        report.add_test(td_l);
+    }
+    report.write(
+        Arg.output_folder + "/rxmesh",
+        "MCF_Matvec_Benchmark_" + extract_file_name(Arg.obj_file_name));
+}
@@ -1,9 +1,11 @@
 #pragma once
 
-#include "mcf_util.h"
+#include <cub/block/block_reduce.cuh>
 #include "rxmesh/kernels/rxmesh_query_dispatcher.cuh"
 #include "rxmesh/rxmesh_attribute.h"
 #include "rxmesh/rxmesh_context.h"
+#include "rxmesh/rxmesh_csr.h"
+#include "rxmesh/util/cotan_weights.h"
 #include "rxmesh/util/math.h"
 #include "rxmesh/util/vector.h"
 
@@ -31,50 +33,6 @@ __global__ static void init_PR(const uint32_t                   num_vertices,
     }
 }
 
-/**
- * edge_cotan_weight()
- */
-template <typename T>
-__device__ __forceinline__ T
-edge_cotan_weight(const uint32_t                    p_id,
-                  const uint32_t                    r_id,
-                  const uint32_t                    q_id,
-                  const uint32_t                    s_id,
-                  const RXMESH::RXMeshAttribute<T>& X)
-{
-    // Get the edge weight between the two vertices p-r where
-    // q and s composes the diamond around p-r
-    using namespace RXMESH;
-
-    const Vector<3, T> p(X(p_id, 0), X(p_id, 1), X(p_id, 2));
-    const Vector<3, T> r(X(r_id, 0), X(r_id, 1), X(r_id, 2));
-    const Vector<3, T> q(X(q_id, 0), X(q_id, 1), X(q_id, 2));
-    const Vector<3, T> s(X(s_id, 0), X(s_id, 1), X(s_id, 2));
-
-    return edge_cotan_weight(p, r, q, s);
-}
-
-/**
- * partial_voronoi_area()
- */
-template <typename T>
-__device__ __forceinline__ T
-partial_voronoi_area(const uint32_t                    p_id,  // center
-                     const uint32_t                    q_id,  // before center
-                     const uint32_t                    r_id,  // after center
-                     const RXMESH::RXMeshAttribute<T>& X)
-{
-    // compute partial Voronoi area of the center vertex that is associated with
-    // the triangle p->q->r (oriented ccw)
-    using namespace RXMESH;
-
-    const Vector<3, T> p(X(p_id, 0), X(p_id, 1), X(p_id, 2));
-    const Vector<3, T> q(X(q_id, 0), X(q_id, 1), X(q_id, 2));
-    const Vector<3, T> r(X(r_id, 0), X(r_id, 1), X(r_id, 2));
-
-    return partial_voronoi_area(p, q, r);
-}
-
 /**
  * init_B()
  */
@@ -96,21 +54,8 @@ __launch_bounds__(blockThreads) __global__
         } else {
 
             // using Laplace weights
-            T v_weight = 0;
-
-            // this is the last vertex in the one-ring (before r_id)
-            uint32_t q_id = iter.back();
-
-            for (uint32_t v = 0; v < iter.size(); ++v) {
-                // the current one ring vertex
-                uint32_t r_id = iter[v];
-
-                T tri_area = partial_voronoi_area(p_id, q_id, r_id, X);
-
-                v_weight += (tri_area > 0) ? tri_area : 0.0;
-
-                q_id = r_id;
-            }
+            T v_weight = cotan_one_ring<T>(p_id, iter, X,
+                                           [](uint32_t, uint32_t, T) {});
             v_weight = 0.5 / v_weight;
 
             B(p_id, 0) = X(p_id, 0) / v_weight;
@@ -125,6 +70,92 @@ __launch_bounds__(blockThreads) __global__
                                                  !use_uniform_laplace);
 }
 
+/**
+ * mcf_row()
+ */
+template <typename T, typename offDiagT>
+__device__ __forceinline__ T mcf_row(const uint32_t                    p_id,
+                                     RXMESH::RXMeshIterator&           iter,
+                                     const RXMESH::RXMeshAttribute<T>& coords,
+                                     const bool use_uniform_laplace,
+                                     const T    time_step,
+                                     offDiagT   off_diag)
+{
+    // Compute the row of the MCF system matrix that corresponds to p_id.
+    // off_diag(r_id, val) is called for every off-diagonal entry (p_id, r_id)
+    // and the diagonal entry is returned. The cotan weights and the vertex
+    // (Voronoi) weight come from cotan_one_ring(). P is the vertex that this
+    // thread is responsible of
+    using namespace RXMESH;
+
+    T sum_e_weight(0);
+
+    // vertex weight
+    T v_weight(0);
+
+    if (use_uniform_laplace) {
+        for (uint32_t v = 0; v < iter.size(); ++v) {
+            const T e_weight = time_step;
+            sum_e_weight += e_weight;
+            off_diag(iter[v], -e_weight);
+            ++v_weight;
+        }
+    } else {
+        v_weight = cotan_one_ring<T>(
+            p_id, iter, coords,
+            [&](const uint32_t, const uint32_t r_id, T e_weight) {
+                // e_weight = max(0, e_weight) but without branch divergence
+                e_weight = (static_cast<T>(e_weight >= 0.0)) * e_weight;
+
+                e_weight *= time_step;
+                sum_e_weight += e_weight;
+
+                off_diag(r_id, -e_weight);
+            });
+    }
+
+    // Diagonal entry
+    if (use_uniform_laplace) {
+        v_weight = 1.0 / v_weight;
+    } else {
+        v_weight = 0.5 / v_weight;
+    }
+
+    assert(!isnan(v_weight));
+    assert(!isinf(v_weight));
+
+    return ((1.0 / v_weight) + sum_e_weight);
+}
+
+/**
+ * mcf_matvec_vertex()
+ */
+template <typename T>
+__device__ __forceinline__ RXMESH::Vector<3, T> mcf_matvec_vertex(
+    const uint32_t                    p_id,
+    RXMESH::RXMeshIterator&           iter,
+    const RXMESH::RXMeshAttribute<T>& coords,
+    const RXMESH::RXMeshAttribute<T>& in,
+    const bool                        use_uniform_laplace,
+    const T                           time_step)
+{
+    using namespace RXMESH;
+
+    Vector<3, T> x(T(0));
+
+    const T diag = mcf_row(p_id, iter, coords, use_uniform_laplace, time_step,
+                           [&](const uint32_t r_id, const T val) {
+                               x[0] += val * in(r_id, 0);
+                               x[1] += val * in(r_id, 1);
+                               x[2] += val * in(r_id, 2);
+                           });
+
+    x[0] += diag * in(p_id, 0);
+    x[1] += diag * in(p_id, 1);
+    x[2] += diag * in(p_id, 2);
+    return x;
+}
+
 /**
  * mcf_matvec()
  */
@@ -137,85 +168,524 @@ __launch_bounds__(blockThreads) __global__
                            const bool                       use_uniform_laplace,
                            const T                          time_step)
 {
+    using namespace RXMESH;
 
-    // To compute the vertex cotan weight, we use the following configuration
-    // where P is the center vertex we want to compute vertex weight for.
-    // Looping over P's one ring should gives q->r->s.
-    // P is the vertex that this thread is responsible of
-    /*       r
-          /  |  \
-         /   |   \
-        s    |    q
-         \   |   /
-           \ |  /
-             p
-    */
+    auto matvec_lambda = [&](uint32_t p_id, RXMeshIterator& iter) {
+        const Vector<3, T> x = mcf_matvec_vertex(p_id, iter, coords, in,
+                                                 use_uniform_laplace, time_step);
+        out(p_id, 0) = x[0];
+        out(p_id, 1) = x[1];
+        out(p_id, 2) = x[2];
+    };
+
+    // With uniform Laplacian, we just need the valence, thus we
+    // call query_block_dispatcher and set oriented to false
+    query_block_dispatcher<Op::VV, blockThreads>(context, matvec_lambda,
+                                                 !use_uniform_laplace);
+}
+
+/**
+ * mcf_matvec_dot()
+ */
+template <typename T, uint32_t blockThreads>
+__launch_bounds__(blockThreads) __global__
+    static void mcf_matvec_dot(const RXMESH::RXMeshContext      context,
+                               const RXMESH::RXMeshAttribute<T> coords,
+                               const RXMESH::RXMeshAttribute<T> in,
+                               RXMESH::RXMeshAttribute<T>       out,
+                               const bool use_uniform_laplace,
+                               const T    time_step,
+                               T*         d_dots)
+{
+    // out = A*in fused with the two dot products that pipelined CG needs
+    // i.e., d_dots[0:3] += <in, in> and d_dots[3:6] += <out, in> per
+    // coordinate. d_dots should be zeroed before the launch
     using namespace RXMESH;
 
+    T in_in[3] = {0, 0, 0};
+    T out_in[3] = {0, 0, 0};
+
     auto matvec_lambda = [&](uint32_t p_id, RXMeshIterator& iter) {
-        T sum_e_weight(0);
+        const Vector<3, T> x = mcf_matvec_vertex(p_id, iter, coords, in,
+                                                 use_uniform_laplace, time_step);
+        for (uint32_t i = 0; i < 3; ++i) {
+            const T in_val = in(p_id, i);
+            out(p_id, i) = x[i];
+            in_in[i] += in_val * in_val;
+            out_in[i] += x[i] * in_val;
+        }
+    };
 
-        Vector<3, T> x(T(0));
+    query_block_dispatcher<Op::VV, blockThreads>(context, matvec_lambda,
+                                                 !use_uniform_laplace);
 
-        // vertex weight
-        T v_weight(0);
+    if (blockIdx.x >= context.get_num_dispatch_patches()) {
+        return;
+    }
 
-        // this is the last vertex in the one-ring (before r_id)
-        uint32_t q_id = iter.back();
+    typedef cub::BlockReduce<T, blockThreads>    BlockReduce;
+    __shared__ typename BlockReduce::TempStorage temp_storage;
+    for (uint32_t i = 0; i < 3; ++i) {
+        T block_sum = BlockReduce(temp_storage).Sum(in_in[i]);
+        if (threadIdx.x == 0) {
+            atomicAdd(d_dots + i, block_sum);
+        }
+        __syncthreads();
+        block_sum = BlockReduce(temp_storage).Sum(out_in[i]);
+        if (threadIdx.x == 0) {
+            atomicAdd(d_dots + 3 + i, block_sum);
+        }
+        __syncthreads();
+    }
+}
 
-        for (uint32_t v = 0; v < iter.size(); ++v) {
-            // the current one ring vertex
-            uint32_t r_id = iter[v];
+/**
+ * pipelined_cg_update()
+ */
+template <typename T>
+__global__ static void pipelined_cg_update(const uint32_t num_vertices,
+                                           const RXMESH::Vector<3, T> alpha,
+                                           const RXMESH::Vector<3, T> beta,
+                                           const RXMESH::RXMeshAttribute<T> W,
+                                           RXMESH::RXMeshAttribute<T>       P,
+                                           RXMESH::RXMeshAttribute<T>       S,
+                                           RXMESH::RXMeshAttribute<T>       X,
+                                           RXMESH::RXMeshAttribute<T>       R)
+{
+    // all vector updates of one pipelined CG iteration in a single sweep
+    // p = r + beta*p
+    // s = w + beta*s
+    // x = x + alpha*p
+    // r = r - alpha*s
+    uint32_t idx = threadIdx.x + blockIdx.x * blockDim.x;
+    if (idx < num_vertices) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            const T p = R(idx, i) + beta[i] * P(idx, i);
+            const T s = W(idx, i) + beta[i] * S(idx, i);
+            P(idx, i) = p;
+            S(idx, i) = s;
+            X(idx, i) += alpha[i] * p;
+            R(idx, i) -= alpha[i] * s;
+        }
+    }
+}
 
-            T e_weight = 0;
-            if (use_uniform_laplace) {
-                e_weight = 1;
-            } else {
-                // the second vertex in the one ring (after r_id)
-                uint32_t s_id = (v == iter.size() - 1) ? iter[0] : iter[v + 1];
+/**
+ * mcf_diagonal()
+ */
+template <typename T, uint32_t blockThreads>
+__launch_bounds__(blockThreads) __global__
+    static void mcf_diagonal(const RXMESH::RXMeshContext      context,
+                             const RXMESH::RXMeshAttribute<T> coords,
+                             RXMESH::RXMeshAttribute<T>       diag,
+                             const bool use_uniform_laplace,
+                             const T    time_step)
+{
+    // diagonal of the MCF system matrix used by Jacobi preconditioner
+    using namespace RXMESH;
 
-                e_weight = edge_cotan_weight(p_id, r_id, q_id, s_id, coords);
+    auto diag_lambda = [&](uint32_t p_id, RXMeshIterator& iter) {
+        diag(p_id) = mcf_row(p_id, iter, coords, use_uniform_laplace,
+                             time_step, [](const uint32_t, const T) {});
+    };
 
-                // e_weight = max(0, e_weight) but without branch divergence
-                e_weight = (static_cast<T>(e_weight >= 0.0)) * e_weight;
-            }
+    query_block_dispatcher<Op::VV, blockThreads>(context, diag_lambda,
+                                                 !use_uniform_laplace);
+}
 
-            e_weight *= time_step;
-            sum_e_weight += e_weight;
+/**
+ * jacobi_apply()
+ */
+template <typename T>
+__global__ static void jacobi_apply(const uint32_t                   num_vertices,
+                                    const RXMESH::RXMeshAttribute<T> diag,
+                                    const RXMESH::RXMeshAttribute<T> R,
+                                    RXMESH::RXMeshAttribute<T>       Z)
+{
+    // z = D^{-1} r
+    uint32_t idx = threadIdx.x + blockIdx.x * blockDim.x;
+    if (idx < num_vertices) {
+        const T inv_d = T(1) / diag(idx);
+        Z(idx, 0) = R(idx, 0) * inv_d;
+        Z(idx, 1) = R(idx, 1) * inv_d;
+        Z(idx, 2) = R(idx, 2) * inv_d;
+    }
+}
+
+/**
+ * packed_lower()
+ */
+__device__ __forceinline__ uint32_t packed_lower(const uint32_t i,
+                                                 const uint32_t j)
+{
+    // index of (i, j) with j <= i in a row-major packed lower triangle
+    return i * (i + 1) / 2 + j;
+}
 
-            x[0] -= e_weight * in(r_id, 0);
-            x[1] -= e_weight * in(r_id, 1);
-            x[2] -= e_weight * in(r_id, 2);
+/**
+ * block_jacobi_local_id()
+ */
+__global__ static void block_jacobi_local_id(const RXMESH::RXMeshContext context,
+                                             uint32_t* d_local_id)
+{
+    // map every vertex to its index among its owner patch's owned vertices.
+    // One block per patch
+    const uint32_t patch_id = blockIdx.x;
+    if (patch_id >= context.get_num_patches()) {
+        return;
+    }
+    const uint32_t  num_owned = context.get_size_owned()[patch_id].z;
+    const uint32_t  start = context.get_ad_size_ltog_v()[patch_id].x;
+    const uint32_t* ltog = context.get_patches_ltog_v();
+    for (uint32_t l = threadIdx.x; l < num_owned; l += blockDim.x) {
+        d_local_id[ltog[start + l] >> 1] = l;
+    }
+}
 
+/**
+ * block_jacobi_assemble()
+ */
+template <typename T, uint32_t blockThreads>
+__launch_bounds__(blockThreads) __global__
+    static void block_jacobi_assemble(const RXMESH::RXMeshContext      context,
+                                      const RXMESH::RXMeshAttribute<T> coords,
+                                      const uint32_t* d_local_id,
+                                      T*              d_blocks,
+                                      const uint32_t  block_stride,
+                                      const bool      use_uniform_laplace,
+                                      const T         time_step)
+{
+    // scatter the lower triangle of each patch's owned-vertex subsystem into
+    // its dense packed block. d_blocks should be zeroed before the launch
+    using namespace RXMESH;
 
-            // compute vertex weight
-            if (use_uniform_laplace) {
-                ++v_weight;
-            } else {
-                T tri_area = partial_voronoi_area(p_id, q_id, r_id, coords);
-                v_weight += (tri_area > 0) ? tri_area : 0;
-                q_id = r_id;
+    auto assemble_lambda = [&](uint32_t p_id, RXMeshIterator& iter) {
+        const uint32_t patch_id = context.get_vertex_patch()[p_id];
+        const uint32_t l = d_local_id[p_id];
+        T*             block = d_blocks + size_t(patch_id) * block_stride;
+
+        const T diag = mcf_row(
+            p_id, iter, coords, use_uniform_laplace, time_step,
+            [&](const uint32_t r_id, const T val) {
+                if (context.get_vertex_patch()[r_id] == patch_id) {
+                    const uint32_t lr = d_local_id[r_id];
+                    if (lr < l) {
+                        block[packed_lower(l, lr)] = val;
+                    }
+                }
+            });
+        block[packed_lower(l, l)] = diag;
+    };
+
+    query_block_dispatcher<Op::VV, blockThreads>(context, assemble_lambda,
+                                                 !use_uniform_laplace);
+}
+
+/**
+ * block_jacobi_factor()
+ */
+template <typename T>
+__global__ static void block_jacobi_factor(const RXMESH::RXMeshContext context,
+                                           T*             d_blocks,
+                                           const uint32_t block_stride)
+{
+    // in-place dense Cholesky (A = LL^T) of each patch block. One block per
+    // patch
+    const uint32_t patch_id = blockIdx.x;
+    if (patch_id >= context.get_num_patches()) {
+        return;
+    }
+    const uint32_t n = context.get_size_owned()[patch_id].z;
+    T*             L = d_blocks + size_t(patch_id) * block_stride;
+
+    for (uint32_t k = 0; k < n; ++k) {
+        if (threadIdx.x == 0) {
+            L[packed_lower(k, k)] = sqrt(L[packed_lower(k, k)]);
+        }
+        __syncthreads();
+        const T l_kk = L[packed_lower(k, k)];
+        for (uint32_t i = k + 1 + threadIdx.x; i < n; i += blockDim.x) {
+            L[packed_lower(i, k)] /= l_kk;
+        }
+        __syncthreads();
+        // trailing update of the lower triangle, one row per thread
+        for (uint32_t i = k + 1 + threadIdx.x; i < n; i += blockDim.x) {
+            const T l_ik = L[packed_lower(i, k)];
+            if (l_ik != 0) {
+                for (uint32_t j = k + 1; j <= i; ++j) {
+                    L[packed_lower(i, j)] -= l_ik * L[packed_lower(j, k)];
+                }
             }
         }
+        __syncthreads();
+    }
+}
+
+/**
+ * block_jacobi_apply()
+ */
+template <typename T>
+__global__ static void block_jacobi_apply(const RXMESH::RXMeshContext context,
+                                          const T*       d_blocks,
+                                          const uint32_t block_stride,
+                                          const RXMESH::RXMeshAttribute<T> R,
+                                          RXMESH::RXMeshAttribute<T>       Z)
+{
+    // z = (LL^T)^{-1} r restricted to each patch's owned vertices. One block
+    // per patch with 3 * max owned vertices of dynamic shared memory
+    const uint32_t patch_id = blockIdx.x;
+    if (patch_id >= context.get_num_patches()) {
+        return;
+    }
+    extern __shared__ char shrd_mem[];
+    T* y = reinterpret_cast<T*>(shrd_mem);
+
+    const uint32_t  n = context.get_size_owned()[patch_id].z;
+    const uint32_t  start = context.get_ad_size_ltog_v()[patch_id].x;
+    const uint32_t* ltog = context.get_patches_ltog_v();
+    const T*        L = d_blocks + size_t(patch_id) * block_stride;
+
+    for (uint32_t l = threadIdx.x; l < n; l += blockDim.x) {
+        const uint32_t v = ltog[start + l] >> 1;
+        y[3 * l + 0] = R(v, 0);
+        y[3 * l + 1] = R(v, 1);
+        y[3 * l + 2] = R(v, 2);
+    }
+    __syncthreads();
+
+    // forward substitution L y = r
+    for (uint32_t k = 0; k < n; ++k) {
+        const T l_kk = L[packed_lower(k, k)];
+        const T y0 = y[3 * k + 0] / l_kk;
+        const T y1 = y[3 * k + 1] / l_kk;
+        const T y2 = y[3 * k + 2] / l_kk;
+        for (uint32_t i = k + 1 + threadIdx.x; i < n; i += blockDim.x) {
+            const T l_ik = L[packed_lower(i, k)];
+            y[3 * i + 0] -= l_ik * y0;
+            y[3 * i + 1] -= l_ik * y1;
+            y[3 * i + 2] -= l_ik * y2;
+        }
+        __syncthreads();
+        if (threadIdx.x == 0) {
+            y[3 * k + 0] = y0;
+            y[3 * k + 1] = y1;
+            y[3 * k + 2] = y2;
+        }
+        __syncthreads();
+    }
 
-        // Diagonal entry
+    // backward substitution L^T z = y
+    for (int k = int(n) - 1; k >= 0; --k) {
+        const T l_kk = L[packed_lower(k, k)];
+        const T z0 = y[3 * k + 0] / l_kk;
+        const T z1 = y[3 * k + 1] / l_kk;
+        const T z2 = y[3 * k + 2] / l_kk;
+        for (uint32_t i = threadIdx.x; i < uint32_t(k); i += blockDim.x) {
+            const T l_ki = L[packed_lower(k, i)];
+            y[3 * i + 0] -= l_ki * z0;
+            y[3 * i + 1] -= l_ki * z1;
+            y[3 * i + 2] -= l_ki * z2;
+        }
+        __syncthreads();
+        if (threadIdx.x == 0) {
+            y[3 * k + 0] = z0;
+            y[3 * k + 1] = z1;
+            y[3 * k + 2] = z2;
+        }
+        __syncthreads();
+    }
+
+    for (uint32_t l = threadIdx.x; l < n; l += blockDim.x) {
+        const uint32_t v = ltog[start + l] >> 1;
+        Z(v, 0) = y[3 * l + 0];
+        Z(v, 1) = y[3 * l + 1];
+        Z(v, 2) = y[3 * l + 2];
+    }
+}
+
+/**
+ * init_B_multi()
+ */
+template <typename T, uint32_t K, uint32_t blockThreads>
+__launch_bounds__(blockThreads) __global__
+    static void init_B_multi(const RXMESH::RXMeshContext      context,
+                             const RXMESH::RXMeshAttribute<T> coords,
+                             const RXMESH::RXMeshAttribute<T> X,
+                             RXMESH::RXMeshAttribute<T>       B,
+                             const bool use_uniform_laplace)
+{
+    // same as init_B() but for K fields stored in X
+    using namespace RXMESH;
+
+    auto init_lambda = [&](uint32_t p_id, RXMeshIterator& iter) {
+        T mass(0);
         if (use_uniform_laplace) {
-            v_weight = 1.0 / v_weight;
+            mass = static_cast<T>(iter.size());
         } else {
-            v_weight = 0.5 / v_weight;
+            // using Laplace weights
+            const T v_weight = cotan_one_ring<T>(
+                p_id, iter, coords, [](uint32_t, uint32_t, T) {});
+            mass = T(1) / (0.5 / v_weight);
+        }
+#pragma unroll
+        for (uint32_t k = 0; k < K; ++k) {
+            B(p_id, k) = X(p_id, k) * mass;
         }
+    };
 
-        assert(!isnan(v_weight));
-        assert(!isinf(v_weight));
+    query_block_dispatcher<Op::VV, blockThreads>(context, init_lambda,
+                                                 !use_uniform_laplace);
+}
+
+/**
+ * mcf_matvec_multi()
+ */
+template <typename T, uint32_t K, uint32_t blockThreads>
+__launch_bounds__(blockThreads) __global__
+    static void mcf_matvec_multi(const RXMESH::RXMeshContext      context,
+                                 const RXMESH::RXMeshAttribute<T> coords,
+                                 const RXMESH::RXMeshAttribute<T> in,
+                                 RXMESH::RXMeshAttribute<T>       out,
+                                 const bool use_uniform_laplace,
+                                 const T    time_step)
+{
+    // out = A*in for K right-hand sides stored as K attributes per vertex.
+    // The edge weights are computed once and applied to all K columns that
+    // are accumulated in registers
+    using namespace RXMESH;
+
+    assert(in.get_num_attribute_per_element() == K);
+    assert(out.get_num_attribute_per_element() == K);
 
-        T diag = ((1.0 / v_weight) + sum_e_weight);
-        out(p_id, 0) = x[0] + diag * in(p_id, 0);
-        out(p_id, 1) = x[1] + diag * in(p_id, 1);
-        out(p_id, 2) = x[2] + diag * in(p_id, 2);
+    auto matvec_lambda = [&](uint32_t p_id, RXMeshIterator& iter) {
+        T x[K];
+#pragma unroll
+        for (uint32_t k = 0; k < K; ++k) {
+            x[k] = 0;
+        }
+
+        const T diag = mcf_row(p_id, iter, coords, use_uniform_laplace,
+                               time_step, [&](const uint32_t r_id, const T val) {
+#pragma unroll
+                                   for (uint32_t k = 0; k < K; ++k) {
+                                       x[k] += val * in(r_id, k);
+                                   }
+                               });
+
+#pragma unroll
+        for (uint32_t k = 0; k < K; ++k) {
+            out(p_id, k) = x[k] + diag * in(p_id, k);
+        }
     };
 
-    // With uniform Laplacian, we just need the valence, thus we
-    // call query_block_dispatcher and set oriented to false
     query_block_dispatcher<Op::VV, blockThreads>(context, matvec_lambda,
                                                  !use_uniform_laplace);
-}
\ No newline at end of file
+}
+
+/**
+ * multi_dot()
+ */
+template <typename T, uint32_t K, uint32_t blockThreads>
+__launch_bounds__(blockThreads) __global__
+    static void multi_dot(const uint32_t                   num_vertices,
+                          const RXMESH::RXMeshAttribute<T> A,
+                          const RXMESH::RXMeshAttribute<T> B,
+                          T*                               d_dots)
+{
+    // d_dots[k] += <A(:,k), B(:,k)> for all K columns in one sweep.
+    // d_dots should be zeroed before the launch
+    uint32_t idx = threadIdx.x + blockIdx.x * blockDim.x;
+
+    T thread_val[K];
+#pragma unroll
+    for (uint32_t k = 0; k < K; ++k) {
+        thread_val[k] = (idx < num_vertices) ? A(idx, k) * B(idx, k) : T(0);
+    }
+
+    typedef cub::BlockReduce<T, blockThreads>    BlockReduce;
+    __shared__ typename BlockReduce::TempStorage temp_storage;
+#pragma unroll
+    for (uint32_t k = 0; k < K; ++k) {
+        T block_sum = BlockReduce(temp_storage).Sum(thread_val[k]);
+        if (threadIdx.x == 0) {
+            atomicAdd(d_dots + k, block_sum);
+        }
+        __syncthreads();
+    }
+}
+
+/**
+ * multi_cg_update_xr()
+ */
+template <typename T, uint32_t K>
+__global__ static void multi_cg_update_xr(const uint32_t num_vertices,
+                                          const RXMESH::Vector<K, T> alpha,
+                                          const RXMESH::RXMeshAttribute<T> P,
+                                          const RXMESH::RXMeshAttribute<T> S,
+                                          RXMESH::RXMeshAttribute<T>       X,
+                                          RXMESH::RXMeshAttribute<T>       R)
+{
+    // x = x + alpha*p
+    // r = r - alpha*s
+    uint32_t idx = threadIdx.x + blockIdx.x * blockDim.x;
+    if (idx < num_vertices) {
+#pragma unroll
+        for (uint32_t k = 0; k < K; ++k) {
+            X(idx, k) += alpha[k] * P(idx, k);
+            R(idx, k) -= alpha[k] * S(idx, k);
+        }
+    }
+}
+
+/**
+ * multi_cg_update_p()
+ */
+template <typename T, uint32_t K>
+__global__ static void multi_cg_update_p(const uint32_t num_vertices,
+                                         const RXMESH::Vector<K, T> beta,
+                                         const RXMESH::RXMeshAttribute<T> R,
+                                         RXMESH::RXMeshAttribute<T>       P)
+{
+    // p = r + beta*p
+    uint32_t idx = threadIdx.x + blockIdx.x * blockDim.x;
+    if (idx < num_vertices) {
+#pragma unroll
+        for (uint32_t k = 0; k < K; ++k) {
+            P(idx, k) = R(idx, k) + beta[k] * P(idx, k);
+        }
+    }
+}
+
+/**
+ * mcf_system_from_laplacian()
+ */
+template <typename T>
+__global__ static void mcf_system_from_laplacian(
+    RXMESH::CSRMatrix<T>             A,
+    const RXMESH::RXMeshAttribute<T> mass,
+    const bool                       use_uniform_laplace,
+    const T                          time_step)
+{
+    // Turn the assembled Laplacian L (in place) into the MCF system matrix
+    // A = M + dt*L where M is the valence (uniform) or twice the vertex
+    // Voronoi area (cotan). This matches what mcf_row() computes on the fly
+    // when L is assembled with non-negative cotan weights
+    using namespace RXMESH;
+
+    const uint32_t row = threadIdx.x + blockIdx.x * blockDim.x;
+    if (row < A.get_num_rows()) {
+        const uint32_t start = A.get_row_ptr()[row];
+        const uint32_t end = A.get_row_ptr()[row + 1];
+        for (uint32_t j = start; j < end; ++j) {
+            const T l = A.get_val()[j];
+            if (A.get_col_idx()[j] == row) {
+                const T m = (use_uniform_laplace) ?
+                                l :
+                                T(2) * mass(A.get_row_vertex()[row]);
+                A.get_val()[j] = m + time_step * l;
+            } else {
+                A.get_val()[j] = time_step * l;
+            }
+        }
+    }
+}
@@ -3,6 +3,9 @@
 // Journal of Graphics Tools 4, no. 2 (1999): 1-6.
 
 #include <cuda_profiler_api.h>
+#include <algorithm>
+#include <cstring>
+#include <numeric>
 #include "gtest/gtest.h"
 #include "rxmesh/rxmesh_attribute.h"
 #include "rxmesh/rxmesh_static.h"
@@ -117,6 +120,373 @@ void vertex_normal_rxmesh(RXMESH::RXMeshStatic<patchSize>&   rxmesh_static,
                  "VertexNormal_RXMesh_" + extract_file_name(Arg.obj_file_name));
 }
 
+template <typename T, uint32_t patchSize>
+void vertex_normal_layout(RXMESH::RXMeshStatic<patchSize>&   rxmesh_static,
+                          const std::vector<std::vector<T>>& Verts,
+                          const std::vector<T>&              vertex_normal_gold)
+{
+    // Run the RXMesh vertex normal kernel with the coordinates and normals
+    // stored as AoS, SoA, and AoSoA
+    using namespace RXMESH;
+    constexpr uint32_t blockThreads = 256;
+
+    Report report("VertexNormal_Layout_RXMesh");
+    report.command_line(Arg.argc, Arg.argv);
+    report.device();
+    report.system();
+    report.model_data(Arg.obj_file_name, rxmesh_static);
+    report.add_member("method", std::string("RXMesh"));
+    report.add_member("blockThreads", blockThreads);
+    report.add_member("aosoa_tile_size", AOSOA_TILE_SIZE);
+
+    LaunchBox<blockThreads> launch_box;
+    rxmesh_static.prepare_launch_box(RXMESH::Op::FV, launch_box);
+
+    const std::vector<std::pair<layoutT, std::string>> layouts = {
+        {AoS, "AoS"}, {SoA, "SoA"}, {AoSoA, "AoSoA"}};
+
+    for (const auto& layout : layouts) {
+        RXMeshAttribute<T> coords;
+        coords.set_name("coord");
+        coords.init(Verts.size(), 3u, RXMESH::LOCATION_ALL, layout.first);
+        for (uint32_t i = 0; i < Verts.size(); ++i) {
+            for (uint32_t j = 0; j < Verts[i].size(); ++j) {
+                coords(i, j) = Verts[i][j];
+            }
+        }
+        coords.move(RXMESH::HOST, RXMESH::DEVICE);
+
+        RXMeshAttribute<T> rxmesh_normal;
+        rxmesh_normal.set_name("normal");
+        rxmesh_normal.init(coords.get_num_mesh_elements(), 3u,
+                           RXMESH::LOCATION_ALL, layout.first);
+
+        TestData td;
+        td.test_name = "VertexNormal_" + layout.second;
+        td.num_threads = launch_box.num_threads;
+        td.num_blocks = launch_box.blocks;
+        td.dyn_smem = launch_box.smem_bytes_dyn;
+        td.static_smem = launch_box.smem_bytes_static;
+
+        float vn_time = 0;
+        for (uint32_t itr = 0; itr < Arg.num_run; ++itr) {
+            rxmesh_normal.reset(0, RXMESH::DEVICE);
+            GPUTimer timer;
+            timer.start();
+
+            compute_vertex_normal<T, blockThreads>
+                <<<launch_box.blocks, blockThreads,
+                   launch_box.smem_bytes_dyn>>>(rxmesh_static.get_context(),
+                                                coords, rxmesh_normal);
+
+            timer.stop();
+            CUDA_ERROR(cudaDeviceSynchronize());
+            CUDA_ERROR(cudaGetLastError());
+            td.time_ms.push_back(timer.elapsed_millis());
+            vn_time += timer.elapsed_millis();
+        }
+
+        RXMESH_TRACE("vertex_normal_layout() {} took {} (ms)",
+                     layout.second, vn_time / Arg.num_run);
+
+        // Verify against the gold (which is AoS)
+        rxmesh_normal.move(RXMESH::DEVICE, RXMESH::HOST);
+        std::vector<T> normal(3 * Verts.size());
+        for (uint32_t i = 0; i < Verts.size(); ++i) {
+            for (uint32_t j = 0; j < 3; ++j) {
+                normal[3 * i + j] = rxmesh_normal(i, j);
+            }
+        }
+        bool passed = compare(vertex_normal_gold.data(), normal.data(),
+                              normal.size(), false);
+        td.passed.push_back(passed);
+        EXPECT_TRUE(passed) << " RXMesh " << layout.second
+                            << " validation failed \n";
+
+        report.add_test(td);
+
+        rxmesh_normal.release();
+        coords.release();
+    }
+
+    report.write(
+        Arg.output_folder + "/rxmesh",
+        "VertexNormal_Layout_RXMesh_" + extract_file_name(Arg.obj_file_name));
+}
+
+template <typename T, uint32_t patchSize>
+void vertex_normal_colored(RXMESH::RXMeshStatic<patchSize>&   rxmesh_static,
+                           const std::vector<std::vector<T>>& Verts,
+                           const std::vector<T>&              vertex_normal_gold)
+{
+    // Compute the vertex normals without atomics by scattering the face
+    // weights one patch color at a time. The atomicAdd in
+    // compute_vertex_normal() sums each normal in whatever order the threads
+    // arrive so the low bits may differ between runs. Here we run the
+    // colored version several times and require the results to be bitwise
+    // identical (and to match the gold)
+    using namespace RXMESH;
+    constexpr uint32_t blockThreads = 256;
+    const uint32_t     num_runs = std::max(Arg.num_run, 3u);
+
+    RXMeshAttribute<T> coords;
+    coords.set_name("coord");
+    coords.init(Verts.size(), 3u, RXMESH::LOCATION_ALL);
+    for (uint32_t i = 0; i < Verts.size(); ++i) {
+        for (uint32_t j = 0; j < Verts[i].size(); ++j) {
+            coords(i, j) = Verts[i][j];
+        }
+    }
+    coords.move(RXMESH::HOST, RXMESH::DEVICE);
+
+    RXMeshAttribute<T> rxmesh_normal;
+    rxmesh_normal.set_name("normal");
+    rxmesh_normal.init(coords.get_num_mesh_elements(), 3u,
+                       RXMESH::LOCATION_ALL);
+
+    RXMeshAttribute<T> face_weights;
+    face_weights.set_name("face_weights");
+    face_weights.init(rxmesh_static.get_num_faces(), 9u, RXMESH::DEVICE);
+    RXMeshAttribute<uint32_t> face_vertices;
+    face_vertices.set_name("face_vertices");
+    face_vertices.init(rxmesh_static.get_num_faces(), 3u, RXMESH::DEVICE);
+
+    LaunchBox<blockThreads> launch_box;
+    rxmesh_static.prepare_launch_box(RXMESH::Op::FV, launch_box);
+
+    rxmesh_static.compute_patch_coloring();
+
+    TestData td;
+    td.test_name = "VertexNormal_Colored";
+
+    const uint32_t num_values = coords.get_num_mesh_elements() * 3;
+    std::vector<T> first_run(num_values);
+    bool           reproducible = true;
+    for (uint32_t itr = 0; itr < num_runs; ++itr) {
+        rxmesh_normal.reset(0, RXMESH::DEVICE);
+        GPUTimer timer;
+        timer.start();
+
+        compute_face_normal_weights<T, blockThreads>
+            <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+                rxmesh_static.get_context(), coords, face_weights,
+                face_vertices);
+        rxmesh_static.for_each_color(
+            [&](const RXMeshContext& context, uint32_t num_blocks) {
+                scatter_vertex_normal<T><<<num_blocks, blockThreads>>>(
+                    context, face_weights, face_vertices, rxmesh_normal);
+            });
+
+        timer.stop();
+        CUDA_ERROR(cudaDeviceSynchronize());
+        CUDA_ERROR(cudaGetLastError());
+        td.time_ms.push_back(timer.elapsed_millis());
+
+        rxmesh_normal.move(RXMESH::DEVICE, RXMESH::HOST);
+        const T* normal = rxmesh_normal.get_pointer(RXMESH::HOST);
+        if (itr == 0) {
+            std::copy(normal, normal + num_values, first_run.begin());
+        } else {
+            reproducible = reproducible &&
+                           std::memcmp(first_run.data(), normal,
+                                       num_values * sizeof(T)) == 0;
+        }
+    }
+
+    RXMESH_TRACE(
+        "vertex_normal_colored() {} colors took {} (ms), reproducible= {}",
+        rxmesh_static.get_num_patch_colors(),
+        std::accumulate(td.time_ms.begin(), td.time_ms.end(), 0.0f) /
+            num_runs,
+        reproducible);
+
+    bool passed = compare(vertex_normal_gold.data(), first_run.data(),
+                          num_values, false);
+    td.passed.push_back(passed && reproducible);
+    EXPECT_TRUE(passed) << " RXMesh colored validation failed \n";
+    EXPECT_TRUE(reproducible)
+        << " RXMesh colored normals differ between runs \n";
+
+    Report report("VertexNormal_Colored_RXMesh");
+    report.command_line(Arg.argc, Arg.argv);
+    report.device();
+    report.system();
+    report.model_data(Arg.obj_file_name, rxmesh_static);
+    report.add_member("method", std::string("RXMesh"));
+    report.add_member("blockThreads", blockThreads);
+    report.add_member("num_colors", rxmesh_static.get_num_patch_colors());
+    report.add_test(td);
+    report.write(Arg.output_folder + "/rxmesh",
+                 "VertexNormal_Colored_RXMesh_" +
+                     extract_file_name(Arg.obj_file_name));
+
+    face_vertices.release();
+    face_weights.release();
+    rxmesh_normal.release();
+    coords.release();
+}
+
+template <typename T, uint32_t patchSize>
+void vertex_normal_incremental(RXMESH::RXMeshStatic<patchSize>&   rxmesh_static,
+                               const std::vector<std::vector<T>>& Verts)
+{
+    // Emulate interactive sculpting where a brush moves a small region
+    // (~1% of the vertices) every frame. Instead of recomputing all the
+    // normals, we only recompute the normals of the vertices owned by the
+    // dirty patches and their neighbours. The result is compared against
+    // recomputing the normals of the whole mesh
+    using namespace RXMESH;
+    constexpr uint32_t blockThreads = 256;
+    const uint32_t     num_frames = 10;
+
+    RXMeshAttribute<T> coords;
+    coords.set_name("coord");
+    coords.init(Verts.size(), 3u, RXMESH::LOCATION_ALL);
+    for (uint32_t i = 0; i < Verts.size(); ++i) {
+        for (uint32_t j = 0; j < Verts[i].size(); ++j) {
+            coords(i, j) = Verts[i][j];
+        }
+    }
+    coords.move(RXMESH::HOST, RXMESH::DEVICE);
+    rxmesh_static.enable_dirty_tracking(ELEMENT::VERTEX, coords);
+
+    RXMeshAttribute<T> incremental_normal;
+    incremental_normal.set_name("incremental_normal");
+    incremental_normal.init(coords.get_num_mesh_elements(), 3u,
+                            RXMESH::LOCATION_ALL);
+    RXMeshAttribute<T> full_normal;
+    full_normal.set_name("full_normal");
+    full_normal.init(coords.get_num_mesh_elements(), 3u,
+                     RXMESH::LOCATION_ALL);
+
+    LaunchBox<blockThreads> launch_box;
+    rxmesh_static.prepare_launch_box(RXMESH::Op::FV, launch_box);
+
+    // the brush region is the vertices closest to the first vertex
+    const uint32_t region_size = std::max(1u, uint32_t(Verts.size()) / 100);
+    std::vector<uint32_t> region(Verts.size());
+    std::iota(region.begin(), region.end(), 0);
+    auto dist = [&](const uint32_t v) {
+        T d = 0;
+        for (uint32_t j = 0; j < 3; ++j) {
+            d += (Verts[v][j] - Verts[0][j]) * (Verts[v][j] - Verts[0][j]);
+        }
+        return d;
+    };
+    std::partial_sort(
+        region.begin(), region.begin() + region_size, region.end(),
+        [&](const uint32_t a, const uint32_t b) { return dist(a) < dist(b); });
+    uint32_t* d_region = nullptr;
+    CUDA_ERROR(cudaMalloc((void**)&d_region, region_size * sizeof(uint32_t)));
+    CUDA_ERROR(cudaMemcpy(d_region, region.data(),
+                          region_size * sizeof(uint32_t),
+                          cudaMemcpyHostToDevice));
+
+    // the patches whose normals are rewritten and the patches processed to
+    // get them
+    PatchSet write_set, dispatch_set;
+    rxmesh_static.init_patch_set(write_set);
+    rxmesh_static.init_patch_set(dispatch_set);
+
+    // initial normals
+    compute_vertex_normal<T, blockThreads>
+        <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+            rxmesh_static.get_context(), coords, incremental_normal);
+    CUDA_ERROR(cudaDeviceSynchronize());
+    coords.clear_dirty();
+
+    TestData td_incremental, td_full;
+    td_incremental.test_name = "VertexNormal_Incremental";
+    td_full.test_name = "VertexNormal_Full";
+    uint32_t num_active_patches = 0;
+    for (uint32_t frame = 0; frame < num_frames; ++frame) {
+        const T offset = (frame % 2 == 0) ? T(0.01) : T(-0.01);
+        sculpt_vertices<T>
+            <<<DIVIDE_UP(region_size, blockThreads), blockThreads>>>(
+                coords, d_region, region_size, offset);
+        CUDA_ERROR(cudaDeviceSynchronize());
+
+        CPUTimer timer;
+        timer.start();
+        const std::vector<uint32_t> dirty = coords.get_dirty_patches();
+        write_set.set(rxmesh_static.expand_patches(dirty, 1));
+        dispatch_set.set(rxmesh_static.expand_patches(dirty, 2));
+        if (!dirty.empty()) {
+            clear_vertex_normal<T>
+                <<<write_set.get_num_active_patches(), blockThreads>>>(
+                    rxmesh_static.get_patch_set_context(write_set),
+                    incremental_normal);
+            update_vertex_normal<T, blockThreads>
+                <<<dispatch_set.get_num_active_patches(), blockThreads,
+                   launch_box.smem_bytes_dyn>>>(
+                    rxmesh_static.get_patch_set_context(dispatch_set), coords,
+                    incremental_normal, write_set);
+            coords.clear_dirty();
+        }
+        CUDA_ERROR(cudaDeviceSynchronize());
+        timer.stop();
+        CUDA_ERROR(cudaGetLastError());
+        td_incremental.time_ms.push_back(timer.elapsed_millis());
+        num_active_patches += dispatch_set.get_num_active_patches();
+
+        timer.start();
+        full_normal.reset(0, RXMESH::DEVICE);
+        compute_vertex_normal<T, blockThreads>
+            <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+                rxmesh_static.get_context(), coords, full_normal);
+        CUDA_ERROR(cudaDeviceSynchronize());
+        timer.stop();
+        CUDA_ERROR(cudaGetLastError());
+        td_full.time_ms.push_back(timer.elapsed_millis());
+    }
+
+    // Verify
+    incremental_normal.move(RXMESH::DEVICE, RXMESH::HOST);
+    full_normal.move(RXMESH::DEVICE, RXMESH::HOST);
+    bool passed = compare(full_normal.get_pointer(RXMESH::HOST),
+                          incremental_normal.get_pointer(RXMESH::HOST),
+                          coords.get_num_mesh_elements() * 3, false);
+    td_incremental.passed.push_back(passed);
+    td_full.passed.push_back(true);
+    EXPECT_TRUE(passed) << " RXMesh incremental validation failed \n";
+
+    RXMESH_TRACE(
+        "vertex_normal_incremental() {} frames, {} dirty vertices, {} of {} "
+        "patches per frame: incremental= {} (ms), full= {} (ms)",
+        num_frames, region_size, float(num_active_patches) / num_frames,
+        rxmesh_static.get_num_patches(),
+        std::accumulate(td_incremental.time_ms.begin(),
+                        td_incremental.time_ms.end(), 0.0f) /
+            num_frames,
+        std::accumulate(td_full.time_ms.begin(), td_full.time_ms.end(),
+                        0.0f) /
+            num_frames);
+
+    Report report("VertexNormal_Incremental_RXMesh");
+    report.command_line(Arg.argc, Arg.argv);
+    report.device();
+    report.system();
+    report.model_data(Arg.obj_file_name, rxmesh_static);
+    report.add_member("method", std::string("RXMesh"));
+    report.add_member("blockThreads", blockThreads);
+    report.add_member("num_frames", num_frames);
+    report.add_member("num_dirty_vertices", region_size);
+    report.add_member("avg_active_patches",
+                      double(num_active_patches) / num_frames);
+    report.add_test(td_incremental);
+    report.add_test(td_full);
+    report.write(Arg.output_folder + "/rxmesh",
+                 "VertexNormal_Incremental_RXMesh_" +
+                     extract_file_name(Arg.obj_file_name));
+
+    GPU_FREE(d_region);
+    write_set.release();
+    dispatch_set.release();
+    full_normal.release();
+    incremental_normal.release();
+    coords.release();
+}
+
 TEST(Apps, VertexNormal)
 {
     using namespace RXMESH;
@@ -154,6 +524,15 @@ TEST(Apps, VertexNormal)
     //*** RXMesh Impl
     vertex_normal_rxmesh(rxmesh_static, Verts, vertex_normal_gold);
 
+    //*** RXMesh Impl with different attribute layouts
+    vertex_normal_layout(rxmesh_static, Verts, vertex_normal_gold);
+
+    //*** RXMesh Impl without atomics (one patch color at a time)
+    vertex_normal_colored(rxmesh_static, Verts, vertex_normal_gold);
+
+    //*** RXMesh Impl recomputing only the modified patches
+    vertex_normal_incremental(rxmesh_static, Verts);
+
     //*** Hardwired Impl
     vertex_normal_hardwired(Faces, Verts, vertex_normal_gold);
 }
@@ -3,6 +3,7 @@
 #include "rxmesh/kernels/rxmesh_query_dispatcher.cuh"
 #include "rxmesh/rxmesh_attribute.h"
 #include "rxmesh/rxmesh_context.h"
+#include "rxmesh/rxmesh_patch_set.h"
 #include "rxmesh/util/math.h"
 #include "rxmesh/util/vector.h"
 /**
@@ -36,4 +37,162 @@ __launch_bounds__(blockThreads, 6) __global__
     };
 
     query_block_dispatcher<Op::FV, blockThreads>(context, vn_lambda);
-}
\ No newline at end of file
+}
+
+/**
+ * clear_vertex_normal()
+ */
+template <typename T>
+__global__ static void clear_vertex_normal(const RXMESH::RXMeshContext context,
+                                           RXMESH::RXMeshAttribute<T>  normals)
+{
+    // zero the normals of the vertices owned by the dispatched patches. One
+    // block per patch (see RXMeshStatic::get_patch_set_context())
+    using namespace RXMESH;
+    if (blockIdx.x >= context.get_num_dispatch_patches()) {
+        return;
+    }
+    const uint32_t  patch_id = context.get_dispatch_patch(blockIdx.x);
+    const uint32_t  num_owned = context.get_size_owned()[patch_id].z;
+    const uint32_t  start = context.get_ad_size_ltog_v()[patch_id].x;
+    const uint32_t* ltog = context.get_patches_ltog_v();
+    for (uint32_t l = threadIdx.x; l < num_owned; l += blockDim.x) {
+        const uint32_t v = ltog[start + l] >> 1;
+        for (uint32_t i = 0; i < 3; ++i) {
+            normals(v, i) = 0;
+        }
+    }
+}
+
+/**
+ * update_vertex_normal()
+ */
+template <typename T, uint32_t blockThreads>
+__launch_bounds__(blockThreads, 6) __global__
+    static void update_vertex_normal(const RXMESH::RXMeshContext context,
+                                     RXMESH::RXMeshAttribute<T>  coords,
+                                     RXMESH::RXMeshAttribute<T>  normals,
+                                     const RXMESH::PatchSet      write_set)
+{
+    // Same as compute_vertex_normal() but only accumulate into the vertices
+    // owned by the patches in write_set (which are zeroed before by
+    // clear_vertex_normal()). Every face incident to such a vertex is owned
+    // by write_set or its neighbour patches so dispatching write_set plus
+    // one ring of patches recomputes these normals exactly while the normals
+    // of all other vertices are left untouched
+    using namespace RXMESH;
+    const uint32_t* vertex_patch = context.get_vertex_patch();
+    auto vn_lambda = [&](uint32_t face_id, RXMeshIterator& fv) {
+        Vector<3, T> c0(coords(fv[0], 0), coords(fv[0], 1), coords(fv[0], 2));
+        Vector<3, T> c1(coords(fv[1], 0), coords(fv[1], 1), coords(fv[1], 2));
+        Vector<3, T> c2(coords(fv[2], 0), coords(fv[2], 1), coords(fv[2], 2));
+
+        Vector<3, T> n = cross(c1 - c0, c2 - c0);
+
+        Vector<3, T> l(dist2(c0, c1), dist2(c1, c2), dist2(c2, c0));
+
+        for (uint32_t v = 0; v < 3; ++v) {
+            if (!write_set.contains(vertex_patch[fv[v]])) {
+                continue;
+            }
+            for (uint32_t i = 0; i < 3; ++i) {
+                atomicAdd(&normals(fv[v], i), n[i] / (l[v] + l[(v + 2) % 3]));
+            }
+        }
+    };
+
+    query_block_dispatcher<Op::FV, blockThreads>(context, vn_lambda);
+}
+
+/**
+ * compute_face_normal_weights()
+ */
+template <typename T, uint32_t blockThreads>
+__launch_bounds__(blockThreads, 6) __global__
+    static void compute_face_normal_weights(
+        const RXMESH::RXMeshContext       context,
+        RXMESH::RXMeshAttribute<T>        coords,
+        RXMESH::RXMeshAttribute<T>        face_weights,
+        RXMESH::RXMeshAttribute<uint32_t> face_vertices)
+{
+    // Same math as compute_vertex_normal() but instead of adding the
+    // weighted face normal to the vertices, store it per face corner i.e.,
+    // face_weights(f, 3 * v + i) is what face f adds to the i-th coordinate
+    // of its v-th vertex (face_vertices(f, v)). Every face is written only by
+    // its owner patch so there are no races here
+    using namespace RXMESH;
+    auto fw_lambda = [&](uint32_t face_id, RXMeshIterator& fv) {
+        Vector<3, T> c0(coords(fv[0], 0), coords(fv[0], 1), coords(fv[0], 2));
+        Vector<3, T> c1(coords(fv[1], 0), coords(fv[1], 1), coords(fv[1], 2));
+        Vector<3, T> c2(coords(fv[2], 0), coords(fv[2], 1), coords(fv[2], 2));
+
+        Vector<3, T> n = cross(c1 - c0, c2 - c0);
+
+        Vector<3, T> l(dist2(c0, c1), dist2(c1, c2), dist2(c2, c0));
+
+        for (uint32_t v = 0; v < 3; ++v) {
+            face_vertices(face_id, v) = fv[v];
+            for (uint32_t i = 0; i < 3; ++i) {
+                face_weights(face_id, 3 * v + i) =
+                    n[i] / (l[v] + l[(v + 2) % 3]);
+            }
+        }
+    };
+
+    query_block_dispatcher<Op::FV, blockThreads>(context, fw_lambda);
+}
+
+/**
+ * scatter_vertex_normal()
+ */
+template <typename T>
+__global__ static void scatter_vertex_normal(
+    const RXMESH::RXMeshContext             context,
+    const RXMESH::RXMeshAttribute<T>        face_weights,
+    const RXMESH::RXMeshAttribute<uint32_t> face_vertices,
+    RXMESH::RXMeshAttribute<T>              normals)
+{
+    // Add the per-corner weights of compute_face_normal_weights() to the
+    // vertices with plain writes. Launched one color at a time (see
+    // RXMeshStatic::for_each_color()) with one block per patch. Patches of
+    // the same color share no vertex so no two blocks touch the same normal.
+    // Inside the block, thread i owns the i-th coordinate and walks the
+    // patch's owned faces in their local order. Thus, every normal is summed
+    // in the same order on every run and the result is bitwise reproducible
+    using namespace RXMESH;
+    if (blockIdx.x >= context.get_num_dispatch_patches() || threadIdx.x >= 3) {
+        return;
+    }
+    const uint32_t  patch_id = context.get_dispatch_patch(blockIdx.x);
+    const uint32_t  num_owned = context.get_size_owned()[patch_id].x;
+    const uint32_t  start = context.get_ad_size_ltog_f()[patch_id].x;
+    const uint32_t* ltog = context.get_patches_ltog_f();
+    const uint32_t  i = threadIdx.x;
+    for (uint32_t l = 0; l < num_owned; ++l) {
+        const uint32_t f = ltog[start + l] >> 1;
+        for (uint32_t v = 0; v < 3; ++v) {
+            normals(face_vertices(f, v), i) += face_weights(f, 3 * v + i);
+        }
+    }
+}
+
+/**
+ * sculpt_vertices()
+ */
+template <typename T>
+__global__ static void sculpt_vertices(RXMESH::RXMeshAttribute<T> coords,
+                                       const uint32_t*            d_region,
+                                       const uint32_t             region_size,
+                                       const T                    offset)
+{
+    // emulate a sculpting brush i.e., displace the vertices in d_region and
+    // mark them as modified
+    const uint32_t i = blockDim.x * blockIdx.x + threadIdx.x;
+    if (i < region_size) {
+        const uint32_t v = d_region[i];
+        for (uint32_t j = 0; j < 3; ++j) {
+            coords(v, j) += offset * coords(v, j);
+        }
+        coords.mark_dirty(v);
+    }
+}
@@ -13,8 +13,6 @@ __launch_bounds__(blockThreads) __global__
     static void query_prototype(const RXMeshContext context,
                                 const bool          oriented = false)
 {
-    static_assert(op != Op::EE, "Op::EE is not supported!");
-
     auto user_lambda = [&](uint32_t id, RXMeshIterator& iter) {
         printf("\n iter.size() = %u", iter.size());
         for (uint32_t i = 0; i < iter.size(); ++i) {
@@ -35,8 +33,6 @@ __launch_bounds__(blockThreads) __global__
     static void higher_query_prototype(const RXMeshContext context,
                                        const bool          oriented = false)
 {
-    static_assert(op != Op::EE, "Op::EE is not supported!");
-
     uint32_t thread_element;
     auto     first_ring = [&](uint32_t id, RXMeshIterator& iter) {
         thread_element = id;
@@ -1,11 +1,38 @@
 #pragma once
 #include <cub/block/block_reduce.cuh>
+#include <cub/iterator/counting_input_iterator.cuh>
+#include <cub/iterator/transform_input_iterator.cuh>
 #include "rxmesh/util/macros.h"
 namespace RXMESH {
 
 template <class T>
 class RXMeshAttribute;
 
+namespace detail {
+/**
+ * AttributeColumn
+ * Maps a mesh element index to the value of one of its attributes. Used to
+ * feed a single attribute of a non-SoA RXMeshAttribute to cub device-wide
+ * algorithms
+ */
+template <class T>
+struct AttributeColumn
+{
+    AttributeColumn(const RXMeshAttribute<T>& attr, const uint32_t attribute_id)
+        : m_attr(attr), m_attribute_id(attribute_id)
+    {
+    }
+
+    __device__ __forceinline__ T operator()(const uint32_t& idx) const
+    {
+        return m_attr(idx, m_attribute_id);
+    }
+
+    RXMeshAttribute<T> m_attr;
+    uint32_t           m_attribute_id;
+};
+}  // namespace detail
+
 template <class T>
 __global__ void rxmesh_attribute_axpy(const RXMeshAttribute<T> X,
                                       const T*                 alpha,
@@ -84,4 +111,192 @@ __global__ void rxmesh_attribute_dot(const RXMeshAttribute<T> X,
         d_block_output[blockIdx.x] = block_sum;
     }
 }
+
+
+template <class T, uint32_t blockSize, uint32_t numSlots, class... StatementT>
+__global__ void rxmesh_attribute_fused(const uint32_t num_mesh_elements,
+                                       const uint32_t num_attributes,
+                                       T*             d_block_output,
+                                       const StatementT... statements)
+{
+    // apply the statements (see FusedEvaluator) in order to every attribute
+    // of every mesh element with a grid-stride loop. The reduction
+    // statements accumulate into per-thread sums (one per attribute and per
+    // reduction) that are reduced per block into
+    // d_block_output[slot * gridDim.x + blockIdx.x]
+    constexpr uint32_t num_reductions = (StatementT::num_reductions + ... + 0);
+    const uint32_t     num_slots = num_attributes * num_reductions;
+    assert(num_slots <= numSlots);
+
+    T partial[numSlots > 0 ? numSlots : 1];
+    for (uint32_t s = 0; s < numSlots; ++s) {
+        partial[s] = 0;
+    }
+
+    for (uint32_t idx = threadIdx.x + blockIdx.x * blockDim.x;
+         idx < num_mesh_elements;
+         idx += blockDim.x * gridDim.x) {
+        for (uint32_t attr = 0; attr < num_attributes; ++attr) {
+            T* slot = partial + attr * num_reductions;
+            (statements.apply(idx, attr, slot, 1), ...);
+        }
+    }
+
+    if constexpr (numSlots > 0) {
+        typedef cub::BlockReduce<T, blockSize>       BlockReduce;
+        __shared__ typename BlockReduce::TempStorage temp_storage;
+        for (uint32_t s = 0; s < num_slots; ++s) {
+            T block_sum = BlockReduce(temp_storage).Sum(partial[s]);
+            if (threadIdx.x == 0) {
+                d_block_output[s * gridDim.x + blockIdx.x] = block_sum;
+            }
+            __syncthreads();
+        }
+    }
+}
+
+
+template <class T, uint32_t blockSize>
+__global__ void rxmesh_attribute_fused_finalize(const T*       d_block_output,
+                                                const uint32_t num_blocks,
+                                                T*             d_output)
+{
+    // one block per slot sums the per-block output of rxmesh_attribute_fused
+    T thread_val = 0;
+    for (uint32_t b = threadIdx.x; b < num_blocks; b += blockDim.x) {
+        thread_val += d_block_output[blockIdx.x * num_blocks + b];
+    }
+
+    typedef cub::BlockReduce<T, blockSize>       BlockReduce;
+    __shared__ typename BlockReduce::TempStorage temp_storage;
+    T block_sum = BlockReduce(temp_storage).Sum(thread_val);
+    if (threadIdx.x == 0) {
+        d_output[blockIdx.x] = block_sum;
+    }
+}
+
+
+template <class T, uint32_t tileDim, uint32_t blockRows>
+__global__ void rxmesh_attribute_transpose(const T* const d_in,
+                                           T*             d_out,
+                                           const uint64_t num_rows,
+                                           const uint64_t num_cols)
+{
+    // d_out = d_in^T where d_in is a row-major num_rows x num_cols matrix.
+    // Every block transposes one tileDim x tileDim tile at a time through
+    // shared memory so that both the reads and the writes are coalesced. The
+    // tile is padded by one column to avoid bank conflicts. Tiles are visited
+    // with a grid-stride loop since either dimension could be larger than what
+    // a 2D grid can cover. Shared memory is declared as raw bytes since T may
+    // not be trivially constructible
+    __shared__ __align__(16) unsigned char s_raw[tileDim * (tileDim + 1) *
+                                                 sizeof(T)];
+    T* s_tile = reinterpret_cast<T*>(s_raw);
+
+    const uint64_t row_tiles = DIVIDE_UP(num_rows, tileDim);
+    const uint64_t col_tiles = DIVIDE_UP(num_cols, tileDim);
+
+    for (uint64_t t = blockIdx.x; t < row_tiles * col_tiles; t += gridDim.x) {
+        const uint64_t r0 = (t / col_tiles) * tileDim;
+        const uint64_t c0 = (t % col_tiles) * tileDim;
+
+        for (uint32_t j = threadIdx.y; j < tileDim; j += blockRows) {
+            const uint64_t r = r0 + j;
+            const uint64_t c = c0 + threadIdx.x;
+            if (r < num_rows && c < num_cols) {
+                s_tile[j * (tileDim + 1) + threadIdx.x] =
+                    d_in[r * num_cols + c];
+            }
+        }
+        __syncthreads();
+
+        for (uint32_t j = threadIdx.y; j < tileDim; j += blockRows) {
+            const uint64_t c = c0 + j;
+            const uint64_t r = r0 + threadIdx.x;
+            if (r < num_rows && c < num_cols) {
+                d_out[c * num_rows + r] =
+                    s_tile[threadIdx.x * (tileDim + 1) + j];
+            }
+        }
+        __syncthreads();
+    }
+}
+
+
+template <class T>
+__global__ void rxmesh_attribute_transpose_narrow(const T* const d_in,
+                                                  T*             d_out,
+                                                  const uint64_t num_rows,
+                                                  const uint64_t num_cols)
+{
+    // Same as rxmesh_attribute_transpose but for matrices with fewer rows or
+    // columns than a tile (e.g., AoS with a few attributes per element) where
+    // most of a tile's threads would be idle. Every thread writes one output
+    // entry so the writes are coalesced and the reads of a warp only span a
+    // few cache lines
+    const uint64_t size = num_rows * num_cols;
+    for (uint64_t i = uint64_t(blockIdx.x) * blockDim.x + threadIdx.x; i < size;
+         i += uint64_t(blockDim.x) * gridDim.x) {
+        const uint64_t c = i / num_rows;
+        const uint64_t r = i % num_rows;
+        d_out[i] = d_in[r * num_cols + c];
+    }
+}
+
+
+template <class T>
+__global__ void rxmesh_attribute_relayout(const RXMeshAttribute<T> src,
+                                          RXMeshAttribute<T>       dst)
+{
+    // dst(i, j) = src(i, j) where src and dst only differ in their layout.
+    // Consecutive threads handle consecutive attributes of the same element
+    // and then consecutive elements so a warp touches a few tiles of an AoSoA
+    // side and a few cache lines per attribute of an SoA side
+    const uint32_t num_attr = src.get_num_attribute_per_element();
+    const uint64_t size = uint64_t(src.get_num_mesh_elements()) * num_attr;
+    for (uint64_t k = uint64_t(blockIdx.x) * blockDim.x + threadIdx.x; k < size;
+         k += uint64_t(blockDim.x) * gridDim.x) {
+        const uint32_t i = static_cast<uint32_t>(k / num_attr);
+        const uint32_t j = static_cast<uint32_t>(k % num_attr);
+        dst(i, j) = src(i, j);
+    }
+}
+
+template <class T>
+__global__ void rxmesh_attribute_permute(const RXMeshAttribute<T> src,
+                                         RXMeshAttribute<T>       dst,
+                                         const uint32_t* const    d_map,
+                                         const bool               scatter)
+{
+    // dst(d_map[i], j) = src(i, j) if scatter and dst(i, j) = src(d_map[i], j)
+    // otherwise. Elements mapped to INVALID32 are skipped. Same traversal as
+    // rxmesh_attribute_relayout so the side indexed by i is accessed in order
+    const uint32_t num_attr = src.get_num_attribute_per_element();
+    const uint64_t size = uint64_t(src.get_num_mesh_elements()) * num_attr;
+    for (uint64_t k = uint64_t(blockIdx.x) * blockDim.x + threadIdx.x; k < size;
+         k += uint64_t(blockDim.x) * gridDim.x) {
+        const uint32_t i = static_cast<uint32_t>(k / num_attr);
+        const uint32_t j = static_cast<uint32_t>(k % num_attr);
+        const uint32_t m = d_map[i];
+        if (m == INVALID32) {
+            continue;
+        }
+        if (scatter) {
+            dst(m, j) = src(i, j);
+        } else {
+            dst(i, j) = src(m, j);
+        }
+    }
+}
+
+template <class T>
+__global__ void rxmesh_attribute_mark_dirty(const RXMeshAttribute<T> attr,
+                                            const uint32_t* d_elements,
+                                            const uint32_t  num_elements)
+{
+    const uint32_t i = blockDim.x * blockIdx.x + threadIdx.x;
+    if (i < num_elements) {
+        attr.mark_dirty(d_elements[i]);
+    }
+}
 }  // namespace RXMESH
\ No newline at end of file
@@ -0,0 +1,410 @@
+#pragma once
+#include <assert.h>
+#include <stdint.h>
+#include <cub/block/block_discontinuity.cuh>
+#include <cub/block/block_radix_sort.cuh>
+
+#include "rxmesh/kernels/rxmesh_iterator.cuh"
+#include "rxmesh/kernels/rxmesh_query_dispatcher.cuh"
+#include "rxmesh/rxmesh_context.h"
+#include "rxmesh/rxmesh_kring.h"
+#include "rxmesh/util/macros.h"
+
+namespace RXMESH {
+
+namespace detail {
+
+/**
+ * kring_element_patch()
+ */
+template <Op op>
+__device__ __forceinline__ uint32_t kring_element_patch(
+    const RXMeshContext& context,
+    const uint32_t       id)
+{
+    static_assert(op == Op::VV || op == Op::FF,
+                  "k-ring is only defined for Op::VV and Op::FF");
+    if constexpr (op == Op::VV) {
+        return context.get_vertex_patch()[id];
+    } else {
+        return context.get_face_patch()[id];
+    }
+}
+
+/**
+ * kring_test_and_set()
+ */
+__device__ __forceinline__ bool kring_test_and_set(uint32_t*      s_visited,
+                                                   const uint16_t local)
+{
+    // returns true if local was already marked in this thread's visited
+    // bitset. s_visited is null when the bitset is not used
+    if (s_visited == nullptr || local == INVALID16) {
+        return false;
+    }
+    const uint32_t mask = 1u << (local & 31);
+    const bool     was_set = s_visited[local >> 5] & mask;
+    s_visited[local >> 5] |= mask;
+    return was_set;
+}
+
+/**
+ * kring_try_add()
+ */
+template <typename inBallT>
+__device__ __forceinline__ void kring_try_add(KRing&         ring,
+                                              const uint32_t k,
+                                              const uint32_t element,
+                                              const uint32_t level,
+                                              const uint32_t patch,
+                                              const uint16_t local,
+                                              inBallT        in_ball,
+                                              const bool     is_exact_visited)
+{
+    // add element to the ring if it is not there and it is within the ball.
+    // If it is already there but now reached with fewer hops (patches are not
+    // expanded in BFS order), its level is lowered and it is expanded again.
+    // If is_exact_visited, the caller has already checked the visited bitset
+    // and knows that element is not in the ring, so the search is skipped
+    if (element == ring.center()) {
+        return;
+    }
+    if (!is_exact_visited) {
+        const uint32_t e = ring.find(element);
+        if (e != INVALID32) {
+            if (k != INVALID32 && level < ring.level(e)) {
+                const bool expand_again =
+                    (ring.patch(e) == INVALID32 && level < k);
+                if (expand_again) {
+                    ring.patch(e) = patch;
+                    ring.set_meta(e, level, local);
+                } else {
+                    ring.set_meta(e, level, ring.local(e));
+                }
+            }
+            return;
+        }
+    }
+    if (in_ball(ring.center(), element)) {
+        // elements at the last level do not need to be expanded
+        ring.push(element, (level < k) ? patch : INVALID32, level, local);
+    }
+}
+
+/**
+ * kring_expand()
+ */
+template <Op op, typename inBallT>
+__device__ __forceinline__ void kring_expand(const RXMeshContext&  context,
+                                             KRing&                ring,
+                                             const uint32_t        k,
+                                             const uint32_t        e,
+                                             const RXMeshIterator& patch_iter,
+                                             const uint32_t        patch_id,
+                                             inBallT               in_ball,
+                                             uint32_t*             s_visited,
+                                             const bool is_home_patch)
+{
+    // expand the entry e using the query of patch_id currently in shared
+    // memory. patch_iter is any iterator over this patch's output. In the
+    // home patch, entries are expanded in BFS order and every element
+    // reached has a local index in this patch so the visited bitset is exact.
+    // Elsewhere, the bitset only avoids searching the ring again for
+    // elements already seen in this patch when there is no level to relax
+    const uint32_t level = ring.level(e);
+    ring.patch(e) = INVALID32;
+    if (level >= k) {
+        return;
+    }
+
+    const uint32_t num_src_in_patch = patch_iter.m_num_src_in_patch;
+
+    uint16_t local_id = ring.local(e);
+    if (local_id == INVALID16) {
+        const uint32_t v = ring.vertex(e);
+        for (uint16_t j = 0; j < num_src_in_patch; ++j) {
+            if (patch_iter.m_output_ltog_map[j] == v) {
+                local_id = j;
+                break;
+            }
+        }
+    }
+    assert(local_id < num_src_in_patch);
+
+    const bool use_visited =
+        s_visited != nullptr && (is_home_patch || k == INVALID32);
+
+    RXMeshIterator iter(patch_iter);
+    iter.set(local_id, 0);
+    for (uint32_t i = 0; i < iter.size(); ++i) {
+        const uint32_t n = iter[i];
+        const uint16_t n_local = iter.neighbour_local_id(i);
+        if (use_visited && kring_test_and_set(s_visited, n_local)) {
+            continue;
+        }
+        if (n_local < num_src_in_patch) {
+            kring_try_add(ring, k, n, level + 1, patch_id, n_local, in_ball,
+                          use_visited && is_home_patch);
+        } else {
+            kring_try_add(ring, k, n, level + 1,
+                          kring_element_patch<op>(context, n), INVALID16,
+                          in_ball, use_visited && is_home_patch);
+        }
+    }
+}
+
+/**
+ * kring_clear_visited()
+ */
+__device__ __forceinline__ void kring_clear_visited(uint32_t*      s_visited,
+                                                    const uint32_t words)
+{
+    if (s_visited != nullptr) {
+        for (uint32_t w = 0; w < words; ++w) {
+            s_visited[w] = 0;
+        }
+    }
+}
+}  // namespace detail
+
+/**
+ * kring_gather()
+ */
+template <uint32_t blockThreads,
+          Op op = Op::VV,
+          typename initT,
+          typename inBallT>
+__device__ __inline__ void kring_gather(const RXMeshContext& context,
+                                        KRing&               ring,
+                                        const uint32_t       k,
+                                        initT                init_op,
+                                        inBallT              in_ball,
+                                        uint32_t*            s_visited = nullptr,
+                                        const uint32_t       visited_words = 0)
+{
+    // Gather, for every element owned by this block's patch, the elements
+    // (vertices for Op::VV and faces for Op::FF) that are at most k hops away
+    // (k = INVALID32 for no limit) and for which in_ball(center, element) is
+    // true, while only walking through such elements. The whole block should
+    // call this function and every thread gets at most one element i.e.,
+    // blockThreads should be at least the number of owned elements per
+    // patch. init_op(center, iter) is called with the center's one ring
+    // before anything is gathered (e.g., to compute the ball radius).
+    // Elements owned by this patch are expanded right away using the patch's
+    // query with 16-bit local indices. Others are marked with their owner
+    // patch, which the block then loads and expands in batches until no
+    // thread has anything left to expand. If s_visited is not null, it is
+    // the block's visited bitsets in shared memory with visited_words words
+    // per thread (covering all elements in a patch) which replaces searching
+    // the ring for duplicates inside the home patch. The result goes into
+    // ring whose storage is taken from the arena; check the arena for
+    // overflow after the launch
+
+    uint32_t* s_my_visited =
+        (s_visited == nullptr) ? nullptr :
+                                 s_visited + threadIdx.x * visited_words;
+
+    auto first_ring = [&](uint32_t id, RXMeshIterator& iter) {
+        assert(!ring.is_valid());
+        const uint32_t home_patch = detail::kring_element_patch<op>(context, id);
+        ring.begin(id, home_patch, iter.local_id());
+
+        detail::kring_clear_visited(s_my_visited, visited_words);
+        detail::kring_test_and_set(s_my_visited, iter.local_id());
+
+        init_op(id, iter);
+
+        const uint32_t num_src_in_patch = iter.m_num_src_in_patch;
+        if (k > 0) {
+            for (uint32_t i = 0; i < iter.size(); ++i) {
+                const uint32_t n = iter[i];
+                const uint16_t n_local = iter.neighbour_local_id(i);
+                if (detail::kring_test_and_set(s_my_visited, n_local)) {
+                    continue;
+                }
+                if (n_local < num_src_in_patch) {
+                    detail::kring_try_add(ring, k, n, 1, home_patch, n_local,
+                                          in_ball, s_my_visited != nullptr);
+                } else {
+                    detail::kring_try_add(
+                        ring, k, n, 1,
+                        detail::kring_element_patch<op>(context, n),
+                        INVALID16, in_ball, s_my_visited != nullptr);
+                }
+            }
+        }
+
+        // expand everything that lives in this patch (including what gets
+        // added along the way)
+        ring.for_each_entry([&](uint32_t e) {
+            if (ring.patch(e) == home_patch) {
+                detail::kring_expand<op>(context, ring, k, e, iter,
+                                         home_patch, in_ball, s_my_visited,
+                                         true);
+            }
+        });
+    };
+
+    query_block_dispatcher<op, blockThreads>(context, first_ring);
+    __syncthreads();
+
+
+    __shared__ uint32_t s_block_patches[blockThreads];
+    __shared__ uint32_t s_num_requests;
+    __shared__ uint32_t s_num_patches;
+
+    typedef cub::BlockRadixSort<uint32_t, blockThreads, 1>  BlockRadixSort;
+    typedef cub::BlockDiscontinuity<uint32_t, blockThreads> BlockDiscontinuity;
+    union TempStorage
+    {
+        typename BlockRadixSort::TempStorage     sort_storage;
+        typename BlockDiscontinuity::TempStorage discont_storage;
+    };
+    __shared__ TempStorage all_temp_storage;
+
+    while (true) {
+        if (threadIdx.x == 0) {
+            s_num_requests = 0;
+            s_num_patches = 0;
+        }
+        __syncthreads();
+
+        // every thread requests the patches it needs. A thread requests a
+        // patch once. If there are more requests than what s_block_patches
+        // can hold, the rest wait for the next round
+        bool has_pending = false;
+        if (ring.is_valid()) {
+            uint32_t i = 0;
+            ring.for_each_entry([&](uint32_t e) {
+                const uint32_t p = ring.patch(e);
+                if (p != INVALID32) {
+                    has_pending = true;
+                    bool     requested = false;
+                    uint32_t j = 0;
+                    ring.for_each_entry([&](uint32_t f) {
+                        if (j++ < i && ring.patch(f) == p) {
+                            requested = true;
+                        }
+                    });
+                    if (!requested) {
+                        const uint32_t id = ::atomicAdd(&s_num_requests, 1u);
+                        if (id < blockThreads) {
+                            s_block_patches[id] = p;
+                        }
+                    }
+                }
+                ++i;
+            });
+        }
+        if (__syncthreads_or(has_pending) == 0) {
+            break;
+        }
+
+        // sort and uniquify the requests
+        uint32_t thread_data[1], thread_head_flags[1];
+        thread_data[0] = (threadIdx.x < min(s_num_requests, blockThreads)) ?
+                             s_block_patches[threadIdx.x] :
+                             INVALID32;
+        thread_head_flags[0] = 0;
+        BlockRadixSort(all_temp_storage.sort_storage).Sort(thread_data);
+        __syncthreads();
+        BlockDiscontinuity(all_temp_storage.discont_storage)
+            .FlagHeads(thread_head_flags, thread_data, cub::Inequality());
+        if (thread_head_flags[0] == 1 && thread_data[0] != INVALID32) {
+            const uint32_t id = ::atomicAdd(&s_num_patches, 1u);
+            s_block_patches[id] = thread_data[0];
+        }
+        __syncthreads();
+
+        for (uint32_t p = 0; p < s_num_patches; ++p) {
+            const uint32_t patch_id = s_block_patches[p];
+            assert(patch_id < context.get_num_patches());
+
+            uint32_t  num_src_in_patch = 0;
+            uint32_t *input_mapping(nullptr), *s_output_mapping(nullptr);
+            uint16_t *s_offset_all_patches(nullptr),
+                *s_output_all_patches(nullptr);
+
+            detail::template query_block_dispatcher<op, blockThreads>(
+                context, patch_id, [](uint32_t) { return true; }, false, true,
+                num_src_in_patch, input_mapping, s_output_mapping,
+                s_offset_all_patches, s_output_all_patches);
+
+            if (ring.is_valid()) {
+                const RXMeshIterator patch_iter(
+                    0, s_output_all_patches, s_offset_all_patches,
+                    s_output_mapping, 0, num_src_in_patch);
+
+                detail::kring_clear_visited(s_my_visited, visited_words);
+
+                ring.for_each_entry([&](uint32_t e) {
+                    if (ring.patch(e) == patch_id) {
+                        detail::kring_expand<op>(context, ring, k, e,
+                                                 patch_iter, patch_id, in_ball,
+                                                 s_my_visited, false);
+                    }
+                });
+            }
+            __syncthreads();
+        }
+    }
+}
+
+/**
+ * query_kring()
+ */
+template <Op op, uint32_t blockThreads, typename computeT>
+__device__ __inline__ void query_kring(const RXMeshContext& context,
+                                       const KRingArena&    arena,
+                                       const uint32_t       k,
+                                       computeT             compute_op,
+                                       uint32_t*            s_visited = nullptr,
+                                       const uint32_t       visited_words = 0)
+{
+    // Higher order query: compute_op(id, ring) is called once for every
+    // element owned by this block's patch with its k-ring (the elements at
+    // most k hops away including the element itself at level 0). Use
+    // ring.for_each() or ring.for_each_level() to iterate over it. The whole
+    // block should call this function. If the arena overflows, the launch is
+    // repeated after grow() and only the elements whose ring did not fit
+    // (i.e., not marked as done in the arena) call compute_op again
+    KRing ring(arena);
+    kring_gather<blockThreads, op>(
+        context, ring, k, [](uint32_t, RXMeshIterator&) {},
+        [](uint32_t, uint32_t) { return true; }, s_visited, visited_words);
+
+    if (ring.is_valid() && !ring.is_overflown() &&
+        !arena.is_done(ring.home_patch(), ring.center_local())) {
+        compute_op(ring.center(), ring);
+        arena.set_done(ring.home_patch(), ring.center_local());
+    }
+}
+
+namespace detail {
+/**
+ * query_kring_kernel()
+ */
+template <Op op, uint32_t blockThreads, typename computeT>
+__launch_bounds__(blockThreads) __global__
+    static void query_kring_kernel(const RXMeshContext context,
+                                   const KRingArena    arena,
+                                   const uint32_t      k,
+                                   computeT            compute_op,
+                                   const uint32_t      visited_offset,
+                                   const uint32_t      visited_words)
+{
+    // the visited bitsets live right after the dynamic shared memory used
+    // by the query itself
+    extern __shared__ uint16_t shrd_mem[];
+    uint32_t*                  s_visited =
+        (visited_words == 0) ?
+                             nullptr :
+                             reinterpret_cast<uint32_t*>(
+                                 reinterpret_cast<char*>(shrd_mem) +
+                                 visited_offset);
+
+    query_kring<op, blockThreads>(context, arena, k, compute_op, s_visited,
+                                  visited_words);
+}
+}  // namespace detail
+}  // namespace RXMESH
@@ -0,0 +1,122 @@
+#pragma once
+#include <stdint.h>
+#include "rxmesh/kernels/rxmesh_query_dispatcher.cuh"
+#include "rxmesh/rxmesh_attribute.h"
+#include "rxmesh/rxmesh_context.h"
+#include "rxmesh/rxmesh_csr.h"
+#include "rxmesh/util/cotan_weights.h"
+#include "rxmesh/util/vector.h"
+
+namespace RXMESH {
+namespace detail {
+
+/**
+ * csr_row_map()
+ */
+__global__ static void csr_row_map(const RXMeshContext context,
+                                   uint32_t*           d_row_vertex,
+                                   uint32_t*           d_vertex_row)
+{
+    // number the rows such that the vertices owned by a patch are consecutive
+    // i.e., patch p owned vertices start at row vertex_distribution[p]. One
+    // block per patch
+    const uint32_t patch_id = blockIdx.x;
+    if (patch_id >= context.get_num_patches()) {
+        return;
+    }
+    const uint32_t  num_owned = context.get_size_owned()[patch_id].z;
+    const uint32_t  start = context.get_ad_size_ltog_v()[patch_id].x;
+    const uint32_t  row_start = context.get_vertex_distribution()[patch_id];
+    const uint32_t* ltog = context.get_patches_ltog_v();
+    for (uint32_t l = threadIdx.x; l < num_owned; l += blockDim.x) {
+        const uint32_t v = ltog[start + l] >> 1;
+        d_row_vertex[row_start + l] = v;
+        d_vertex_row[v] = row_start + l;
+    }
+}
+
+/**
+ * laplacian_row_nnz()
+ */
+template <uint32_t blockThreads>
+__launch_bounds__(blockThreads) __global__
+    static void laplacian_row_nnz(const RXMeshContext context,
+                                  const uint32_t*     d_vertex_row,
+                                  uint32_t*           d_row_nnz)
+{
+    // one entry per one-ring vertex plus the diagonal
+    auto nnz_lambda = [&](uint32_t p_id, RXMeshIterator& iter) {
+        d_row_nnz[d_vertex_row[p_id]] = iter.size() + 1;
+    };
+    query_block_dispatcher<Op::VV, blockThreads>(context, nnz_lambda);
+}
+
+/**
+ * laplacian_fill()
+ */
+template <typename T, uint32_t blockThreads>
+__launch_bounds__(blockThreads) __global__
+    static void laplacian_fill(const RXMeshContext      context,
+                               const RXMeshAttribute<T> coords,
+                               const CSRMatrix<T>       mat,
+                               RXMeshAttribute<T>       mass,
+                               const bool               use_uniform_laplace,
+                               const bool               clamp_negative_weights)
+{
+    // L(p,r) = -w(p,r) and L(p,p) = sum_r w(p,r) where w is either 1
+    // (uniform) or the cotan weight. The row columns are sorted. mass (if
+    // allocated on the device) is the Voronoi area (cotan) or one (uniform)
+    auto fill_lambda = [&](uint32_t p_id, RXMeshIterator& iter) {
+        const uint32_t row = mat.get_vertex_row()[p_id];
+        const uint32_t start = mat.get_row_ptr()[row];
+        uint32_t*      col = mat.get_col_idx() + start;
+        T*             val = mat.get_val() + start;
+
+        T sum_w(0), area(0);
+
+        if (use_uniform_laplace) {
+            for (uint32_t v = 0; v < iter.size(); ++v) {
+                col[v] = mat.get_vertex_row()[iter[v]];
+                val[v] = T(-1);
+            }
+            sum_w = static_cast<T>(iter.size());
+        } else {
+            area = cotan_one_ring<T>(
+                p_id, iter, coords,
+                [&](const uint32_t v, const uint32_t r_id, T w) {
+                    if (clamp_negative_weights) {
+                        w = (static_cast<T>(w >= 0.0)) * w;
+                    }
+                    sum_w += w;
+                    col[v] = mat.get_vertex_row()[r_id];
+                    val[v] = -w;
+                });
+        }
+        col[iter.size()] = row;
+        val[iter.size()] = sum_w;
+
+        // sort the row by column (rows are as short as the valence)
+        for (uint32_t i = 1; i <= iter.size(); ++i) {
+            const uint32_t c = col[i];
+            const T        w = val[i];
+            uint32_t       j = i;
+            while (j > 0 && col[j - 1] > c) {
+                col[j] = col[j - 1];
+                val[j] = val[j - 1];
+                --j;
+            }
+            col[j] = c;
+            val[j] = w;
+        }
+
+        if (mass.is_device_allocated()) {
+            mass(p_id) = (use_uniform_laplace) ? T(1) : area;
+        }
+    };
+
+    query_block_dispatcher<Op::VV, blockThreads>(context, fill_lambda,
+                                                 !use_uniform_laplace);
+}
+
+}  // namespace detail
+}  // namespace RXMESH
@@ -0,0 +1,43 @@
+#pragma once
+#include "rxmesh/util/macros.h"
+namespace RXMESH {
+
+template <class T>
+class RXMeshAttribute;
+
+template <class codecT>
+class RXMeshPackedAttribute;
+
+template <class codecT>
+__global__ void rxmesh_packed_attribute_encode(
+    const RXMeshAttribute<float>  src,
+    RXMeshPackedAttribute<codecT> dst)
+{
+    // dst(i, j) = src(i, j) with src and dst possibly having different
+    // layouts. Same traversal as rxmesh_attribute_relayout
+    const uint32_t num_attr = src.get_num_attribute_per_element();
+    const uint64_t size = uint64_t(src.get_num_mesh_elements()) * num_attr;
+    for (uint64_t k = uint64_t(blockIdx.x) * blockDim.x + threadIdx.x; k < size;
+         k += uint64_t(blockDim.x) * gridDim.x) {
+        const uint32_t i = static_cast<uint32_t>(k / num_attr);
+        const uint32_t j = static_cast<uint32_t>(k % num_attr);
+        dst(i, j) = src(i, j);
+    }
+}
+
+template <class codecT>
+__global__ void rxmesh_packed_attribute_decode(
+    const RXMeshPackedAttribute<codecT> src,
+    RXMeshAttribute<float>              dst)
+{
+    // dst(i, j) = src(i, j) (see rxmesh_packed_attribute_encode)
+    const uint32_t num_attr = src.get_num_attribute_per_element();
+    const uint64_t size = uint64_t(src.get_num_mesh_elements()) * num_attr;
+    for (uint64_t k = uint64_t(blockIdx.x) * blockDim.x + threadIdx.x; k < size;
+         k += uint64_t(blockDim.x) * gridDim.x) {
+        const uint32_t i = static_cast<uint32_t>(k / num_attr);
+        const uint32_t j = static_cast<uint32_t>(k % num_attr);
+        dst(i, j) = src(i, j);
+    }
+}
+}  // namespace RXMESH
\ No newline at end of file
@@ -461,6 +461,101 @@ __device__ __forceinline__ void f_f(const uint32_t num_edges,
 //*************************************************************************
 
 
+//********************** 4) Edge adjacent edges
+template <uint32_t blockThreads>
+__device__ __forceinline__ void e_e(const uint32_t num_edges,
+                                    const uint32_t num_faces,
+                                    uint16_t*      s_FE,
+                                    uint16_t*&     s_EE_offset,
+                                    uint16_t*&     s_EE_output)
+{
+    // M_ee = M_fe^{T} \dot M_fe i.e., the edges adjacent to an edge are the
+    // other edges of its incident faces. We first construct M_ef in shared
+    // memory (similar to f_f) and then, instead of materializing the product,
+    // every thread walks the incident faces of its edge twice: once to count
+    // the unique adjacent edges and once (after the prefix sum) to write them.
+    // FE keeps the edge direction bit since we use it to orient the output
+
+    uint16_t* s_EF_offset = &s_FE[num_faces * 3];
+    uint16_t* s_EF_output = &s_EF_offset[num_edges + 1];
+    s_EE_offset = &s_EF_output[num_faces * 3];
+    s_EE_output = &s_EE_offset[num_edges + 1];
+
+    for (uint16_t i = threadIdx.x; i < num_faces * 3; i += blockThreads) {
+        s_EF_offset[i] = s_FE[i] >> 1;
+    }
+    __syncthreads();
+
+    e_f<blockThreads>(num_edges, num_faces, s_EF_offset, s_EF_output, 0);
+    __syncthreads();
+
+    // The c-th candidate of edge e is the (c%2 + 1)-th edge after e in its
+    // (c/2)-th incident face. On a manifold edge, we start with the face in
+    // which e is not flipped so the output is the boundary of the two faces
+    // (the diamond around e) in counter-clockwise order starting right after
+    // e. Duplicates (that only happen around non-manifold or degenerate
+    // faces) are dropped by checking the earlier candidates
+    auto candidate = [&](const uint16_t e, const uint16_t first,
+                         const uint16_t c) -> uint16_t {
+        const uint16_t start = s_EF_offset[e];
+        const uint16_t num_ef = s_EF_offset[e + 1] - start;
+        const uint16_t f = s_EF_output[start + (first + c / 2) % num_ef];
+        uint16_t       i = 0;
+        while (i < 2 && (s_FE[3 * f + i] >> 1) != e) {
+            ++i;
+        }
+        return s_FE[3 * f + (i + c % 2 + 1) % 3] >> 1;
+    };
+
+    auto first_face = [&](const uint16_t e) -> uint16_t {
+        const uint16_t start = s_EF_offset[e];
+        if (s_EF_offset[e + 1] - start != 2) {
+            return 0;
+        }
+        const uint16_t f = s_EF_output[start];
+        for (uint16_t i = 0; i < 3; ++i) {
+            if ((s_FE[3 * f + i] >> 1) == e) {
+                return s_FE[3 * f + i] & 1;
+            }
+        }
+        return 0;
+    };
+
+    auto gather = [&](const uint16_t e, uint16_t* out) -> uint16_t {
+        const uint16_t num_candidates =
+            2 * (s_EF_offset[e + 1] - s_EF_offset[e]);
+        const uint16_t first = first_face(e);
+        uint16_t       count = 0;
+        for (uint16_t c = 0; c < num_candidates; ++c) {
+            const uint16_t n = candidate(e, first, c);
+            bool           is_unique = (n != e);
+            for (uint16_t d = 0; d < c && is_unique; ++d) {
+                is_unique = (candidate(e, first, d) != n);
+            }
+            if (is_unique) {
+                if (out != nullptr) {
+                    out[count] = n;
+                }
+                ++count;
+            }
+        }
+        return count;
+    };
+
+    for (uint16_t e = threadIdx.x; e < num_edges; e += blockThreads) {
+        s_EE_offset[e] = gather(e, nullptr);
+    }
+    __syncthreads();
+
+    cub_block_exclusive_sum<uint16_t, blockThreads>(s_EE_offset, num_edges);
+
+    for (uint16_t e = threadIdx.x; e < num_edges; e += blockThreads) {
+        gather(e, &s_EE_output[s_EE_offset[e]]);
+    }
+}
+//*************************************************************************
+
+
 //**********************
 template <uint32_t blockThreads, Op op>
 __device__ __forceinline__ void query(uint16_t*&     s_offset_all_patches,
@@ -502,6 +597,12 @@ __device__ __forceinline__ void query(uint16_t*&     s_offset_all_patches,
             s_output_all_patches = s_patch_edges;
             break;
         }
+        case Op::EE: {
+            assert(num_edges <= 3 * num_faces);
+            e_e<blockThreads>(num_edges, num_faces, s_patch_faces,
+                              s_offset_all_patches, s_output_all_patches);
+            break;
+        }
         case Op::EF: {
             assert(num_edges <= 3 * num_faces);
             s_offset_all_patches = &s_patch_faces[0];
@@ -32,7 +32,6 @@ __device__ __inline__ void query_block_dispatcher(
     uint16_t*&           s_offset_all_patches,
     uint16_t*&           s_output_all_patches)
 {
-    static_assert(op != Op::EE, "Op::EE is not supported!");
     assert(current_patch_id < context.get_num_patches());
 
 
@@ -105,7 +104,7 @@ __device__ __inline__ void query_block_dispatcher(
     uint16_t local_id = threadIdx.x;
     while (local_id < num_src_in_patch) {
         is_active =
-            local_id || compute_active_set(input_mapping[local_id] >> 1);
+            is_active || compute_active_set(input_mapping[local_id] >> 1);
         local_id += blockThreads;
     }
 
@@ -171,6 +170,12 @@ __device__ __inline__ void query_block_dispatcher(
             s_output_mapping = (uint32_t*)&shrd_mem[0];
         }
 
+        if constexpr (op == Op::EE) {
+            // after FE, EF and the EE offsets and output (see e_e())
+            uint32_t last_ee = 4 * ad_size.w + 2 * (ad_size_ltog_e.y + 1);
+            s_output_mapping = (uint32_t*)&shrd_mem[last_ee + last_ee % 2];
+        }
+
         if constexpr (op == Op::VV) {
             // We use extra shared memory that is read only for VV which we can
             // just use for loading ltog. The drawback is that we need to wait
@@ -198,7 +203,6 @@ __device__ __inline__ void query_block_dispatcher(
     const bool           oriented = false,
     const bool           output_needs_mapping = true)
 {
-    static_assert(op != Op::EE, "Op::EE is not supported!");
     assert(current_patch_id < context.get_num_patches());
 
     uint32_t  num_src_in_patch = 0;
@@ -249,12 +253,12 @@ __device__ __inline__ void query_block_dispatcher(
     const bool           oriented = false,
     const bool           output_needs_mapping = true)
 {
-    if (blockIdx.x >= context.get_num_patches()) {
+    if (blockIdx.x >= context.get_num_dispatch_patches()) {
         return;
     }
-    query_block_dispatcher<op, blockThreads>(context, blockIdx.x, compute_op,
-                                             compute_active_set, oriented,
-                                             output_needs_mapping);
+    query_block_dispatcher<op, blockThreads>(
+        context, context.get_dispatch_patch(blockIdx.x), compute_op,
+        compute_active_set, oriented, output_needs_mapping);
 }
 
 /**
@@ -267,12 +271,12 @@ __device__ __inline__ void query_block_dispatcher(
     const bool           oriented = false,
     const bool           output_needs_mapping = true)
 {
-    if (blockIdx.x >= context.get_num_patches()) {
+    if (blockIdx.x >= context.get_num_dispatch_patches()) {
         return;
     }
     query_block_dispatcher<op, blockThreads>(
-        context, blockIdx.x, compute_op, [](uint32_t) { return true; },
-        oriented, output_needs_mapping);
+        context, context.get_dispatch_patch(blockIdx.x), compute_op,
+        [](uint32_t) { return true; }, oriented, output_needs_mapping);
 }
 
 
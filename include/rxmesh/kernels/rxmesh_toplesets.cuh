@@ -0,0 +1,85 @@
+#pragma once
+#include <stdint.h>
+#include "rxmesh/kernels/rxmesh_query_dispatcher.cuh"
+#include "rxmesh/rxmesh_context.h"
+#include "rxmesh/rxmesh_frontier.h"
+#include "rxmesh/util/macros.h"
+
+namespace RXMESH {
+namespace detail {
+
+/**
+ * toplesets_init_seeds()
+ */
+__global__ static void toplesets_init_seeds(const uint32_t* d_seeds,
+                                            const uint32_t  num_seeds,
+                                            uint32_t*       d_toplesets,
+                                            const Frontier  frontier)
+{
+    // seeds are level 0. Duplicate seeds are only activated once
+    const uint32_t stride = blockDim.x * gridDim.x;
+    uint32_t       i = blockDim.x * blockIdx.x + threadIdx.x;
+    while (i < num_seeds) {
+        const uint32_t s = d_seeds[i];
+        if (atomicCAS(d_toplesets + s, INVALID32, 0u) == INVALID32) {
+            frontier.activate(s);
+        }
+        i += stride;
+    }
+}
+
+/**
+ * toplesets_expand()
+ */
+template <uint32_t blockThreads>
+__launch_bounds__(blockThreads) __global__
+    static void toplesets_expand(const RXMeshContext context,
+                                 uint32_t*           d_toplesets,
+                                 const uint32_t      level,
+                                 const Frontier      frontier)
+{
+    // One level of a level-synchronous BFS. The context only dispatches the
+    // patches of the frontier (see RXMeshStatic::get_frontier_context()).
+    // Vertices discovered for the first time are assigned level + 1 and
+    // activated for the next round
+    auto in_frontier = [&](uint32_t v_id) { return frontier.is_active(v_id); };
+
+    auto expand = [&](uint32_t v_id, RXMeshIterator& iter) {
+        for (uint32_t i = 0; i < iter.size(); ++i) {
+            const uint32_t n = iter[i];
+            if (d_toplesets[n] == INVALID32 &&
+                atomicCAS(d_toplesets + n, INVALID32, level + 1) ==
+                    INVALID32) {
+                frontier.activate(n);
+            }
+        }
+    };
+
+    query_block_dispatcher<Op::VV, blockThreads>(context, expand,
+                                                 in_frontier);
+}
+
+/**
+ * toplesets_sort_keys()
+ */
+__global__ static void toplesets_sort_keys(const RXMeshContext context,
+                                           const uint32_t*     d_toplesets,
+                                           uint64_t*           d_keys,
+                                           uint32_t*           d_values)
+{
+    // sort key is (level, owner patch) so that within a level, vertices of
+    // the same patch are next to each other. Unreached vertices
+    // (INVALID32 level) sort last
+    const uint32_t num_vertices = context.get_num_vertices();
+    const uint32_t stride = blockDim.x * gridDim.x;
+    uint32_t       v = blockDim.x * blockIdx.x + threadIdx.x;
+    while (v < num_vertices) {
+        d_keys[v] = (uint64_t(d_toplesets[v]) << 32) |
+                    uint64_t(context.get_vertex_patch()[v]);
+        d_values[v] = v;
+        v += stride;
+    }
+}
+
+}  // namespace detail
+}  // namespace RXMESH
@@ -24,13 +24,16 @@ namespace PATCHER {
 
 //********************** Constructors/Destructors
 Patcher::Patcher(uint32_t                                  patch_size,
-                 const std::vector<std::vector<uint32_t>>& fvn,
+                 const std::vector<std::vector<uint32_t>>& fv,
+                 const std::vector<uint32_t>&              ff_offset,
+                 const std::vector<uint32_t>&              ff_values,
                  const uint32_t                            num_vertices,
                  const uint32_t                            num_edges,
                  const bool is_multi_component /* = true*/,
                  const bool quite /*=true*/)
-    : m_patch_size(patch_size), m_fvn(fvn), m_num_vertices(num_vertices),
-      m_num_edges(num_edges), m_num_faces(fvn.size()), m_num_seeds(0),
+    : m_fv(fv), m_ff_offset(ff_offset), m_ff_values(ff_values),
+      m_patch_size(patch_size), m_num_vertices(num_vertices),
+      m_num_edges(num_edges), m_num_faces(fv.size()), m_num_seeds(0),
       m_max_num_patches(0), m_is_multi_component(is_multi_component),
       m_quite(quite), m_num_components(0), m_patching_time_ms(0)
 {
@@ -123,7 +126,7 @@ void Patcher::export_ext_ribbon(const std::vector<std::vector<T_d>>& Verts,
                                 int                                  patch_id)
 {
     uint32_t start = ((patch_id == 0) ? 0 : m_ribbon_ext_offset[patch_id - 1]);
-    export_face_list("ribbon_ext" + std::to_string(patch_id) + ".obj", m_fvn,
+    export_face_list("ribbon_ext" + std::to_string(patch_id) + ".obj", m_fv,
                      Verts, m_ribbon_ext_offset[patch_id] - start,
                      m_ribbon_ext_val.data() + start);
 }
@@ -131,7 +134,7 @@ void Patcher::export_ext_ribbon(const std::vector<std::vector<T_d>>& Verts,
 template <class T_d>
 void Patcher::export_patches(const std::vector<std::vector<T_d>>& Verts)
 {
-    export_attribute_VTK("patches.vtk", m_fvn, Verts, 1, m_face_patch.data(),
+    export_attribute_VTK("patches.vtk", m_fv, Verts, 1, m_face_patch.data(),
                          m_vertex_patch.data(), false);
 
     /*if (!m_vertex_patch.empty()) {
@@ -165,7 +168,7 @@ void Patcher::export_components(
         }
         ++comp_id;
     }
-    export_attribute_VTK("components.vtk", m_fvn, Verts, 1,
+    export_attribute_VTK("components.vtk", m_fv, Verts, 1,
                          face_component.data(), face_component.data(),
                          num_components, false, rand_color.data());
 }
@@ -243,8 +246,7 @@ void Patcher::export_single_patch_edges(
 
 
 //********************** executer/internal utilities
-void Patcher::execute(std::function<uint32_t(uint32_t, uint32_t)> get_edge_id,
-                      const std::vector<std::vector<uint32_t>>&   ef)
+void Patcher::execute(std::function<uint32_t(uint32_t, uint32_t)> get_edge_id)
 {
 
     // degenerate cases
@@ -263,7 +265,7 @@ void Patcher::execute(std::function<uint32_t(uint32_t, uint32_t)> get_edge_id,
         return;
     }
 
-    parallel_execute(ef);
+    parallel_execute();
 
     postprocess();
 
@@ -411,7 +413,7 @@ void Patcher::initialize_random_seeds()
     }
 
 
-    // export_face_list("seeds.obj", m_fvn, Verts, uint32_t(m_seeds.size()),
+    // export_face_list("seeds.obj", m_fv, Verts, uint32_t(m_seeds.size()),
     //                 m_seeds.data());
 }
 
@@ -641,12 +643,13 @@ void Patcher::postprocess()
 void Patcher::get_adjacent_faces(uint32_t               face_id,
                                  std::vector<uint32_t>& ff) const
 {
-    if (m_fvn.size() != 0) {
+    if (m_ff_offset.size() != 0) {
         // We account here for non-manifold cases where a face might not be
         // adjacent to just three faces
-        uint32_t size = m_fvn[face_id].size() - 3;
+        uint32_t start = (face_id == 0) ? 0 : m_ff_offset[face_id - 1];
+        uint32_t size = m_ff_offset[face_id] - start;
         ff.resize(size);
-        std::memcpy(ff.data(), m_fvn[face_id].data() + 3,
+        std::memcpy(ff.data(), m_ff_values.data() + start,
                     size * sizeof(uint32_t));
     } else {
         RXMESH_ERROR(
@@ -656,9 +659,9 @@ void Patcher::get_adjacent_faces(uint32_t               face_id,
 
 void Patcher::get_incident_vertices(uint32_t face_id, std::vector<uint32_t>& fv)
 {
-    if (m_fvn.size() != 0) {
+    if (m_fv.size() != 0) {
         fv.resize(3);
-        std::memcpy(fv.data(), m_fvn[face_id].data(), 3 * sizeof(uint32_t));
+        std::memcpy(fv.data(), m_fv[face_id].data(), 3 * sizeof(uint32_t));
     } else {
         RXMESH_ERROR(
             "Patcher::get_incident_vertices() can not get adjacent faces!!");
@@ -707,71 +710,24 @@ void Patcher::assign_patch(
 }
 
 //********************** Parallel Execute
-void Patcher::populate_ff(const std::vector<std::vector<uint32_t>>& ef,
-                          std::vector<uint32_t>&                    h_ff_values,
-                          std::vector<uint32_t>&                    h_ff_offset)
-{
-    assert(ef.size() == m_num_edges);
-    uint32_t                           total_ff_values = 0;
-    std::vector<std::vector<uint32_t>> h_ff_values_vec;
-    for (uint32_t f = 0; f < m_num_faces; ++f) {
-        std::vector<uint32_t> ff;
-        ff.reserve(3);
-        h_ff_values_vec.push_back(ff);
-    }
-    for (uint32_t e = 0; e < ef.size(); ++e) {
-        for (uint32_t f0 = 0; f0 < ef[e].size() - 1; ++f0) {
-            uint32_t face0 = ef[e][f0];
-            for (uint32_t f1 = f0 + 1; f1 < ef[e].size(); ++f1) {
-                uint32_t face1 = ef[e][f1];
-                total_ff_values += 2;
-                h_ff_values_vec[face0].push_back(face1);
-                h_ff_values_vec[face1].push_back(face0);
-            }
-        }
-    }
-
-    h_ff_offset.clear();
-    h_ff_offset.resize(m_num_faces);
-    for (uint32_t f = 0; f < m_num_faces; ++f) {
-        uint32_t s = 0;
-        if (f != 0) {
-            s = h_ff_offset[f - 1];
-        }
-        h_ff_offset[f] = s + h_ff_values_vec[f].size();
-    }
-    assert(h_ff_offset.back() == total_ff_values);
-    h_ff_values.clear();
-    h_ff_values.reserve(total_ff_values);
-    for (uint32_t f = 0; f < m_num_faces; ++f) {
-        for (uint32_t ff = 0; ff < h_ff_values_vec[f].size(); ff++) {
-            h_ff_values.push_back(h_ff_values_vec[f][ff]);
-        }
-    }
-}
-
-void Patcher::parallel_execute(const std::vector<std::vector<uint32_t>>& ef)
+void Patcher::parallel_execute()
 {
     // TODO use streams
-    // TODO we don't need ef. We only use it to compute FF which we already
-    // compute in RXMesh build_local method before invoking patcher.
 
     // adjacent faces
     uint32_t *d_ff_values(nullptr), *d_ff_offset(nullptr);
     {
-        std::vector<uint32_t> h_ff_values, h_ff_offset;
-        populate_ff(ef, h_ff_values, h_ff_offset);
-        assert(h_ff_offset.size() == m_num_faces);
+        assert(m_ff_offset.size() == m_num_faces);
         CUDA_ERROR(cudaMalloc((void**)&d_ff_values,
-                              h_ff_values.size() * sizeof(uint32_t)));
+                              m_ff_values.size() * sizeof(uint32_t)));
         CUDA_ERROR(cudaMalloc((void**)&d_ff_offset,
-                              h_ff_offset.size() * sizeof(uint32_t)));
+                              m_ff_offset.size() * sizeof(uint32_t)));
 
-        CUDA_ERROR(cudaMemcpy(d_ff_values, h_ff_values.data(),
-                              h_ff_values.size() * sizeof(uint32_t),
+        CUDA_ERROR(cudaMemcpy(d_ff_values, m_ff_values.data(),
+                              m_ff_values.size() * sizeof(uint32_t),
                               cudaMemcpyHostToDevice));
-        CUDA_ERROR(cudaMemcpy(d_ff_offset, h_ff_offset.data(),
-                              h_ff_offset.size() * sizeof(uint32_t),
+        CUDA_ERROR(cudaMemcpy(d_ff_offset, m_ff_offset.data(),
+                              m_ff_offset.size() * sizeof(uint32_t),
                               cudaMemcpyHostToDevice));
     }
 
@@ -994,7 +950,7 @@ void Patcher::parallel_execute(const std::vector<std::vector<uint32_t>>& ef)
                     face_list.push_back(i);
                 }
             }
-            export_face_list("second_queue.obj", m_fvn, Verts,
+            export_face_list("second_queue.obj", m_fv, Verts,
                              uint32_t(face_list.size()), face_list.data());
         }*/
         /*{
@@ -2,6 +2,7 @@
 
 #include <stdint.h>
 #include <functional>
+#include <vector>
 namespace RXMESH {
 
 namespace PATCHER {
@@ -10,14 +11,15 @@ class Patcher
 {
    public:
     Patcher(uint32_t                                  patch_size,
-            const std::vector<std::vector<uint32_t>>& fvn,
+            const std::vector<std::vector<uint32_t>>& fv,
+            const std::vector<uint32_t>&              ff_offset,
+            const std::vector<uint32_t>&              ff_values,
             const uint32_t                            num_vertices,
             const uint32_t                            num_edges,
             const bool                                is_multi_component = true,
             const bool                                quite = true);
 
-    void execute(std::function<uint32_t(uint32_t, uint32_t)> get_edge_id,
-                 const std::vector<std::vector<uint32_t>>&   ef);
+    void execute(std::function<uint32_t(uint32_t, uint32_t)> get_edge_id);
 
     template <class T_d>
     void export_patches(const std::vector<std::vector<T_d>>& Verts);
@@ -154,8 +156,33 @@ class Patcher
     {
         return m_num_lloyd_run;
     }
+
+    size_t get_host_storage_bytes() const
+    {
+        // bytes reserved on the host by all the patcher containers
+        auto bytes = [](const std::vector<uint32_t>& v) {
+            return v.capacity() * sizeof(uint32_t);
+        };
+        return bytes(m_face_patch) + bytes(m_vertex_patch) +
+               bytes(m_edge_patch) + bytes(m_patches_val) +
+               bytes(m_patches_offset) + bytes(m_ribbon_ext_val) +
+               bytes(m_ribbon_ext_offset) + bytes(m_neighbour_patches) +
+               bytes(m_neighbour_patches_offset) + bytes(m_frontier) +
+               bytes(m_tf) + bytes(m_seeds);
+    }
     //**************************************************************************
 
+    void release_scratch()
+    {
+        // free the utility vectors that are only needed while patching. Note
+        // that the exporters still reference the face list (m_fv) passed
+        // in the constructor and should not be called once its owner
+        // releases it
+        std::vector<uint32_t>().swap(m_frontier);
+        std::vector<uint32_t>().swap(m_tf);
+        std::vector<uint32_t>().swap(m_seeds);
+    }
+
 
     ~Patcher();
 
@@ -176,9 +203,6 @@ class Patcher
     void get_adjacent_faces(uint32_t face_id, std::vector<uint32_t>& ff) const;
     void get_incident_vertices(uint32_t face_id, std::vector<uint32_t>& fv);
 
-    void     populate_ff(const std::vector<std::vector<uint32_t>>& ef,
-                         std::vector<uint32_t>&                    h_ff_values,
-                         std::vector<uint32_t>&                    h_ff_offset);
     uint32_t construct_patches_compressed_parallel(
         void*     d_cub_temp_storage_max,
         size_t    cub_temp_storage_bytes_max,
@@ -189,10 +213,16 @@ class Patcher
         uint32_t* d_patches_offset,
         uint32_t* d_face_patch,
         uint32_t* d_patches_val);
-    void parallel_execute(const std::vector<std::vector<uint32_t>>& ef);
+    void parallel_execute();
     //********
 
-    const std::vector<std::vector<uint32_t>>& m_fvn;
+    // face incident vertices
+    const std::vector<std::vector<uint32_t>>& m_fv;
+
+    // face adjacent faces in compressed format (same format as the patches
+    // i.e., ff_offset[f] is the end of face f adjacent faces)
+    const std::vector<uint32_t>& m_ff_offset;
+    const std::vector<uint32_t>& m_ff_values;
 
     uint32_t m_patch_size;
     uint32_t m_num_patches, m_num_vertices, m_num_edges, m_num_faces,
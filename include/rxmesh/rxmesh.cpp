@@ -8,6 +8,7 @@
 #include "rxmesh/rxmesh_context.h"
 #include "rxmesh/util/export_tools.h"
 #include "rxmesh/util/math.h"
+#include "rxmesh/util/util.h"
 
 namespace RXMESH {
 // extern std::vector<std::vector<RXMESH::float>> Verts; // TODO remove this
@@ -18,24 +19,46 @@ RXMesh<patchSize>::RXMesh(std::vector<std::vector<uint32_t>>& fv,
                           std::vector<std::vector<coordT>>&   coordinates,
                           const bool                          sort /*= false*/,
                           const bool                          quite /*= true*/)
+    : RXMesh(std::vector<std::vector<uint32_t>>(fv), coordinates, sort, quite)
+{
+    // the caller keeps its own faces so we reflect the new order on it
+    if (m_is_sort) {
+        for (uint32_t f = 0; f < m_num_faces; ++f) {
+            std::memcpy(fv[f].data(), m_fv[f].data(),
+                        m_face_degree * sizeof(uint32_t));
+        }
+    }
+}
+
+template <uint32_t patchSize>
+RXMesh<patchSize>::RXMesh(std::vector<std::vector<uint32_t>>&& fv,
+                          std::vector<std::vector<coordT>>&    coordinates,
+                          const bool                           sort /*= false*/,
+                          const bool                           quite /*= true*/)
     : m_num_edges(0), m_num_faces(0), m_num_vertices(0), m_max_ele_count(0),
       m_max_valence(0), m_max_valence_vertex_id(INVALID32),
       m_max_edge_incident_faces(0), m_max_face_adjacent_faces(0),
       m_face_degree(3), m_num_patches(0), m_is_input_edge_manifold(true),
       m_is_input_closed(true), m_is_sort(sort), m_quite(quite),
-      m_max_vertices_per_patch(0), m_max_edges_per_patch(0),
-      m_max_faces_per_patch(0), m_d_patches_ltog_v(nullptr),
+      m_fv(std::move(fv)), m_max_vertices_per_patch(0),
+      m_max_edges_per_patch(0), m_max_faces_per_patch(0),
+      m_d_patches_ltog_v(nullptr),
       m_d_patches_ltog_e(nullptr), m_d_patches_ltog_f(nullptr),
       m_d_ad_size_ltog_v(nullptr), m_d_ad_size_ltog_e(nullptr),
       m_d_ad_size_ltog_f(nullptr), m_d_patches_edges(nullptr),
       m_d_patches_faces(nullptr), m_d_patch_distribution_v(nullptr),
       m_d_patch_distribution_e(nullptr), m_d_patch_distribution_f(nullptr),
       m_d_ad_size(nullptr), m_d_neighbour_patches(nullptr),
-      m_d_neighbour_patches_offset(nullptr)
+      m_d_neighbour_patches_offset(nullptr), m_total_gpu_storage_mb(0)
 {
     // Build everything from scratch including patches
-    build_local(fv, coordinates);
+    build_local(coordinates);
     device_alloc_local();
+    update_host_storage();
+    if (!m_quite) {
+        RXMESH_TRACE("Host storage = {0:f} Mb (peak = {1:f} Mb)",
+                     get_host_storage_mb(), get_peak_host_storage_mb());
+    }
 }
 
 template <uint32_t patchSize>
@@ -65,33 +88,32 @@ RXMesh<patchSize>::~RXMesh()
 //********************** Builders
 template <uint32_t patchSize>
 void RXMesh<patchSize>::build_local(
-    std::vector<std::vector<uint32_t>>& fv,
-    std::vector<std::vector<coordT>>&   coordinates)
+    std::vector<std::vector<coordT>>& coordinates)
 {
-    // we build everything here from scratch
+    // we build everything here from scratch starting from the faces in m_fv
     // 1) set num vertices
     // 2) populate edge_map
     // 3) for each edge, store a list of faces that are incident to that edge
-    // 4) copy fv to m_fvn and append the adjacent faces for each face using
+    // 4) build the adjacent faces for each face (in compressed format) using
     // info from 3)
     // 5) patch the mesh
     // 6) populate the local mesh
 
     //=========== 1)
-    m_num_faces = static_cast<uint32_t>(fv.size());
-    set_num_vertices(fv);
+    m_num_faces = static_cast<uint32_t>(m_fv.size());
+    set_num_vertices(m_fv);
     //===============================
 
 
     //=========== 2)
-    populate_edge_map(fv);
+    populate_edge_map(m_fv);
     m_num_edges = static_cast<uint32_t>(m_edges_map.size());
     //===============================
 
 
     //=========== 3)
     std::vector<std::vector<uint32_t>> ef;
-    edge_incident_faces(fv, ef);
+    edge_incident_faces(m_fv, ef);
     // caching mesh type; edge manifold, closed
     for (uint32_t e = 0; e < ef.size(); ++e) {
         if (ef[e].size() < 2) {
@@ -101,26 +123,15 @@ void RXMesh<patchSize>::build_local(
             m_is_input_edge_manifold = false;
         }
     }
+    update_host_storage(get_host_bytes(ef));
     //===============================
 
 
     //=========== 4)
-    // copy fv
-    std::vector<std::vector<uint32_t>> rep(fv);
-    rep.swap(m_fvn);
-    // extend m_fvn by adding the face neighbors
-    for (uint32_t e = 0; e < ef.size(); ++e) {
-        assert(ef[e].size() != 0);  // we don't handle dangling edges
-
-        for (uint32_t f = 0; f < ef[e].size(); ++f) {
-            uint32_t f0 = ef[e][f];
-            for (uint32_t s = f + 1; s < ef[e].size(); ++s) {
-                uint32_t f1 = ef[e][s];
-                m_fvn[f0].push_back(f1);
-                m_fvn[f1].push_back(f0);
-            }
-        }
-    }
+    populate_ff(ef);
+    update_host_storage(get_host_bytes(ef));
+    // ef is not needed anymore
+    std::vector<std::vector<uint32_t>>().swap(ef);
     //===============================
 
 
@@ -128,20 +139,22 @@ void RXMesh<patchSize>::build_local(
     // create an instance of Patcher and execute it and then move the
     // ownership to m_patcher
     std::unique_ptr<PATCHER::Patcher> pp = std::make_unique<PATCHER::Patcher>(
-        patchSize, m_fvn, m_num_vertices, m_num_edges, true, m_quite);
-    pp->execute(
-        [this](uint32_t v0, uint32_t v1) { return this->get_edge_id(v0, v1); },
-        ef);
+        patchSize, m_fv, m_ff_offset, m_ff_values, m_num_vertices, m_num_edges,
+        true, m_quite);
+    pp->execute([this](uint32_t v0, uint32_t v1) {
+        return this->get_edge_id(v0, v1);
+    });
 
     m_patcher = std::move(pp);
     m_num_patches = m_patcher->get_num_patches();
     // m_patcher->export_patches(Verts);
+    update_host_storage();
     //===============================
 
     //=========== 5.5)
     // sort indices based on patches
     if (m_is_sort) {
-        sort(fv, coordinates);
+        sort(coordinates);
     }
     //===============================
 
@@ -218,6 +231,8 @@ void RXMesh<patchSize>::build_local(
     ex_scan(m_h_patch_distribution_e);
     ex_scan(m_h_patch_distribution_f);
 
+    update_host_storage();
+
     if (!m_quite) {
         RXMESH_TRACE("#Vertices = {}, #Faces= {}, #Edges= {}", m_num_vertices,
                      m_num_faces, m_num_edges);
@@ -307,8 +322,8 @@ void RXMesh<patchSize>::build_patch_locally(const uint32_t patch_id)
     auto count_num_elements = [&](uint32_t global_f) {
         for (uint32_t j = 0; j < 3; j++) {
             // find the edge global id
-            uint32_t global_v0 = m_fvn[global_f][j];
-            uint32_t global_v1 = m_fvn[global_f][(j + 1) % 3];
+            uint32_t global_v0 = m_fv[global_f][j];
+            uint32_t global_v1 = m_fv[global_f][(j + 1) % 3];
 
             // find the edge in m_edge_map with v0,v1
             std::pair<uint32_t, uint32_t> my_edge =
@@ -351,7 +366,7 @@ void RXMesh<patchSize>::build_patch_locally(const uint32_t patch_id)
         vertices_owned_count(0), vertices_not_owned_count(0);
     for (uint32_t s = p_start; s < p_end; ++s) {
         uint32_t global_f = p_val[s];
-        create_new_local_face(patch_id, global_f, m_fvn[global_f], faces_count,
+        create_new_local_face(patch_id, global_f, m_fv[global_f], faces_count,
                               edges_owned_count, edges_not_owned_count,
                               vertices_owned_count, vertices_not_owned_count,
                               num_edges_owned, num_vertices_owned, f_ltog,
@@ -362,7 +377,7 @@ void RXMesh<patchSize>::build_patch_locally(const uint32_t patch_id)
     // 2) loop over ribbon faces
     for (uint32_t s = r_start; s < r_end; ++s) {
         uint32_t global_f = m_patcher->get_external_ribbon_val()[s];
-        create_new_local_face(patch_id, global_f, m_fvn[global_f], faces_count,
+        create_new_local_face(patch_id, global_f, m_fv[global_f], faces_count,
                               edges_owned_count, edges_not_owned_count,
                               vertices_owned_count, vertices_not_owned_count,
                               num_edges_owned, num_vertices_owned, f_ltog,
@@ -637,6 +652,55 @@ void RXMesh<patchSize>::edge_incident_faces(
     }
 }
 
+template <uint32_t patchSize>
+void RXMesh<patchSize>::populate_ff(
+    const std::vector<std::vector<uint32_t>>& ef)
+{
+    // populate the face adjacent faces (m_ff_offset and m_ff_values) from the
+    // edge incident faces. Two faces are adjacent if they share an edge.
+    // We first count the number of adjacent faces per face, scan them, and
+    // then fill in m_ff_values backward by decrementing the offset. Iterating
+    // over ef in reverse order keeps the adjacent faces of each face ordered
+    // by the edge id. This avoids growing a vector per face and does not
+    // require any temporary storage
+
+    m_ff_offset.clear();
+    m_ff_offset.resize(m_num_faces, 0);
+    for (uint32_t e = 0; e < ef.size(); ++e) {
+        assert(ef[e].size() != 0);  // we don't handle dangling edges
+        for (uint32_t f = 0; f < ef[e].size(); ++f) {
+            m_ff_offset[ef[e][f]] += static_cast<uint32_t>(ef[e].size()) - 1;
+        }
+    }
+
+    for (uint32_t f = 1; f < m_num_faces; ++f) {
+        m_ff_offset[f] += m_ff_offset[f - 1];
+    }
+
+    m_ff_values.clear();
+    m_ff_values.resize((m_num_faces == 0) ? 0 : m_ff_offset.back());
+
+    for (int64_t e = int64_t(ef.size()) - 1; e >= 0; --e) {
+        for (int64_t f = int64_t(ef[e].size()) - 1; f >= 0; --f) {
+            uint32_t f0 = ef[e][f];
+            for (int64_t s = int64_t(ef[e].size()) - 1; s > f; --s) {
+                uint32_t f1 = ef[e][s];
+                m_ff_values[--m_ff_offset[f0]] = f1;
+                m_ff_values[--m_ff_offset[f1]] = f0;
+            }
+        }
+    }
+
+    // m_ff_offset[f] now points to the start of f's adjacent faces. Shift it
+    // so it points to the end instead
+    if (m_num_faces > 0) {
+        for (uint32_t f = 0; f < m_num_faces - 1; ++f) {
+            m_ff_offset[f] = m_ff_offset[f + 1];
+        }
+        m_ff_offset.back() = static_cast<uint32_t>(m_ff_values.size());
+    }
+}
+
 template <uint32_t patchSize>
 uint32_t RXMesh<patchSize>::get_edge_id(const uint32_t v0,
                                         const uint32_t v1) const
@@ -657,6 +721,11 @@ template <uint32_t patchSize>
 uint32_t RXMesh<patchSize>::get_edge_id(
     const std::pair<uint32_t, uint32_t>& edge) const
 {
+    if (m_edges_map.empty()) {
+        RXMESH_ERROR(
+            "RXMesh::get_edge_id() the edge map is empty. It was either not "
+            "populated yet or released by release_build_temporaries()");
+    }
     uint32_t edge_id = -1;
     try {
         edge_id = m_edges_map.at(edge);
@@ -673,8 +742,7 @@ uint32_t RXMesh<patchSize>::get_edge_id(
 
 //********************** sort
 template <uint32_t patchSize>
-void RXMesh<patchSize>::sort(std::vector<std::vector<uint32_t>>& fv,
-                             std::vector<std::vector<coordT>>&   coordinates)
+void RXMesh<patchSize>::sort(std::vector<std::vector<coordT>>& coordinates)
 {
     if (m_num_patches == 1) {
         return;
@@ -731,7 +799,7 @@ void RXMesh<patchSize>::sort(std::vector<std::vector<uint32_t>>& fv,
 
                 // assign face's vertices new id
                 for (uint32_t v = 0; v < 3; ++v) {
-                    uint32_t vertex = m_fvn[face][v];
+                    uint32_t vertex = m_fv[face][v];
                     // if the vertex is owned by this patch
                     if (m_patcher->get_vertex_patch_id(vertex) == p &&
                         new_vertex_id[vertex] == INVALID32) {
@@ -743,8 +811,8 @@ void RXMesh<patchSize>::sort(std::vector<std::vector<uint32_t>>& fv,
                 // assign face's edge new id
                 uint32_t v1 = 2;
                 for (uint32_t v0 = 0; v0 < 3; ++v0) {
-                    uint32_t vertex0 = m_fvn[face][v0];
-                    uint32_t vertex1 = m_fvn[face][v1];
+                    uint32_t vertex0 = m_fv[face][v0];
+                    uint32_t vertex1 = m_fv[face][v1];
                     uint32_t edge = get_edge_id(vertex0, vertex1);
 
                     // if the edge is owned by this patch
@@ -819,27 +887,43 @@ void RXMesh<patchSize>::sort(std::vector<std::vector<uint32_t>>& fv,
         m_edges_map.swap(edges_map);
     }
 
-    // m_fvn
+    // m_fv
     {
-        std::vector<std::vector<uint32_t>> fvn(m_fvn);
-        for (uint32_t f = 0; f < m_fvn.size(); ++f) {
+        // we only move the per-face vectors around so the face list is not
+        // duplicated
+        std::vector<std::vector<uint32_t>> fv(m_num_faces);
+        for (uint32_t f = 0; f < m_num_faces; ++f) {
             uint32_t new_f_id = new_face_id[f];
-            fvn[new_f_id].resize(3);
-            // v
-            fvn[new_f_id][0] = new_vertex_id[m_fvn[f][0]];
-            fvn[new_f_id][1] = new_vertex_id[m_fvn[f][1]];
-            fvn[new_f_id][2] = new_vertex_id[m_fvn[f][2]];
-
-            fv[new_f_id][0] = fvn[new_f_id][0];
-            fv[new_f_id][1] = fvn[new_f_id][1];
-            fv[new_f_id][2] = fvn[new_f_id][2];
-
-            // n
-            for (uint32_t n = 3; n < m_fvn[f].size(); ++n) {
-                fvn[new_f_id].push_back(new_face_id[m_fvn[f][n]]);
+            m_fv[f][0] = new_vertex_id[m_fv[f][0]];
+            m_fv[f][1] = new_vertex_id[m_fv[f][1]];
+            m_fv[f][2] = new_vertex_id[m_fv[f][2]];
+            fv[new_f_id].swap(m_fv[f]);
+        }
+        m_fv.swap(fv);
+    }
+
+    // m_ff_offset and m_ff_values
+    {
+        std::vector<uint32_t> ff_offset(m_num_faces);
+        for (uint32_t f = 0; f < m_num_faces; ++f) {
+            uint32_t start = (f == 0) ? 0 : m_ff_offset[f - 1];
+            ff_offset[new_face_id[f]] = m_ff_offset[f] - start;
+        }
+        for (uint32_t f = 1; f < m_num_faces; ++f) {
+            ff_offset[f] += ff_offset[f - 1];
+        }
+
+        std::vector<uint32_t> ff_values(m_ff_values.size());
+        for (uint32_t f = 0; f < m_num_faces; ++f) {
+            uint32_t new_f_id = new_face_id[f];
+            uint32_t start = (f == 0) ? 0 : m_ff_offset[f - 1];
+            uint32_t new_start = (new_f_id == 0) ? 0 : ff_offset[new_f_id - 1];
+            for (uint32_t i = start; i < m_ff_offset[f]; ++i) {
+                ff_values[new_start++] = new_face_id[m_ff_values[i]];
             }
         }
-        m_fvn.swap(fvn);
+        m_ff_offset.swap(ff_offset);
+        m_ff_values.swap(ff_values);
     }
 
     // patcher
@@ -894,9 +978,9 @@ void RXMesh<patchSize>::sort(std::vector<std::vector<uint32_t>>& fv,
     std::vector<uint32_t> face_id(m_num_faces);
     fill_with_sequential_numbers(vert_id.data(), vert_id.size());
     fill_with_sequential_numbers(face_id.data(), face_id.size());
-    export_attribute_VTK("sort_faces.vtk", m_fvn, coordinates,
+    export_attribute_VTK("sort_faces.vtk", m_fv, coordinates,
                          true, face_id.data(), vert_id.data(), false);
-    export_attribute_VTK("sort_vertices.vtk", m_fvn, coordinates,
+    export_attribute_VTK("sort_vertices.vtk", m_fv, coordinates,
                          false, face_id.data(), vert_id.data(), false);*/
 }
 //**************************************************************************
@@ -1020,7 +1104,7 @@ void RXMesh<patchSize>::device_alloc_local()
                           sizeof(uint16_t) * m_h_ad_size.back().x));
     CUDA_ERROR(cudaMalloc((void**)&m_d_patches_faces,
                           sizeof(uint16_t) * m_h_ad_size.back().z));
-    if (!m_quite) {
+    {
         uint32_t patch_local_storage =
             sizeof(uint16_t) * (m_h_ad_size.back().x + m_h_ad_size.back().z) +
             sizeof(uint32_t) *
@@ -1031,7 +1115,9 @@ void RXMesh<patchSize>::device_alloc_local()
         m_total_gpu_storage_mb =
             double(patch_local_storage + patch_membership_storage) /
             double(1024 * 1024);
-        RXMESH_TRACE("Total storage = {0:f} Mb", m_total_gpu_storage_mb);
+        if (!m_quite) {
+            RXMESH_TRACE("Total storage = {0:f} Mb", m_total_gpu_storage_mb);
+        }
     }
 
     // alloc ad_size_ltog and edges_/faces_ad
@@ -1178,32 +1264,130 @@ void RXMesh<patchSize>::device_alloc_local()
 //**************************************************************************
 
 
+//********************** Host Storage
+template <uint32_t patchSize>
+void RXMesh<patchSize>::update_host_storage(const size_t transient_bytes)
+{
+    // Estimate the host bytes held by each component. For the edge map, we
+    // count the bucket array plus one node per entry (key/value pair, next
+    // pointer, and cached hash) which is how std::unordered_map is typically
+    // implemented
+    using EdgeMapT = std::unordered_map<std::pair<uint32_t, uint32_t>,
+                                        uint32_t, edge_key_hash>;
+    const double to_mb = 1.0 / double(1024 * 1024);
+
+    const size_t edges_map_bytes =
+        m_edges_map.bucket_count() * sizeof(void*) +
+        m_edges_map.size() *
+            (sizeof(typename EdgeMapT::value_type) + sizeof(void*) +
+             sizeof(size_t));
+
+    const size_t patches_local_bytes = get_host_bytes(m_h_patches_edges) +
+                                       get_host_bytes(m_h_patches_faces);
+
+    const size_t patches_ltog_bytes = get_host_bytes(m_h_patches_ltog_v) +
+                                      get_host_bytes(m_h_patches_ltog_e) +
+                                      get_host_bytes(m_h_patches_ltog_f);
+
+    const size_t ad_size_bytes =
+        get_host_bytes(m_h_ad_size) + get_host_bytes(m_h_owned_size) +
+        get_host_bytes(m_h_ad_size_ltog_v) +
+        get_host_bytes(m_h_ad_size_ltog_e) + get_host_bytes(m_h_ad_size_ltog_f);
+
+    const size_t distribution_bytes = get_host_bytes(m_h_patch_distribution_v) +
+                                      get_host_bytes(m_h_patch_distribution_e) +
+                                      get_host_bytes(m_h_patch_distribution_f);
+
+    const size_t patcher_bytes =
+        (m_patcher) ? m_patcher->get_host_storage_bytes() : 0;
+
+    m_host_storage_mb["edges_map"] = double(edges_map_bytes) * to_mb;
+    m_host_storage_mb["fv"] = double(get_host_bytes(m_fv)) * to_mb;
+    m_host_storage_mb["ff"] =
+        double(get_host_bytes(m_ff_offset) + get_host_bytes(m_ff_values)) *
+        to_mb;
+    m_host_storage_mb["patches_local"] = double(patches_local_bytes) * to_mb;
+    m_host_storage_mb["patches_ltog"] = double(patches_ltog_bytes) * to_mb;
+    m_host_storage_mb["patches_ad_size"] = double(ad_size_bytes) * to_mb;
+    m_host_storage_mb["patch_distribution"] =
+        double(distribution_bytes) * to_mb;
+    m_host_storage_mb["patcher"] = double(patcher_bytes) * to_mb;
+    m_host_storage_mb["build_transient"] = double(transient_bytes) * to_mb;
+    m_host_storage_mb["attributes"] =
+        double(get_attributes_host_bytes()) * to_mb;
+
+    double total = 0;
+    for (auto& it : m_host_storage_mb) {
+        if (it.first != "total") {
+            total += it.second;
+        }
+    }
+    m_host_storage_mb["total"] = total;
+
+    for (auto& it : m_host_storage_mb) {
+        double& peak = m_peak_host_storage_mb[it.first];
+        peak = std::max(peak, it.second);
+    }
+}
+
+template <uint32_t patchSize>
+void RXMesh<patchSize>::release_build_temporaries()
+{
+    // swap with empty containers so the memory is actually returned (clear()
+    // keeps the capacity)
+    {
+        std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t,
+                           edge_key_hash>
+            empty_map;
+        m_edges_map.swap(empty_map);
+    }
+    std::vector<std::vector<uint32_t>>().swap(m_fv);
+    std::vector<uint32_t>().swap(m_ff_offset);
+    std::vector<uint32_t>().swap(m_ff_values);
+    if (m_patcher) {
+        m_patcher->release_scratch();
+    }
+    update_host_storage();
+
+    if (!m_quite) {
+        RXMESH_TRACE(
+            "RXMesh::release_build_temporaries() host storage after release = "
+            "{0:f} Mb",
+            get_host_storage_mb());
+    }
+}
+//**************************************************************************
+
+
 //********************** Export
 template <uint32_t patchSize>
-void RXMesh<patchSize>::write_connectivity(std::fstream& file) const
+void RXMesh<patchSize>::write_connectivity(BufferedWriter& file) const
 {
-    for (uint32_t p = 0; p < m_num_patches; ++p) {  // for every patch
+    // the faces of every patch are formatted in parallel (see
+    // BufferedWriter::write_records())
+    file.write_records(m_num_patches, [&](int64_t p, std::string& out) {
         assert(m_h_ad_size[p].w % 3 == 0);
         uint16_t patch_num_faces = m_h_ad_size[p].w / 3;
         for (uint32_t f = 0; f < patch_num_faces; ++f) {
             uint32_t f_global = m_h_patches_ltog_f[p][f] >> 1;
-            if (m_patcher->get_face_patch_id(f_global) != p) {
+            if (m_patcher->get_face_patch_id(f_global) != uint32_t(p)) {
                 // if it is a ribbon
                 continue;
             }
 
-            file << "f ";
+            out.push_back('f');
             for (uint32_t e = 0; e < 3; ++e) {
                 uint16_t edge = m_h_patches_faces[p][3 * f + e];
                 flag_t   dir(0);
                 RXMeshContext::unpack_edge_dir(edge, edge, dir);
                 uint16_t e_id = (2 * edge) + dir;
                 uint16_t v = m_h_patches_edges[p][e_id];
-                file << (m_h_patches_ltog_v[p][v] >> 1) + 1 << " ";
+                out.push_back(' ');
+                append_number(out, (m_h_patches_ltog_v[p][v] >> 1) + 1);
             }
-            file << std::endl;
+            out.push_back('\n');
         }
-    }
+    });
 }
 
 //**************************************************************************
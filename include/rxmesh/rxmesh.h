@@ -1,11 +1,13 @@
 #pragma once
 
 #include <fstream>
+#include <map>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 #include "rxmesh/patcher/patcher.h"
 #include "rxmesh/rxmesh_context.h"
+#include "rxmesh/util/buffered_writer.h"
 #include "rxmesh/util/log.h"
 #include "rxmesh/util/macros.h"
 
@@ -77,23 +79,27 @@ class RXMesh
     template <typename VertT>
     void exportOBJ(const std::string& filename, VertT getCoords)
     {
-        std::string  fn = STRINGIFY(OUTPUT_DIR) + filename;
-        std::fstream file(fn, std::ios::out);
-        file.precision(30);
-
-        // write vertices
-        for (uint32_t v = 0; v < m_num_vertices; ++v) {
-            uint32_t v_id = v;
+        std::string    fn = STRINGIFY(OUTPUT_DIR) + filename;
+        BufferedWriter file;
+        if (!file.open(fn)) {
+            return;
+        }
 
-            file << "v  ";
+        // write vertices. Lines are formatted in parallel so getCoords is
+        // called concurrently
+        file.write_records(m_num_vertices, [&](int64_t v, std::string& out) {
+            out.push_back('v');
             for (uint32_t i = 0; i < 3; ++i) {
-                file << getCoords(v_id, i) << "  ";
+                out.push_back(' ');
+                append_number(out, getCoords(uint32_t(v), i));
             }
-            file << std::endl;
-        }
+            out.push_back('\n');
+        });
         // write connectivity
         write_connectivity(file);
-        file.close();
+        if (!file.close()) {
+            RXMESH_ERROR("RXMesh::exportOBJ() writing {} failed", fn);
+        }
     }
 
 
@@ -220,11 +226,49 @@ class RXMesh
         return m_total_gpu_storage_mb;
     }
 
+    double get_host_storage_mb() const
+    {
+        return m_host_storage_mb.at("total");
+    }
+
+    double get_peak_host_storage_mb() const
+    {
+        return m_peak_host_storage_mb.at("total");
+    }
+
+    // per-component host storage (in mb) currently held by RXMesh. Keys are
+    // edges_map, fv, ff, patches_local, patches_ltog, patches_ad_size,
+    // patch_distribution, patcher, build_transient, attributes, and total
+    const std::map<std::string, double>& get_host_storage_breakdown_mb() const
+    {
+        return m_host_storage_mb;
+    }
+
+    // per-component peak host storage (in mb) sampled during construction
+    // and after every release. Same keys as get_host_storage_breakdown_mb()
+    const std::map<std::string, double>& get_peak_host_storage_breakdown_mb()
+        const
+    {
+        return m_peak_host_storage_mb;
+    }
+
+    // free host structures that are only needed while building RXMesh i.e.,
+    // the edge map, the face list with its neighbour faces, and the patcher
+    // utility vectors. After calling this, get_edge_id() is not valid anymore
+    void release_build_temporaries();
+
     const std::unique_ptr<PATCHER::Patcher>& get_patcher() const
     {
         return m_patcher;
     };
 
+    // the face incident vertices owned by RXMesh (sorted if sort was set in
+    // construction). Empty after release_build_temporaries()
+    const std::vector<std::vector<uint32_t>>& get_faces() const
+    {
+        return m_fv;
+    }
+
    protected:
     virtual ~RXMesh();
 
@@ -232,18 +276,25 @@ class RXMesh
 
     RXMesh(const RXMesh&) = delete;
 
-    virtual void write_connectivity(std::fstream& file) const;
+    virtual void write_connectivity(BufferedWriter& file) const;
 
-    // build everything from scratch including patches (use this)
+    // build everything from scratch including patches (use this). fv is
+    // copied once and, if sort is true, overwritten by the sorted faces
     RXMesh(std::vector<std::vector<uint32_t>>& fv,
            std::vector<std::vector<coordT>>&   coordinates,
            const bool                          sort = false,
            const bool                          quite = true);
 
+    // same as above but takes the ownership of fv so the face list is never
+    // duplicated. The (sorted) faces are then accessible via get_faces()
+    RXMesh(std::vector<std::vector<uint32_t>>&& fv,
+           std::vector<std::vector<coordT>>&    coordinates,
+           const bool                           sort = false,
+           const bool                           quite = true);
+
     uint32_t get_edge_id(const std::pair<uint32_t, uint32_t>& edge) const;
 
-    void     build_local(std::vector<std::vector<uint32_t>>& fv,
-                         std::vector<std::vector<coordT>>&   coordinates);
+    void     build_local(std::vector<std::vector<coordT>>& coordinates);
     void     build_patch_locally(const uint32_t patch_id);
     void     populate_edge_map(const std::vector<std::vector<uint32_t>>& fv);
     uint16_t create_new_local_face(const uint32_t               patch_id,
@@ -264,6 +315,7 @@ class RXMesh
     void     set_num_vertices(const std::vector<std::vector<uint32_t>>& fv);
     void     edge_incident_faces(const std::vector<std::vector<uint32_t>>& fv,
                                  std::vector<std::vector<uint32_t>>&       ef);
+    void     populate_ff(const std::vector<std::vector<uint32_t>>& ef);
 
     inline std::pair<uint32_t, uint32_t> edge_key(const uint32_t v0,
                                                   const uint32_t v1) const
@@ -287,6 +339,18 @@ class RXMesh
 
     void device_alloc_local();
 
+    // sample the host storage of all components and update the peaks.
+    // transient_bytes accounts for local containers that are alive only
+    // during the build (e.g., the edge-face incidence)
+    void update_host_storage(const size_t transient_bytes = 0);
+
+    // host bytes of the attribute buffers owned by the mesh (see
+    // RXMeshStatic::add_attribute()). Sampled by update_host_storage()
+    virtual size_t get_attributes_host_bytes() const
+    {
+        return 0;
+    }
+
     template <typename Tin, typename Tst>
     void get_starting_ids(const std::vector<std::vector<Tin>>& input,
                           std::vector<Tst>&                    starting_id);
@@ -300,8 +364,7 @@ class RXMesh
     void get_size(const std::vector<std::vector<Tin>>& input,
                   std::vector<Tad>&                    ad);
 
-    void sort(std::vector<std::vector<uint32_t>>& fv,
-              std::vector<std::vector<coordT>>&   coordinates);
+    void sort(std::vector<std::vector<coordT>>& coordinates);
 
 
     // www.techiedelight.com/use-std-pair-key-std-unordered_map-cpp/
@@ -336,9 +399,13 @@ class RXMesh
     std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t, edge_key_hash>
         m_edges_map;
 
-    // store a copy of face incident vertices along with the neighbor
-    // faces of that face
-    std::vector<std::vector<uint32_t>> m_fvn;
+    // face incident vertices (owned by RXMesh either by copying or moving
+    // the input faces)
+    std::vector<std::vector<uint32_t>> m_fv;
+
+    // face adjacent faces in compressed format where m_ff_offset[f] is the
+    // end of f's adjacent faces in m_ff_values (and the start of f+1's)
+    std::vector<uint32_t> m_ff_offset, m_ff_values;
 
     // pointer to the patcher class responsible for everything related to
     // patching the mesh into small pieces
@@ -428,6 +495,9 @@ class RXMesh
     uint32_t *m_d_neighbour_patches, *m_d_neighbour_patches_offset;
 
     double m_total_gpu_storage_mb;
+
+    // live and peak host storage per component (in mb)
+    std::map<std::string, double> m_host_storage_mb, m_peak_host_storage_mb;
 };
 
 extern template class RXMesh<PATCH_SIZE>;
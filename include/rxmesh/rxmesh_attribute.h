@@ -1,9 +1,18 @@
 #pragma once
 
 #include <assert.h>
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 #include "rxmesh/kernels/collective.cuh"
 #include "rxmesh/kernels/rxmesh_attribute.cuh"
 #include "rxmesh/kernels/util.cuh"
+#include "rxmesh/util/mapped_file.h"
 #include "rxmesh/util/util.h"
 #include "rxmesh/util/vector.h"
 
@@ -25,8 +34,16 @@ enum : layoutT
 {
     AoS = 0x00,
     SoA = 0x01,
+    // mesh elements are grouped into tiles of AOSOA_TILE_SIZE elements and
+    // every tile stores its elements' first attribute, then their second
+    // attribute, and so on
+    AoSoA = 0x02,
 };
 
+// number of mesh elements per tile in the AoSoA layout. 8 floats fill a 256-bit
+// SIMD register and the 3 coordinates of a vertex stay within 96 bytes
+constexpr uint32_t AOSOA_TILE_SIZE = 8;
+
 // Reduce ops
 using reduceOpT = uint32_t;
 enum : reduceOpT
@@ -54,6 +71,268 @@ static std::string location_to_string(locationT target)
     return str;
 }
 
+class AttributeArena
+{
+    // Pooled allocator for attribute buffers on the host and the device.
+    // Released buffers are kept in per-size-class free lists and handed back
+    // to later allocations of the same size class instead of going through
+    // malloc/cudaMalloc again. Sizes are rounded up to one of four classes
+    // per power of two (so at most 25% is wasted). Thread-safe
+
+   public:
+    AttributeArena() = default;
+    AttributeArena(const AttributeArena&) = delete;
+    AttributeArena& operator=(const AttributeArena&) = delete;
+
+    ~AttributeArena()
+    {
+        for (uint32_t k = 0; k < 2; ++k) {
+            if (!m_pool[k].in_use.empty()) {
+                RXMESH_WARN(
+                    "~AttributeArena() {} buffer(s) ({} bytes) on {} were not "
+                    "freed",
+                    m_pool[k].in_use.size(), m_pool[k].bytes_in_use,
+                    location_to_string(k == 0 ? HOST : DEVICE));
+            }
+        }
+        trim(LOCATION_ALL);
+    }
+
+    /**
+     * allocate()
+     */
+    void* allocate(const size_t bytes, const locationT location)
+    {
+        // a buffer of at least bytes on location (HOST or DEVICE). Returns
+        // nullptr on failure
+        if (bytes == 0) {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Pool&                       pool = get_pool(location);
+        const size_t                size = size_class(bytes);
+
+        void* ptr = nullptr;
+        auto  it = pool.free_list.find(size);
+        if (it != pool.free_list.end() && !it->second.empty()) {
+            ptr = it->second.back();
+            it->second.pop_back();
+            pool.bytes_pooled -= size;
+            pool.num_reuses++;
+        } else {
+            ptr = system_allocate(size, location);
+            if (ptr == nullptr) {
+                // return the pooled buffers to the system and try again
+                trim_pool(pool, location);
+                ptr = system_allocate(size, location);
+            }
+            if (ptr == nullptr) {
+                return nullptr;
+            }
+            pool.num_system_allocations++;
+        }
+        pool.in_use[ptr] = size;
+        pool.bytes_in_use += size;
+        pool.peak_bytes = std::max(pool.peak_bytes, pool.bytes_in_use);
+        return ptr;
+    }
+
+    /**
+     * free()
+     */
+    void free(void* ptr, const locationT location)
+    {
+        // give back a buffer obtained from allocate() on the same location
+        if (ptr == nullptr) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Pool&                       pool = get_pool(location);
+        auto                        it = pool.in_use.find(ptr);
+        if (it == pool.in_use.end()) {
+            RXMESH_ERROR(
+                "AttributeArena::free() pointer was not allocated by this "
+                "arena on {}",
+                location_to_string(location));
+            return;
+        }
+        const size_t size = it->second;
+        pool.in_use.erase(it);
+        pool.bytes_in_use -= size;
+        pool.free_list[size].push_back(ptr);
+        pool.bytes_pooled += size;
+    }
+
+    /**
+     * trim()
+     */
+    void trim(const locationT location = LOCATION_ALL)
+    {
+        // return the pooled (not in use) buffers to the system
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if ((location & HOST) == HOST) {
+            trim_pool(m_pool[0], HOST);
+        }
+        if ((location & DEVICE) == DEVICE) {
+            trim_pool(m_pool[1], DEVICE);
+        }
+    }
+
+    //********************** Accounting (location is HOST or DEVICE)
+    // the counters are updated by allocate()/free() from any thread so they
+    // are read under the same lock
+    size_t get_bytes_in_use(const locationT location) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return get_pool(location).bytes_in_use;
+    }
+    size_t get_bytes_pooled(const locationT location) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return get_pool(location).bytes_pooled;
+    }
+    size_t get_peak_bytes(const locationT location) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return get_pool(location).peak_bytes;
+    }
+    size_t get_num_system_allocations(const locationT location) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return get_pool(location).num_system_allocations;
+    }
+    size_t get_num_reuses(const locationT location) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return get_pool(location).num_reuses;
+    }
+    //*********************************************************************
+
+   private:
+    struct Pool
+    {
+        std::unordered_map<size_t, std::vector<void*>> free_list;
+        std::unordered_map<void*, size_t>              in_use;
+        size_t bytes_in_use = 0, bytes_pooled = 0, peak_bytes = 0;
+        size_t num_system_allocations = 0, num_reuses = 0;
+    };
+
+    Pool& get_pool(const locationT location)
+    {
+        assert(location == HOST || location == DEVICE);
+        return m_pool[location == HOST ? 0 : 1];
+    }
+
+    const Pool& get_pool(const locationT location) const
+    {
+        assert(location == HOST || location == DEVICE);
+        return m_pool[location == HOST ? 0 : 1];
+    }
+
+    static size_t size_class(const size_t bytes)
+    {
+        // at least 256 bytes, then four classes per power of two
+        if (bytes <= 256) {
+            return 256;
+        }
+        size_t pow2 = 256;
+        while (pow2 < bytes) {
+            pow2 <<= 1;
+        }
+        const size_t step = pow2 / 8;
+        return DIVIDE_UP(bytes, step) * step;
+    }
+
+    static void* system_allocate(const size_t bytes, const locationT location)
+    {
+        if (location == HOST) {
+            return malloc(bytes);
+        }
+        void* ptr = nullptr;
+        if (cudaMalloc(&ptr, bytes) != cudaSuccess) {
+            // clear the allocation error
+            cudaGetLastError();
+            return nullptr;
+        }
+        return ptr;
+    }
+
+    static void trim_pool(Pool& pool, const locationT location)
+    {
+        for (auto& fl : pool.free_list) {
+            for (void* ptr : fl.second) {
+                if (location == HOST) {
+                    ::free(ptr);
+                } else {
+                    CUDA_ERROR(cudaFree(ptr));
+                }
+            }
+        }
+        pool.free_list.clear();
+        pool.bytes_pooled = 0;
+    }
+
+    // [0] host, [1] device
+    Pool               m_pool[2];
+    mutable std::mutex m_mutex;
+};
+
+// Order of the mesh elements in a saved attribute
+using orderT = uint32_t;
+enum : orderT
+{
+    GLOBAL_ORDER = 0x00,
+    // see RXMeshStatic::to_patch_order()
+    PATCH_ORDER = 0x01,
+};
+
+/**
+ * attribute_type_code()
+ */
+template <typename T>
+constexpr uint32_t attribute_type_code()
+{
+    // identifies T in a saved attribute. Types not listed here get 0 and only
+    // their size is checked on load
+    return std::is_same<T, float>::value    ? 1 :
+           std::is_same<T, double>::value   ? 2 :
+           std::is_same<T, int8_t>::value   ? 3 :
+           std::is_same<T, uint8_t>::value  ? 4 :
+           std::is_same<T, int16_t>::value  ? 5 :
+           std::is_same<T, uint16_t>::value ? 6 :
+           std::is_same<T, int32_t>::value  ? 7 :
+           std::is_same<T, uint32_t>::value ? 8 :
+           std::is_same<T, int64_t>::value  ? 9 :
+           std::is_same<T, uint64_t>::value ? 10 :
+                                              0;
+}
+
+// Header of the binary file written by RXMeshAttribute::save(). The data
+// follows at data_offset which is page aligned so it can be mapped as is
+struct AttributeFileHeader
+{
+    static constexpr char     MAGIC[8] = "RXMATTR";
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint64_t DATA_ALIGNMENT = 4096;
+
+    char     magic[8];
+    uint32_t version;
+    uint32_t type_code;
+    uint32_t type_size;
+    layoutT  layout;
+    uint32_t num_mesh_elements;
+    uint32_t num_attribute_per_element;
+    orderT   order;
+    uint32_t has_checksum;
+    // identifies the patches PATCH_ORDER data was saved with
+    uint64_t order_fingerprint;
+    // checksum64() of the data
+    uint64_t checksum;
+    uint64_t data_offset;
+    uint64_t data_bytes;
+    char     name[128];
+};
+
 template <class T>
 class RXMeshAttribute
 {
@@ -76,7 +355,9 @@ class RXMeshAttribute
           m_is_axpy_allocated(false), m_is_reduce_allocated(false),
           m_reduce_temp_storage_bytes(0), m_d_reduce_temp_storage(nullptr),
           m_d_reduce_output(nullptr), m_reduce_streams(nullptr),
-          m_norm2_temp_buffer(nullptr)
+          m_norm2_temp_buffer(nullptr), m_arena(nullptr),
+          m_h_mapped(nullptr), m_num_patches(0), m_d_element_patch(nullptr),
+          m_d_dirty_patches(nullptr)
     {
 
         this->m_name = (char*)malloc(sizeof(char) * 1);
@@ -92,7 +373,9 @@ class RXMeshAttribute
           m_h_attr(nullptr), m_d_attr(nullptr), m_layout(AoS),
           d_axpy_alpha(nullptr), d_axpy_beta(nullptr),
           m_is_axpy_allocated(false), m_is_reduce_allocated(false),
-          m_reduce_temp_storage_bytes(0)
+          m_reduce_temp_storage_bytes(0), m_arena(nullptr),
+          m_h_mapped(nullptr), m_num_patches(0), m_d_element_patch(nullptr),
+          m_d_dirty_patches(nullptr)
     {
 
         if (name != nullptr) {
@@ -115,6 +398,11 @@ class RXMeshAttribute
         strcpy(this->m_name, name.c_str());
     }
 
+    const char* get_name() const
+    {
+        return this->m_name;
+    }
+
     __host__ __device__ __forceinline__ uint32_t get_num_mesh_elements() const
     {
         return this->m_num_mesh_elements;
@@ -131,6 +419,11 @@ class RXMeshAttribute
         return this->m_allocated;
     }
 
+    __host__ __device__ __forceinline__ layoutT get_layout() const
+    {
+        return this->m_layout;
+    }
+
     __host__ __device__ __forceinline__ bool is_device_allocated() const
     {
         return ((m_allocated & DEVICE) == DEVICE);
@@ -141,6 +434,56 @@ class RXMeshAttribute
         return ((m_allocated & HOST) == HOST);
     }
 
+    double get_host_storage_mb() const
+    {
+        // host bytes held by this attribute i.e., the host buffer (if
+        // allocated) and the name
+        size_t bytes = (m_name != nullptr) ? strlen(m_name) + 1 : 0;
+        if ((m_allocated & HOST) == HOST) {
+            bytes += sizeof(T) * storage_size(m_num_mesh_elements);
+        }
+        return double(bytes) / double(1024 * 1024);
+    }
+
+    double get_device_storage_mb() const
+    {
+        // device bytes held by this attribute i.e., the device buffer (if
+        // allocated) and the axpy/reduce scratch
+        size_t bytes = 0;
+        if ((m_allocated & DEVICE) == DEVICE) {
+            bytes += sizeof(T) * storage_size(m_num_mesh_elements);
+        }
+        if (m_is_axpy_allocated) {
+            bytes += 2 * sizeof(T) * m_num_attribute_per_element;
+        }
+        if (m_is_reduce_allocated) {
+            bytes += m_num_attribute_per_element *
+                     (m_reduce_temp_storage_bytes + sizeof(T) +
+                      sizeof(T) * DIVIDE_UP(m_num_mesh_elements, m_block_size));
+        }
+        return double(bytes) / double(1024 * 1024);
+    }
+
+    void set_arena(AttributeArena* arena)
+    {
+        // allocate the host/device buffers and the axpy/reduce scratch from
+        // arena (nullptr for malloc/cudaMalloc). Should be called before
+        // init() or after release()
+        if (m_allocated != LOCATION_NONE || m_is_axpy_allocated ||
+            m_is_reduce_allocated) {
+            RXMESH_ERROR(
+                "RXMeshAttribute::set_arena() can not change the arena of an "
+                "allocated attribute");
+            return;
+        }
+        m_arena = arena;
+    }
+
+    AttributeArena* get_arena() const
+    {
+        return m_arena;
+    }
+
     __host__ __device__ __forceinline__ T* get_pointer(locationT target) const
     {
 
@@ -161,8 +504,7 @@ class RXMeshAttribute
             assert((m_allocated & DEVICE) == DEVICE);
 
             const int      threads = 256;
-            const uint32_t total =
-                m_num_attribute_per_element * m_num_mesh_elements;
+            const uint32_t total = storage_size(m_num_mesh_elements);
             memset<T><<<(total + threads - 1) / threads, threads, 0, stream>>>(
                 m_d_attr, value, total);
             CUDA_ERROR(cudaDeviceSynchronize());
@@ -172,8 +514,8 @@ class RXMeshAttribute
 
         if ((target & HOST) == HOST) {
             assert((m_allocated & HOST) == HOST);
-            for (uint32_t i = 0;
-                 i < m_num_mesh_elements * m_num_attribute_per_element; ++i) {
+            const uint32_t total = storage_size(m_num_mesh_elements);
+            for (uint32_t i = 0; i < total; ++i) {
                 m_h_attr[i] = value;
             }
         }
@@ -196,15 +538,15 @@ class RXMeshAttribute
         if (num_elements == 0) {
             return;
         }
-        allocate(num_elements, target);
+        // the layout decides the allocation size (AoSoA is padded to full
+        // tiles)
         m_layout = layout;
+        allocate(num_elements, target);
         set_pitch();
 
         if (!m_is_axpy_allocated && with_axpy_alloc) {
-            CUDA_ERROR(cudaMalloc((void**)&d_axpy_alpha,
-                                  m_num_attribute_per_element * sizeof(T)));
-            CUDA_ERROR(cudaMalloc((void**)&d_axpy_beta,
-                                  m_num_attribute_per_element * sizeof(T)));
+            d_axpy_alpha = device_allocate<T>(m_num_attribute_per_element);
+            d_axpy_beta = device_allocate<T>(m_num_attribute_per_element);
             m_is_axpy_allocated = true;
         }
 
@@ -228,8 +570,7 @@ class RXMeshAttribute
                     "m_norm2_temp_buffer.");
             }
             for (uint32_t i = 0; i < m_num_attribute_per_element; ++i) {
-                CUDA_ERROR(cudaMalloc(&m_norm2_temp_buffer[i],
-                                      sizeof(T) * num_blocks));
+                m_norm2_temp_buffer[i] = device_allocate<T>(num_blocks);
             }
 
             m_d_reduce_output =
@@ -265,12 +606,24 @@ class RXMeshAttribute
                                        m_num_mesh_elements);
                 m_reduce_temp_storage_bytes =
                     std::max(norm2_temp_bytes, other_reduce_temp_bytes);
+                // non-SoA layouts reduce through an index iterator
+                cub::DeviceReduce::Sum(
+                    m_d_reduce_temp_storage[0], other_reduce_temp_bytes,
+                    cub::TransformInputIterator<
+                        T, detail::AttributeColumn<T>,
+                        cub::CountingInputIterator<uint32_t>>(
+                        cub::CountingInputIterator<uint32_t>(0),
+                        detail::AttributeColumn<T>(*this, 0)),
+                    d_out, m_num_mesh_elements);
+                m_reduce_temp_storage_bytes =
+                    std::max(m_reduce_temp_storage_bytes,
+                             other_reduce_temp_bytes);
             }
 
             for (uint32_t i = 0; i < m_num_attribute_per_element; ++i) {
-                CUDA_ERROR(cudaMalloc(&m_d_reduce_temp_storage[i],
-                                      m_reduce_temp_storage_bytes));
-                CUDA_ERROR(cudaMalloc(&m_d_reduce_output[i], sizeof(T)));
+                m_d_reduce_temp_storage[i] =
+                    device_allocate<char>(m_reduce_temp_storage_bytes);
+                m_d_reduce_output[i] = device_allocate<T>(1);
                 CUDA_ERROR(cudaStreamCreate(&m_reduce_streams[i]));
             }
         }
@@ -282,8 +635,8 @@ class RXMeshAttribute
         if ((target & HOST) == HOST) {
             release(HOST);
             if (num_mesh_elements != 0) {
-                m_h_attr = (T*)malloc(sizeof(T) * num_mesh_elements *
-                                      m_num_attribute_per_element);
+                m_h_attr =
+                    host_allocate<T>(storage_size(num_mesh_elements));
                 if (!m_h_attr) {
                     RXMESH_ERROR(
                         " RXMeshAttribute::allocate() allocation on {} failed "
@@ -300,9 +653,7 @@ class RXMeshAttribute
         if ((target & DEVICE) == DEVICE) {
             release(DEVICE);
             if (num_mesh_elements != 0) {
-                CUDA_ERROR(cudaMalloc((void**)&(m_d_attr),
-                                      sizeof(T) * num_mesh_elements *
-                                          m_num_attribute_per_element));
+                m_d_attr = device_allocate<T>(storage_size(num_mesh_elements));
             }
             m_allocated = m_allocated | DEVICE;
         }
@@ -334,13 +685,13 @@ class RXMeshAttribute
         if (source == HOST && target == DEVICE) {
             CUDA_ERROR(cudaMemcpy(
                 m_d_attr, m_h_attr,
-                sizeof(T) * m_num_mesh_elements * m_num_attribute_per_element,
+                sizeof(T) * storage_size(m_num_mesh_elements),
                 cudaMemcpyHostToDevice));
 
         } else if (source == DEVICE && target == HOST) {
             CUDA_ERROR(cudaMemcpy(
                 m_h_attr, m_d_attr,
-                sizeof(T) * m_num_mesh_elements * m_num_attribute_per_element,
+                sizeof(T) * storage_size(m_num_mesh_elements),
                 cudaMemcpyDeviceToHost));
         }
     }
@@ -349,14 +700,13 @@ class RXMeshAttribute
     {
 
         if (((target & HOST) == HOST) && ((m_allocated & HOST) == HOST)) {
-            free(m_h_attr);
-            m_h_attr = nullptr;
+            host_free(m_h_attr);
             m_allocated = m_allocated & (~HOST);
         }
 
         if (((target & DEVICE) == DEVICE) &&
             ((m_allocated & DEVICE) == DEVICE)) {
-            GPU_FREE(m_d_attr);
+            device_free(m_d_attr);
             m_allocated = m_allocated & (~DEVICE);
         }
 
@@ -366,15 +716,15 @@ class RXMeshAttribute
             m_pitch.y = 0;
 
             if (m_is_axpy_allocated) {
-                GPU_FREE(d_axpy_alpha);
-                GPU_FREE(d_axpy_beta);
+                device_free(d_axpy_alpha);
+                device_free(d_axpy_beta);
                 m_is_axpy_allocated = false;
             }
             if (m_is_reduce_allocated) {
                 for (uint32_t i = 0; i < m_num_attribute_per_element; ++i) {
-                    GPU_FREE(m_d_reduce_temp_storage[i]);
-                    GPU_FREE(m_norm2_temp_buffer[i]);
-                    GPU_FREE(m_d_reduce_output[i]);
+                    device_free(m_d_reduce_temp_storage[i]);
+                    device_free(m_norm2_temp_buffer[i]);
+                    device_free(m_d_reduce_output[i]);
                     CUDA_ERROR(cudaStreamDestroy(m_reduce_streams[i]));
                 }
                 m_is_reduce_allocated = false;
@@ -383,6 +733,7 @@ class RXMeshAttribute
                 free(m_norm2_temp_buffer);
                 free(m_d_reduce_temp_storage);
             }
+            disable_dirty_tracking();
         }
     }
 
@@ -404,12 +755,6 @@ class RXMeshAttribute
         // LOCATION_ALL is invalid because we don't know which source to copy
         // from
 
-        if (source.m_layout != m_layout) {
-            RXMESH_ERROR(
-                "RXMeshAttribute::copy() does not support copy from source of "
-                "different layout!");
-        }
-
         if ((source_flag & LOCATION_ALL) == LOCATION_ALL &&
             (target_flag & LOCATION_ALL) != LOCATION_ALL) {
             RXMESH_ERROR("RXMeshAttribute::copy() Invalid configuration!");
@@ -421,6 +766,38 @@ class RXMeshAttribute
                 "target!");
         }
 
+        if (source.m_layout != m_layout) {
+            // copy between different layouts is an element-by-element gather
+            // which we only support from HOST to HOST and DEVICE to DEVICE
+            if (source_flag != target_flag ||
+                source.m_num_attribute_per_element !=
+                    m_num_attribute_per_element ||
+                (source_flag & source.m_allocated) != source_flag ||
+                (target_flag & m_allocated) != target_flag) {
+                RXMESH_ERROR(
+                    "RXMeshAttribute::copy() copy from source of different "
+                    "layout is only supported within the same location and "
+                    "with the same number of attributes!");
+                return;
+            }
+            if ((source_flag & HOST) == HOST) {
+                const int64_t num_elements = m_num_mesh_elements;
+#pragma omp parallel for schedule(static)
+                for (int64_t i = 0; i < num_elements; ++i) {
+                    for (uint32_t j = 0; j < m_num_attribute_per_element; ++j) {
+                        (*this)(uint32_t(i), j) = source(uint32_t(i), j);
+                    }
+                }
+            }
+            if ((source_flag & DEVICE) == DEVICE) {
+                rxmesh_attribute_relayout<T>
+                    <<<num_relayout_blocks(), m_block_size>>>(source, *this);
+                CUDA_ERROR(cudaDeviceSynchronize());
+                CUDA_ERROR(cudaGetLastError());
+            }
+            return;
+        }
+
         // 1) copy from HOST to HOST
         if ((source_flag & HOST) == HOST && (target_flag & HOST) == HOST) {
             if ((source_flag & source.m_allocated) != source_flag) {
@@ -436,7 +813,7 @@ class RXMeshAttribute
 
             std::memcpy(
                 (void*)m_h_attr, source.m_h_attr,
-                m_num_mesh_elements * m_num_attribute_per_element * sizeof(T));
+                storage_size(m_num_mesh_elements) * sizeof(T));
         }
 
 
@@ -456,7 +833,7 @@ class RXMeshAttribute
 
             CUDA_ERROR(cudaMemcpy(
                 m_d_attr, source.m_d_attr,
-                m_num_mesh_elements * m_num_attribute_per_element * sizeof(T),
+                storage_size(m_num_mesh_elements) * sizeof(T),
                 cudaMemcpyDeviceToDevice));
         }
 
@@ -476,7 +853,7 @@ class RXMeshAttribute
 
             CUDA_ERROR(cudaMemcpy(
                 m_h_attr, source.m_d_attr,
-                m_num_mesh_elements * m_num_attribute_per_element * sizeof(T),
+                storage_size(m_num_mesh_elements) * sizeof(T),
                 cudaMemcpyDeviceToHost));
         }
 
@@ -496,51 +873,156 @@ class RXMeshAttribute
 
             CUDA_ERROR(cudaMemcpy(
                 m_d_attr, source.m_h_attr,
-                m_num_mesh_elements * m_num_attribute_per_element * sizeof(T),
+                storage_size(m_num_mesh_elements) * sizeof(T),
                 cudaMemcpyHostToDevice));
         }
     }
 
+    void permute(RXMeshAttribute<T>& source,
+                 const uint32_t*     map,
+                 const bool          scatter,
+                 locationT           location)
+    {
+        // Element-by-element copy from source with the elements reordered by
+        // map i.e., (*this)(map[i], j) = source(i, j) if scatter is true and
+        // (*this)(i, j) = source(map[i], j) otherwise. Elements mapped to
+        // INVALID32 are skipped. location is either HOST or DEVICE and map
+        // should reside there. source and this may have different layouts
+        // but should not share the same storage
+        if (source.get_num_mesh_elements() != m_num_mesh_elements ||
+            source.m_num_attribute_per_element !=
+                m_num_attribute_per_element) {
+            RXMESH_ERROR(
+                "RXMeshAttribute::permute() source has different size than "
+                "target!");
+            return;
+        }
+        if (location != HOST && location != DEVICE) {
+            RXMESH_ERROR(
+                "RXMeshAttribute::permute() location should be either HOST "
+                "or DEVICE");
+            return;
+        }
+        if ((location & source.m_allocated) != location ||
+            (location & m_allocated) != location) {
+            RXMESH_ERROR(
+                "RXMeshAttribute::permute() source or target (this) is not "
+                "allocated on {}",
+                location_to_string(location));
+            return;
+        }
+
+        if (location == HOST) {
+            const int64_t num_elements = m_num_mesh_elements;
+#pragma omp parallel for schedule(static)
+            for (int64_t i = 0; i < num_elements; ++i) {
+                const uint32_t m = map[i];
+                if (m == INVALID32) {
+                    continue;
+                }
+                const uint32_t dst = scatter ? m : uint32_t(i);
+                const uint32_t src = scatter ? uint32_t(i) : m;
+                for (uint32_t j = 0; j < m_num_attribute_per_element; ++j) {
+                    (*this)(dst, j) = source(src, j);
+                }
+            }
+        } else {
+            rxmesh_attribute_permute<T>
+                <<<num_relayout_blocks(), m_block_size>>>(source, *this, map,
+                                                          scatter);
+            CUDA_ERROR(cudaDeviceSynchronize());
+            CUDA_ERROR(cudaGetLastError());
+        }
+    }
+
     void change_layout(locationT target)
     {
-        // Only supporting HOST target
-        // If target is HOST, then the layout change only for the HOST
-        // the user then can copy the data to the DEVICE.
-        // To change the layout of data in the DEVICE, it should be copied first
-        // to the HOST, change layout, and then copy back to the DEVICE
+        // Toggle between AoS and SoA (AoSoA goes to AoS)
+        change_layout(target, (m_layout == AoS) ? SoA : AoS);
+    }
 
-        // Only make sense when number of attributes is >1
-        if (m_num_attribute_per_element > 1) {
+    void change_layout(locationT target, layoutT layout)
+    {
+        // Change the layout to layout on the target which could be HOST,
+        // DEVICE, or both. The layout is shared between the host and the
+        // device so if only one side is changed, the other side should be
+        // overwritten (e.g., by move()) before it is used. Since AoSoA is
+        // padded to full tiles, changing to/from AoSoA reallocates the side
+        // that is not changed. The change is done out-of-place in parallel
+        // and the old buffer is freed, so the underlying pointers change.
+        // AoS <-> SoA is a transpose and, if there is not enough memory for a
+        // second copy, the host falls back to a (serial) in-place transpose
+        // and the device to a transpose through the host. Changing to/from
+        // AoSoA is a gather into a new buffer
+
+        if (layout == m_layout) {
+            return;
+        }
 
-            if ((target & m_allocated) != target) {
-                RXMESH_ERROR(
-                    "RXMeshAttribute::change_layout() changing layout {} is "
-                    "not valid because it was not allocated",
-                    location_to_string(target));
-                return;
-            }
+        // AoS and SoA are the same when there is a single attribute
+        if (m_num_attribute_per_element <= 1 && m_layout != AoSoA &&
+            layout != AoSoA) {
+            m_layout = layout;
+            set_pitch();
+            return;
+        }
 
-            if ((target & HOST) != HOST) {
-                RXMESH_ERROR(
-                    "RXMeshAttribute::change_layout() changing layout {} is "
-                    "not valid because it is not supported",
-                    location_to_string(target));
-                return;
+        if ((target & m_allocated) != target) {
+            RXMESH_ERROR(
+                "RXMeshAttribute::change_layout() changing layout {} is "
+                "not valid because it was not allocated",
+                location_to_string(target));
+            return;
+        }
+
+        if ((target & (HOST | DEVICE)) == 0) {
+            RXMESH_ERROR(
+                "RXMeshAttribute::change_layout() changing layout {} is "
+                "not valid because it is not supported",
+                location_to_string(target));
+            return;
+        }
+
+        if (m_layout != AoSoA && layout != AoSoA) {
+            const uint64_t num_rows = (m_layout == AoS) ?
+                                          m_num_mesh_elements :
+                                          m_num_attribute_per_element;
+            const uint64_t num_cols = (m_layout == AoS) ?
+                                          m_num_attribute_per_element :
+                                          m_num_mesh_elements;
+
+            if ((target & DEVICE) == DEVICE) {
+                if (!transpose_device(num_rows, num_cols)) {
+                    return;
+                }
             }
 
             if ((target & HOST) == HOST) {
-                const uint32_t size =
-                    m_num_mesh_elements * m_num_attribute_per_element;
-                const uint32_t num_cols = (m_layout == AoS) ?
-                                              m_num_attribute_per_element :
-                                              m_num_mesh_elements;
-                in_place_matrix_transpose(m_h_attr, m_h_attr + size,
-                                          uint64_t(num_cols));
+                transpose_host(m_h_attr, num_rows, num_cols);
+            }
+        } else {
+            if ((target & DEVICE) == DEVICE) {
+                if (!relayout(DEVICE, layout)) {
+                    return;
+                }
+            }
 
-                m_layout = (m_layout == SoA) ? AoS : SoA;
-                set_pitch();
+            if ((target & HOST) == HOST) {
+                if (!relayout(HOST, layout)) {
+                    return;
+                }
             }
         }
+
+        const bool same_size = (storage_size(m_num_mesh_elements, layout) ==
+                                storage_size(m_num_mesh_elements, m_layout));
+        m_layout = layout;
+        set_pitch();
+
+        const locationT others = m_allocated & (~target) & (HOST | DEVICE);
+        if (!same_size && others != LOCATION_NONE) {
+            allocate(m_num_mesh_elements, others);
+        }
     }
     //*********************************************************************
 
@@ -588,10 +1070,44 @@ class RXMeshAttribute
             cudaStreamSynchronize(stream);
         }
         if ((location & HOST) == HOST) {
-            for (uint32_t i = 0; i < m_num_mesh_elements; ++i) {
-                for (uint32_t j = 0; j < m_num_attribute_per_element; ++j) {
-                    (*this)(i, j) =
-                        alpha[j] * X(i, j) + beta[j] * (*this)(i, j);
+            if (attribute_id != INVALID32) {
+                assert(attribute_id < m_num_attribute_per_element);
+                for (uint32_t i = 0; i < m_num_mesh_elements; ++i) {
+                    (*this)(i, attribute_id) =
+                        alpha[0] * X(i, attribute_id) +
+                        beta[0] * (*this)(i, attribute_id);
+                }
+            } else if (m_layout == AoSoA && X.m_layout == AoSoA) {
+                // every attribute of a tile is a contiguous run of
+                // AOSOA_TILE_SIZE values which we process as one SIMD vector.
+                // The last tile stops at m_num_mesh_elements so its padding
+                // is never touched
+                const uint32_t num_tiles =
+                    DIVIDE_UP(m_num_mesh_elements, AOSOA_TILE_SIZE);
+                for (uint32_t t = 0; t < num_tiles; ++t) {
+                    const uint32_t num_lanes =
+                        std::min(AOSOA_TILE_SIZE,
+                                 m_num_mesh_elements - t * AOSOA_TILE_SIZE);
+                    for (uint32_t j = 0; j < m_num_attribute_per_element; ++j) {
+                        const uint32_t offset =
+                            (t * m_num_attribute_per_element + j) *
+                            AOSOA_TILE_SIZE;
+                        T*       y = m_h_attr + offset;
+                        const T* x = X.m_h_attr + offset;
+                        const T  a = alpha[j], b = beta[j];
+#pragma omp simd
+                        for (uint32_t l = 0; l < num_lanes; ++l) {
+                            y[l] = a * x[l] + b * y[l];
+                        }
+                    }
+                }
+            } else {
+                for (uint32_t i = 0; i < m_num_mesh_elements; ++i) {
+                    for (uint32_t j = 0; j < m_num_attribute_per_element;
+                         ++j) {
+                        (*this)(i, j) =
+                            alpha[j] * X(i, j) + beta[j] * (*this)(i, j);
+                    }
                 }
             }
         }
@@ -613,38 +1129,28 @@ class RXMeshAttribute
 
 
         if ((location & DEVICE) == DEVICE) {
-            if (m_layout != SoA) {
-                RXMESH_ERROR(
-                    "RXMeshAttribute::reduce is not supported for non SoA "
-                    "layouts on the device");
-            }
             for (uint32_t i = 0; i < m_num_attribute_per_element; ++i) {
                 switch (op) {
-                    case SUM: {
-                        cub::DeviceReduce::Sum(
-                            m_d_reduce_temp_storage[i],
-                            m_reduce_temp_storage_bytes,
-                            m_d_attr + i * m_num_mesh_elements,
-                            m_d_reduce_output[i], m_num_mesh_elements,
-                            m_reduce_streams[i]);
-                        break;
-                    }
-                    case MAX: {
-                        cub::DeviceReduce::Max(
-                            m_d_reduce_temp_storage[i],
-                            m_reduce_temp_storage_bytes,
-                            m_d_attr + i * m_num_mesh_elements,
-                            m_d_reduce_output[i], m_num_mesh_elements,
-                            m_reduce_streams[i]);
-                        break;
-                    }
+                    case SUM:
+                    case MAX:
                     case MIN: {
-                        cub::DeviceReduce::Min(
-                            m_d_reduce_temp_storage[i],
-                            m_reduce_temp_storage_bytes,
-                            m_d_attr + i * m_num_mesh_elements,
-                            m_d_reduce_output[i], m_num_mesh_elements,
-                            m_reduce_streams[i]);
+                        if (m_layout == SoA) {
+                            device_reduce(op,
+                                          m_d_attr + i * m_num_mesh_elements,
+                                          i);
+                        } else {
+                            // the attribute is not contiguous in AoS and
+                            // AoSoA so we read it through its index
+                            device_reduce(
+                                op,
+                                cub::TransformInputIterator<
+                                    T,
+                                    detail::AttributeColumn<T>,
+                                    cub::CountingInputIterator<uint32_t>>(
+                                    cub::CountingInputIterator<uint32_t>(0),
+                                    detail::AttributeColumn<T>(*this, i)),
+                                i);
+                        }
                         break;
                     }
                     case NORM2: {
@@ -745,6 +1251,19 @@ class RXMeshAttribute
 
 
     //********************** Operators
+    __host__ __device__ __forceinline__ uint32_t get_index(uint32_t idx,
+                                                           uint32_t attr) const
+    {
+        // offset of the attr-th attribute of the idx-th mesh element in the
+        // underlying array
+        if (m_layout == AoSoA) {
+            return (idx / AOSOA_TILE_SIZE) *
+                       (AOSOA_TILE_SIZE * m_num_attribute_per_element) +
+                   attr * AOSOA_TILE_SIZE + idx % AOSOA_TILE_SIZE;
+        }
+        return idx * m_pitch.x + attr * m_pitch.y;
+    }
+
     __host__ __device__ __forceinline__ T& operator()(uint32_t idx,
                                                       uint32_t attr)
     {
@@ -754,9 +1273,9 @@ class RXMeshAttribute
         assert(m_pitch.x > 0 && m_pitch.y > 0);
 
 #ifdef __CUDA_ARCH__
-        return m_d_attr[idx * m_pitch.x + attr * m_pitch.y];
+        return m_d_attr[get_index(idx, attr)];
 #else
-        return m_h_attr[idx * m_pitch.x + attr * m_pitch.y];
+        return m_h_attr[get_index(idx, attr)];
 #endif
     }
 
@@ -782,9 +1301,9 @@ class RXMeshAttribute
         assert(idx < m_num_mesh_elements);
 
 #ifdef __CUDA_ARCH__
-        return m_d_attr[idx * m_pitch.x + attr * m_pitch.y];
+        return m_d_attr[get_index(idx, attr)];
 #else
-        return m_h_attr[idx * m_pitch.x + attr * m_pitch.y];
+        return m_h_attr[get_index(idx, attr)];
 #endif
     }
 
@@ -824,7 +1343,567 @@ class RXMeshAttribute
     //*********************************************************************
 
 
-   private:
+    //********************** Dirty Tracking
+    /**
+     * enable_dirty_tracking()
+     */
+    void enable_dirty_tracking(const uint32_t  num_patches,
+                               const uint32_t* d_element_patch)
+    {
+        // track the patches that own modified (dirty) elements so that
+        // dependent quantities can be recomputed only there. d_element_patch
+        // maps every mesh element to its owner patch on the device and
+        // should outlive the tracking (see
+        // RXMeshStatic::enable_dirty_tracking()). Should be called after
+        // init() since release() stops the tracking
+        disable_dirty_tracking();
+        m_num_patches = num_patches;
+        m_d_element_patch = d_element_patch;
+        m_d_dirty_patches = device_allocate<uint32_t>(num_dirty_words());
+        clear_dirty();
+    }
+
+    void disable_dirty_tracking()
+    {
+        if (m_d_dirty_patches != nullptr) {
+            device_free(m_d_dirty_patches);
+        }
+        m_num_patches = 0;
+        m_d_element_patch = nullptr;
+    }
+
+    __host__ __device__ __forceinline__ bool is_dirty_tracking_enabled() const
+    {
+        return m_d_dirty_patches != nullptr;
+    }
+
+    /**
+     * mark_dirty()
+     */
+    __device__ __forceinline__ void mark_dirty(const uint32_t element) const
+    {
+        // record that element was modified. Kernels that write to the
+        // attribute call it for the elements they change
+        assert(m_d_dirty_patches != nullptr);
+        const uint32_t p = m_d_element_patch[element];
+        ::atomicOr(m_d_dirty_patches + (p >> 5), 1u << (p & 31));
+    }
+
+    void mark_dirty(const std::vector<uint32_t>& h_elements,
+                    cudaStream_t                 stream = NULL)
+    {
+        // mark_dirty() for elements modified on the host
+        if (h_elements.empty() || !is_dirty_tracking_enabled()) {
+            return;
+        }
+        const uint32_t num = static_cast<uint32_t>(h_elements.size());
+        uint32_t*      d_elements = device_allocate<uint32_t>(num);
+        CUDA_ERROR(cudaMemcpyAsync(d_elements, h_elements.data(),
+                                   num * sizeof(uint32_t),
+                                   cudaMemcpyHostToDevice, stream));
+        rxmesh_attribute_mark_dirty<T>
+            <<<DIVIDE_UP(num, m_block_size), m_block_size, 0, stream>>>(
+                *this, d_elements, num);
+        CUDA_ERROR(cudaStreamSynchronize(stream));
+        device_free(d_elements);
+    }
+
+    __device__ __forceinline__ bool is_patch_dirty(const uint32_t p) const
+    {
+        return (m_d_dirty_patches[p >> 5] >> (p & 31)) & 1u;
+    }
+
+    /**
+     * get_dirty_patches()
+     */
+    std::vector<uint32_t> get_dirty_patches(cudaStream_t stream = NULL) const
+    {
+        // sorted list of the patches marked since the last clear_dirty().
+        // Only the bitmap (num_patches / 32 words) is read back
+        std::vector<uint32_t> patches;
+        if (!is_dirty_tracking_enabled()) {
+            return patches;
+        }
+        std::vector<uint32_t> h_bitmap(num_dirty_words());
+        CUDA_ERROR(cudaMemcpyAsync(h_bitmap.data(), m_d_dirty_patches,
+                                   h_bitmap.size() * sizeof(uint32_t),
+                                   cudaMemcpyDeviceToHost, stream));
+        CUDA_ERROR(cudaStreamSynchronize(stream));
+        for (uint32_t w = 0; w < h_bitmap.size(); ++w) {
+            for (uint32_t b = 0; h_bitmap[w] != 0 && b < 32; ++b) {
+                if ((h_bitmap[w] >> b) & 1u) {
+                    patches.push_back(32 * w + b);
+                }
+            }
+        }
+        return patches;
+    }
+
+    void clear_dirty(cudaStream_t stream = NULL)
+    {
+        if (is_dirty_tracking_enabled()) {
+            CUDA_ERROR(cudaMemsetAsync(m_d_dirty_patches, 0,
+                                       num_dirty_words() * sizeof(uint32_t),
+                                       stream));
+        }
+    }
+    //*********************************************************************
+
+
+    //********************** File I/O
+    /**
+     * save()
+     */
+    bool save(const std::string& file_name,
+              const bool         with_checksum = true,
+              const orderT       order = GLOBAL_ORDER,
+              const uint64_t     order_fingerprint = 0) const
+    {
+        // write the attribute (in its current layout) to a binary file i.e.,
+        // an AttributeFileHeader followed by the raw storage. The data is
+        // taken from the host if allocated there and from the device
+        // otherwise. order and order_fingerprint only describe how the mesh
+        // elements are ordered (see RXMeshStatic::save_attribute())
+        if (m_num_mesh_elements != 0 && m_allocated == LOCATION_NONE) {
+            RXMESH_ERROR(
+                "RXMeshAttribute::save() attribute {} is not allocated",
+                m_name);
+            return false;
+        }
+
+        AttributeFileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, AttributeFileHeader::MAGIC,
+                    sizeof(header.magic));
+        header.version = AttributeFileHeader::VERSION;
+        header.type_code = attribute_type_code<T>();
+        header.type_size = sizeof(T);
+        header.layout = m_layout;
+        header.num_mesh_elements = m_num_mesh_elements;
+        header.num_attribute_per_element = m_num_attribute_per_element;
+        header.order = order;
+        header.order_fingerprint = order_fingerprint;
+        header.data_offset = AttributeFileHeader::DATA_ALIGNMENT;
+        header.data_bytes =
+            uint64_t(sizeof(T)) * storage_size(m_num_mesh_elements);
+        if (m_name != nullptr) {
+            std::strncpy(header.name, m_name, sizeof(header.name) - 1);
+        }
+
+        const T*       data = m_h_attr;
+        std::vector<T> h_temp;
+        if (!is_host_allocated() && header.data_bytes > 0) {
+            h_temp.resize(storage_size(m_num_mesh_elements));
+            CUDA_ERROR(cudaMemcpy(h_temp.data(), m_d_attr, header.data_bytes,
+                                  cudaMemcpyDeviceToHost));
+            data = h_temp.data();
+        }
+        if (with_checksum) {
+            header.has_checksum = 1;
+            header.checksum = checksum64(data, header.data_bytes);
+        }
+
+        std::ofstream file(file_name, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            RXMESH_ERROR("RXMeshAttribute::save() can not open {}", file_name);
+            return false;
+        }
+        const std::vector<char> padding(header.data_offset - sizeof(header),
+                                        0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(padding.data(), padding.size());
+        file.write(reinterpret_cast<const char*>(data), header.data_bytes);
+        if (!file.good()) {
+            RXMESH_ERROR("RXMeshAttribute::save() writing {} failed",
+                         file_name);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * read_header()
+     */
+    static bool read_header(const std::string&   file_name,
+                            AttributeFileHeader& header)
+    {
+        // read (and validate) the header of a file written by save() with
+        // the same T
+        std::ifstream file(file_name, std::ios::binary);
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            RXMESH_ERROR(
+                "RXMeshAttribute::read_header() can not read the header of {}",
+                file_name);
+            return false;
+        }
+        return check_header(header, file_name);
+    }
+
+    /**
+     * load()
+     */
+    bool load(const std::string& file_name,
+              const locationT    target = HOST,
+              const bool         verify_checksum = true,
+              const bool         with_axpy_alloc = true,
+              const bool         with_reduce_alloc = true)
+    {
+        // load an attribute written by save() with the same T. The
+        // attribute takes the name, size, and layout stored in the file.
+        // The host side is not read nor copied: the file is mapped
+        // (copy-on-write) and the host buffer points into the mapping so the
+        // OS brings the pages in on first access. The device side is copied
+        // from the mapping. Verifying the checksum reads the whole file. The
+        // axpy/reduce scratch is only allocated if target includes DEVICE
+        std::unique_ptr<MappedFile> file(new MappedFile());
+        if (!file->open(file_name)) {
+            return false;
+        }
+        AttributeFileHeader header;
+        if (file->size() < sizeof(header)) {
+            RXMESH_ERROR("RXMeshAttribute::load() {} is truncated",
+                         file_name);
+            return false;
+        }
+        std::memcpy(&header, file->data(), sizeof(header));
+        if (!check_header(header, file_name)) {
+            return false;
+        }
+        if (header.data_offset + header.data_bytes > file->size()) {
+            RXMESH_ERROR("RXMeshAttribute::load() {} is truncated",
+                         file_name);
+            return false;
+        }
+        const T* data =
+            reinterpret_cast<const T*>(file->data() + header.data_offset);
+        if (verify_checksum && header.has_checksum &&
+            checksum64(data, header.data_bytes) != header.checksum) {
+            RXMESH_ERROR("RXMeshAttribute::load() checksum mismatch in {}",
+                         file_name);
+            return false;
+        }
+
+        const bool on_device = (target & DEVICE) == DEVICE;
+        init(header.num_mesh_elements, header.num_attribute_per_element,
+             target & DEVICE, header.layout, with_axpy_alloc && on_device,
+             with_reduce_alloc && on_device);
+        set_name(header.name);
+        if (header.num_mesh_elements == 0) {
+            return true;
+        }
+        if (on_device) {
+            CUDA_ERROR(cudaMemcpy(m_d_attr, data, header.data_bytes,
+                                  cudaMemcpyHostToDevice));
+        }
+        if ((target & HOST) == HOST) {
+            m_h_attr = const_cast<T*>(data);
+            m_h_mapped = file.release();
+            m_allocated = m_allocated | HOST;
+        }
+        return true;
+    }
+
+    bool is_host_mapped() const
+    {
+        return m_h_mapped != nullptr;
+    }
+    //*********************************************************************
+
+
+   protected:
+    static bool check_header(AttributeFileHeader& header,
+                             const std::string&   file_name)
+    {
+        if (std::memcmp(header.magic, AttributeFileHeader::MAGIC,
+                        sizeof(header.magic)) != 0 ||
+            header.version != AttributeFileHeader::VERSION) {
+            RXMESH_ERROR(
+                "RXMeshAttribute::check_header() {} is not an attribute file "
+                "or has a different version",
+                file_name);
+            return false;
+        }
+        if (header.type_size != sizeof(T) ||
+            header.type_code != attribute_type_code<T>()) {
+            RXMESH_ERROR(
+                "RXMeshAttribute::check_header() {} stores a different type",
+                file_name);
+            return false;
+        }
+        if (header.layout != AoS && header.layout != SoA &&
+            header.layout != AoSoA) {
+            RXMESH_ERROR("RXMeshAttribute::check_header() {} unknown layout",
+                         file_name);
+            return false;
+        }
+        const uint64_t num_stored =
+            (header.layout == AoSoA) ?
+                uint64_t(DIVIDE_UP(header.num_mesh_elements, AOSOA_TILE_SIZE)) *
+                    AOSOA_TILE_SIZE :
+                uint64_t(header.num_mesh_elements);
+        if (header.data_bytes !=
+                num_stored * header.num_attribute_per_element * sizeof(T) ||
+            header.data_offset < sizeof(header) ||
+            header.data_offset % alignof(T) != 0) {
+            RXMESH_ERROR(
+                "RXMeshAttribute::check_header() {} has an inconsistent header",
+                file_name);
+            return false;
+        }
+        header.name[sizeof(header.name) - 1] = '\0';
+        return true;
+    }
+
+    template <typename InputIteratorT>
+    void device_reduce(const reduceOpT      op,
+                       const InputIteratorT d_in,
+                       const uint32_t       attribute_id)
+    {
+        // SUM, MAX, or MIN of one attribute using cub device-wide reduce
+        switch (op) {
+            case SUM: {
+                cub::DeviceReduce::Sum(m_d_reduce_temp_storage[attribute_id],
+                                       m_reduce_temp_storage_bytes, d_in,
+                                       m_d_reduce_output[attribute_id],
+                                       m_num_mesh_elements,
+                                       m_reduce_streams[attribute_id]);
+                break;
+            }
+            case MAX: {
+                cub::DeviceReduce::Max(m_d_reduce_temp_storage[attribute_id],
+                                       m_reduce_temp_storage_bytes, d_in,
+                                       m_d_reduce_output[attribute_id],
+                                       m_num_mesh_elements,
+                                       m_reduce_streams[attribute_id]);
+                break;
+            }
+            case MIN: {
+                cub::DeviceReduce::Min(m_d_reduce_temp_storage[attribute_id],
+                                       m_reduce_temp_storage_bytes, d_in,
+                                       m_d_reduce_output[attribute_id],
+                                       m_num_mesh_elements,
+                                       m_reduce_streams[attribute_id]);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    uint32_t storage_size(const uint32_t num_mesh_elements) const
+    {
+        return storage_size(num_mesh_elements, m_layout);
+    }
+
+    uint32_t storage_size(const uint32_t num_mesh_elements,
+                          const layoutT  layout) const
+    {
+        // number of T's needed to store num_mesh_elements with the given
+        // layout (AoSoA is padded to full tiles)
+        if (layout == AoSoA) {
+            return (DIVIDE_UP(num_mesh_elements, AOSOA_TILE_SIZE)) *
+                   AOSOA_TILE_SIZE * m_num_attribute_per_element;
+        }
+        return num_mesh_elements * m_num_attribute_per_element;
+    }
+
+    uint32_t num_dirty_words() const
+    {
+        return std::max(DIVIDE_UP(m_num_patches, 32), 1u);
+    }
+
+    uint32_t num_relayout_blocks() const
+    {
+        // rxmesh_attribute_relayout uses a grid-stride loop over all entries
+        const uint64_t size =
+            uint64_t(m_num_mesh_elements) * m_num_attribute_per_element;
+        return static_cast<uint32_t>(
+            std::min<uint64_t>(DIVIDE_UP(size, m_block_size), 65535));
+    }
+
+    bool relayout(const locationT target, const layoutT layout)
+    {
+        // gather the target data into a new buffer with the given layout.
+        // dst is a shallow copy of this (similar to what the kernels get)
+        // that points to the new buffer
+        const uint32_t     size = storage_size(m_num_mesh_elements, layout);
+        RXMeshAttribute<T> dst = *this;
+        dst.m_layout = layout;
+        dst.set_pitch();
+
+        if (target == DEVICE) {
+            dst.m_d_attr = device_allocate<T>(size);
+            if (dst.m_d_attr == nullptr) {
+                return false;
+            }
+            rxmesh_attribute_relayout<T>
+                <<<num_relayout_blocks(), m_block_size>>>(*this, dst);
+            CUDA_ERROR(cudaDeviceSynchronize());
+            CUDA_ERROR(cudaGetLastError());
+            device_free(m_d_attr);
+            m_d_attr = dst.m_d_attr;
+        }
+
+        if (target == HOST) {
+            dst.m_h_attr = host_allocate<T>(size, false);
+            if (!dst.m_h_attr) {
+                RXMESH_ERROR(
+                    "RXMeshAttribute::relayout() could not allocate {} "
+                    "elements on the host",
+                    size);
+                return false;
+            }
+            const int64_t num_elements = m_num_mesh_elements;
+#pragma omp parallel for schedule(static)
+            for (int64_t i = 0; i < num_elements; ++i) {
+                for (uint32_t j = 0; j < m_num_attribute_per_element; ++j) {
+                    dst(uint32_t(i), j) = (*this)(uint32_t(i), j);
+                }
+            }
+            host_free(m_h_attr);
+            m_h_attr = dst.m_h_attr;
+        }
+        return true;
+    }
+
+    void transpose_host(T*&            h_ptr,
+                        const uint64_t num_rows,
+                        const uint64_t num_cols)
+    {
+        // transpose the host buffer h_ptr (allocated with host_allocate())
+        // which may be replaced by a new buffer
+        const uint64_t size = num_rows * num_cols;
+        T*             h_out = host_allocate<T>(size, false);
+        if (!h_out) {
+            RXMESH_WARN(
+                "RXMeshAttribute::transpose_host() could not allocate a "
+                "second buffer of {} elements. Falling back to in-place "
+                "transpose",
+                size);
+            in_place_matrix_transpose(h_ptr, h_ptr + size, num_cols);
+            return;
+        }
+        matrix_transpose(h_ptr, h_out, num_rows, num_cols);
+        host_free(h_ptr);
+        h_ptr = h_out;
+    }
+
+    bool transpose_device(const uint64_t num_rows, const uint64_t num_cols)
+    {
+        const uint64_t size = num_rows * num_cols;
+        T*             d_out = device_allocate<T>(size, false);
+        if (d_out == nullptr) {
+            // go through the host instead
+            RXMESH_WARN(
+                "RXMeshAttribute::transpose_device() could not allocate a "
+                "second buffer of {} elements on the device. Falling back to "
+                "transpose through the host",
+                size);
+            T* h_temp = host_allocate<T>(size, false);
+            if (!h_temp) {
+                RXMESH_ERROR(
+                    "RXMeshAttribute::transpose_device() could not allocate "
+                    "{} elements on the host",
+                    size);
+                return false;
+            }
+            CUDA_ERROR(cudaMemcpy(h_temp, m_d_attr, sizeof(T) * size,
+                                  cudaMemcpyDeviceToHost));
+            transpose_host(h_temp, num_rows, num_cols);
+            CUDA_ERROR(cudaMemcpy(m_d_attr, h_temp, sizeof(T) * size,
+                                  cudaMemcpyHostToDevice));
+            host_free(h_temp);
+            return true;
+        }
+
+        constexpr uint32_t tile_dim = 32;
+        constexpr uint32_t block_rows = 8;
+        if (num_rows < tile_dim || num_cols < tile_dim) {
+            const uint32_t blocks = static_cast<uint32_t>(
+                std::min<uint64_t>(DIVIDE_UP(size, m_block_size), 65535));
+            rxmesh_attribute_transpose_narrow<T>
+                <<<blocks, m_block_size>>>(m_d_attr, d_out, num_rows, num_cols);
+        } else {
+            const uint64_t num_tiles = (DIVIDE_UP(num_rows, tile_dim)) *
+                                       (DIVIDE_UP(num_cols, tile_dim));
+            const uint32_t blocks =
+                static_cast<uint32_t>(std::min<uint64_t>(num_tiles, 65535));
+            rxmesh_attribute_transpose<T, tile_dim, block_rows>
+                <<<blocks, dim3(tile_dim, block_rows)>>>(m_d_attr, d_out,
+                                                         num_rows, num_cols);
+        }
+        CUDA_ERROR(cudaDeviceSynchronize());
+        CUDA_ERROR(cudaGetLastError());
+
+        device_free(m_d_attr);
+        m_d_attr = d_out;
+        return true;
+    }
+
+    template <typename P>
+    P* host_allocate(const size_t count, const bool must_succeed = true) const
+    {
+        // count P's on the host from the arena (if set) or malloc
+        const size_t bytes = sizeof(P) * count;
+        void*        ptr = (m_arena != nullptr) ?
+                               m_arena->allocate(bytes, HOST) :
+                               malloc(bytes);
+        if (ptr == nullptr && must_succeed && bytes > 0) {
+            RXMESH_ERROR(
+                "RXMeshAttribute::host_allocate() could not allocate {} bytes",
+                bytes);
+        }
+        return static_cast<P*>(ptr);
+    }
+
+    template <typename P>
+    P* device_allocate(const size_t count, const bool must_succeed = true) const
+    {
+        // count P's on the device from the arena (if set) or cudaMalloc
+        const size_t bytes = sizeof(P) * count;
+        void*        ptr = nullptr;
+        if (m_arena != nullptr) {
+            ptr = m_arena->allocate(bytes, DEVICE);
+        } else if (cudaMalloc(&ptr, bytes) != cudaSuccess) {
+            // clear the allocation error
+            cudaGetLastError();
+            ptr = nullptr;
+        }
+        if (ptr == nullptr && must_succeed && bytes > 0) {
+            RXMESH_ERROR(
+                "RXMeshAttribute::device_allocate() could not allocate {} "
+                "bytes",
+                bytes);
+        }
+        return static_cast<P*>(ptr);
+    }
+
+    template <typename P>
+    void host_free(P*& ptr)
+    {
+        if (m_h_mapped != nullptr && m_h_mapped->contains(ptr)) {
+            // the host buffer points into the file mapped by load()
+            delete m_h_mapped;
+            m_h_mapped = nullptr;
+        } else if (m_arena != nullptr) {
+            m_arena->free(ptr, HOST);
+        } else {
+            free(ptr);
+        }
+        ptr = nullptr;
+    }
+
+    template <typename P>
+    void device_free(P*& ptr) const
+    {
+        if (m_arena != nullptr) {
+            m_arena->free(ptr, DEVICE);
+            ptr = nullptr;
+        } else {
+            GPU_FREE(ptr);
+        }
+    }
+
     void set_pitch()
     {
         if (m_layout == AoS) {
@@ -833,6 +1912,10 @@ class RXMeshAttribute
         } else if (m_layout == SoA) {
             m_pitch.x = 1;
             m_pitch.y = m_num_mesh_elements;
+        } else if (m_layout == AoSoA) {
+            // strides within a tile
+            m_pitch.x = 1;
+            m_pitch.y = AOSOA_TILE_SIZE;
         } else {
             RXMESH_ERROR("RXMeshAttribute::set_pitch() unknown layout");
         }
@@ -861,6 +1944,18 @@ class RXMeshAttribute
     T**           m_d_reduce_output;
     cudaStream_t* m_reduce_streams;
     T**           m_norm2_temp_buffer;
+
+    // where the buffers come from (nullptr for malloc/cudaMalloc)
+    AttributeArena* m_arena;
+
+    // the file the host buffer is mapped from (see load())
+    MappedFile* m_h_mapped;
+
+    // dirty tracking: owner patch of every mesh element (not owned by the
+    // attribute) and bitmap over the patches with modified elements
+    uint32_t        m_num_patches;
+    const uint32_t* m_d_element_patch;
+    uint32_t*       m_d_dirty_patches;
     //*********************************************************************
 };
 }  // namespace RXMESH
\ No newline at end of file
@@ -0,0 +1,730 @@
+#pragma once
+
+#include <assert.h>
+#include <stdint.h>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+#include "rxmesh/kernels/rxmesh_attribute.cuh"
+#include "rxmesh/rxmesh_attribute.h"
+#include "rxmesh/util/log.h"
+#include "rxmesh/util/macros.h"
+#include "rxmesh/util/vector.h"
+
+namespace RXMESH {
+
+// Element-wise expressions over RXMeshAttribute that are evaluated lazily so
+// that several updates and reductions run in a single pass over the memory
+// e.g., the CG update
+//   FusedEvaluator<float> fused;
+//   fused.evaluate(DEVICE,
+//                  fused_add(X, alpha * P),   // X += alpha*P
+//                  fused_sub(R, alpha * S),   // R -= alpha*S
+//                  fused_dot(R, R, delta));   // delta = <R,R>
+// An expression is built from attributes, scalars, and Vector<N, T> (where
+// the j-th entry multiplies the j-th attribute, like axpy's alpha) combined
+// with +, -, *, and /. The statements are applied in order to every
+// attribute of every mesh element so a reduction sees the values written by
+// the statements before it
+
+template <typename NodeT>
+class AttributeExpr;
+
+namespace detail {
+
+//********************** Operators
+struct AddOp
+{
+    template <typename A, typename B>
+    __host__ __device__ __forceinline__ static auto apply(const A a, const B b)
+    {
+        return a + b;
+    }
+};
+struct SubOp
+{
+    template <typename A, typename B>
+    __host__ __device__ __forceinline__ static auto apply(const A a, const B b)
+    {
+        return a - b;
+    }
+};
+struct MulOp
+{
+    template <typename A, typename B>
+    __host__ __device__ __forceinline__ static auto apply(const A a, const B b)
+    {
+        return a * b;
+    }
+};
+struct DivOp
+{
+    template <typename A, typename B>
+    __host__ __device__ __forceinline__ static auto apply(const A a, const B b)
+    {
+        return a / b;
+    }
+};
+
+struct AssignOp
+{
+    template <typename T, typename V>
+    __host__ __device__ __forceinline__ static void apply(T& y, const V v)
+    {
+        y = v;
+    }
+};
+struct AddAssignOp
+{
+    template <typename T, typename V>
+    __host__ __device__ __forceinline__ static void apply(T& y, const V v)
+    {
+        y += v;
+    }
+};
+struct SubAssignOp
+{
+    template <typename T, typename V>
+    __host__ __device__ __forceinline__ static void apply(T& y, const V v)
+    {
+        y -= v;
+    }
+};
+//**************************************************************************
+
+
+//********************** Nodes
+// Every node is evaluated at (mesh element i, attribute j). find_shape()
+// reports the shape of the first attribute in the node (if any) and check()
+// verifies that all attributes match the shape and are allocated on location
+template <typename T>
+struct AttributeNode
+{
+    explicit AttributeNode(const RXMeshAttribute<T>& attr) : m_attr(attr)
+    {
+    }
+
+    __host__ __device__ __forceinline__ T operator()(const uint32_t i,
+                                                     const uint32_t j) const
+    {
+        return m_attr(i, j);
+    }
+
+    bool find_shape(uint32_t& num_elements, uint32_t& num_attributes) const
+    {
+        num_elements = m_attr.get_num_mesh_elements();
+        num_attributes = m_attr.get_num_attribute_per_element();
+        return true;
+    }
+
+    bool check(const uint32_t  num_elements,
+               const uint32_t  num_attributes,
+               const locationT location) const
+    {
+        return m_attr.get_num_mesh_elements() == num_elements &&
+               m_attr.get_num_attribute_per_element() == num_attributes &&
+               ((location & HOST) != HOST || m_attr.is_host_allocated()) &&
+               ((location & DEVICE) != DEVICE || m_attr.is_device_allocated());
+    }
+
+    RXMeshAttribute<T> m_attr;
+};
+
+template <typename S>
+struct ScalarNode
+{
+    explicit ScalarNode(const S value) : m_value(value)
+    {
+    }
+
+    __host__ __device__ __forceinline__ S operator()(const uint32_t,
+                                                     const uint32_t) const
+    {
+        return m_value;
+    }
+
+    bool find_shape(uint32_t&, uint32_t&) const
+    {
+        return false;
+    }
+
+    bool check(const uint32_t, const uint32_t, const locationT) const
+    {
+        return true;
+    }
+
+    S m_value;
+};
+
+template <uint32_t N, typename T>
+struct ColumnNode
+{
+    // j-th entry is applied to the j-th attribute
+    explicit ColumnNode(const Vector<N, T>& value) : m_value(value)
+    {
+    }
+
+    __host__ __device__ __forceinline__ T operator()(const uint32_t,
+                                                     const uint32_t j) const
+    {
+        return m_value[j];
+    }
+
+    bool find_shape(uint32_t&, uint32_t&) const
+    {
+        return false;
+    }
+
+    bool check(const uint32_t, const uint32_t num_attributes,
+               const locationT) const
+    {
+        return num_attributes <= N;
+    }
+
+    Vector<N, T> m_value;
+};
+
+template <typename OpT, typename L, typename R>
+struct BinaryNode
+{
+    BinaryNode(const L& lhs, const R& rhs) : m_lhs(lhs), m_rhs(rhs)
+    {
+    }
+
+    __host__ __device__ __forceinline__ auto operator()(const uint32_t i,
+                                                        const uint32_t j) const
+    {
+        return OpT::apply(m_lhs(i, j), m_rhs(i, j));
+    }
+
+    bool find_shape(uint32_t& num_elements, uint32_t& num_attributes) const
+    {
+        return m_lhs.find_shape(num_elements, num_attributes) ||
+               m_rhs.find_shape(num_elements, num_attributes);
+    }
+
+    bool check(const uint32_t  num_elements,
+               const uint32_t  num_attributes,
+               const locationT location) const
+    {
+        return m_lhs.check(num_elements, num_attributes, location) &&
+               m_rhs.check(num_elements, num_attributes, location);
+    }
+
+    L m_lhs;
+    R m_rhs;
+};
+
+template <typename E>
+struct NegateNode
+{
+    explicit NegateNode(const E& node) : m_node(node)
+    {
+    }
+
+    __host__ __device__ __forceinline__ auto operator()(const uint32_t i,
+                                                        const uint32_t j) const
+    {
+        return -m_node(i, j);
+    }
+
+    bool find_shape(uint32_t& num_elements, uint32_t& num_attributes) const
+    {
+        return m_node.find_shape(num_elements, num_attributes);
+    }
+
+    bool check(const uint32_t  num_elements,
+               const uint32_t  num_attributes,
+               const locationT location) const
+    {
+        return m_node.check(num_elements, num_attributes, location);
+    }
+
+    E m_node;
+};
+//**************************************************************************
+
+
+//********************** Operands
+// ExprOperand<X>::node is the node type that X becomes inside an expression.
+// Only defined for the types that can be used in an expression
+template <typename X, typename = void>
+struct ExprOperand
+{
+};
+
+template <typename NodeT>
+struct ExprOperand<AttributeExpr<NodeT>>
+{
+    using node = NodeT;
+    static const NodeT& make(const AttributeExpr<NodeT>& expr)
+    {
+        return expr.get_node();
+    }
+};
+
+template <typename T>
+struct ExprOperand<RXMeshAttribute<T>>
+{
+    using node = AttributeNode<T>;
+    static node make(const RXMeshAttribute<T>& attr)
+    {
+        return node(attr);
+    }
+};
+
+template <uint32_t N, typename T>
+struct ExprOperand<Vector<N, T>>
+{
+    using node = ColumnNode<N, T>;
+    static node make(const Vector<N, T>& value)
+    {
+        return node(value);
+    }
+};
+
+template <typename S>
+struct ExprOperand<S, std::enable_if_t<std::is_arithmetic_v<S>>>
+{
+    using node = ScalarNode<S>;
+    static node make(const S value)
+    {
+        return node(value);
+    }
+};
+
+template <typename X, typename = void>
+struct is_expr_operand : std::false_type
+{
+};
+template <typename X>
+struct is_expr_operand<X, std::void_t<typename ExprOperand<X>::node>>
+    : std::true_type
+{
+};
+
+// attributes and expressions (but not scalars and Vector) start an expression
+template <typename X>
+struct is_expr_term : std::false_type
+{
+};
+template <typename NodeT>
+struct is_expr_term<AttributeExpr<NodeT>> : std::true_type
+{
+};
+template <typename T>
+struct is_expr_term<RXMeshAttribute<T>> : std::true_type
+{
+};
+
+template <typename X>
+struct is_vector : std::false_type
+{
+};
+template <uint32_t N, typename T>
+struct is_vector<Vector<N, T>> : std::true_type
+{
+};
+
+// Vector on the left is handled by dedicated overloads since Vector has
+// member operators that take anything on the right
+template <typename L, typename R>
+inline constexpr bool is_binary_expr_v =
+    is_expr_operand<L>::value && is_expr_operand<R>::value &&
+    (is_expr_term<L>::value || is_expr_term<R>::value) && !is_vector<L>::value;
+
+template <typename OpT, typename L, typename R>
+inline auto make_binary(const L& lhs, const R& rhs)
+{
+    using LN = typename ExprOperand<L>::node;
+    using RN = typename ExprOperand<R>::node;
+    return AttributeExpr<BinaryNode<OpT, LN, RN>>(BinaryNode<OpT, LN, RN>(
+        ExprOperand<L>::make(lhs), ExprOperand<R>::make(rhs)));
+}
+//**************************************************************************
+
+
+//********************** Statements
+template <typename AssignOpT, typename T, typename NodeT>
+class AssignStatement
+{
+    // target (=, +=, or -=) node
+   public:
+    static constexpr uint32_t num_reductions = 0;
+    static constexpr uint32_t output_size = 0;
+
+    AssignStatement(const RXMeshAttribute<T>& target, const NodeT& node)
+        : m_target(target), m_node(node)
+    {
+    }
+
+    __host__ __device__ __forceinline__ void apply(const uint32_t i,
+                                                   const uint32_t j,
+                                                   T*&,
+                                                   const uint32_t) const
+    {
+        AssignOpT::apply(m_target(i, j), m_node(i, j));
+    }
+
+    bool find_shape(uint32_t& num_elements, uint32_t& num_attributes) const
+    {
+        return AttributeNode<T>(m_target).find_shape(num_elements,
+                                                     num_attributes);
+    }
+
+    bool check(const uint32_t  num_elements,
+               const uint32_t  num_attributes,
+               const locationT location) const
+    {
+        return AttributeNode<T>(m_target).check(num_elements, num_attributes,
+                                                location) &&
+               m_node.check(num_elements, num_attributes, location);
+    }
+
+    void write(const std::vector<T>&, const uint32_t, const uint32_t,
+               uint32_t&) const
+    {
+    }
+
+   private:
+    RXMeshAttribute<T> m_target;
+    NodeT              m_node;
+};
+
+template <uint32_t N, typename T, typename NodeT>
+class ReduceStatement
+{
+    // h_output[j] = sum over the mesh elements i of node(i, j)
+   public:
+    static constexpr uint32_t num_reductions = 1;
+    static constexpr uint32_t output_size = N;
+
+    ReduceStatement(const NodeT& node, Vector<N, T>& h_output)
+        : m_node(node), m_h_output(&h_output)
+    {
+    }
+
+    __host__ __device__ __forceinline__ void apply(const uint32_t i,
+                                                   const uint32_t j,
+                                                   T*&            slot,
+                                                   const uint32_t stride) const
+    {
+        // slot is this statement's running sum for attribute j. The next
+        // reduction's sum is stride entries away
+        slot[0] += m_node(i, j);
+        slot += stride;
+    }
+
+    bool find_shape(uint32_t& num_elements, uint32_t& num_attributes) const
+    {
+        return m_node.find_shape(num_elements, num_attributes);
+    }
+
+    bool check(const uint32_t  num_elements,
+               const uint32_t  num_attributes,
+               const locationT location) const
+    {
+        return num_attributes <= N &&
+               m_node.check(num_elements, num_attributes, location);
+    }
+
+    void write(const std::vector<T>& sums,
+               const uint32_t        num_attributes,
+               const uint32_t        num_reductions_total,
+               uint32_t&             reduction_id) const
+    {
+        for (uint32_t j = 0; j < num_attributes; ++j) {
+            (*m_h_output)[j] = sums[j * num_reductions_total + reduction_id];
+        }
+        ++reduction_id;
+    }
+
+   private:
+    NodeT         m_node;
+    Vector<N, T>* m_h_output;
+};
+
+//**************************************************************************
+}  // namespace detail
+
+
+/**
+ * AttributeExpr
+ * A lazily evaluated element-wise expression. Use it through the operators
+ * and the fused_* statements below
+ */
+template <typename NodeT>
+class AttributeExpr
+{
+   public:
+    explicit AttributeExpr(const NodeT& node) : m_node(node)
+    {
+    }
+
+    __host__ __device__ __forceinline__ auto operator()(const uint32_t i,
+                                                        const uint32_t j) const
+    {
+        return m_node(i, j);
+    }
+
+    const NodeT& get_node() const
+    {
+        return m_node;
+    }
+
+   private:
+    NodeT m_node;
+};
+
+#define RXMESH_ATTRIBUTE_EXPR_OPERATOR(op, OpT)                              \
+    template <typename L, typename R,                                        \
+              typename = std::enable_if_t<detail::is_binary_expr_v<L, R>>>   \
+    inline auto operator op(const L& lhs, const R& rhs)                      \
+    {                                                                        \
+        return detail::make_binary<detail::OpT>(lhs, rhs);                   \
+    }                                                                        \
+    template <uint32_t N, typename T, typename NodeT>                        \
+    inline auto operator op(const Vector<N, T>&         lhs,                 \
+                            const AttributeExpr<NodeT>& rhs)                 \
+    {                                                                        \
+        return detail::make_binary<detail::OpT>(lhs, rhs);                   \
+    }                                                                        \
+    template <uint32_t N, typename T>                                        \
+    inline auto operator op(const Vector<N, T>&       lhs,                   \
+                            const RXMeshAttribute<T>& rhs)                   \
+    {                                                                        \
+        return detail::make_binary<detail::OpT>(lhs, rhs);                   \
+    }
+
+RXMESH_ATTRIBUTE_EXPR_OPERATOR(+, AddOp)
+RXMESH_ATTRIBUTE_EXPR_OPERATOR(-, SubOp)
+RXMESH_ATTRIBUTE_EXPR_OPERATOR(*, MulOp)
+RXMESH_ATTRIBUTE_EXPR_OPERATOR(/, DivOp)
+#undef RXMESH_ATTRIBUTE_EXPR_OPERATOR
+
+template <typename E,
+          typename = std::enable_if_t<detail::is_expr_term<E>::value>>
+inline auto operator-(const E& expr)
+{
+    using node = typename detail::ExprOperand<E>::node;
+    return AttributeExpr<detail::NegateNode<node>>(
+        detail::NegateNode<node>(detail::ExprOperand<E>::make(expr)));
+}
+
+
+/**
+ * fused_assign()
+ */
+template <typename T, typename E>
+inline auto fused_assign(RXMeshAttribute<T>& target, const E& expr)
+{
+    // target = expr
+    using node = typename detail::ExprOperand<E>::node;
+    return detail::AssignStatement<detail::AssignOp, T, node>(
+        target, detail::ExprOperand<E>::make(expr));
+}
+
+/**
+ * fused_add()
+ */
+template <typename T, typename E>
+inline auto fused_add(RXMeshAttribute<T>& target, const E& expr)
+{
+    // target += expr
+    using node = typename detail::ExprOperand<E>::node;
+    return detail::AssignStatement<detail::AddAssignOp, T, node>(
+        target, detail::ExprOperand<E>::make(expr));
+}
+
+/**
+ * fused_sub()
+ */
+template <typename T, typename E>
+inline auto fused_sub(RXMeshAttribute<T>& target, const E& expr)
+{
+    // target -= expr
+    using node = typename detail::ExprOperand<E>::node;
+    return detail::AssignStatement<detail::SubAssignOp, T, node>(
+        target, detail::ExprOperand<E>::make(expr));
+}
+
+/**
+ * fused_sum()
+ */
+template <uint32_t N, typename T, typename E>
+inline auto fused_sum(const E& expr, Vector<N, T>& h_output)
+{
+    // h_output[j] = sum_i expr(i, j) for every attribute j
+    using node = typename detail::ExprOperand<E>::node;
+    return detail::ReduceStatement<N, T, node>(
+        detail::ExprOperand<E>::make(expr), h_output);
+}
+
+/**
+ * fused_dot()
+ */
+template <uint32_t N, typename T, typename A, typename B>
+inline auto fused_dot(const A& a, const B& b, Vector<N, T>& h_output)
+{
+    // h_output[j] = sum_i a(i, j) * b(i, j) i.e., the same as
+    // RXMeshAttribute::reduce() with DOT
+    return fused_sum(detail::make_binary<detail::MulOp>(a, b), h_output);
+}
+
+/**
+ * fused_norm2()
+ */
+template <uint32_t N, typename T, typename A>
+inline auto fused_norm2(const A& a, Vector<N, T>& h_output)
+{
+    // h_output[j] = sum_i a(i, j)^2 i.e., the same as
+    // RXMeshAttribute::reduce() with NORM2
+    return fused_dot(a, a, h_output);
+}
+
+
+/**
+ * FusedEvaluator
+ * Runs a list of fused_* statements in one pass over the mesh elements on
+ * the host and/or the device. On the host, the mesh elements are split into
+ * tiles of AOSOA_TILE_SIZE elements distributed over OpenMP threads and every
+ * tile is processed as one SIMD vector per attribute with per-lane partial
+ * sums. On the device, a single kernel applies the statements and reduces
+ * the partial sums per block which a second (tiny) kernel combines. The
+ * evaluator owns the device scratch for the reductions which is reused
+ * across calls and freed by release()
+ */
+template <typename T>
+class FusedEvaluator
+{
+   public:
+    FusedEvaluator()
+        : m_num_slots_allocated(0),
+          m_d_block_output(nullptr),
+          m_d_output(nullptr)
+    {
+    }
+
+    /**
+     * evaluate()
+     */
+    template <typename... StatementT>
+    void evaluate(const locationT location, const StatementT&... statements)
+    {
+        constexpr uint32_t num_reductions =
+            (StatementT::num_reductions + ... + 0);
+        constexpr uint32_t max_output_size =
+            std::max({1u, StatementT::output_size...});
+
+        // all attributes in all statements should have the same shape
+        uint32_t num_elements(0), num_attributes(0);
+        if (!(statements.find_shape(num_elements, num_attributes) || ...)) {
+            RXMESH_ERROR(
+                "FusedEvaluator::evaluate() the statements do not contain "
+                "any attribute");
+            return;
+        }
+        if (!(statements.check(num_elements, num_attributes, location) &&
+              ...)) {
+            RXMESH_ERROR(
+                "FusedEvaluator::evaluate() the attributes should have {} mesh "
+                "elements and {} attributes per element, be allocated on {}, "
+                "and the output Vector size should be >= {}",
+                num_elements, num_attributes, location_to_string(location),
+                num_attributes);
+            return;
+        }
+        // one running sum per attribute and per reduction statement
+        const uint32_t num_slots = num_attributes * num_reductions;
+        std::vector<T> sums(num_slots, T(0));
+
+        if ((location & DEVICE) == DEVICE && num_elements > 0) {
+            const uint32_t num_blocks =
+                std::min(DIVIDE_UP(num_elements, m_block_size), m_max_blocks);
+            if (num_slots > m_num_slots_allocated) {
+                release();
+                CUDA_ERROR(cudaMalloc((void**)&m_d_block_output,
+                                      num_slots * m_max_blocks * sizeof(T)));
+                CUDA_ERROR(
+                    cudaMalloc((void**)&m_d_output, num_slots * sizeof(T)));
+                m_num_slots_allocated = num_slots;
+            }
+
+            rxmesh_attribute_fused<T, m_block_size,
+                                   num_reductions * max_output_size>
+                <<<num_blocks, m_block_size>>>(num_elements, num_attributes,
+                                               m_d_block_output,
+                                               statements...);
+            if (num_slots > 0) {
+                rxmesh_attribute_fused_finalize<T, m_block_size>
+                    <<<num_slots, m_block_size>>>(m_d_block_output,
+                                                  num_blocks, m_d_output);
+                CUDA_ERROR(cudaMemcpy(sums.data(), m_d_output,
+                                      num_slots * sizeof(T),
+                                      cudaMemcpyDeviceToHost));
+            }
+            CUDA_ERROR(cudaStreamSynchronize(NULL));
+            CUDA_ERROR(cudaGetLastError());
+        }
+
+        if ((location & HOST) == HOST) {
+            std::fill(sums.begin(), sums.end(), T(0));
+            constexpr uint32_t lanes = AOSOA_TILE_SIZE;
+            const int64_t      num_tiles =
+                DIVIDE_UP(int64_t(num_elements), int64_t(lanes));
+#pragma omp parallel
+            {
+                // partial[(j * num_reductions + r) * lanes + l] is the sum of
+                // reduction r for attribute j in SIMD lane l
+                std::vector<T> partial(std::max(num_slots, 1u) * lanes, T(0));
+#pragma omp for schedule(static)
+                for (int64_t t = 0; t < num_tiles; ++t) {
+                    const uint32_t begin = uint32_t(t) * lanes;
+                    const uint32_t count =
+                        std::min(lanes, num_elements - begin);
+                    for (uint32_t j = 0; j < num_attributes; ++j) {
+                        T* slot = partial.data() + j * num_reductions * lanes;
+#pragma omp simd
+                        for (uint32_t l = 0; l < count; ++l) {
+                            // in order so later statements see the values
+                            // written by earlier ones
+                            T* lane_slot = slot + l;
+                            (statements.apply(begin + l, j, lane_slot, lanes),
+                             ...);
+                        }
+                    }
+                }
+#pragma omp critical
+                {
+                    for (uint32_t s = 0; s < num_slots; ++s) {
+                        for (uint32_t l = 0; l < lanes; ++l) {
+                            sums[s] += partial[s * lanes + l];
+                        }
+                    }
+                }
+            }
+        }
+
+        uint32_t reduction_id = 0;
+        (statements.write(sums, num_attributes, num_reductions, reduction_id),
+         ...);
+    }
+
+    void release()
+    {
+        GPU_FREE(m_d_block_output);
+        GPU_FREE(m_d_output);
+        m_num_slots_allocated = 0;
+    }
+
+   private:
+    constexpr static uint32_t m_block_size = 256;
+    // enough blocks to saturate the memory bandwidth. Larger inputs are
+    // processed with a grid-stride loop which keeps the number of partial
+    // sums small
+    constexpr static uint32_t m_max_blocks = 1024;
+
+    uint32_t m_num_slots_allocated;
+    T *m_d_block_output, *m_d_output;
+};
+}  // namespace RXMESH
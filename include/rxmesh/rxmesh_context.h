@@ -25,7 +25,8 @@ class __align__(16) RXMeshContext
           m_d_patches_faces(nullptr), m_d_patch_distribution_v(nullptr),
           m_d_patch_distribution_e(nullptr), m_d_patch_distribution_f(nullptr),
           m_d_ad_size(nullptr), m_d_owned_size(nullptr),
-          m_d_neighbour_patches(nullptr), m_d_neighbour_patches_offset(nullptr)
+          m_d_neighbour_patches(nullptr), m_d_neighbour_patches_offset(nullptr),
+          m_num_dispatch_patches(0), m_d_dispatch_patches(nullptr)
 
     {
         m_d_max_size.x = m_d_max_size.y = 0;
@@ -77,6 +78,38 @@ class __align__(16) RXMeshContext
     }
 
 
+    void set_dispatch_patches(const uint32_t num_dispatch_patches,
+                              uint32_t*      d_dispatch_patches)
+    {
+        // restrict the patches processed by the query dispatcher to the
+        // d_dispatch_patches list (on the device) such that block i processes
+        // patch d_dispatch_patches[i]. Passing nullptr processes all patches
+        // where block i processes patch i
+        m_num_dispatch_patches = num_dispatch_patches;
+        m_d_dispatch_patches = d_dispatch_patches;
+    }
+
+    void set_mapping(uint32_t* d_patches_ltog_v,
+                     uint32_t* d_patches_ltog_e,
+                     uint32_t* d_patches_ltog_f,
+                     uint32_t* d_vertex_patch,
+                     uint32_t* d_edge_patch,
+                     uint32_t* d_face_patch)
+    {
+        // replace the local-to-global maps and the element-to-patch maps so
+        // the dispatcher (and RXMeshIterator) report the mesh elements by
+        // another numbering than their global id e.g., patch order (see
+        // RXMeshStatic::get_patch_order_context()). The maps should have the
+        // same layout as the ones they replace
+        m_d_patches_ltog_v = d_patches_ltog_v;
+        m_d_patches_ltog_e = d_patches_ltog_e;
+        m_d_patches_ltog_f = d_patches_ltog_f;
+        m_d_vertex_patch = d_vertex_patch;
+        m_d_edge_patch = d_edge_patch;
+        m_d_face_patch = d_face_patch;
+    }
+
+
     template <typename dataT>
     __device__ void print_data(const dataT* arr, const uint32_t start_id,
                                const uint32_t len, int shift = 0) const
@@ -237,6 +270,47 @@ class __align__(16) RXMeshContext
     {
         return m_d_patch_distribution_f;
     }
+    __device__ __forceinline__ uint32_t* get_neighbour_patches() const
+    {
+        return m_d_neighbour_patches;
+    }
+    __device__ __forceinline__ uint32_t* get_neighbour_patches_offset() const
+    {
+        return m_d_neighbour_patches_offset;
+    }
+    __device__ __forceinline__ uint32_t get_num_dispatch_patches() const
+    {
+        return (m_d_dispatch_patches == nullptr) ? m_num_patches :
+                                                   m_num_dispatch_patches;
+    }
+    __device__ __forceinline__ uint32_t
+    get_dispatch_patch(const uint32_t block_id) const
+    {
+        return (m_d_dispatch_patches == nullptr) ?
+                   block_id :
+                   m_d_dispatch_patches[block_id];
+    }
+    // index of an owned element in patch order i.e., where the owned
+    // elements of patch 0 come first, then those of patch 1, and so on. Only
+    // valid for owned local ids
+    __device__ __forceinline__ uint32_t
+    get_patch_ordered_vertex(const uint32_t patch_id,
+                             const uint16_t local_id) const
+    {
+        return m_d_patch_distribution_v[patch_id] + local_id;
+    }
+    __device__ __forceinline__ uint32_t
+    get_patch_ordered_edge(const uint32_t patch_id,
+                           const uint16_t local_id) const
+    {
+        return m_d_patch_distribution_e[patch_id] + local_id;
+    }
+    __device__ __forceinline__ uint32_t
+    get_patch_ordered_face(const uint32_t patch_id,
+                           const uint16_t local_id) const
+    {
+        return m_d_patch_distribution_f[patch_id] + local_id;
+    }
     //**********************************************************************
 
     static __device__ __host__ __forceinline__ void unpack_edge_dir(
@@ -280,5 +354,9 @@ class __align__(16) RXMeshContext
 
     // patch neighbour
     uint32_t *m_d_neighbour_patches, *m_d_neighbour_patches_offset;
+
+    // subset of patches to process by the dispatcher (nullptr for all)
+    uint32_t  m_num_dispatch_patches;
+    uint32_t* m_d_dispatch_patches;
 };
 }  // namespace RXMESH
\ No newline at end of file
@@ -0,0 +1,191 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "rxmesh/rxmesh_attribute.h"
+#include "rxmesh/util/log.h"
+#include "rxmesh/util/macros.h"
+
+namespace RXMESH {
+
+template <class T>
+class CSRMatrix;
+
+template <class T>
+__global__ void csr_spmv(const CSRMatrix<T>       mat,
+                         const RXMeshAttribute<T> in,
+                         RXMeshAttribute<T>       out)
+{
+    // out = mat * in applied to every attribute where in and out are indexed
+    // by vertex id and the matrix rows/columns by row id
+    const uint32_t row = threadIdx.x + blockIdx.x * blockDim.x;
+    if (row < mat.get_num_rows()) {
+        const uint32_t  start = mat.get_row_ptr()[row];
+        const uint32_t  end = mat.get_row_ptr()[row + 1];
+        const uint32_t* col = mat.get_col_idx();
+        const T*        val = mat.get_val();
+        const uint32_t* row_vertex = mat.get_row_vertex();
+
+        for (uint32_t attr = 0; attr < in.get_num_attribute_per_element();
+             ++attr) {
+            T sum = 0;
+            for (uint32_t j = start; j < end; ++j) {
+                sum += val[j] * in(row_vertex[col[j]], attr);
+            }
+            out(row_vertex[row], attr) = sum;
+        }
+    }
+}
+
+/**
+ * CSRMatrix
+ * Sparse matrix in compressed sparse row format defined over the mesh
+ * vertices and stored on the device. Rows (and columns) are not indexed by
+ * the vertex id but by a row id where the vertices owned by the same patch
+ * are consecutive rows. get_row_vertex() and get_vertex_row() map between
+ * the two. init() allocates the row pointers, the column indices, the
+ * values, and the two row/vertex maps on the device. Copies passed to
+ * kernels alias these arrays. release() frees all five and must be called
+ * once, on the instance that was initialized
+ */
+template <class T>
+class CSRMatrix
+{
+   public:
+    CSRMatrix()
+        : m_num_rows(0), m_nnz(0), m_d_row_ptr(nullptr), m_d_col_idx(nullptr),
+          m_d_val(nullptr), m_d_row_vertex(nullptr), m_d_vertex_row(nullptr)
+    {
+    }
+
+    void init(const uint32_t num_rows, const uint32_t nnz)
+    {
+        release();
+        m_num_rows = num_rows;
+        m_nnz = nnz;
+        CUDA_ERROR(cudaMalloc((void**)&m_d_row_ptr,
+                              (m_num_rows + 1) * sizeof(uint32_t)));
+        CUDA_ERROR(
+            cudaMalloc((void**)&m_d_row_vertex, m_num_rows * sizeof(uint32_t)));
+        CUDA_ERROR(
+            cudaMalloc((void**)&m_d_vertex_row, m_num_rows * sizeof(uint32_t)));
+        if (nnz > 0) {
+            alloc_entries(nnz);
+        }
+    }
+
+    void alloc_entries(const uint32_t nnz)
+    {
+        GPU_FREE(m_d_col_idx);
+        GPU_FREE(m_d_val);
+        m_nnz = nnz;
+        CUDA_ERROR(cudaMalloc((void**)&m_d_col_idx, m_nnz * sizeof(uint32_t)));
+        CUDA_ERROR(cudaMalloc((void**)&m_d_val, m_nnz * sizeof(T)));
+    }
+
+    void release()
+    {
+        GPU_FREE(m_d_row_ptr);
+        GPU_FREE(m_d_col_idx);
+        GPU_FREE(m_d_val);
+        GPU_FREE(m_d_row_vertex);
+        GPU_FREE(m_d_vertex_row);
+        m_num_rows = 0;
+        m_nnz = 0;
+    }
+
+    /**
+     * multiply()
+     */
+    void multiply(const RXMeshAttribute<T>& in,
+                  RXMeshAttribute<T>&       out,
+                  cudaStream_t              stream = NULL) const
+    {
+        // out = this * in
+        if (in.get_num_attribute_per_element() !=
+            out.get_num_attribute_per_element()) {
+            RXMESH_ERROR(
+                "CSRMatrix::multiply() input and output should have the same "
+                "number of attributes");
+        }
+        constexpr uint32_t blockThreads = 256;
+        csr_spmv<T><<<DIVIDE_UP(m_num_rows, blockThreads), blockThreads, 0,
+                      stream>>>(*this, in, out);
+    }
+
+    /**
+     * copy_to_host()
+     */
+    void copy_to_host(std::vector<uint32_t>& row_ptr,
+                      std::vector<uint32_t>& col_idx,
+                      std::vector<T>&        val,
+                      std::vector<uint32_t>& row_vertex) const
+    {
+        // export the matrix to the host. row_vertex[r] is the vertex id of
+        // row r
+        row_ptr.resize(m_num_rows + 1);
+        col_idx.resize(m_nnz);
+        val.resize(m_nnz);
+        row_vertex.resize(m_num_rows);
+        CUDA_ERROR(cudaMemcpy(row_ptr.data(), m_d_row_ptr,
+                              (m_num_rows + 1) * sizeof(uint32_t),
+                              cudaMemcpyDeviceToHost));
+        CUDA_ERROR(cudaMemcpy(col_idx.data(), m_d_col_idx,
+                              m_nnz * sizeof(uint32_t),
+                              cudaMemcpyDeviceToHost));
+        CUDA_ERROR(cudaMemcpy(val.data(), m_d_val, m_nnz * sizeof(T),
+                              cudaMemcpyDeviceToHost));
+        CUDA_ERROR(cudaMemcpy(row_vertex.data(), m_d_row_vertex,
+                              m_num_rows * sizeof(uint32_t),
+                              cudaMemcpyDeviceToHost));
+    }
+
+    double get_device_storage_mb() const
+    {
+        size_t bytes = (3 * size_t(m_num_rows) + 1 + m_nnz) * sizeof(uint32_t) +
+                       size_t(m_nnz) * sizeof(T);
+        return double(bytes) / double(1024 * 1024);
+    }
+
+    //********************** Getter
+    __host__ __device__ __forceinline__ uint32_t get_num_rows() const
+    {
+        return m_num_rows;
+    }
+    __host__ __device__ __forceinline__ uint32_t get_nnz() const
+    {
+        return m_nnz;
+    }
+    __host__ __device__ __forceinline__ uint32_t* get_row_ptr() const
+    {
+        return m_d_row_ptr;
+    }
+    __host__ __device__ __forceinline__ uint32_t* get_col_idx() const
+    {
+        return m_d_col_idx;
+    }
+    __host__ __device__ __forceinline__ T* get_val() const
+    {
+        return m_d_val;
+    }
+    __host__ __device__ __forceinline__ uint32_t* get_row_vertex() const
+    {
+        return m_d_row_vertex;
+    }
+    __host__ __device__ __forceinline__ uint32_t* get_vertex_row() const
+    {
+        return m_d_vertex_row;
+    }
+    //**************************************************************************
+
+   private:
+    uint32_t m_num_rows, m_nnz;
+
+    // row_ptr[r] is the start of row r and row_ptr[num_rows] = nnz
+    uint32_t* m_d_row_ptr;
+    uint32_t* m_d_col_idx;
+    T*        m_d_val;
+
+    // map row id to vertex id and vice versa
+    uint32_t *m_d_row_vertex, *m_d_vertex_row;
+};
+}  // namespace RXMESH
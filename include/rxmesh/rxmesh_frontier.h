@@ -0,0 +1,330 @@
+#pragma once
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+#include "rxmesh/rxmesh_context.h"
+#include "rxmesh/util/log.h"
+#include "rxmesh/util/macros.h"
+
+namespace RXMESH {
+
+class Frontier;
+
+namespace detail {
+
+/**
+ * frontier_vertex_map()
+ */
+__global__ static void frontier_vertex_map(const RXMeshContext context,
+                                           uint32_t*           d_vertex_bit,
+                                           uint32_t*           d_vertex_patch)
+{
+    // the vertices owned by a patch get consecutive bits starting at
+    // vertex_distribution[p] so that every patch has its own contiguous range
+    // of the bitmap. One block per patch
+    const uint32_t patch_id = blockIdx.x;
+    if (patch_id >= context.get_num_patches()) {
+        return;
+    }
+    const uint32_t  num_owned = context.get_size_owned()[patch_id].z;
+    const uint32_t  start = context.get_ad_size_ltog_v()[patch_id].x;
+    const uint32_t  bit_start = context.get_vertex_distribution()[patch_id];
+    const uint32_t* ltog = context.get_patches_ltog_v();
+    for (uint32_t l = threadIdx.x; l < num_owned; l += blockDim.x) {
+        const uint32_t v = ltog[start + l] >> 1;
+        d_vertex_bit[v] = bit_start + l;
+        d_vertex_patch[v] = patch_id;
+    }
+}
+
+/**
+ * frontier_clear()
+ */
+__global__ static void frontier_clear(const uint32_t* d_patches,
+                                      const uint32_t  num_patches,
+                                      const uint32_t* d_patch_offset,
+                                      uint32_t*       d_bits,
+                                      uint32_t*       d_patch_flags)
+{
+    // clear the bitmap range and the flag of the patches in d_patches. One
+    // block per patch so the cost is proportional to the number of patches
+    // in the list and not to the mesh size. Words shared with a neighbour
+    // patch are cleared as a whole which is fine since a patch that is not
+    // in the list has no bit set
+    if (blockIdx.x >= num_patches) {
+        return;
+    }
+    const uint32_t p = d_patches[blockIdx.x];
+    if (d_bits != nullptr) {
+        const uint32_t word_start = d_patch_offset[p] >> 5;
+        const uint32_t word_end = DIVIDE_UP(d_patch_offset[p + 1], 32);
+        for (uint32_t w = word_start + threadIdx.x; w < word_end;
+             w += blockDim.x) {
+            d_bits[w] = 0;
+        }
+    }
+    if (d_patch_flags != nullptr && threadIdx.x == 0) {
+        atomicAnd(d_patch_flags + (p >> 5), ~(1u << (p & 31)));
+    }
+}
+
+/**
+ * frontier_add()
+ */
+__global__ static void frontier_add(const Frontier  frontier,
+                                    const uint32_t* d_vertices,
+                                    const uint32_t  num_vertices);
+}  // namespace detail
+
+/**
+ * Frontier
+ * Sparse set of active vertices for front-propagation algorithms (BFS,
+ * geodesics, region growing, flood fill) that run in rounds where only a few
+ * patches have active vertices in every round. Every patch owns a contiguous
+ * range of a bitmap over the vertices. Along with the bitmap, the frontier
+ * keeps the compacted list of the patches that have at least one active
+ * vertex so that a round only launches one block per active patch (see
+ * RXMeshStatic::get_frontier_context()). Kernels test the current round with
+ * is_active() and activate vertices for the next round with activate().
+ * advance() moves to the next round and clears only the patches that were
+ * active so the cost of a round is proportional to the frontier. A kernel
+ * should get its copy after the last advance() since the copy holds which
+ * of the two bitmaps is the current one. release() frees the two bitmaps,
+ * the two patch lists, and the per-vertex bit and patch maps made by init()
+ */
+class Frontier
+{
+   public:
+    Frontier()
+        : m_num_vertices(0), m_num_patches(0), m_num_words(0),
+          m_num_active_patches(0), m_num_active_vertices(0), m_current(0),
+          m_d_vertex_bit(nullptr), m_d_vertex_patch(nullptr),
+          m_d_patch_offset(nullptr), m_d_patch_flags(nullptr),
+          m_d_counters(nullptr)
+    {
+        m_d_bits[0] = m_d_bits[1] = nullptr;
+        m_d_patches[0] = m_d_patches[1] = nullptr;
+    }
+
+    void init(const RXMeshContext&         context,
+              const uint32_t               num_vertices,
+              const std::vector<uint32_t>& h_patch_distribution_v)
+    {
+        // h_patch_distribution_v is the exclusive prefix sum of the number of
+        // owned vertices per patch (num_patches + 1 entries)
+        release();
+        m_num_vertices = num_vertices;
+        m_num_patches =
+            static_cast<uint32_t>(h_patch_distribution_v.size()) - 1;
+        m_num_words = std::max(DIVIDE_UP(m_num_vertices, 32), 1u);
+        const uint32_t num_flag_words =
+            std::max(DIVIDE_UP(m_num_patches, 32), 1u);
+
+        CUDA_ERROR(cudaMalloc((void**)&m_d_vertex_bit,
+                              m_num_vertices * sizeof(uint32_t)));
+        CUDA_ERROR(cudaMalloc((void**)&m_d_vertex_patch,
+                              m_num_vertices * sizeof(uint32_t)));
+        CUDA_ERROR(cudaMalloc((void**)&m_d_patch_offset,
+                              (m_num_patches + 1) * sizeof(uint32_t)));
+        CUDA_ERROR(cudaMalloc((void**)&m_d_patch_flags,
+                              num_flag_words * sizeof(uint32_t)));
+        CUDA_ERROR(cudaMalloc((void**)&m_d_counters, 2 * sizeof(uint32_t)));
+        for (uint32_t i = 0; i < 2; ++i) {
+            CUDA_ERROR(cudaMalloc((void**)&m_d_bits[i],
+                                  m_num_words * sizeof(uint32_t)));
+            CUDA_ERROR(cudaMalloc((void**)&m_d_patches[i],
+                                  m_num_patches * sizeof(uint32_t)));
+            CUDA_ERROR(
+                cudaMemset(m_d_bits[i], 0, m_num_words * sizeof(uint32_t)));
+        }
+        CUDA_ERROR(cudaMemset(m_d_patch_flags, 0,
+                              num_flag_words * sizeof(uint32_t)));
+        CUDA_ERROR(cudaMemset(m_d_counters, 0, 2 * sizeof(uint32_t)));
+        CUDA_ERROR(cudaMemcpy(m_d_patch_offset, h_patch_distribution_v.data(),
+                              (m_num_patches + 1) * sizeof(uint32_t),
+                              cudaMemcpyHostToDevice));
+
+        detail::frontier_vertex_map<<<m_num_patches, 256>>>(
+            context, m_d_vertex_bit, m_d_vertex_patch);
+        CUDA_ERROR(cudaDeviceSynchronize());
+
+        m_current = 0;
+        m_num_active_patches = 0;
+        m_num_active_vertices = 0;
+    }
+
+    /**
+     * add()
+     */
+    void add(const std::vector<uint32_t>& h_vertices,
+             cudaStream_t                 stream = NULL)
+    {
+        // activate h_vertices for the next round i.e., they become active
+        // after the next call to advance()
+        if (h_vertices.empty()) {
+            return;
+        }
+        const uint32_t num = static_cast<uint32_t>(h_vertices.size());
+        uint32_t*      d_vertices(nullptr);
+        CUDA_ERROR(cudaMalloc((void**)&d_vertices, num * sizeof(uint32_t)));
+        CUDA_ERROR(cudaMemcpyAsync(d_vertices, h_vertices.data(),
+                                   num * sizeof(uint32_t),
+                                   cudaMemcpyHostToDevice, stream));
+        constexpr uint32_t blockThreads = 256;
+        detail::frontier_add<<<DIVIDE_UP(num, blockThreads), blockThreads, 0,
+                               stream>>>(*this, d_vertices, num);
+        CUDA_ERROR(cudaStreamSynchronize(stream));
+        GPU_FREE(d_vertices);
+    }
+
+    /**
+     * advance()
+     */
+    uint32_t advance(cudaStream_t stream = NULL)
+    {
+        // make the vertices activated since the last advance() the current
+        // frontier and start an empty next round. Returns the number of
+        // active patches in the new round. Synchronizes the stream
+        const uint32_t next = m_current ^ 1;
+
+        uint32_t counters[2];
+        CUDA_ERROR(cudaMemcpyAsync(counters, m_d_counters,
+                                   2 * sizeof(uint32_t),
+                                   cudaMemcpyDeviceToHost, stream));
+        CUDA_ERROR(cudaStreamSynchronize(stream));
+
+        // the current bitmap becomes the next round's so only the patches
+        // of the current round need clearing. The patch flags are only set
+        // for the patches of the new round
+        if (m_num_active_patches > 0) {
+            detail::frontier_clear<<<m_num_active_patches, 256, 0, stream>>>(
+                m_d_patches[m_current], m_num_active_patches,
+                m_d_patch_offset, m_d_bits[m_current], nullptr);
+        }
+        if (counters[0] > 0) {
+            detail::frontier_clear<<<counters[0], 256, 0, stream>>>(
+                m_d_patches[next], counters[0], m_d_patch_offset, nullptr,
+                m_d_patch_flags);
+        }
+        CUDA_ERROR(
+            cudaMemsetAsync(m_d_counters, 0, 2 * sizeof(uint32_t), stream));
+
+        m_current = next;
+        m_num_active_patches = counters[0];
+        m_num_active_vertices = counters[1];
+        return m_num_active_patches;
+    }
+
+    void release()
+    {
+        GPU_FREE(m_d_vertex_bit);
+        GPU_FREE(m_d_vertex_patch);
+        GPU_FREE(m_d_patch_offset);
+        GPU_FREE(m_d_patch_flags);
+        GPU_FREE(m_d_counters);
+        for (uint32_t i = 0; i < 2; ++i) {
+            GPU_FREE(m_d_bits[i]);
+            GPU_FREE(m_d_patches[i]);
+        }
+        m_num_vertices = m_num_patches = m_num_words = 0;
+        m_num_active_patches = m_num_active_vertices = 0;
+    }
+
+    double get_device_storage_mb() const
+    {
+        size_t bytes = (2 * size_t(m_num_vertices) + 2 * m_num_words +
+                        3 * size_t(m_num_patches) + 1 +
+                        DIVIDE_UP(m_num_patches, 32) + 2) *
+                       sizeof(uint32_t);
+        return double(bytes) / double(1024 * 1024);
+    }
+
+    /**
+     * is_active()
+     */
+    __device__ __forceinline__ bool is_active(const uint32_t v) const
+    {
+        // true if v is in the current round's frontier
+        const uint32_t bit = m_d_vertex_bit[v];
+        return (m_d_bits[m_current][bit >> 5] >> (bit & 31)) & 1u;
+    }
+
+    /**
+     * activate()
+     */
+    __device__ __forceinline__ bool activate(const uint32_t v) const
+    {
+        // add v to the next round's frontier. The first activation of a
+        // patch appends it to the next round's patch list. Returns true if v
+        // was not already activated
+        const uint32_t bit = m_d_vertex_bit[v];
+        const uint32_t mask = 1u << (bit & 31);
+        if ((::atomicOr(m_d_bits[m_current ^ 1] + (bit >> 5), mask) & mask) !=
+            0) {
+            return false;
+        }
+        ::atomicAdd(m_d_counters + 1, 1u);
+
+        const uint32_t p = m_d_vertex_patch[v];
+        const uint32_t p_mask = 1u << (p & 31);
+        if ((::atomicOr(m_d_patch_flags + (p >> 5), p_mask) & p_mask) == 0) {
+            m_d_patches[m_current ^ 1][::atomicAdd(m_d_counters, 1u)] = p;
+        }
+        return true;
+    }
+
+    //********************** Getter
+    __host__ __device__ __forceinline__ uint32_t get_num_active_patches() const
+    {
+        // number of patches in the current round
+        return m_num_active_patches;
+    }
+    __host__ __device__ __forceinline__ uint32_t get_num_active_vertices() const
+    {
+        // number of vertices in the current round
+        return m_num_active_vertices;
+    }
+    __host__ __device__ __forceinline__ uint32_t* get_active_patches() const
+    {
+        // device list of the patches in the current round
+        return m_d_patches[m_current];
+    }
+    //**************************************************************************
+
+   private:
+    uint32_t m_num_vertices, m_num_patches, m_num_words;
+    uint32_t m_num_active_patches, m_num_active_vertices;
+
+    // index (0 or 1) of the current round's bitmap and patch list. The other
+    // one collects the next round
+    uint32_t m_current;
+
+    // per vertex: its bit in the bitmaps and its owner patch
+    uint32_t *m_d_vertex_bit, *m_d_vertex_patch;
+
+    // the first bit of every patch (num_patches + 1 entries)
+    uint32_t* m_d_patch_offset;
+
+    // bitmaps over the vertices and compacted lists of the active patches
+    uint32_t* m_d_bits[2];
+    uint32_t* m_d_patches[2];
+
+    // bitmap over the patches already in the next round's list
+    uint32_t* m_d_patch_flags;
+
+    // number of patches and vertices activated for the next round
+    uint32_t* m_d_counters;
+};
+
+namespace detail {
+__global__ static void frontier_add(const Frontier  frontier,
+                                    const uint32_t* d_vertices,
+                                    const uint32_t  num_vertices)
+{
+    const uint32_t i = blockDim.x * blockIdx.x + threadIdx.x;
+    if (i < num_vertices) {
+        frontier.activate(d_vertices[i]);
+    }
+}
+}  // namespace detail
+}  // namespace RXMESH
@@ -0,0 +1,236 @@
+#pragma once
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+#include "rxmesh/util/macros.h"
+
+// The AVX2/AVX-512 paths are compiled per function (target attribute) and
+// picked at runtime so the rest of the build keeps the default codegen
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define RXMESH_HOST_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace RXMESH {
+
+namespace detail {
+// number of interleaved sub-histograms used while counting so that
+// consecutive entries with the same column do not serialize on the same
+// counter
+constexpr uint32_t host_num_sub_hist = 4;
+
+#if defined(RXMESH_HOST_X86_SIMD)
+inline bool host_has_avx2()
+{
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+}
+
+inline bool host_has_avx512bw()
+{
+    static const bool has = __builtin_cpu_supports("avx512f") &&
+                            __builtin_cpu_supports("avx512bw");
+    return has;
+}
+#endif
+
+/**
+ * host_merge_hist_scalar()
+ */
+inline void host_merge_hist_scalar(const uint32_t num_cols,
+                                   uint16_t*      hist,
+                                   const uint32_t first = 0)
+{
+    // hist holds host_num_sub_hist sub-histograms of num_cols counters each
+    // (padded to a multiple of 32). Sum columns [first, stride) of them into
+    // the first one
+    const uint32_t stride = DIVIDE_UP(num_cols, 32) * 32;
+    for (uint32_t c = first; c < stride; ++c) {
+        for (uint32_t h = 1; h < host_num_sub_hist; ++h) {
+            hist[c] += hist[h * stride + c];
+        }
+    }
+}
+
+#if defined(RXMESH_HOST_X86_SIMD)
+/**
+ * host_merge_hist_avx512()
+ */
+__attribute__((target("avx512f,avx512bw")))
+inline void host_merge_hist_avx512(const uint32_t num_cols, uint16_t* hist)
+{
+    const uint32_t stride = DIVIDE_UP(num_cols, 32) * 32;
+    uint32_t       c = 0;
+    for (; c + 32 <= stride; c += 32) {
+        __m512i sum = _mm512_loadu_si512((const void*)(hist + c));
+        for (uint32_t h = 1; h < host_num_sub_hist; ++h) {
+            sum = _mm512_add_epi16(
+                sum, _mm512_loadu_si512((const void*)(hist + h * stride + c)));
+        }
+        _mm512_storeu_si512((void*)(hist + c), sum);
+    }
+    host_merge_hist_scalar(num_cols, hist, c);
+}
+
+/**
+ * host_merge_hist_avx2()
+ */
+__attribute__((target("avx2")))
+inline void host_merge_hist_avx2(const uint32_t num_cols, uint16_t* hist)
+{
+    const uint32_t stride = DIVIDE_UP(num_cols, 32) * 32;
+    uint32_t       c = 0;
+    for (; c + 16 <= stride; c += 16) {
+        __m256i sum = _mm256_loadu_si256((const __m256i*)(hist + c));
+        for (uint32_t h = 1; h < host_num_sub_hist; ++h) {
+            sum = _mm256_add_epi16(
+                sum,
+                _mm256_loadu_si256((const __m256i*)(hist + h * stride + c)));
+        }
+        _mm256_storeu_si256((__m256i*)(hist + c), sum);
+    }
+    host_merge_hist_scalar(num_cols, hist, c);
+}
+#endif
+
+/**
+ * host_merge_hist()
+ */
+inline void host_merge_hist(const uint32_t num_cols, uint16_t* hist)
+{
+    // the widest path the host CPU supports
+#if defined(RXMESH_HOST_X86_SIMD)
+    if (host_has_avx512bw()) {
+        host_merge_hist_avx512(num_cols, hist);
+        return;
+    }
+    if (host_has_avx2()) {
+        host_merge_hist_avx2(num_cols, hist);
+        return;
+    }
+#endif
+    host_merge_hist_scalar(num_cols, hist);
+}
+
+/**
+ * host_exclusive_sum_scalar()
+ */
+inline void host_exclusive_sum_scalar(const uint32_t  num,
+                                      const uint16_t* in,
+                                      uint16_t*       out,
+                                      const uint32_t  first = 0,
+                                      uint16_t        carry = 0)
+{
+    // out[i] = carry + sum(in[first:i]) for i in [first, num]. in and out
+    // may alias
+    for (uint32_t i = first; i < num; ++i) {
+        const uint16_t x = in[i];
+        out[i] = carry;
+        carry += x;
+    }
+    out[num] = carry;
+}
+
+#if defined(RXMESH_HOST_X86_SIMD)
+/**
+ * host_exclusive_sum_avx2()
+ */
+__attribute__((target("avx2")))
+inline void host_exclusive_sum_avx2(const uint32_t  num,
+                                    const uint16_t* in,
+                                    uint16_t*       out)
+{
+    uint16_t carry = 0;
+    uint32_t i = 0;
+    for (; i + 16 <= num; i += 16) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(in + i));
+        // inclusive scan within every 128-bit lane
+        __m256i s = _mm256_add_epi16(x, _mm256_slli_si256(x, 2));
+        s = _mm256_add_epi16(s, _mm256_slli_si256(s, 4));
+        s = _mm256_add_epi16(s, _mm256_slli_si256(s, 8));
+        // carry the low lane total into the high lane
+        const uint16_t low_total =
+            uint16_t(_mm_extract_epi16(_mm256_castsi256_si128(s), 7));
+        s = _mm256_add_epi16(
+            s, _mm256_set_m128i(_mm_set1_epi16(short(low_total)),
+                                _mm_setzero_si128()));
+        s = _mm256_add_epi16(s, _mm256_set1_epi16(short(carry)));
+        const uint16_t next_carry = uint16_t(_mm256_extract_epi16(s, 15));
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_sub_epi16(s, x));
+        carry = next_carry;
+    }
+    host_exclusive_sum_scalar(num, in, out, i, carry);
+}
+#endif
+
+/**
+ * host_exclusive_sum()
+ */
+inline void host_exclusive_sum(const uint32_t  num,
+                               const uint16_t* in,
+                               uint16_t*       out)
+{
+    // out[i] = sum(in[0:i]) for i in [0, num]. in and out may alias
+#if defined(RXMESH_HOST_X86_SIMD)
+    if (host_has_avx2()) {
+        host_exclusive_sum_avx2(num, in, out);
+        return;
+    }
+#endif
+    host_exclusive_sum_scalar(num, in, out);
+}
+}  // namespace detail
+
+/**
+ * host_mat_transpose()
+ */
+template <uint32_t rowOffset>
+inline void host_mat_transpose(const uint32_t         num_rows,
+                               const uint32_t         num_cols,
+                               const uint16_t*        mat,
+                               uint16_t*              offset,
+                               uint16_t*              output,
+                               std::vector<uint16_t>& scratch,
+                               const int              shift = 0)
+{
+    // Host counterpart of block_mat_transpose(). mat is a num_rows x
+    // rowOffset incidence matrix of local indices (e.g., EV or FE of a patch)
+    // where every entry is shifted left by shift. On return, the rows
+    // incident to column c are output[offset[c]:offset[c+1]] in increasing
+    // order. offset should have num_cols + 1 entries and output
+    // num_rows * rowOffset. scratch is reused between calls to avoid
+    // allocation and should stay small enough to remain in cache for
+    // patch-sized inputs
+
+    // 1) count into interleaved sub-histograms
+    const uint32_t stride = DIVIDE_UP(num_cols, 32) * 32;
+    scratch.assign(detail::host_num_sub_hist * stride, 0);
+    uint16_t*      hist = scratch.data();
+    const uint32_t nnz = num_rows * rowOffset;
+    uint32_t       i = 0;
+    for (; i + detail::host_num_sub_hist <= nnz;
+         i += detail::host_num_sub_hist) {
+        for (uint32_t h = 0; h < detail::host_num_sub_hist; ++h) {
+            hist[h * stride + (mat[i + h] >> shift)]++;
+        }
+    }
+    for (; i < nnz; ++i) {
+        hist[mat[i] >> shift]++;
+    }
+    detail::host_merge_hist(num_cols, hist);
+
+    // 2) prefix sum into the offsets
+    detail::host_exclusive_sum(num_cols, hist, offset);
+
+    // 3) stable scatter of the row indices. The first sub-histogram is reused
+    // as the per-column write cursor
+    std::copy(offset, offset + num_cols, hist);
+    i = 0;
+    for (uint32_t r = 0; r < num_rows; ++r) {
+        for (uint32_t j = 0; j < rowOffset; ++j, ++i) {
+            output[hist[mat[i] >> shift]++] = static_cast<uint16_t>(r);
+        }
+    }
+}
+}  // namespace RXMESH
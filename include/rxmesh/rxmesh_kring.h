@@ -0,0 +1,432 @@
+#pragma once
+#include <stdint.h>
+#include <algorithm>
+#include "rxmesh/util/log.h"
+#include "rxmesh/util/macros.h"
+
+namespace RXMESH {
+
+/**
+ * KRingArena
+ * Device scratch storage for variable-size vertex neighbourhoods (k-rings or
+ * radius balls) gathered by kring_gather(). Storage is split into chunks of
+ * chunk_size entries. Every patch owns a contiguous slice of chunks that is
+ * used by the vertices it owns so that the neighbourhoods of a patch stay
+ * close in memory. Once a patch's slice is used up, chunks are spilled into a
+ * shared overflow pool. If the overflow pool is used up as well, the arena is
+ * flagged as overflown, the extra entries are dropped, and the caller is
+ * expected to grow() the arena and re-launch. The arena is usually kept
+ * across queries (see RXMeshStatic::query_kring()) so grown chunks are
+ * reused. grow() reallocates the chunks, so copies taken before it must
+ * not be used after it. release() frees the chunks and the per-element done
+ * bits
+ */
+class KRingArena
+{
+   public:
+    static constexpr uint32_t chunk_size = 8;
+
+    KRingArena()
+        : m_num_patches(0), m_chunks_per_patch(0), m_num_overflow_chunks(0),
+          m_max_owned(0), m_d_vertex(nullptr), m_d_patch(nullptr),
+          m_d_meta(nullptr), m_d_next(nullptr), m_d_counters(nullptr),
+          m_d_done(nullptr)
+    {
+    }
+
+    void init(const uint32_t num_patches,
+              const uint32_t max_owned_vertices,
+              const uint32_t expected_ring_size = 16)
+    {
+        // expected_ring_size is only a hint for the per-patch slice. Larger
+        // rings spill into the overflow pool
+        const uint32_t chunks_per_patch =
+            max_owned_vertices * DIVIDE_UP(expected_ring_size, chunk_size);
+        allocate(num_patches, chunks_per_patch,
+                 std::max(num_patches * max_owned_vertices, 1u));
+
+        GPU_FREE(m_d_done);
+        m_max_owned = max_owned_vertices;
+        CUDA_ERROR(cudaMalloc((void**)&m_d_done,
+                              get_num_done_words() * sizeof(uint32_t)));
+        reset_done();
+    }
+
+    /**
+     * grow()
+     */
+    void grow()
+    {
+        // double the overflow pool. Previous content is discarded
+        const uint32_t num_overflow_chunks = 2 * m_num_overflow_chunks;
+        allocate(m_num_patches, m_chunks_per_patch, num_overflow_chunks);
+    }
+
+    /**
+     * reset()
+     */
+    void reset(cudaStream_t stream = NULL)
+    {
+        // should be called before every kernel that gathers into the arena
+        CUDA_ERROR(cudaMemsetAsync(m_d_counters, 0,
+                                   (m_num_patches + 2) * sizeof(uint32_t),
+                                   stream));
+    }
+
+    /**
+     * reset_done()
+     */
+    void reset_done(cudaStream_t stream = NULL)
+    {
+        // clear the per-element done flags (see set_done()). Unlike reset(),
+        // this is called once per query and not before every re-launch
+        CUDA_ERROR(cudaMemsetAsync(
+            m_d_done, 0, get_num_done_words() * sizeof(uint32_t), stream));
+    }
+
+    /**
+     * is_overflown()
+     */
+    bool is_overflown(cudaStream_t stream = NULL) const
+    {
+        // true if a neighbourhood did not fit in the arena since the last
+        // reset(). Synchronizes the stream
+        uint32_t flag = 0;
+        CUDA_ERROR(cudaMemcpyAsync(&flag, m_d_counters + m_num_patches + 1,
+                                   sizeof(uint32_t), cudaMemcpyDeviceToHost,
+                                   stream));
+        CUDA_ERROR(cudaStreamSynchronize(stream));
+        return flag != 0;
+    }
+
+    void release()
+    {
+        release_chunks();
+        GPU_FREE(m_d_done);
+    }
+
+    double get_device_storage_mb() const
+    {
+        const size_t num_chunks = get_num_chunks();
+        size_t bytes = num_chunks * chunk_size * 3 * sizeof(uint32_t) +
+                       num_chunks * sizeof(uint32_t) +
+                       (m_num_patches + 2) * sizeof(uint32_t) +
+                       get_num_done_words() * sizeof(uint32_t);
+        return double(bytes) / double(1024 * 1024);
+    }
+
+    /**
+     * alloc_chunk()
+     */
+    __device__ __forceinline__ uint32_t alloc_chunk(
+        const uint32_t patch_id) const
+    {
+        // returns a chunk from the patch slice, or the overflow pool if the
+        // slice is used up, or INVALID32 if both are used up
+        uint32_t c = ::atomicAdd(m_d_counters + patch_id, 1u);
+        if (c < m_chunks_per_patch) {
+            return patch_id * m_chunks_per_patch + c;
+        }
+        c = ::atomicAdd(m_d_counters + m_num_patches, 1u);
+        if (c < m_num_overflow_chunks) {
+            return m_num_patches * m_chunks_per_patch + c;
+        }
+        ::atomicOr(m_d_counters + m_num_patches + 1, 1u);
+        return INVALID32;
+    }
+
+    /**
+     * is_done()
+     */
+    __device__ __forceinline__ bool is_done(const uint32_t patch_id,
+                                            const uint16_t local_id) const
+    {
+        // true if the element owned by patch_id with local_id was marked by
+        // set_done() since the last reset_done(). Used to skip elements that
+        // were already processed when a launch is repeated after grow()
+        const uint32_t id = patch_id * m_max_owned + local_id;
+        return (m_d_done[id / 32] >> (id % 32)) & 1u;
+    }
+
+    /**
+     * set_done()
+     */
+    __device__ __forceinline__ void set_done(const uint32_t patch_id,
+                                             const uint16_t local_id) const
+    {
+        const uint32_t id = patch_id * m_max_owned + local_id;
+        ::atomicOr(m_d_done + id / 32, 1u << (id % 32));
+    }
+
+    //********************** Getter
+    __host__ __device__ __forceinline__ uint32_t get_num_chunks() const
+    {
+        return m_num_patches * m_chunks_per_patch + m_num_overflow_chunks;
+    }
+    __host__ __device__ __forceinline__ uint32_t get_num_overflow_chunks() const
+    {
+        return m_num_overflow_chunks;
+    }
+    __host__ __device__ __forceinline__ uint32_t get_num_patches() const
+    {
+        return m_num_patches;
+    }
+    __host__ __device__ __forceinline__ uint32_t get_max_owned() const
+    {
+        return m_max_owned;
+    }
+    __host__ __device__ __forceinline__ uint32_t* get_vertex() const
+    {
+        return m_d_vertex;
+    }
+    __host__ __device__ __forceinline__ uint32_t* get_patch() const
+    {
+        return m_d_patch;
+    }
+    __host__ __device__ __forceinline__ uint32_t* get_meta() const
+    {
+        return m_d_meta;
+    }
+    __host__ __device__ __forceinline__ uint32_t* get_next() const
+    {
+        return m_d_next;
+    }
+    //**************************************************************************
+
+   private:
+    void allocate(const uint32_t num_patches,
+                  const uint32_t chunks_per_patch,
+                  const uint32_t num_overflow_chunks)
+    {
+        release_chunks();
+        m_num_patches = num_patches;
+        m_chunks_per_patch = chunks_per_patch;
+        m_num_overflow_chunks = num_overflow_chunks;
+
+        const size_t num_entries = size_t(get_num_chunks()) * chunk_size;
+        CUDA_ERROR(
+            cudaMalloc((void**)&m_d_vertex, num_entries * sizeof(uint32_t)));
+        CUDA_ERROR(
+            cudaMalloc((void**)&m_d_patch, num_entries * sizeof(uint32_t)));
+        CUDA_ERROR(
+            cudaMalloc((void**)&m_d_meta, num_entries * sizeof(uint32_t)));
+        CUDA_ERROR(cudaMalloc((void**)&m_d_next,
+                              size_t(get_num_chunks()) * sizeof(uint32_t)));
+        CUDA_ERROR(cudaMalloc((void**)&m_d_counters,
+                              (m_num_patches + 2) * sizeof(uint32_t)));
+        reset();
+    }
+
+    void release_chunks()
+    {
+        GPU_FREE(m_d_vertex);
+        GPU_FREE(m_d_patch);
+        GPU_FREE(m_d_meta);
+        GPU_FREE(m_d_next);
+        GPU_FREE(m_d_counters);
+    }
+
+    size_t get_num_done_words() const
+    {
+        return std::max<size_t>(
+            DIVIDE_UP(size_t(m_num_patches) * m_max_owned, 32), 1);
+    }
+
+    uint32_t m_num_patches, m_chunks_per_patch, m_num_overflow_chunks;
+    uint32_t m_max_owned;
+
+    // per entry: the vertex id, the patch that still needs to expand this
+    // vertex (INVALID32 if already expanded), and the ring level (high 16
+    // bits) along with the local index in that patch (low 16 bits)
+    uint32_t *m_d_vertex, *m_d_patch, *m_d_meta;
+
+    // per chunk: the next chunk in the same neighbourhood
+    uint32_t* m_d_next;
+
+    // num_patches counters for the used chunks in every patch slice followed
+    // by the used overflow chunks and the overflow flag
+    uint32_t* m_d_counters;
+
+    // one bit per owned element (patch_id * max_owned + local_id) that is
+    // kept across grow()
+    uint32_t* m_d_done;
+};
+
+/**
+ * KRing
+ * Per-thread handle to one vertex neighbourhood stored in a KRingArena as a
+ * list of chunks. The center vertex is always the first entry
+ */
+class KRing
+{
+   public:
+    __device__ KRing(const KRingArena& arena)
+        : m_arena(arena), m_center(INVALID32), m_home_patch(INVALID32),
+          m_size(0), m_head(INVALID32), m_tail(INVALID32),
+          m_center_local(INVALID16), m_overflown(false)
+    {
+    }
+
+    /**
+     * begin()
+     */
+    __device__ __inline__ void begin(const uint32_t center,
+                                     const uint32_t home_patch,
+                                     const uint16_t center_local)
+    {
+        m_center = center;
+        m_home_patch = home_patch;
+        m_center_local = center_local;
+        m_size = 0;
+        m_head = m_tail = INVALID32;
+        push(center, INVALID32, 0, INVALID16);
+    }
+
+    /**
+     * push()
+     */
+    __device__ __inline__ bool push(const uint32_t vertex,
+                                    const uint32_t patch,
+                                    const uint32_t level,
+                                    const uint16_t local)
+    {
+        const uint32_t slot = m_size % KRingArena::chunk_size;
+        if (slot == 0) {
+            const uint32_t chunk = m_arena.alloc_chunk(m_home_patch);
+            if (chunk == INVALID32) {
+                m_overflown = true;
+                return false;
+            }
+            m_arena.get_next()[chunk] = INVALID32;
+            if (m_tail == INVALID32) {
+                m_head = chunk;
+            } else {
+                m_arena.get_next()[m_tail] = chunk;
+            }
+            m_tail = chunk;
+        }
+        const uint32_t e = m_tail * KRingArena::chunk_size + slot;
+        m_arena.get_vertex()[e] = vertex;
+        m_arena.get_patch()[e] = patch;
+        set_meta(e, level, local);
+        ++m_size;
+        return true;
+    }
+
+    /**
+     * for_each_entry()
+     */
+    template <typename opT>
+    __device__ __inline__ void for_each_entry(opT op) const
+    {
+        // op(e) is called with the arena index of every entry in order.
+        // Entries pushed by op are visited as well
+        uint32_t chunk = m_head;
+        for (uint32_t i = 0; i < m_size; ++i) {
+            if (i > 0 && i % KRingArena::chunk_size == 0) {
+                chunk = m_arena.get_next()[chunk];
+            }
+            op(chunk * KRingArena::chunk_size + i % KRingArena::chunk_size);
+        }
+    }
+
+    /**
+     * for_each()
+     */
+    template <typename opT>
+    __device__ __inline__ void for_each(opT op) const
+    {
+        // op(id) for every element in the neighbourhood (including the
+        // center)
+        for_each_entry([&](uint32_t e) { op(m_arena.get_vertex()[e]); });
+    }
+
+    /**
+     * for_each_level()
+     */
+    template <typename opT>
+    __device__ __inline__ void for_each_level(opT op) const
+    {
+        // op(id, level) for every element in the neighbourhood where level
+        // is the number of hops from the center
+        for_each_entry(
+            [&](uint32_t e) { op(m_arena.get_vertex()[e], level(e)); });
+    }
+
+    /**
+     * find()
+     */
+    __device__ __inline__ uint32_t find(const uint32_t vertex) const
+    {
+        // the arena index of vertex or INVALID32 if it is not in the list
+        uint32_t chunk = m_head;
+        for (uint32_t i = 0; i < m_size; ++i) {
+            if (i > 0 && i % KRingArena::chunk_size == 0) {
+                chunk = m_arena.get_next()[chunk];
+            }
+            const uint32_t e =
+                chunk * KRingArena::chunk_size + i % KRingArena::chunk_size;
+            if (m_arena.get_vertex()[e] == vertex) {
+                return e;
+            }
+        }
+        return INVALID32;
+    }
+
+    //********************** Entry access
+    __device__ __forceinline__ uint32_t vertex(const uint32_t e) const
+    {
+        return m_arena.get_vertex()[e];
+    }
+    __device__ __forceinline__ uint32_t& patch(const uint32_t e) const
+    {
+        return m_arena.get_patch()[e];
+    }
+    __device__ __forceinline__ uint32_t level(const uint32_t e) const
+    {
+        return m_arena.get_meta()[e] >> 16;
+    }
+    __device__ __forceinline__ uint16_t local(const uint32_t e) const
+    {
+        return m_arena.get_meta()[e] & 0xFFFF;
+    }
+    __device__ __forceinline__ void set_meta(const uint32_t e,
+                                             const uint32_t level,
+                                             const uint16_t local) const
+    {
+        m_arena.get_meta()[e] = (min(level, 0xFFFFu) << 16) | local;
+    }
+    //**************************************************************************
+
+    __device__ __forceinline__ bool is_valid() const
+    {
+        return m_center != INVALID32;
+    }
+    __device__ __forceinline__ bool is_overflown() const
+    {
+        return m_overflown;
+    }
+    __device__ __forceinline__ uint32_t center() const
+    {
+        return m_center;
+    }
+    __device__ __forceinline__ uint32_t home_patch() const
+    {
+        return m_home_patch;
+    }
+    __device__ __forceinline__ uint16_t center_local() const
+    {
+        return m_center_local;
+    }
+    __device__ __forceinline__ uint32_t size() const
+    {
+        return m_size;
+    }
+
+   private:
+    const KRingArena& m_arena;
+    uint32_t          m_center, m_home_patch, m_size, m_head, m_tail;
+    uint16_t          m_center_local;
+    bool              m_overflown;
+};
+}  // namespace RXMESH
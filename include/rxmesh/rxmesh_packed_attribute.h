@@ -0,0 +1,622 @@
+#pragma once
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <cuda_fp16.h>
+#include "rxmesh/kernels/rxmesh_packed_attribute.cuh"
+#include "rxmesh/rxmesh_attribute.h"
+
+#if defined(__F16C__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace RXMESH {
+
+namespace detail {
+/**
+ * float_as_bits()
+ */
+__host__ __device__ __forceinline__ uint32_t float_as_bits(const float f)
+{
+#ifdef __CUDA_ARCH__
+    return __float_as_uint(f);
+#else
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(float));
+    return u;
+#endif
+}
+
+/**
+ * bits_as_float()
+ */
+__host__ __device__ __forceinline__ float bits_as_float(const uint32_t u)
+{
+#ifdef __CUDA_ARCH__
+    return __uint_as_float(u);
+#else
+    float f;
+    std::memcpy(&f, &u, sizeof(float));
+    return f;
+#endif
+}
+}  // namespace detail
+
+// Codecs for RXMeshPackedAttribute. A codec defines the storage type
+// (storageT) and how a float is encoded into it and decoded back given the
+// attribute's scale and offset (only used by the quantized codecs). Every
+// codec also provides host bulk conversions (encode_n/decode_n) over
+// contiguous arrays that use SIMD when available
+
+/**
+ * HalfCodec
+ * IEEE 754 binary16 with round-to-nearest-even
+ */
+struct HalfCodec
+{
+    using storageT = uint16_t;
+    static constexpr bool is_quantized = false;
+
+    __host__ __device__ __forceinline__ static storageT
+    encode(const float f, const float, const float)
+    {
+#ifdef __CUDA_ARCH__
+        return __half_as_ushort(__float2half_rn(f));
+#else
+        // branchy but exact (from F. Giesen's float_to_half_fast3_rtne)
+        uint32_t       u = detail::float_as_bits(f);
+        const uint32_t sign = u & 0x80000000u;
+        u ^= sign;
+        uint32_t h;
+        if (u >= (143u << 23)) {
+            // inf or NaN (NaN stays a quiet NaN)
+            h = (u > (255u << 23)) ? 0x7E00u : 0x7C00u;
+        } else if (u < (113u << 23)) {
+            // subnormal or zero: let the FPU do the rounding
+            const float denorm_magic = detail::bits_as_float(
+                ((127u - 15u) + (23u - 10u) + 1u) << 23);
+            h = detail::float_as_bits(detail::bits_as_float(u) +
+                                      denorm_magic) -
+                detail::float_as_bits(denorm_magic);
+        } else {
+            const uint32_t mant_odd = (u >> 13) & 1u;
+            u = u - (112u << 23) + 0xFFFu + mant_odd;
+            h = u >> 13;
+        }
+        return static_cast<storageT>(h | (sign >> 16));
+#endif
+    }
+
+    __host__ __device__ __forceinline__ static float
+    decode(const storageT h, const float, const float)
+    {
+#ifdef __CUDA_ARCH__
+        return __half2float(__ushort_as_half(h));
+#else
+        const uint32_t shifted_exp = 0x7C00u << 13;
+        uint32_t       u = (uint32_t(h) & 0x7FFFu) << 13;
+        const uint32_t exp = shifted_exp & u;
+        u += (127u - 15u) << 23;
+        if (exp == shifted_exp) {
+            // inf or NaN
+            u += (128u - 16u) << 23;
+        } else if (exp == 0) {
+            // zero or subnormal: renormalize
+            u += 1u << 23;
+            u = detail::float_as_bits(detail::bits_as_float(u) -
+                                      detail::bits_as_float(113u << 23));
+        }
+        return detail::bits_as_float(u | ((uint32_t(h) & 0x8000u) << 16));
+#endif
+    }
+
+    static void encode_n(const float* in,
+                         storageT*    out,
+                         const size_t n,
+                         const float  scale,
+                         const float  offset)
+    {
+        size_t i = 0;
+#if defined(__F16C__)
+        for (; i + 8 <= n; i += 8) {
+            const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i),
+                                              _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128((__m128i*)(out + i), h);
+        }
+#endif
+        for (; i < n; ++i) {
+            out[i] = encode(in[i], scale, offset);
+        }
+    }
+
+    static void decode_n(const storageT* in,
+                         float*          out,
+                         const size_t    n,
+                         const float     scale,
+                         const float     offset)
+    {
+        size_t i = 0;
+#if defined(__F16C__)
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_ps(
+                out + i,
+                _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i))));
+        }
+#endif
+        for (; i < n; ++i) {
+            out[i] = decode(in[i], scale, offset);
+        }
+    }
+};
+
+/**
+ * BFloat16Codec
+ * The upper 16 bits of a float (same range as float, 8-bit mantissa) with
+ * round-to-nearest-even
+ */
+struct BFloat16Codec
+{
+    using storageT = uint16_t;
+    static constexpr bool is_quantized = false;
+
+    __host__ __device__ __forceinline__ static storageT
+    encode(const float f, const float, const float)
+    {
+        const uint32_t u = detail::float_as_bits(f);
+        if ((u & 0x7FFFFFFFu) > 0x7F800000u) {
+            // keep NaN a (quiet) NaN
+            return static_cast<storageT>((u >> 16) | 0x40u);
+        }
+        return static_cast<storageT>((u + 0x7FFFu + ((u >> 16) & 1u)) >> 16);
+    }
+
+    __host__ __device__ __forceinline__ static float
+    decode(const storageT h, const float, const float)
+    {
+        return detail::bits_as_float(uint32_t(h) << 16);
+    }
+
+    static void encode_n(const float* in,
+                         storageT*    out,
+                         const size_t n,
+                         const float  scale,
+                         const float  offset)
+    {
+        size_t i = 0;
+#if defined(__AVX2__)
+        const __m256i abs_mask = _mm256_set1_epi32(0x7FFFFFFF);
+        const __m256i inf = _mm256_set1_epi32(0x7F800000);
+        const __m256i round = _mm256_set1_epi32(0x7FFF);
+        const __m256i one = _mm256_set1_epi32(1);
+        const __m256i quiet = _mm256_set1_epi32(0x400000);
+        for (; i + 8 <= n; i += 8) {
+            const __m256i u = _mm256_loadu_si256((const __m256i*)(in + i));
+            const __m256i lsb =
+                _mm256_and_si256(_mm256_srli_epi32(u, 16), one);
+            const __m256i rounded =
+                _mm256_add_epi32(u, _mm256_add_epi32(round, lsb));
+            const __m256i is_nan =
+                _mm256_cmpgt_epi32(_mm256_and_si256(u, abs_mask), inf);
+            const __m256i r = _mm256_srli_epi32(
+                _mm256_blendv_epi8(rounded, _mm256_or_si256(u, quiet), is_nan),
+                16);
+            // pack the 8 32-bit lanes into 8 16-bit values (packus works per
+            // 128-bit lane so the two lanes are gathered afterwards)
+            const __m256i packed = _mm256_permute4x64_epi64(
+                _mm256_packus_epi32(r, r), 0x08);
+            _mm_storeu_si128((__m128i*)(out + i),
+                             _mm256_castsi256_si128(packed));
+        }
+#endif
+        for (; i < n; ++i) {
+            out[i] = encode(in[i], scale, offset);
+        }
+    }
+
+    static void decode_n(const storageT* in,
+                         float*          out,
+                         const size_t    n,
+                         const float     scale,
+                         const float     offset)
+    {
+        size_t i = 0;
+#if defined(__AVX2__)
+        for (; i + 8 <= n; i += 8) {
+            const __m256i u = _mm256_slli_epi32(
+                _mm256_cvtepu16_epi32(
+                    _mm_loadu_si128((const __m128i*)(in + i))),
+                16);
+            _mm256_storeu_si256((__m256i*)(out + i), u);
+        }
+#endif
+        for (; i < n; ++i) {
+            out[i] = decode(in[i], scale, offset);
+        }
+    }
+};
+
+/**
+ * QuantizedCodec
+ * Signed fixed point where a value is stored as the integer q in
+ * [-qmax, qmax] and decoded as offset + scale * q. The scale and offset of
+ * an attribute are set from its range (see
+ * RXMeshPackedAttribute::set_range()) and values outside the range are
+ * clamped
+ */
+template <typename intT>
+struct QuantizedCodec
+{
+    using storageT = intT;
+    static constexpr bool  is_quantized = true;
+    static constexpr float qmax = float((1u << (8 * sizeof(intT) - 1)) - 1);
+
+    __host__ __device__ __forceinline__ static storageT
+    encode(const float f, const float scale, const float offset)
+    {
+        const float q = rintf((f - offset) * (1.0f / scale));
+        // NaN is stored as zero (the middle of the range) here and in
+        // encode_n()
+        if (isnan(q)) {
+            return 0;
+        }
+        return static_cast<storageT>(fminf(fmaxf(q, -qmax), qmax));
+    }
+
+    __host__ __device__ __forceinline__ static float
+    decode(const storageT q, const float scale, const float offset)
+    {
+        return offset + scale * float(q);
+    }
+
+    static void encode_n(const float* in,
+                         storageT*    out,
+                         const size_t n,
+                         const float  scale,
+                         const float  offset)
+    {
+        size_t i = 0;
+#if defined(__AVX2__)
+        const __m256 inv = _mm256_set1_ps(1.0f / scale);
+        const __m256 off = _mm256_set1_ps(offset);
+        const __m256 hi = _mm256_set1_ps(qmax);
+        const __m256 lo = _mm256_set1_ps(-qmax);
+        for (; i + 8 <= n; i += 8) {
+            __m256 q = _mm256_mul_ps(
+                _mm256_sub_ps(_mm256_loadu_ps(in + i), off), inv);
+            // zero the NaN lanes as encode() does. Otherwise, the result
+            // depends on the operand order of max_ps/min_ps and cvtps turns
+            // a NaN into INT_MIN
+            const __m256 is_num = _mm256_cmp_ps(q, q, _CMP_ORD_Q);
+            q = _mm256_min_ps(_mm256_max_ps(q, lo), hi);
+            q = _mm256_and_ps(q, is_num);
+            // cvtps rounds to nearest even (as rintf) in the default mode
+            const __m256i q32 = _mm256_cvtps_epi32(q);
+            const __m256i q16 = _mm256_permute4x64_epi64(
+                _mm256_packs_epi32(q32, q32), 0x08);
+            if (sizeof(intT) == 2) {
+                _mm_storeu_si128((__m128i*)(out + i),
+                                 _mm256_castsi256_si128(q16));
+            } else {
+                const __m128i q8 = _mm_packs_epi16(
+                    _mm256_castsi256_si128(q16), _mm256_castsi256_si128(q16));
+                _mm_storel_epi64((__m128i*)(out + i), q8);
+            }
+        }
+#endif
+        for (; i < n; ++i) {
+            out[i] = encode(in[i], scale, offset);
+        }
+    }
+
+    static void decode_n(const storageT* in,
+                         float*          out,
+                         const size_t    n,
+                         const float     scale,
+                         const float     offset)
+    {
+        size_t i = 0;
+#if defined(__AVX2__)
+        const __m256 s = _mm256_set1_ps(scale);
+        const __m256 off = _mm256_set1_ps(offset);
+        for (; i + 8 <= n; i += 8) {
+            __m256i q32;
+            if (sizeof(intT) == 2) {
+                q32 = _mm256_cvtepi16_epi32(
+                    _mm_loadu_si128((const __m128i*)(in + i)));
+            } else {
+                q32 = _mm256_cvtepi8_epi32(
+                    _mm_loadl_epi64((const __m128i*)(in + i)));
+            }
+            _mm256_storeu_ps(
+                out + i,
+                _mm256_add_ps(off, _mm256_mul_ps(s, _mm256_cvtepi32_ps(q32))));
+        }
+#endif
+        for (; i < n; ++i) {
+            out[i] = decode(in[i], scale, offset);
+        }
+    }
+};
+
+using Quantized16Codec = QuantizedCodec<int16_t>;
+using Quantized8Codec = QuantizedCodec<int8_t>;
+
+/**
+ * PackedRef
+ * Reference to one packed value that reads and writes floats
+ */
+template <class codecT>
+class PackedRef
+{
+   public:
+    using storageT = typename codecT::storageT;
+
+    __host__ __device__ __forceinline__ PackedRef(storageT&   value,
+                                                  const float scale,
+                                                  const float offset)
+        : m_value(value), m_scale(scale), m_offset(offset)
+    {
+    }
+
+    __host__ __device__ __forceinline__ operator float() const
+    {
+        return codecT::decode(m_value, m_scale, m_offset);
+    }
+
+    __host__ __device__ __forceinline__ PackedRef& operator=(const float f)
+    {
+        m_value = codecT::encode(f, m_scale, m_offset);
+        return *this;
+    }
+
+    __host__ __device__ __forceinline__ PackedRef& operator=(
+        const PackedRef& other)
+    {
+        return *this = float(other);
+    }
+
+    __host__ __device__ __forceinline__ PackedRef& operator+=(const float f)
+    {
+        return *this = float(*this) + f;
+    }
+
+    __host__ __device__ __forceinline__ PackedRef& operator-=(const float f)
+    {
+        return *this = float(*this) - f;
+    }
+
+    __host__ __device__ __forceinline__ PackedRef& operator*=(const float f)
+    {
+        return *this = float(*this) * f;
+    }
+
+   private:
+    storageT&   m_value;
+    const float m_scale, m_offset;
+};
+
+template <class codecT>
+class RXMeshPackedAttribute
+    : public RXMeshAttribute<typename codecT::storageT>
+{
+    // An attribute stored in a reduced-precision format given by codecT
+    // (HalfCodec, BFloat16Codec, Quantized16Codec, or Quantized8Codec) while
+    // it is read and written as float i.e., operator() returns a float (or
+    // a PackedRef that converts on assignment) so kernels compute in fp32 and
+    // only the storage (and thus the memory traffic) is reduced. Storage
+    // management (init, move, copy, change_layout, permute, ...) is inherited
+    // and works on the packed values. Arithmetic (axpy, reduce, norm2, dot)
+    // should be done on a float attribute (see decode()/encode())
+
+   public:
+    using storageT = typename codecT::storageT;
+    using baseT = RXMeshAttribute<storageT>;
+
+    RXMeshPackedAttribute() : baseT(), m_scale(1.f), m_offset(0.f)
+    {
+    }
+
+    RXMeshPackedAttribute(const char* const name)
+        : baseT(name), m_scale(1.f), m_offset(0.f)
+    {
+    }
+
+    void init(uint32_t  num_elements,
+              uint32_t  num_attributes_per_elements,
+              locationT target = DEVICE,
+              layoutT   layout = AoS)
+    {
+        // axpy and reduce are meaningless on the packed values so their
+        // buffers are not allocated
+        baseT::init(num_elements, num_attributes_per_elements, target, layout,
+                    false, false);
+    }
+
+    /**
+     * set_range()
+     */
+    void set_range(const float min_val, const float max_val)
+    {
+        // map [min_val, max_val] onto the quantized range. No effect for
+        // floating-point codecs
+        if (!codecT::is_quantized) {
+            return;
+        }
+        if (!(max_val >= min_val)) {
+            RXMESH_ERROR(
+                "RXMeshPackedAttribute::set_range() invalid range [{}, {}]",
+                min_val, max_val);
+            return;
+        }
+        m_offset = 0.5f * (max_val + min_val);
+        m_scale = 0.5f * (max_val - min_val) / codecT::qmax;
+        if (m_scale == 0.f) {
+            m_scale = 1.f;
+        }
+    }
+
+    /**
+     * set_range()
+     */
+    void set_range(const RXMeshAttribute<float>& source)
+    {
+        // fit the quantized range to all the values of source (on the host)
+        if (!codecT::is_quantized) {
+            return;
+        }
+        if (!source.is_host_allocated()) {
+            RXMESH_ERROR(
+                "RXMeshPackedAttribute::set_range() source should be "
+                "allocated on the host");
+            return;
+        }
+        float min_val = std::numeric_limits<float>::max();
+        float max_val = std::numeric_limits<float>::lowest();
+        for (uint32_t i = 0; i < source.get_num_mesh_elements(); ++i) {
+            for (uint32_t j = 0; j < source.get_num_attribute_per_element();
+                 ++j) {
+                min_val = std::min(min_val, source(i, j));
+                max_val = std::max(max_val, source(i, j));
+            }
+        }
+        set_range(min_val, max_val);
+    }
+
+    __host__ __device__ __forceinline__ float get_scale() const
+    {
+        return m_scale;
+    }
+
+    __host__ __device__ __forceinline__ float get_offset() const
+    {
+        return m_offset;
+    }
+
+    /**
+     * encode()
+     */
+    void encode(const RXMeshAttribute<float>& source, locationT location)
+    {
+        // (*this)(i, j) = source(i, j) on location (HOST, DEVICE, or both).
+        // For quantized codecs, the range should be set before
+        if (!check_size(source, location, "encode")) {
+            return;
+        }
+        if ((location & HOST) == HOST) {
+            if (source.get_layout() == this->m_layout) {
+                // same layout: convert the underlying arrays in bulk
+                codecT::encode_n(source.get_pointer(HOST), this->m_h_attr,
+                                 this->storage_size(this->m_num_mesh_elements),
+                                 m_scale, m_offset);
+            } else {
+                const int64_t num_elements = this->m_num_mesh_elements;
+#pragma omp parallel for schedule(static)
+                for (int64_t i = 0; i < num_elements; ++i) {
+                    for (uint32_t j = 0; j < this->m_num_attribute_per_element;
+                         ++j) {
+                        (*this)(uint32_t(i), j) = source(uint32_t(i), j);
+                    }
+                }
+            }
+        }
+        if ((location & DEVICE) == DEVICE) {
+            rxmesh_packed_attribute_encode<codecT>
+                <<<this->num_relayout_blocks(), this->m_block_size>>>(source,
+                                                                    *this);
+            CUDA_ERROR(cudaDeviceSynchronize());
+            CUDA_ERROR(cudaGetLastError());
+        }
+    }
+
+    /**
+     * decode()
+     */
+    void decode(RXMeshAttribute<float>& target, locationT location) const
+    {
+        // target(i, j) = (*this)(i, j) on location (HOST, DEVICE, or both)
+        if (!check_size(target, location, "decode")) {
+            return;
+        }
+        if ((location & HOST) == HOST) {
+            if (target.get_layout() == this->m_layout) {
+                codecT::decode_n(this->m_h_attr, target.get_pointer(HOST),
+                                 this->storage_size(this->m_num_mesh_elements),
+                                 m_scale, m_offset);
+            } else {
+                const int64_t num_elements = this->m_num_mesh_elements;
+#pragma omp parallel for schedule(static)
+                for (int64_t i = 0; i < num_elements; ++i) {
+                    for (uint32_t j = 0; j < this->m_num_attribute_per_element;
+                         ++j) {
+                        target(uint32_t(i), j) = (*this)(uint32_t(i), j);
+                    }
+                }
+            }
+        }
+        if ((location & DEVICE) == DEVICE) {
+            rxmesh_packed_attribute_decode<codecT>
+                <<<this->num_relayout_blocks(), this->m_block_size>>>(*this,
+                                                                    target);
+            CUDA_ERROR(cudaDeviceSynchronize());
+            CUDA_ERROR(cudaGetLastError());
+        }
+    }
+
+    //********************** Operators
+    __host__ __device__ __forceinline__ PackedRef<codecT> operator()(
+        uint32_t idx,
+        uint32_t attr)
+    {
+        return PackedRef<codecT>(baseT::operator()(idx, attr), m_scale,
+                                 m_offset);
+    }
+
+    __host__ __device__ __forceinline__ PackedRef<codecT> operator()(
+        uint32_t idx)
+    {
+        return PackedRef<codecT>(baseT::operator()(idx), m_scale, m_offset);
+    }
+
+    __host__ __device__ __forceinline__ float operator()(uint32_t idx,
+                                                         uint32_t attr) const
+    {
+        return codecT::decode(baseT::operator()(idx, attr), m_scale, m_offset);
+    }
+
+    __host__ __device__ __forceinline__ float operator()(uint32_t idx) const
+    {
+        return codecT::decode(baseT::operator()(idx), m_scale, m_offset);
+    }
+    //*********************************************************************
+
+   private:
+    bool check_size(const RXMeshAttribute<float>& other,
+                    const locationT               location,
+                    const char*                   func) const
+    {
+        if (other.get_num_mesh_elements() != this->m_num_mesh_elements ||
+            other.get_num_attribute_per_element() !=
+                this->m_num_attribute_per_element) {
+            RXMESH_ERROR(
+                "RXMeshPackedAttribute::{}() the float attribute has a "
+                "different size",
+                func);
+            return false;
+        }
+        if ((other.get_allocated() & location) != location ||
+            (this->m_allocated & location) != location) {
+            RXMESH_ERROR(
+                "RXMeshPackedAttribute::{}() attributes are not allocated on "
+                "{}",
+                func, location_to_string(location));
+            return false;
+        }
+        return true;
+    }
+
+    // value = m_offset + m_scale * stored value (quantized codecs only)
+    float m_scale, m_offset;
+};
+}  // namespace RXMESH
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+#include <assert.h>
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+#include "rxmesh/util/log.h"
+#include "rxmesh/util/macros.h"
+
+namespace RXMESH {
+
+/**
+ * PatchSet
+ * Subset of the patches stored both as a bitmap (to test membership in a
+ * kernel) and as a compacted list (to launch one block per patch with
+ * RXMeshStatic::get_patch_set_context()). Used as the active set of
+ * incremental updates e.g., the patches with dirty elements plus their
+ * neighbours (see RXMeshStatic::get_dirty_patches() and
+ * RXMeshStatic::expand_patches()). The device storage is sized by init()
+ * for all the patches and set() overwrites it in place, so one set can be
+ * refilled every frame without reallocating. release() frees the bitmap
+ * and the list
+ */
+class PatchSet
+{
+   public:
+    PatchSet()
+        : m_num_patches(0), m_num_words(0), m_num_active_patches(0),
+          m_d_bitmap(nullptr), m_d_patches(nullptr)
+    {
+    }
+
+    void init(const uint32_t num_patches)
+    {
+        release();
+        m_num_patches = num_patches;
+        m_num_words = std::max(DIVIDE_UP(m_num_patches, 32), 1u);
+        CUDA_ERROR(cudaMalloc((void**)&m_d_bitmap,
+                              m_num_words * sizeof(uint32_t)));
+        CUDA_ERROR(cudaMalloc((void**)&m_d_patches,
+                              std::max(m_num_patches, 1u) * sizeof(uint32_t)));
+        CUDA_ERROR(
+            cudaMemset(m_d_bitmap, 0, m_num_words * sizeof(uint32_t)));
+        m_num_active_patches = 0;
+    }
+
+    /**
+     * set()
+     */
+    void set(const std::vector<uint32_t>& h_patches,
+             cudaStream_t                 stream = NULL)
+    {
+        // make h_patches (with no duplicates) the content of the set. Only
+        // the bitmap (num_patches / 32 words) and the list are copied so the
+        // cost does not depend on the mesh size
+        if (h_patches.size() > m_num_patches) {
+            RXMESH_ERROR(
+                "PatchSet::set() {} patches do not fit in a set of {} patches",
+                h_patches.size(), m_num_patches);
+            return;
+        }
+        std::vector<uint32_t> h_bitmap(m_num_words, 0);
+        for (const uint32_t p : h_patches) {
+            assert(p < m_num_patches);
+            h_bitmap[p >> 5] |= 1u << (p & 31);
+        }
+        m_num_active_patches = static_cast<uint32_t>(h_patches.size());
+        CUDA_ERROR(cudaMemcpyAsync(m_d_bitmap, h_bitmap.data(),
+                                   m_num_words * sizeof(uint32_t),
+                                   cudaMemcpyHostToDevice, stream));
+        if (m_num_active_patches > 0) {
+            CUDA_ERROR(cudaMemcpyAsync(
+                m_d_patches, h_patches.data(),
+                m_num_active_patches * sizeof(uint32_t),
+                cudaMemcpyHostToDevice, stream));
+        }
+        CUDA_ERROR(cudaStreamSynchronize(stream));
+    }
+
+    void release()
+    {
+        GPU_FREE(m_d_bitmap);
+        GPU_FREE(m_d_patches);
+        m_num_patches = m_num_words = m_num_active_patches = 0;
+    }
+
+    /**
+     * contains()
+     */
+    __device__ __forceinline__ bool contains(const uint32_t p) const
+    {
+        return (m_d_bitmap[p >> 5] >> (p & 31)) & 1u;
+    }
+
+    //********************** Getter
+    __host__ __device__ __forceinline__ uint32_t get_num_active_patches() const
+    {
+        // number of patches in the set
+        return m_num_active_patches;
+    }
+    __host__ __device__ __forceinline__ uint32_t* get_active_patches() const
+    {
+        // device list of the patches in the set
+        return m_d_patches;
+    }
+    //**************************************************************************
+
+   private:
+    uint32_t m_num_patches, m_num_words, m_num_active_patches;
+
+    // bitmap over all the patches and compacted list of the patches in the
+    // set
+    uint32_t *m_d_bitmap, *m_d_patches;
+};
+}  // namespace RXMESH
@@ -0,0 +1,223 @@
+#pragma once
+#include <omp.h>
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include "rxmesh/util/log.h"
+#include "rxmesh/util/macros.h"
+
+namespace RXMESH {
+
+/**
+ * PatchTask
+ * A range [begin, end) of the owned source elements of a patch along with
+ * its estimated cost
+ */
+struct PatchTask
+{
+    uint32_t patch_id, begin, end;
+    uint64_t cost;
+};
+
+/**
+ * PatchScheduler
+ * Work-stealing scheduler for host-side patch processing. Every worker owns a
+ * deque of tasks that is seeded up-front by assigning the tasks, from the
+ * most to the least expensive, to the worker with the least estimated load.
+ * A worker pops tasks from the front of its own deque (so it starts with its
+ * most expensive tasks) and, once its deque is empty, steals from the back of
+ * another worker's deque where the cheapest tasks are, which evens out the
+ * tail of the run. Patches that cost much more than the average are split into
+ * sub-ranges of their owned elements so a single heavy patch does not hold
+ * back the whole run. Workers are OpenMP threads
+ */
+class PatchScheduler
+{
+   public:
+    PatchScheduler(const uint32_t num_workers = 0)
+        : m_num_workers(num_workers == 0 ?
+                            static_cast<uint32_t>(omp_get_max_threads()) :
+                            num_workers),
+          m_num_steals(0)
+    {
+    }
+
+    /**
+     * build()
+     */
+    void build(const std::vector<uint64_t>& patch_cost,
+               const std::vector<uint32_t>& patch_size,
+               const uint32_t               tasks_per_worker = 4)
+    {
+        // patch_cost is the estimated cost of every patch and patch_size is
+        // the number of its owned source elements. Patches that cost more
+        // than 1/tasks_per_worker of a worker's share of the total cost are
+        // split into sub-ranges of about that cost. tasks_per_worker = 0
+        // disables splitting
+        if (patch_cost.size() != patch_size.size()) {
+            RXMESH_ERROR(
+                "PatchScheduler::build() patch_cost and patch_size should "
+                "have the same size");
+            return;
+        }
+        m_tasks.clear();
+
+        const uint64_t total_cost =
+            std::accumulate(patch_cost.begin(), patch_cost.end(), uint64_t(0));
+        const uint64_t max_task_cost =
+            (tasks_per_worker == 0) ?
+                std::numeric_limits<uint64_t>::max() :
+                std::max(uint64_t(1),
+                         total_cost / (uint64_t(m_num_workers) *
+                                       uint64_t(tasks_per_worker)));
+
+        for (uint32_t p = 0; p < patch_cost.size(); ++p) {
+            if (patch_size[p] == 0) {
+                continue;
+            }
+            const uint32_t num_splits = static_cast<uint32_t>(std::min(
+                uint64_t(patch_size[p]),
+                std::max(uint64_t(1),
+                         DIVIDE_UP(patch_cost[p], max_task_cost))));
+            const uint32_t range = DIVIDE_UP(patch_size[p], num_splits);
+            for (uint32_t b = 0; b < patch_size[p]; b += range) {
+                const uint32_t e = std::min(b + range, patch_size[p]);
+                m_tasks.push_back(
+                    {p, b, e, patch_cost[p] * (e - b) / patch_size[p]});
+            }
+        }
+
+        // LPT assignment: the most expensive task first, to the least loaded
+        // worker
+        std::sort(m_tasks.begin(), m_tasks.end(),
+                  [](const PatchTask& a, const PatchTask& b) {
+                      return a.cost > b.cost;
+                  });
+        m_task_worker.resize(m_tasks.size());
+        std::vector<uint64_t> load(m_num_workers, 0);
+        for (uint32_t t = 0; t < m_tasks.size(); ++t) {
+            const uint32_t w = static_cast<uint32_t>(
+                std::min_element(load.begin(), load.end()) - load.begin());
+            m_task_worker[t] = w;
+            load[w] += m_tasks[t].cost;
+        }
+    }
+
+    /**
+     * run()
+     */
+    template <typename opT>
+    void run(opT op)
+    {
+        // op(worker_id, patch_id, begin, end) is called once for every task
+        // and may be called concurrently from different workers
+        std::vector<Worker> workers(m_num_workers);
+        for (uint32_t t = 0; t < m_tasks.size(); ++t) {
+            // tasks are sorted by decreasing cost so the front of every deque
+            // is its most expensive task and the back is its cheapest
+            workers[m_task_worker[t]].tasks.push_back(t);
+        }
+
+        const uint32_t num_tasks = static_cast<uint32_t>(m_tasks.size());
+
+        std::atomic<uint32_t> num_taken(0), num_steals(0);
+
+#pragma omp parallel num_threads(m_num_workers)
+        {
+            // OpenMP may give us fewer threads than requested in which case
+            // the deques of the missing workers are only stolen from
+            const uint32_t w = static_cast<uint32_t>(omp_get_thread_num());
+            uint32_t       victim = w;
+            while (num_taken.load(std::memory_order_relaxed) < num_tasks) {
+                uint32_t t = workers[w].pop_front();
+                bool     stolen = false;
+                for (uint32_t i = 1; t == INVALID32 && i < m_num_workers;
+                     ++i) {
+                    victim = (victim + 1) % m_num_workers;
+                    if (victim != w) {
+                        t = workers[victim].pop_back();
+                        stolen = true;
+                    }
+                }
+                if (t == INVALID32) {
+                    // everything is taken but some tasks are still running
+                    std::this_thread::yield();
+                    continue;
+                }
+                if (stolen) {
+                    num_steals.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    victim = w;
+                }
+                num_taken.fetch_add(1, std::memory_order_relaxed);
+                const PatchTask& task = m_tasks[t];
+                op(w, task.patch_id, task.begin, task.end);
+            }
+        }
+        m_num_steals = num_steals.load();
+    }
+
+    //********************** Getter
+    uint32_t get_num_workers() const
+    {
+        return m_num_workers;
+    }
+    uint32_t get_num_tasks() const
+    {
+        return static_cast<uint32_t>(m_tasks.size());
+    }
+    const std::vector<PatchTask>& get_tasks() const
+    {
+        return m_tasks;
+    }
+    uint32_t get_num_steals() const
+    {
+        // number of tasks executed by a worker other than the one they were
+        // assigned to in the last run()
+        return m_num_steals;
+    }
+    //**************************************************************************
+
+   private:
+    // padded to a cache line so that workers do not contend on each other's
+    // lock
+    struct alignas(64) Worker
+    {
+        std::mutex           lock;
+        std::deque<uint32_t> tasks;
+
+        uint32_t pop_back()
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (tasks.empty()) {
+                return INVALID32;
+            }
+            const uint32_t t = tasks.back();
+            tasks.pop_back();
+            return t;
+        }
+
+        uint32_t pop_front()
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (tasks.empty()) {
+                return INVALID32;
+            }
+            const uint32_t t = tasks.front();
+            tasks.pop_front();
+            return t;
+        }
+    };
+
+    uint32_t               m_num_workers;
+    std::vector<PatchTask> m_tasks;
+    std::vector<uint32_t>  m_task_worker;
+    uint32_t               m_num_steals;
+};
+}  // namespace RXMESH
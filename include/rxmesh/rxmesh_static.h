@@ -1,10 +1,31 @@
 ﻿#pragma once
 #include <assert.h>
 #include <cuda_profiler_api.h>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include "cub/device/device_radix_sort.cuh"
+#include "cub/device/device_scan.cuh"
 #include "rxmesh/kernels/prototype.cuh"
+#include "rxmesh/kernels/rxmesh_kring.cuh"
+#include "rxmesh/kernels/rxmesh_laplacian.cuh"
+#include "rxmesh/kernels/rxmesh_toplesets.cuh"
 #include "rxmesh/launch_box.h"
 #include "rxmesh/rxmesh.h"
+#include "rxmesh/rxmesh_attribute.h"
+#include "rxmesh/rxmesh_csr.h"
+#include "rxmesh/rxmesh_frontier.h"
+#include "rxmesh/rxmesh_host_queries.h"
+#include "rxmesh/rxmesh_kring.h"
+#include "rxmesh/rxmesh_patch_set.h"
+#include "rxmesh/rxmesh_scheduler.h"
 #include "rxmesh/rxmesh_util.h"
+#include "rxmesh/util/import_ply.h"
 #include "rxmesh/util/log.h"
 #include "rxmesh/util/timer.h"
 
@@ -26,8 +47,22 @@ class RXMeshStatic : public RXMesh<patchSize>
                  const bool                          quite = true)
         : RXMesh<patchSize>(fv, coordinates, sort, quite){};
 
+    RXMeshStatic(std::vector<std::vector<uint32_t>>&& fv,
+                 std::vector<std::vector<coordT>>&    coordinates,
+                 const bool                           sort = false,
+                 const bool                           quite = true)
+        : RXMesh<patchSize>(std::move(fv), coordinates, sort, quite){};
+
     virtual ~RXMeshStatic()
     {
+        GPU_FREE(m_d_color_patches);
+        for (uint32_t k = 0; k < 3; ++k) {
+            GPU_FREE(m_d_patch_order[k]);
+            GPU_FREE(m_d_patch_order_ltog[k]);
+            GPU_FREE(m_d_patch_order_patch[k]);
+        }
+        // registered attributes give their buffers back to the arena
+        m_attributes.clear();
     }
 
     //*********************************************************************
@@ -58,7 +93,1555 @@ class RXMeshStatic : public RXMesh<patchSize>
             op, launch_box, is_higher_query, oriented);
     }
 
+    /**
+     * query_kring()
+     */
+    template <Op op, uint32_t blockThreads = 256, typename computeT>
+    float query_kring(const uint32_t k,
+                      KRingArena&    arena,
+                      computeT       compute_op,
+                      cudaStream_t   stream = NULL)
+    {
+        // Launch the k-ring query (Op::VV or Op::FF) where compute_op is a
+        // __device__ lambda that is called as compute_op(id, ring) for every
+        // vertex/face with its k-ring (see query_kring() in rxmesh_kring.cuh).
+        // arena is initialized if it was not (or was for fewer owned
+        // elements) and grown (and the query is re-launched) if it overflows.
+        // compute_op is only called again for the elements whose ring did not
+        // fit in the previous launch. Every owned element of a patch is
+        // handled by one thread and so blockThreads should be at least the
+        // max number of owned elements per patch. Returns the time in ms
+        static_assert(op == Op::VV || op == Op::FF,
+                      "RXMeshStatic::query_kring() only supports Op::VV and "
+                      "Op::FF");
+
+        const uint32_t max_owned = (op == Op::VV) ?
+                                       this->m_max_owned_vertices_per_patch :
+                                       this->m_max_owned_faces_per_patch;
+        const uint32_t max_elements = (op == Op::VV) ?
+                                          this->m_max_vertices_per_patch :
+                                          this->m_max_faces_per_patch;
+        if (max_owned > blockThreads) {
+            RXMESH_ERROR(
+                "RXMeshStatic::query_kring() blockThreads ({}) should be at "
+                "least the max number of owned elements per patch ({})",
+                blockThreads, max_owned);
+            exit(EXIT_FAILURE);
+        }
+
+        if (arena.get_num_chunks() == 0 ||
+            arena.get_num_patches() != this->m_num_patches ||
+            arena.get_max_owned() < max_owned) {
+            arena.init(this->m_num_patches, max_owned);
+        }
+
+        LaunchBox<blockThreads> launch_box;
+        prepare_launch_box(op, launch_box, true);
+
+        // per-thread visited bitsets over the patch elements go after the
+        // query shared memory if they fit. Otherwise, duplicates are found by
+        // searching the ring
+        auto kernel = detail::query_kring_kernel<op, blockThreads, computeT>;
+        cudaFuncAttributes func_attr;
+        CUDA_ERROR(cudaFuncGetAttributes(&func_attr, kernel));
+        int device_id;
+        CUDA_ERROR(cudaGetDevice(&device_id));
+        cudaDeviceProp devProp;
+        CUDA_ERROR(cudaGetDeviceProperties(&devProp, device_id));
+
+        const uint32_t visited_offset =
+            DIVIDE_UP(launch_box.smem_bytes_dyn, 4) * 4;
+        uint32_t visited_words = DIVIDE_UP(max_elements, 32);
+        uint32_t smem_bytes =
+            visited_offset + blockThreads * visited_words * sizeof(uint32_t);
+        if (smem_bytes + func_attr.sharedSizeBytes >
+            devProp.sharedMemPerBlock) {
+            visited_words = 0;
+            smem_bytes = launch_box.smem_bytes_dyn;
+            if (!this->m_quite) {
+                RXMESH_TRACE(
+                    "RXMeshStatic::query_kring() visited bitsets do not fit in "
+                    "shared memory. Falling back to searching the rings");
+            }
+        }
+
+        GPUTimer timer(stream);
+        timer.start();
+        arena.reset_done(stream);
+        while (true) {
+            arena.reset(stream);
+            kernel<<<launch_box.blocks, blockThreads, smem_bytes, stream>>>(
+                this->m_rxmesh_context, arena, k, compute_op, visited_offset,
+                visited_words);
+            if (!arena.is_overflown(stream)) {
+                break;
+            }
+            arena.grow();
+            if (!this->m_quite) {
+                RXMESH_TRACE(
+                    "RXMeshStatic::query_kring() arena overflow pool grown to "
+                    "{} chunks",
+                    arena.get_num_overflow_chunks());
+            }
+        }
+        timer.stop();
+        CUDA_ERROR(cudaGetLastError());
+
+        if (!this->m_quite) {
+            RXMESH_TRACE(
+                "RXMeshStatic::query_kring() {} with k= {} took {} (ms) "
+                "using {} (mb) of scratch",
+                op_to_string(op), k, timer.elapsed_millis(),
+                arena.get_device_storage_mb());
+        }
+        return timer.elapsed_millis();
+    }
+
+    /**
+     * assemble_laplacian()
+     */
+    template <typename T, uint32_t blockThreads = 256>
+    float assemble_laplacian(const RXMeshAttribute<T>& coords,
+                             CSRMatrix<T>&             laplacian,
+                             RXMeshAttribute<T>*       mass = nullptr,
+                             const bool use_uniform_laplace = false,
+                             const bool clamp_negative_weights = false)
+    {
+        // Assemble the uniform or cotan Laplacian into laplacian (on the
+        // device) where L(p,r) = -w(p,r) for every edge p-r and
+        // L(p,p) = sum_r w(p,r). Rows are ordered by patch so the rows of a
+        // patch's owned vertices are consecutive. If mass is not null, it
+        // should be allocated on the device with one attribute per vertex and
+        // will hold the (lumped) Voronoi area of each vertex (or one for the
+        // uniform Laplacian). coords should be on the device. Returns the
+        // assembly time in ms
+
+        const uint32_t num_vertices = this->m_num_vertices;
+        const uint32_t num_patches = this->m_num_patches;
+
+        if (mass != nullptr && (!mass->is_device_allocated() ||
+                                mass->get_num_mesh_elements() < num_vertices)) {
+            RXMESH_ERROR(
+                "RXMeshStatic::assemble_laplacian() mass should be allocated "
+                "on the device with one attribute per vertex");
+        }
+
+        GPUTimer timer;
+        timer.start();
+
+        laplacian.init(num_vertices, 0);
+
+        detail::csr_row_map<<<num_patches, blockThreads>>>(
+            this->m_rxmesh_context, laplacian.get_row_vertex(),
+            laplacian.get_vertex_row());
+
+        // count the entries per row then scan them into row_ptr
+        uint32_t* d_row_nnz(nullptr);
+        CUDA_ERROR(cudaMalloc((void**)&d_row_nnz,
+                              (num_vertices + 1) * sizeof(uint32_t)));
+        CUDA_ERROR(cudaMemset(d_row_nnz, 0,
+                              (num_vertices + 1) * sizeof(uint32_t)));
+
+        LaunchBox<blockThreads> unoriented_box;
+        prepare_launch_box(Op::VV, unoriented_box, false, false);
+        detail::laplacian_row_nnz<blockThreads>
+            <<<unoriented_box.blocks, blockThreads,
+               unoriented_box.smem_bytes_dyn>>>(
+                this->m_rxmesh_context, laplacian.get_vertex_row(), d_row_nnz);
+
+        void*  d_cub_temp_storage(nullptr);
+        size_t cub_temp_storage_bytes = 0;
+        ::cub::DeviceScan::ExclusiveSum(d_cub_temp_storage,
+                                        cub_temp_storage_bytes, d_row_nnz,
+                                        laplacian.get_row_ptr(),
+                                        num_vertices + 1);
+        CUDA_ERROR(
+            cudaMalloc((void**)&d_cub_temp_storage, cub_temp_storage_bytes));
+        ::cub::DeviceScan::ExclusiveSum(d_cub_temp_storage,
+                                        cub_temp_storage_bytes, d_row_nnz,
+                                        laplacian.get_row_ptr(),
+                                        num_vertices + 1);
+
+        uint32_t nnz = 0;
+        CUDA_ERROR(cudaMemcpy(&nnz, laplacian.get_row_ptr() + num_vertices,
+                              sizeof(uint32_t), cudaMemcpyDeviceToHost));
+        laplacian.alloc_entries(nnz);
+
+        // fill in the entries
+        LaunchBox<blockThreads> launch_box;
+        prepare_launch_box(Op::VV, launch_box, false, !use_uniform_laplace);
+        RXMeshAttribute<T> no_mass;
+        detail::laplacian_fill<T, blockThreads>
+            <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+                this->m_rxmesh_context, coords, laplacian,
+                (mass == nullptr) ? no_mass : *mass, use_uniform_laplace,
+                clamp_negative_weights);
+
+        timer.stop();
+        CUDA_ERROR(cudaDeviceSynchronize());
+        CUDA_ERROR(cudaGetLastError());
+
+        GPU_FREE(d_row_nnz);
+        GPU_FREE(d_cub_temp_storage);
+
+        if (!this->m_quite) {
+            RXMESH_TRACE(
+                "RXMeshStatic::assemble_laplacian() {} rows and {} non-zeros "
+                "({} mb) took {} (ms)",
+                num_vertices, nnz, laplacian.get_device_storage_mb(),
+                timer.elapsed_millis());
+        }
+        return timer.elapsed_millis();
+    }
+
+    /**
+     * compute_toplesets()
+     */
+    template <uint32_t blockThreads = 256>
+    float compute_toplesets(const std::vector<uint32_t>& h_seeds,
+                            RXMeshAttribute<uint32_t>&   toplesets,
+                            std::vector<uint32_t>&       sorted_index,
+                            std::vector<uint32_t>&       limits)
+    {
+        // Compute the toplesets (BFS level) of all vertices from h_seeds
+        // using a level-synchronous BFS on the device where each level is one
+        // launch over the patches that own frontier vertices. toplesets should
+        // be allocated on the device with one attribute per vertex and the
+        // result is also copied to the host if it is allocated there.
+        // sorted_index lists the vertices sorted by level and, within a level,
+        // by their owner patch. Vertices of level l are
+        // sorted_index[limits[l]:limits[l+1]]. Returns the time in ms
+
+        const uint32_t num_vertices = this->m_num_vertices;
+        const uint32_t num_patches = this->m_num_patches;
+
+        if (!toplesets.is_device_allocated() ||
+            toplesets.get_num_mesh_elements() < num_vertices ||
+            toplesets.get_num_attribute_per_element() != 1) {
+            RXMESH_ERROR(
+                "RXMeshStatic::compute_toplesets() toplesets should be "
+                "allocated on the device with one attribute per vertex");
+            return 0;
+        }
+
+        limits.clear();
+        sorted_index.clear();
+        if (h_seeds.empty()) {
+            return 0;
+        }
+
+        GPUTimer timer;
+        timer.start();
+
+        uint32_t* d_toplesets = toplesets.get_pointer(DEVICE);
+        toplesets.reset(INVALID32, DEVICE);
+
+        uint32_t* d_seeds(nullptr);
+        CUDA_ERROR(
+            cudaMalloc((void**)&d_seeds, h_seeds.size() * sizeof(uint32_t)));
+        CUDA_ERROR(cudaMemcpy(d_seeds, h_seeds.data(),
+                              h_seeds.size() * sizeof(uint32_t),
+                              cudaMemcpyHostToDevice));
+
+        Frontier frontier;
+        init_frontier(frontier);
+
+        const uint32_t num_seeds = static_cast<uint32_t>(h_seeds.size());
+        detail::toplesets_init_seeds<<<DIVIDE_UP(num_seeds, blockThreads),
+                                       blockThreads>>>(d_seeds, num_seeds,
+                                                       d_toplesets, frontier);
+
+        LaunchBox<blockThreads> launch_box;
+        prepare_launch_box(Op::VV, launch_box);
+
+        limits.push_back(0);
+        uint32_t level = 0;
+        uint32_t num_launched_patches = 0;
+        while (frontier.advance() > 0) {
+            limits.push_back(limits.back() +
+                             frontier.get_num_active_vertices());
+            num_launched_patches += frontier.get_num_active_patches();
+
+            detail::toplesets_expand<blockThreads>
+                <<<frontier.get_num_active_patches(), blockThreads,
+                   launch_box.smem_bytes_dyn>>>(
+                    get_frontier_context(frontier), d_toplesets, level,
+                    frontier);
+            level++;
+        }
+
+        if (limits.back() != num_vertices) {
+            RXMESH_ERROR(
+                "RXMeshStatic::compute_toplesets() could only reach {} out of "
+                "{} vertices maybe because the input has multiple connected "
+                "components. Unreached vertices are left with INVALID32 level",
+                limits.back(), num_vertices);
+        }
+
+        // sort the vertices by (level, patch)
+        uint64_t *d_keys_in(nullptr), *d_keys_out(nullptr);
+        uint32_t *d_values_in(nullptr), *d_values_out(nullptr);
+        CUDA_ERROR(
+            cudaMalloc((void**)&d_keys_in, num_vertices * sizeof(uint64_t)));
+        CUDA_ERROR(
+            cudaMalloc((void**)&d_keys_out, num_vertices * sizeof(uint64_t)));
+        CUDA_ERROR(
+            cudaMalloc((void**)&d_values_in, num_vertices * sizeof(uint32_t)));
+        CUDA_ERROR(cudaMalloc((void**)&d_values_out,
+                              num_vertices * sizeof(uint32_t)));
+
+        detail::toplesets_sort_keys<<<DIVIDE_UP(num_vertices, blockThreads),
+                                      blockThreads>>>(
+            this->m_rxmesh_context, d_toplesets, d_keys_in, d_values_in);
+
+        void*  d_cub_temp_storage(nullptr);
+        size_t cub_temp_storage_bytes = 0;
+        ::cub::DeviceRadixSort::SortPairs(
+            d_cub_temp_storage, cub_temp_storage_bytes, d_keys_in, d_keys_out,
+            d_values_in, d_values_out, num_vertices);
+        CUDA_ERROR(
+            cudaMalloc((void**)&d_cub_temp_storage, cub_temp_storage_bytes));
+        ::cub::DeviceRadixSort::SortPairs(
+            d_cub_temp_storage, cub_temp_storage_bytes, d_keys_in, d_keys_out,
+            d_values_in, d_values_out, num_vertices);
+
+        sorted_index.resize(limits.back());
+        CUDA_ERROR(cudaMemcpy(sorted_index.data(), d_values_out,
+                              limits.back() * sizeof(uint32_t),
+                              cudaMemcpyDeviceToHost));
+
+        if (toplesets.is_host_allocated()) {
+            toplesets.move(DEVICE, HOST);
+        }
+
+        timer.stop();
+
+        GPU_FREE(d_seeds);
+        frontier.release();
+        GPU_FREE(d_keys_in);
+        GPU_FREE(d_keys_out);
+        GPU_FREE(d_values_in);
+        GPU_FREE(d_values_out);
+        GPU_FREE(d_cub_temp_storage);
+
+        if (!this->m_quite) {
+            RXMESH_TRACE(
+                "RXMeshStatic::compute_toplesets() {} levels took {} (ms) "
+                "launching {} patches in total out of {} for a dense "
+                "dispatch",
+                level, timer.elapsed_millis(), num_launched_patches,
+                level * num_patches);
+        }
+        return timer.elapsed_millis();
+    }
+
+    /**
+     * compute_patch_adjacency()
+     */
+    void compute_patch_adjacency()
+    {
+        // Two patches are adjacent if they share a vertex in their local
+        // space (owned or ribbon). Since every patch contains the one ring of
+        // its owned vertices, two vertices that share a face are owned by the
+        // same patch or by adjacent ones. Any shared edge or face implies
+        // shared vertices so this covers the neighbour patches (those sharing
+        // an edge on the patch boundary) and patches that only touch at a
+        // vertex
+        const uint32_t num_patches = this->m_num_patches;
+        const uint32_t num_vertices = this->m_num_vertices;
+
+        // for each vertex, the patches that contain it in compressed format
+        std::vector<uint32_t> v_offset(num_vertices + 1, 0);
+        for (uint32_t p = 0; p < num_patches; ++p) {
+            for (uint32_t i = 0; i < this->m_h_ad_size_ltog_v[p].y; ++i) {
+                v_offset[(this->m_h_patches_ltog_v[p][i] >> 1) + 1]++;
+            }
+        }
+        std::partial_sum(v_offset.begin(), v_offset.end(), v_offset.begin());
+
+        std::vector<uint32_t> v_patches(v_offset.back());
+        {
+            std::vector<uint32_t> cursor(v_offset.begin(), v_offset.end() - 1);
+            for (uint32_t p = 0; p < num_patches; ++p) {
+                for (uint32_t i = 0; i < this->m_h_ad_size_ltog_v[p].y; ++i) {
+                    uint32_t v = this->m_h_patches_ltog_v[p][i] >> 1;
+                    v_patches[cursor[v]++] = p;
+                }
+            }
+        }
+
+        // seen[q] == p means that q is already a neighbour of p
+        std::vector<uint32_t> seen(num_patches, INVALID32);
+        m_h_patch_adjacency_offset.assign(num_patches + 1, 0);
+        m_h_patch_adjacency.clear();
+        for (uint32_t p = 0; p < num_patches; ++p) {
+            for (uint32_t i = 0; i < this->m_h_ad_size_ltog_v[p].y; ++i) {
+                uint32_t v = this->m_h_patches_ltog_v[p][i] >> 1;
+                for (uint32_t j = v_offset[v]; j < v_offset[v + 1]; ++j) {
+                    uint32_t q = v_patches[j];
+                    if (q != p && seen[q] != p) {
+                        seen[q] = p;
+                        m_h_patch_adjacency.push_back(q);
+                    }
+                }
+            }
+            m_h_patch_adjacency_offset[p + 1] =
+                static_cast<uint32_t>(m_h_patch_adjacency.size());
+        }
+        m_is_patch_adjacency_computed = true;
+    }
+
+    /**
+     * get_patch_neighbours()
+     */
+    std::vector<uint32_t> get_patch_neighbours(const uint32_t patch_id)
+    {
+        // the patches adjacent to patch_id (see compute_patch_adjacency())
+        if (!m_is_patch_adjacency_computed) {
+            compute_patch_adjacency();
+        }
+        assert(patch_id < this->m_num_patches);
+        return std::vector<uint32_t>(
+            m_h_patch_adjacency.begin() + m_h_patch_adjacency_offset[patch_id],
+            m_h_patch_adjacency.begin() +
+                m_h_patch_adjacency_offset[patch_id + 1]);
+    }
+
+    /**
+     * compute_patch_coloring()
+     */
+    void compute_patch_coloring()
+    {
+        // Color the patches such that two patches of the same color do not
+        // share any mesh element in their local space (owned or ribbon) i.e.,
+        // adjacent patches (see compute_patch_adjacency()) get different
+        // colors. We use greedy coloring where larger patches are colored
+        // first
+        if (!m_is_patch_adjacency_computed) {
+            compute_patch_adjacency();
+        }
+        const uint32_t num_patches = this->m_num_patches;
+
+        std::vector<uint32_t> order(num_patches);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [this](const uint32_t a, const uint32_t b) {
+                             return this->m_h_ad_size_ltog_v[a].y >
+                                    this->m_h_ad_size_ltog_v[b].y;
+                         });
+
+        // forbidden[c] == p means that color c is taken by a patch that
+        // conflicts with p
+        std::vector<uint32_t> forbidden(num_patches, INVALID32);
+        m_h_patch_color.clear();
+        m_h_patch_color.resize(num_patches, INVALID32);
+        m_num_patch_colors = 0;
+
+        for (const uint32_t p : order) {
+            for (uint32_t j = m_h_patch_adjacency_offset[p];
+                 j < m_h_patch_adjacency_offset[p + 1]; ++j) {
+                uint32_t q = m_h_patch_adjacency[j];
+                if (m_h_patch_color[q] != INVALID32) {
+                    forbidden[m_h_patch_color[q]] = p;
+                }
+            }
+            uint32_t c = 0;
+            while (forbidden[c] == p) {
+                ++c;
+            }
+            m_h_patch_color[p] = c;
+            m_num_patch_colors = std::max(m_num_patch_colors, c + 1);
+        }
+
+        // group the patches by color
+        m_h_color_offset.clear();
+        m_h_color_offset.resize(m_num_patch_colors + 1, 0);
+        for (uint32_t p = 0; p < num_patches; ++p) {
+            m_h_color_offset[m_h_patch_color[p] + 1]++;
+        }
+        std::partial_sum(m_h_color_offset.begin(), m_h_color_offset.end(),
+                         m_h_color_offset.begin());
+        m_h_color_patches.resize(num_patches);
+        {
+            std::vector<uint32_t> cursor(m_h_color_offset.begin(),
+                                         m_h_color_offset.end() - 1);
+            for (uint32_t p = 0; p < num_patches; ++p) {
+                m_h_color_patches[cursor[m_h_patch_color[p]]++] = p;
+            }
+        }
+
+        GPU_FREE(m_d_color_patches);
+        CUDA_ERROR(cudaMalloc((void**)&m_d_color_patches,
+                              num_patches * sizeof(uint32_t)));
+        CUDA_ERROR(cudaMemcpy(m_d_color_patches, m_h_color_patches.data(),
+                              num_patches * sizeof(uint32_t),
+                              cudaMemcpyHostToDevice));
+
+        if (!this->m_quite) {
+            RXMESH_TRACE(
+                "RXMeshStatic::compute_patch_coloring() {} patches are "
+                "colored with {} colors",
+                num_patches, m_num_patch_colors);
+        }
+    }
+
+    uint32_t get_num_patch_colors() const
+    {
+        return m_num_patch_colors;
+    }
+
+    uint32_t get_patch_color(const uint32_t patch_id) const
+    {
+        assert(patch_id < m_h_patch_color.size());
+        return m_h_patch_color[patch_id];
+    }
+
+    uint32_t get_num_patches_in_color(const uint32_t color) const
+    {
+        assert(color < m_num_patch_colors);
+        return m_h_color_offset[color + 1] - m_h_color_offset[color];
+    }
+
+    /**
+     * get_color_context()
+     */
+    RXMeshContext get_color_context(const uint32_t color) const
+    {
+        // a copy of the context where the dispatcher only processes the
+        // patches of the given color. Launch it with
+        // get_num_patches_in_color(color) blocks
+        if (color >= m_num_patch_colors) {
+            RXMESH_ERROR(
+                "RXMeshStatic::get_color_context() invalid color {}. Number of "
+                "colors is {}. Make sure to call compute_patch_coloring() "
+                "first",
+                color, m_num_patch_colors);
+        }
+        RXMeshContext context = this->m_rxmesh_context;
+        context.set_dispatch_patches(get_num_patches_in_color(color),
+                                     m_d_color_patches +
+                                         m_h_color_offset[color]);
+        return context;
+    }
+
+    /**
+     * get_patch_cost()
+     */
+    void get_patch_cost(const Op               op,
+                        std::vector<uint64_t>& cost,
+                        std::vector<uint32_t>& num_src) const
+    {
+        // cost hint of running op on every patch: the incidence entries the
+        // query has to go through (edges and/or faces, including the ribbon)
+        // plus the owned source elements it is called on. num_src is the
+        // number of owned source elements of every patch
+        ELEMENT src, output;
+        io_elements(op, src, output);
+        const bool load_faces = (op == Op::VF || op == Op::EE ||
+                                 op == Op::EF || op == Op::FV ||
+                                 op == Op::FE || op == Op::FF);
+        const bool load_edges = (op == Op::VV || op == Op::VE ||
+                                 op == Op::VF || op == Op::EV || op == Op::FV);
+
+        cost.resize(this->m_num_patches);
+        num_src.resize(this->m_num_patches);
+        for (uint32_t p = 0; p < this->m_num_patches; ++p) {
+            const uint4& owned = this->m_h_owned_size[p];
+            num_src[p] = (src == ELEMENT::VERTEX) ?
+                             owned.z :
+                             ((src == ELEMENT::EDGE) ? owned.y : owned.x);
+            cost[p] = num_src[p];
+            if (load_edges) {
+                cost[p] += this->m_h_ad_size[p].y;
+            }
+            if (load_faces) {
+                cost[p] += this->m_h_ad_size[p].w;
+            }
+        }
+    }
+
+    /**
+     * for_each_patch_host()
+     */
+    template <typename computeT>
+    float for_each_patch_host(const Op       op,
+                              computeT       compute_op,
+                              const uint32_t num_workers = 0,
+                              const uint32_t tasks_per_worker = 4)
+    {
+        // Host dispatch over the patches using the work-stealing
+        // PatchScheduler with op's cost hints. compute_op is called as
+        // compute_op(worker_id, patch_id, begin, end) where [begin, end) is a
+        // range of the patch owned source elements (large patches are split
+        // into several ranges). Calls may run concurrently. num_workers = 0
+        // uses all OpenMP threads. Returns the time in ms
+        std::vector<uint64_t> cost;
+        std::vector<uint32_t> num_src;
+        get_patch_cost(op, cost, num_src);
+
+        PatchScheduler scheduler(num_workers);
+        scheduler.build(cost, num_src, tasks_per_worker);
+
+        CPUTimer timer;
+        timer.start();
+        scheduler.run(compute_op);
+        timer.stop();
+
+        if (!this->m_quite) {
+            RXMESH_TRACE(
+                "RXMeshStatic::for_each_patch_host() {} with {} workers ran {} "
+                "tasks ({} stolen) in {} (ms)",
+                op_to_string(op), scheduler.get_num_workers(),
+                scheduler.get_num_tasks(), scheduler.get_num_steals(),
+                timer.elapsed_millis());
+        }
+        return timer.elapsed_millis();
+    }
+
+    /**
+     * query_host()
+     */
+    template <Op op, typename computeT>
+    float query_host(computeT compute_op, const uint32_t num_workers = 0)
+    {
+        // Host version of the Op::VV, Op::VE, Op::VF and Op::EF queries
+        // where every patch's incidence is transposed with
+        // host_mat_transpose() and patches are dispatched with
+        // for_each_patch_host(). compute_op is called as
+        // compute_op(id, const uint32_t* output, uint32_t size) for every
+        // source element where output holds the global ids of its
+        // neighbours. Calls may run concurrently. Returns the time in ms
+        static_assert(op == Op::VV || op == Op::VE || op == Op::VF ||
+                          op == Op::EF,
+                      "RXMeshStatic::query_host() only supports Op::VV, "
+                      "Op::VE, Op::VF and Op::EF");
+
+        // per-worker transposed patch. A split patch is only transposed
+        // again if the worker has moved on to another patch in between
+        struct Scratch
+        {
+            uint32_t              patch_id = INVALID32;
+            std::vector<uint16_t> offset, value, fv, hist;
+            std::vector<uint32_t> output;
+        };
+        std::vector<Scratch> scratch(
+            num_workers == 0 ? static_cast<uint32_t>(omp_get_max_threads()) :
+                               num_workers);
+
+        auto compute_patch = [&](uint32_t worker, uint32_t p, uint32_t begin,
+                                 uint32_t end) {
+            Scratch&        s = scratch[worker];
+            const uint32_t  nv = this->m_h_ad_size_ltog_v[p].y;
+            const uint32_t  ne = this->m_h_ad_size_ltog_e[p].y;
+            const uint32_t  nf = this->m_h_ad_size_ltog_f[p].y;
+            const uint16_t* edges = this->m_h_patches_edges[p].data();
+            const uint16_t* faces = this->m_h_patches_faces[p].data();
+
+            if (s.patch_id != p) {
+                s.patch_id = p;
+                if (op == Op::VV || op == Op::VE) {
+                    s.offset.resize(nv + 1);
+                    s.value.resize(2 * ne);
+                    host_mat_transpose<2>(ne, nv, edges, s.offset.data(),
+                                          s.value.data(), s.hist);
+                } else if (op == Op::VF) {
+                    s.fv.resize(3 * nf);
+                    for (uint32_t i = 0; i < 3 * nf; ++i) {
+                        s.fv[i] = edges[2 * (faces[i] >> 1) + (faces[i] & 1)];
+                    }
+                    s.offset.resize(nv + 1);
+                    s.value.resize(3 * nf);
+                    host_mat_transpose<3>(nf, nv, s.fv.data(),
+                                          s.offset.data(), s.value.data(),
+                                          s.hist);
+                } else {
+                    s.offset.resize(ne + 1);
+                    s.value.resize(3 * nf);
+                    host_mat_transpose<3>(nf, ne, faces, s.offset.data(),
+                                          s.value.data(), s.hist, 1);
+                }
+            }
+
+            const std::vector<uint32_t>& src_ltog =
+                (op == Op::EF) ? this->m_h_patches_ltog_e[p] :
+                                 this->m_h_patches_ltog_v[p];
+            const std::vector<uint32_t>& output_ltog =
+                (op == Op::VV) ?
+                    this->m_h_patches_ltog_v[p] :
+                    ((op == Op::VE) ? this->m_h_patches_ltog_e[p] :
+                                      this->m_h_patches_ltog_f[p]);
+
+            for (uint32_t l = begin; l < end; ++l) {
+                s.output.clear();
+                for (uint32_t k = s.offset[l]; k < s.offset[l + 1]; ++k) {
+                    uint16_t o = s.value[k];
+                    if (op == Op::VV) {
+                        // the other end of the edge
+                        o = (edges[2 * o] == l) ? edges[2 * o + 1] :
+                                                  edges[2 * o];
+                    }
+                    s.output.push_back(output_ltog[o] >> 1);
+                }
+                compute_op(src_ltog[l] >> 1, s.output.data(),
+                           static_cast<uint32_t>(s.output.size()));
+            }
+        };
+
+        return for_each_patch_host(op, compute_patch, num_workers);
+    }
+
+    /**
+     * init_frontier()
+     */
+    void init_frontier(Frontier& frontier) const
+    {
+        // allocate an empty frontier over the mesh vertices
+        frontier.init(this->m_rxmesh_context, this->m_num_vertices,
+                      this->m_h_patch_distribution_v);
+    }
+
+    /**
+     * get_frontier_context()
+     */
+    RXMeshContext get_frontier_context(const Frontier& frontier) const
+    {
+        // a copy of the context where the dispatcher only processes the
+        // patches of the frontier's current round. Launch it with
+        // frontier.get_num_active_patches() blocks
+        RXMeshContext context = this->m_rxmesh_context;
+        context.set_dispatch_patches(frontier.get_num_active_patches(),
+                                     frontier.get_active_patches());
+        return context;
+    }
+
+    /**
+     * for_each_frontier_round()
+     */
+    template <typename launchT>
+    uint32_t for_each_frontier_round(Frontier&      frontier,
+                                     launchT        launch,
+                                     const uint32_t max_rounds = INVALID32)
+    {
+        // Host loop for front-propagation algorithms. Vertices added (or
+        // activated) before the call are the first round. Every round calls
+        // launch(const RXMeshContext& context, uint32_t num_blocks) with the
+        // frontier's context and one block per active patch. The kernel is
+        // expected to activate the next round's vertices. Stops once a round
+        // activates nothing or after max_rounds. Returns the number of rounds
+        uint32_t round = 0;
+        while (round < max_rounds && frontier.advance() > 0) {
+            launch(get_frontier_context(frontier),
+                   frontier.get_num_active_patches());
+            round++;
+        }
+        return round;
+    }
+
+    /**
+     * for_each_color()
+     */
+    template <typename launchT>
+    void for_each_color(launchT launch)
+    {
+        // Host dispatch that processes one color at a time where all patches
+        // of the same color are processed in parallel. launch is called with
+        // the color's context and the number of blocks i.e.,
+        // launch(const RXMeshContext& context, uint32_t num_blocks)
+        // and is expected to launch the kernel on the default stream so
+        // colors are processed in order. Since patches of the same color
+        // do not share any mesh element, different blocks never write to the
+        // same element and scatter operations need no global atomics
+        if (m_num_patch_colors == 0) {
+            compute_patch_coloring();
+        }
+        for (uint32_t c = 0; c < m_num_patch_colors; ++c) {
+            launch(get_color_context(c), get_num_patches_in_color(c));
+        }
+    }
+
+    /**
+     * enable_dirty_tracking()
+     */
+    template <typename T>
+    void enable_dirty_tracking(const ELEMENT ele, RXMeshAttribute<T>& attr)
+    {
+        // track the patches with modified elements of attr which is an
+        // attribute of ele (see RXMeshAttribute::mark_dirty())
+        if (attr.get_num_mesh_elements() != get_num_elements(ele)) {
+            RXMESH_ERROR(
+                "RXMeshStatic::enable_dirty_tracking() attribute {} does not "
+                "match the number of mesh elements",
+                attr.get_name());
+            return;
+        }
+        attr.enable_dirty_tracking(
+            this->m_num_patches,
+            (ele == ELEMENT::VERTEX) ?
+                this->m_d_vertex_patch :
+                ((ele == ELEMENT::EDGE) ? this->m_d_edge_patch :
+                                          this->m_d_face_patch));
+    }
+
+    /**
+     * expand_patches()
+     */
+    std::vector<uint32_t> expand_patches(const std::vector<uint32_t>& patches,
+                                         const uint32_t num_rings = 1)
+    {
+        // patches along with their adjacent patches up to num_rings away
+        // (see compute_patch_adjacency()) as a sorted list. The cost is
+        // proportional to the output and not to the number of patches
+        if (!m_is_patch_adjacency_computed) {
+            compute_patch_adjacency();
+        }
+        std::vector<uint32_t> result(patches.begin(), patches.end());
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+
+        // expand the last ring only
+        std::vector<uint32_t> last_ring = result;
+        for (uint32_t r = 0; r < num_rings && !last_ring.empty(); ++r) {
+            std::vector<uint32_t> ring;
+            for (const uint32_t p : last_ring) {
+                ring.insert(ring.end(),
+                            m_h_patch_adjacency.begin() +
+                                m_h_patch_adjacency_offset[p],
+                            m_h_patch_adjacency.begin() +
+                                m_h_patch_adjacency_offset[p + 1]);
+            }
+            std::sort(ring.begin(), ring.end());
+            ring.erase(std::unique(ring.begin(), ring.end()), ring.end());
+
+            last_ring.clear();
+            std::set_difference(ring.begin(), ring.end(), result.begin(),
+                                result.end(), std::back_inserter(last_ring));
+            std::vector<uint32_t> merged;
+            merged.reserve(result.size() + last_ring.size());
+            std::merge(result.begin(), result.end(), last_ring.begin(),
+                       last_ring.end(), std::back_inserter(merged));
+            result.swap(merged);
+        }
+        return result;
+    }
+
+    /**
+     * init_patch_set()
+     */
+    void init_patch_set(PatchSet& patch_set) const
+    {
+        // allocate an empty set over the mesh patches
+        patch_set.init(this->m_num_patches);
+    }
+
+    /**
+     * get_patch_set_context()
+     */
+    RXMeshContext get_patch_set_context(const PatchSet& patch_set) const
+    {
+        // a copy of the context where the dispatcher only processes the
+        // patches in patch_set. Launch it with
+        // patch_set.get_num_active_patches() blocks. Together with dirty
+        // tracking, this lets a kernel recompute only the patches affected
+        // by an edit e.g.,
+        //   auto dirty = rxmesh_static.expand_patches(
+        //       attr.get_dirty_patches(), 1);
+        //   patch_set.set(dirty);
+        //   kernel<<<patch_set.get_num_active_patches(), ...>>>(
+        //       rxmesh_static.get_patch_set_context(patch_set), ...);
+        RXMeshContext context = this->m_rxmesh_context;
+        context.set_dispatch_patches(patch_set.get_num_active_patches(),
+                                     patch_set.get_active_patches());
+        return context;
+    }
+
+    /**
+     * compute_patch_order()
+     */
+    void compute_patch_order()
+    {
+        // Number the mesh elements in patch order i.e., the owned elements of
+        // patch 0 (by local id), then those of patch 1, and so on such that
+        // the owned element local_id of patch p is at
+        // get_X_distribution()[p] + local_id. Elements that are not owned by
+        // any patch go last. Builds the maps used by to_patch_order(),
+        // to_global_order() and get_patch_order_context()
+        for (ELEMENT ele : {ELEMENT::VERTEX, ELEMENT::EDGE, ELEMENT::FACE}) {
+            const uint32_t k = static_cast<uint32_t>(ele);
+
+            const std::vector<std::vector<uint32_t>>& ltog =
+                (ele == ELEMENT::VERTEX) ?
+                    this->m_h_patches_ltog_v :
+                    ((ele == ELEMENT::EDGE) ? this->m_h_patches_ltog_e :
+                                              this->m_h_patches_ltog_f);
+            const std::vector<uint2>& ad_size_ltog =
+                (ele == ELEMENT::VERTEX) ?
+                    this->m_h_ad_size_ltog_v :
+                    ((ele == ELEMENT::EDGE) ? this->m_h_ad_size_ltog_e :
+                                              this->m_h_ad_size_ltog_f);
+            const std::vector<uint32_t>& distribution =
+                (ele == ELEMENT::VERTEX) ?
+                    this->m_h_patch_distribution_v :
+                    ((ele == ELEMENT::EDGE) ? this->m_h_patch_distribution_e :
+                                              this->m_h_patch_distribution_f);
+            const uint32_t num_elements =
+                (ele == ELEMENT::VERTEX) ?
+                    this->m_num_vertices :
+                    ((ele == ELEMENT::EDGE) ? this->m_num_edges :
+                                              this->m_num_faces);
+
+            // global id -> patch-ordered id and patch-ordered id -> patch.
+            // Owned elements come first in every patch so the owned local ids
+            // are [0, owned)
+            std::vector<uint32_t>& gtop = m_h_patch_order[k];
+            gtop.assign(num_elements, INVALID32);
+            std::vector<uint32_t> h_patch(num_elements, INVALID32);
+            for (uint32_t p = 0; p < this->m_num_patches; ++p) {
+                for (uint32_t l = 0; l < ltog[p].size(); ++l) {
+                    const uint32_t m = ltog[p][l];
+                    if (m == INVALID32 || (m & 1) == 0) {
+                        continue;
+                    }
+                    const uint32_t id = distribution[p] + l;
+                    assert(id < distribution[p + 1]);
+                    gtop[m >> 1] = id;
+                    h_patch[id] = p;
+                }
+            }
+            uint32_t next = distribution.back();
+            for (uint32_t g = 0; g < num_elements; ++g) {
+                if (gtop[g] == INVALID32) {
+                    gtop[g] = next++;
+                }
+            }
+
+            // the ltog maps with patch-ordered ids (same layout and owned bit)
+            std::vector<uint32_t> h_ltop(ad_size_ltog.back().x, INVALID32);
+            for (uint32_t p = 0; p < this->m_num_patches; ++p) {
+                for (uint32_t l = 0; l < ltog[p].size(); ++l) {
+                    const uint32_t m = ltog[p][l];
+                    if (m != INVALID32) {
+                        h_ltop[ad_size_ltog[p].x + l] =
+                            (gtop[m >> 1] << 1) | (m & 1);
+                    }
+                }
+            }
+
+            GPU_FREE(m_d_patch_order[k]);
+            GPU_FREE(m_d_patch_order_ltog[k]);
+            GPU_FREE(m_d_patch_order_patch[k]);
+            CUDA_ERROR(cudaMalloc((void**)&m_d_patch_order[k],
+                                  num_elements * sizeof(uint32_t)));
+            CUDA_ERROR(cudaMalloc((void**)&m_d_patch_order_ltog[k],
+                                  h_ltop.size() * sizeof(uint32_t)));
+            CUDA_ERROR(cudaMalloc((void**)&m_d_patch_order_patch[k],
+                                  num_elements * sizeof(uint32_t)));
+            CUDA_ERROR(cudaMemcpy(m_d_patch_order[k], gtop.data(),
+                                  num_elements * sizeof(uint32_t),
+                                  cudaMemcpyHostToDevice));
+            CUDA_ERROR(cudaMemcpy(m_d_patch_order_ltog[k], h_ltop.data(),
+                                  h_ltop.size() * sizeof(uint32_t),
+                                  cudaMemcpyHostToDevice));
+            CUDA_ERROR(cudaMemcpy(m_d_patch_order_patch[k], h_patch.data(),
+                                  num_elements * sizeof(uint32_t),
+                                  cudaMemcpyHostToDevice));
+        }
+        m_is_patch_order_computed = true;
+    }
+
+    /**
+     * get_patch_order()
+     */
+    const std::vector<uint32_t>& get_patch_order(const ELEMENT ele)
+    {
+        // map from global id to patch-ordered id of ele
+        if (!m_is_patch_order_computed) {
+            compute_patch_order();
+        }
+        return m_h_patch_order[static_cast<uint32_t>(ele)];
+    }
+
+    /**
+     * get_patch_order_context()
+     */
+    RXMeshContext get_patch_order_context()
+    {
+        // a copy of the context where the mesh elements are identified by
+        // their patch-ordered id instead of their global id. Kernels launched
+        // with it receive patch-ordered ids from the dispatcher and
+        // RXMeshIterator (with no extra indirection) and should use
+        // attributes stored in patch order (see to_patch_order()). An owned
+        // element can also be addressed directly by (patch, local id) with
+        // e.g., RXMeshContext::get_patch_ordered_vertex()
+        if (!m_is_patch_order_computed) {
+            compute_patch_order();
+        }
+        const uint32_t v = static_cast<uint32_t>(ELEMENT::VERTEX);
+        const uint32_t e = static_cast<uint32_t>(ELEMENT::EDGE);
+        const uint32_t f = static_cast<uint32_t>(ELEMENT::FACE);
+
+        RXMeshContext context = this->m_rxmesh_context;
+        context.set_mapping(m_d_patch_order_ltog[v], m_d_patch_order_ltog[e],
+                            m_d_patch_order_ltog[f], m_d_patch_order_patch[v],
+                            m_d_patch_order_patch[e], m_d_patch_order_patch[f]);
+        return context;
+    }
+
+    /**
+     * to_patch_order()
+     */
+    template <typename T>
+    void to_patch_order(const ELEMENT       ele,
+                        RXMeshAttribute<T>& global_ordered,
+                        RXMeshAttribute<T>& patch_ordered,
+                        const locationT     location = DEVICE)
+    {
+        // copy the attribute of ele from global order into patch order on
+        // the location (HOST, DEVICE, or both). Both attributes should have
+        // the same size and the same number of attributes per element but
+        // could have different layouts
+        if (!m_is_patch_order_computed) {
+            compute_patch_order();
+        }
+        const uint32_t k = static_cast<uint32_t>(ele);
+        if ((location & HOST) == HOST) {
+            patch_ordered.permute(global_ordered, m_h_patch_order[k].data(),
+                                  true, HOST);
+        }
+        if ((location & DEVICE) == DEVICE) {
+            patch_ordered.permute(global_ordered, m_d_patch_order[k], true,
+                                  DEVICE);
+        }
+    }
+
+    /**
+     * to_global_order()
+     */
+    template <typename T>
+    void to_global_order(const ELEMENT       ele,
+                         RXMeshAttribute<T>& patch_ordered,
+                         RXMeshAttribute<T>& global_ordered,
+                         const locationT     location = DEVICE)
+    {
+        // inverse of to_patch_order()
+        if (!m_is_patch_order_computed) {
+            compute_patch_order();
+        }
+        const uint32_t k = static_cast<uint32_t>(ele);
+        if ((location & HOST) == HOST) {
+            global_ordered.permute(patch_ordered, m_h_patch_order[k].data(),
+                                   false, HOST);
+        }
+        if ((location & DEVICE) == DEVICE) {
+            global_ordered.permute(patch_ordered, m_d_patch_order[k], false,
+                                   DEVICE);
+        }
+    }
+
+    uint32_t get_num_elements(const ELEMENT ele) const
+    {
+        return (ele == ELEMENT::VERTEX) ?
+                   this->m_num_vertices :
+                   ((ele == ELEMENT::EDGE) ? this->m_num_edges :
+                                             this->m_num_faces);
+    }
+
+    const char* ply_element_name(const ELEMENT ele) const
+    {
+        // name of the PLY element that holds the properties of ele
+        return (ele == ELEMENT::VERTEX) ?
+                   "vertex" :
+                   ((ele == ELEMENT::EDGE) ? "edge" : "face");
+    }
+
+    /**
+     * get_patch_order_fingerprint()
+     */
+    uint64_t get_patch_order_fingerprint(const ELEMENT ele)
+    {
+        // identifies the patch order of ele so attributes saved in patch
+        // order are only loaded as is by a mesh with the same patches
+        const std::vector<uint32_t>& order = get_patch_order(ele);
+        return checksum64(order.data(), order.size() * sizeof(uint32_t));
+    }
+
+    /**
+     * save_attribute()
+     */
+    template <typename T>
+    bool save_attribute(const ELEMENT       ele,
+                        RXMeshAttribute<T>& attr,
+                        const std::string&  file_name,
+                        const orderT        order = GLOBAL_ORDER,
+                        const bool          with_checksum = true)
+    {
+        // save an attribute of ele (vertex, edge, or face) to a binary file
+        // (see RXMeshAttribute::save()) in either global order or patch
+        // order (see to_patch_order())
+        if (attr.get_num_mesh_elements() != get_num_elements(ele)) {
+            RXMESH_ERROR(
+                "RXMeshStatic::save_attribute() attribute {} does not match "
+                "the number of mesh elements",
+                attr.get_name());
+            return false;
+        }
+        if (order == GLOBAL_ORDER) {
+            return attr.save(file_name, with_checksum);
+        }
+
+        // reorder where the attribute resides
+        const locationT    loc = attr.is_host_allocated() ? HOST : DEVICE;
+        RXMeshAttribute<T> patch_ordered(attr.get_name());
+        patch_ordered.init(attr.get_num_mesh_elements(),
+                           attr.get_num_attribute_per_element(), loc,
+                           attr.get_layout(), false, false);
+        to_patch_order(ele, attr, patch_ordered, loc);
+        const bool ret = patch_ordered.save(file_name, with_checksum,
+                                            PATCH_ORDER,
+                                            get_patch_order_fingerprint(ele));
+        patch_ordered.release();
+        return ret;
+    }
+
+    /**
+     * load_attribute()
+     */
+    template <typename T>
+    bool load_attribute(const ELEMENT       ele,
+                        RXMeshAttribute<T>& attr,
+                        const std::string&  file_name,
+                        const orderT        order = GLOBAL_ORDER,
+                        const locationT     location = HOST,
+                        const bool          verify_checksum = true)
+    {
+        // load an attribute of ele saved by save_attribute() (or
+        // RXMeshAttribute::save()) in the given order. If the file is
+        // already in this order, the host side is mapped from the file with
+        // no copy (see RXMeshAttribute::load()). Otherwise, it is reordered
+        // into a new buffer
+        AttributeFileHeader header;
+        if (!RXMeshAttribute<T>::read_header(file_name, header)) {
+            return false;
+        }
+        if (header.num_mesh_elements != get_num_elements(ele)) {
+            RXMESH_ERROR(
+                "RXMeshStatic::load_attribute() {} does not match the number "
+                "of mesh elements",
+                file_name);
+            return false;
+        }
+        if (header.order == PATCH_ORDER &&
+            header.order_fingerprint != get_patch_order_fingerprint(ele)) {
+            RXMESH_ERROR(
+                "RXMeshStatic::load_attribute() {} was saved in patch order "
+                "of different patches",
+                file_name);
+            return false;
+        }
+        if (header.order == order) {
+            return attr.load(file_name, location, verify_checksum);
+        }
+
+        const locationT loc = ((location & DEVICE) == DEVICE) ? DEVICE : HOST;
+        RXMeshAttribute<T> saved;
+        if (!saved.load(file_name, loc, verify_checksum, false, false)) {
+            return false;
+        }
+        attr.init(header.num_mesh_elements, header.num_attribute_per_element,
+                  location, header.layout);
+        attr.set_name(header.name);
+        if (order == PATCH_ORDER) {
+            to_patch_order(ele, saved, attr, loc);
+        } else {
+            to_global_order(ele, saved, attr, loc);
+        }
+        if (loc == DEVICE && (location & HOST) == HOST) {
+            attr.move(DEVICE, HOST);
+        }
+        saved.release();
+        return true;
+    }
+
+    /**
+     * import_ply_attribute()
+     */
+    template <typename T>
+    bool import_ply_attribute(const ELEMENT                   ele,
+                              const PlyData&                  ply,
+                              const std::vector<std::string>& properties,
+                              RXMeshAttribute<T>&             attr,
+                              const locationT location = LOCATION_ALL,
+                              const layoutT   layout = AoS)
+    {
+        // load the scalar properties of the vertex, edge, or face element
+        // of a PLY file (see import_ply()) into attr with one attribute per
+        // property e.g., {"red", "green", "blue"}. The PLY element is in the
+        // input order so the mesh should not be sorted on construction. PLY
+        // has no edge order and so edges are matched to the mesh edges by
+        // their vertex1 and vertex2 properties which requires the edge map
+        // i.e., it should be called before release_build_temporaries()
+        const PlyElement* ply_ele = ply.find_element(ply_element_name(ele));
+        if (ply_ele == nullptr || ply_ele->count != get_num_elements(ele)) {
+            RXMESH_ERROR(
+                "RXMeshStatic::import_ply_attribute() PLY has no {} element "
+                "that matches the number of mesh elements",
+                ply_element_name(ele));
+            return false;
+        }
+        std::vector<const PlyProperty*> props;
+        for (const std::string& name : properties) {
+            const PlyProperty* prop = ply_ele->find_property(name);
+            if (prop == nullptr || prop->is_list()) {
+                RXMESH_ERROR(
+                    "RXMeshStatic::import_ply_attribute() PLY has no scalar "
+                    "property {} in {} element",
+                    name, ply_ele->name);
+                return false;
+            }
+            props.push_back(prop);
+        }
+        if (props.empty()) {
+            RXMESH_ERROR(
+                "RXMeshStatic::import_ply_attribute() no properties to load");
+            return false;
+        }
+
+        // the mesh id of every PLY edge
+        const uint32_t        num_elements = ply_ele->count;
+        std::vector<uint32_t> edge_id;
+        if (ele == ELEMENT::EDGE) {
+            const PlyProperty* v1 = ply_ele->find_property("vertex1");
+            const PlyProperty* v2 = ply_ele->find_property("vertex2");
+            if (v1 == nullptr || v2 == nullptr || v1->is_list() ||
+                v2->is_list() || this->m_edges_map.empty()) {
+                RXMESH_ERROR(
+                    "RXMeshStatic::import_ply_attribute() PLY edge element "
+                    "has no vertex1 and vertex2 properties or the edge map is "
+                    "released by release_build_temporaries()");
+                return false;
+            }
+            edge_id.resize(num_elements, INVALID32);
+#pragma omp parallel for schedule(static)
+            for (int64_t i = 0; i < int64_t(num_elements); ++i) {
+                auto e_it = this->m_edges_map.find(
+                    this->edge_key(v1->get<uint32_t>(uint32_t(i)),
+                                   v2->get<uint32_t>(uint32_t(i))));
+                if (e_it != this->m_edges_map.end()) {
+                    edge_id[i] = e_it->second;
+                }
+            }
+            std::vector<bool> is_matched(num_elements, false);
+            for (uint32_t i = 0; i < num_elements; ++i) {
+                if (edge_id[i] == INVALID32 || is_matched[edge_id[i]]) {
+                    RXMESH_ERROR(
+                        "RXMeshStatic::import_ply_attribute() PLY edge {} "
+                        "({}, {}) is not a mesh edge or is duplicated",
+                        i, v1->get<uint32_t>(i), v2->get<uint32_t>(i));
+                    return false;
+                }
+                is_matched[edge_id[i]] = true;
+            }
+        }
+
+        // filled on the host and then moved where it is requested
+        const uint32_t num_attr = static_cast<uint32_t>(props.size());
+        attr.init(num_elements, num_attr, location | HOST, layout);
+#pragma omp parallel for schedule(static)
+        for (int64_t i = 0; i < int64_t(num_elements); ++i) {
+            const uint32_t id = edge_id.empty() ? uint32_t(i) : edge_id[i];
+            for (uint32_t j = 0; j < num_attr; ++j) {
+                attr(id, j) = props[j]->get<T>(uint32_t(i));
+            }
+        }
+        if ((location & DEVICE) == DEVICE) {
+            attr.move(HOST, DEVICE);
+        }
+        if ((location & HOST) != HOST) {
+            attr.release(HOST);
+        }
+        return true;
+    }
+
+    /**
+     * export_ply_attribute()
+     */
+    template <typename PlyT = void, typename T>
+    bool export_ply_attribute(const ELEMENT                   ele,
+                              const RXMeshAttribute<T>&       attr,
+                              const std::vector<std::string>& properties,
+                              PlyData&                        ply)
+    {
+        // add the attributes of attr as scalar properties of the vertex,
+        // edge, or face element of ply (one property per attribute) to be
+        // written with export_ply(). The properties are stored as PlyT e.g.,
+        // uint8_t for colors (T if PlyT is void). The host side of attr is
+        // used. Edges are written in the mesh edge order along with their
+        // vertex1 and vertex2 (taken from the edge map and so it should be
+        // called before release_build_temporaries())
+        using StoreT = std::conditional_t<std::is_void<PlyT>::value, T, PlyT>;
+        if (attr.get_num_mesh_elements() != get_num_elements(ele) ||
+            attr.get_num_attribute_per_element() != properties.size() ||
+            !attr.is_host_allocated()) {
+            RXMESH_ERROR(
+                "RXMeshStatic::export_ply_attribute() attribute {} does not "
+                "match the number of mesh elements and properties or is not "
+                "allocated on the host",
+                attr.get_name());
+            return false;
+        }
+        if (ele == ELEMENT::EDGE &&
+            this->m_edges_map.size() != get_num_elements(ele)) {
+            RXMESH_ERROR(
+                "RXMeshStatic::export_ply_attribute() edges can not be "
+                "exported after release_build_temporaries()");
+            return false;
+        }
+        PlyElement& ply_ele =
+            ply.add_element(ply_element_name(ele), get_num_elements(ele));
+        if (ele == ELEMENT::EDGE) {
+            PlyProperty& v1 = ply_ele.add_property<int32_t>("vertex1");
+            PlyProperty& v2 = ply_ele.add_property<int32_t>("vertex2");
+            for (const auto& it : this->m_edges_map) {
+                v1.set(it.second, int32_t(it.first.first));
+                v2.set(it.second, int32_t(it.first.second));
+            }
+        }
+        for (uint32_t j = 0; j < properties.size(); ++j) {
+            PlyProperty&  prop = ply_ele.add_property<StoreT>(properties[j]);
+            const int64_t num_elements = ply_ele.count;
+#pragma omp parallel for schedule(static)
+            for (int64_t i = 0; i < num_elements; ++i) {
+                prop.set(uint32_t(i), attr(uint32_t(i), j));
+            }
+        }
+        return true;
+    }
+
+    /**
+     * init_ply_data()
+     */
+    template <typename T>
+    bool init_ply_data(const RXMeshAttribute<T>& coordinates, PlyData& ply)
+    {
+        // start a PLY file of the mesh with the vertex coordinates (x, y,
+        // and z) and the face vertex indices. Other attributes are added
+        // with export_ply_attribute()
+        ply.clear();
+        const std::vector<std::vector<uint32_t>>& fv = get_faces();
+        if (fv.size() != get_num_faces()) {
+            RXMESH_ERROR(
+                "RXMeshStatic::init_ply_data() the faces are released by "
+                "release_build_temporaries()");
+            return false;
+        }
+        if (!export_ply_attribute(ELEMENT::VERTEX, coordinates,
+                                  {"x", "y", "z"}, ply)) {
+            return false;
+        }
+        ply.add_element("face", get_num_faces())
+            .add_list_property<uint32_t>("vertex_indices", fv);
+        return true;
+    }
+
+    /**
+     * add_attribute()
+     */
+    template <typename T>
+    RXMeshAttribute<T>& add_attribute(const std::string& name,
+                                      const ELEMENT      ele,
+                                      const uint32_t     num_attributes,
+                                      const locationT    location = DEVICE,
+                                      const layoutT      layout = AoS,
+                                      const bool with_axpy_alloc = true,
+                                      const bool with_reduce_alloc = true)
+    {
+        // Create an attribute owned by the mesh with num_attributes values
+        // per vertex, edge, or face (ele) i.e., sized to the number of mesh
+        // elements of that type. Its buffers (and axpy/reduce scratch) come
+        // from the mesh's AttributeArena so removing an attribute and adding
+        // another of similar size reuses the same memory. Adding a name that
+        // already exists returns the existing attribute if it has the same
+        // type and shape and is an error otherwise
+        auto it = m_attributes.find(name);
+        if (it != m_attributes.end()) {
+            if (it->second.type != std::type_index(typeid(T)) ||
+                it->second.ele != ele ||
+                it->second.num_attributes != num_attributes) {
+                RXMESH_ERROR(
+                    "RXMeshStatic::add_attribute() attribute {} already "
+                    "exists with a different type or shape",
+                    name);
+                exit(EXIT_FAILURE);
+            }
+            return *static_cast<RXMeshAttribute<T>*>(it->second.attr.get());
+        }
+
+        const uint32_t num_elements = get_num_elements(ele);
+
+        // the deleter gives the buffers back to the arena
+        std::shared_ptr<RXMeshAttribute<T>> attr(
+            new RXMeshAttribute<T>(), [](RXMeshAttribute<T>* ptr) {
+                ptr->release();
+                delete ptr;
+            });
+        attr->set_name(name);
+        attr->set_arena(&m_attribute_arena);
+        attr->init(num_elements, num_attributes, location, layout,
+                   with_axpy_alloc, with_reduce_alloc);
+
+        RXMeshAttribute<T>* raw = attr.get();
+        AttributeEntry      entry{ele, std::type_index(typeid(T)),
+                             num_attributes, attr,
+                             [raw](const locationT loc) {
+                                 return (loc == HOST) ?
+                                            raw->get_host_storage_mb() :
+                                            raw->get_device_storage_mb();
+                             }};
+        m_attributes.emplace(name, std::move(entry));
+        this->update_host_storage();
+        return *raw;
+    }
+
+    template <typename T>
+    RXMeshAttribute<T>& add_vertex_attribute(
+        const std::string& name,
+        const uint32_t     num_attributes,
+        const locationT    location = DEVICE,
+        const layoutT      layout = AoS,
+        const bool         with_axpy_alloc = true,
+        const bool         with_reduce_alloc = true)
+    {
+        return add_attribute<T>(name, ELEMENT::VERTEX, num_attributes,
+                                location, layout, with_axpy_alloc,
+                                with_reduce_alloc);
+    }
+
+    template <typename T>
+    RXMeshAttribute<T>& add_edge_attribute(
+        const std::string& name,
+        const uint32_t     num_attributes,
+        const locationT    location = DEVICE,
+        const layoutT      layout = AoS,
+        const bool         with_axpy_alloc = true,
+        const bool         with_reduce_alloc = true)
+    {
+        return add_attribute<T>(name, ELEMENT::EDGE, num_attributes, location,
+                                layout, with_axpy_alloc, with_reduce_alloc);
+    }
+
+    template <typename T>
+    RXMeshAttribute<T>& add_face_attribute(
+        const std::string& name,
+        const uint32_t     num_attributes,
+        const locationT    location = DEVICE,
+        const layoutT      layout = AoS,
+        const bool         with_axpy_alloc = true,
+        const bool         with_reduce_alloc = true)
+    {
+        return add_attribute<T>(name, ELEMENT::FACE, num_attributes, location,
+                                layout, with_axpy_alloc, with_reduce_alloc);
+    }
+
+    /**
+     * get_attribute()
+     */
+    template <typename T>
+    RXMeshAttribute<T>* get_attribute(const std::string& name)
+    {
+        // the registered attribute with this name or nullptr if there is no
+        // such attribute (or it has a different type)
+        auto it = m_attributes.find(name);
+        if (it == m_attributes.end()) {
+            return nullptr;
+        }
+        if (it->second.type != std::type_index(typeid(T))) {
+            RXMESH_ERROR(
+                "RXMeshStatic::get_attribute() attribute {} has a different "
+                "type",
+                name);
+            return nullptr;
+        }
+        return static_cast<RXMeshAttribute<T>*>(it->second.attr.get());
+    }
+
+    bool has_attribute(const std::string& name) const
+    {
+        return m_attributes.find(name) != m_attributes.end();
+    }
+
+    /**
+     * remove_attribute()
+     */
+    void remove_attribute(const std::string& name)
+    {
+        // release the attribute (its buffers go back to the arena). References
+        // to it are invalid afterwards
+        if (m_attributes.erase(name) == 0) {
+            RXMESH_WARN(
+                "RXMeshStatic::remove_attribute() attribute {} does not exist",
+                name);
+        }
+        this->update_host_storage();
+    }
+
+    AttributeArena& get_attribute_arena()
+    {
+        return m_attribute_arena;
+    }
+
+    /**
+     * get_attributes_storage_mb()
+     */
+    double get_attributes_storage_mb(const locationT location) const
+    {
+        // memory held by the registered attributes on location (HOST or
+        // DEVICE) not counting the size class rounding of the arena
+        double mb = 0;
+        for (const auto& it : m_attributes) {
+            mb += it.second.storage_mb(location);
+        }
+        return mb;
+    }
+
+    /**
+     * log_attributes_memory()
+     */
+    void log_attributes_memory() const
+    {
+        // per attribute and arena memory accounting
+        auto ele_str = [](const ELEMENT ele) {
+            return (ele == ELEMENT::VERTEX) ?
+                       "vertex" :
+                       ((ele == ELEMENT::EDGE) ? "edge" : "face");
+        };
+        for (const auto& it : m_attributes) {
+            RXMESH_INFO(
+                "RXMeshStatic attribute {} ({}): host= {} (mb), device= {} "
+                "(mb)",
+                it.first, ele_str(it.second.ele), it.second.storage_mb(HOST),
+                it.second.storage_mb(DEVICE));
+        }
+        for (locationT loc : {HOST, DEVICE}) {
+            RXMESH_INFO(
+                "RXMeshStatic attribute arena {}: in use= {} (mb), pooled= {} "
+                "(mb), peak= {} (mb), {} allocations, {} reuses",
+                location_to_string(loc),
+                double(m_attribute_arena.get_bytes_in_use(loc)) / 1048576.0,
+                double(m_attribute_arena.get_bytes_pooled(loc)) / 1048576.0,
+                double(m_attribute_arena.get_peak_bytes(loc)) / 1048576.0,
+                m_attribute_arena.get_num_system_allocations(loc),
+                m_attribute_arena.get_num_reuses(loc));
+        }
+    }
+
    protected:
+    size_t get_attributes_host_bytes() const override
+    {
+        // the arena host memory i.e., the registered attributes (with the
+        // size class rounding) and the pooled buffers kept for reuse
+        return m_attribute_arena.get_bytes_in_use(HOST) +
+               m_attribute_arena.get_bytes_pooled(HOST);
+    }
+
     template <uint32_t blockThreads>
     void calc_shared_memory(const Op                 op,
                             LaunchBox<blockThreads>& launch_box,
@@ -77,7 +1660,8 @@ class RXMeshStatic : public RXMesh<patchSize>
                     "to be increased for op = {}",
                     TRANSPOSE_ITEM_PER_THREAD, op_to_string(op));
             }
-        } else if (op == Op::VE || op == Op::EF || op == Op::FF) {
+        } else if (op == Op::VE || op == Op::EF || op == Op::FF ||
+                   op == Op::EE) {
             if (3 * this->m_max_faces_per_patch >
                 blockThreads * TRANSPOSE_ITEM_PER_THREAD) {
                 RXMESH_ERROR(
@@ -153,6 +1737,19 @@ class RXMeshStatic : public RXMesh<patchSize>
                  4 * this->m_max_faces_per_patch          // FF
                  ) *
                 sizeof(uint16_t);
+        } else if (op == Op::EE) {
+            // EE needs FE and EF (similar to FF) along with the EE offset
+            // and output where every face adds (at most) two adjacent edges
+            // to each of its three edges
+            // The +1 is for padding before the output mapping
+            launch_box.smem_bytes_dyn =
+                (3 * this->m_max_faces_per_patch +        // FE
+                 (this->m_max_edges_per_patch + 1) +      // EF offset
+                 3 * this->m_max_faces_per_patch +        // EF output
+                 (this->m_max_edges_per_patch + 1) +      // EE offset
+                 2 * 3 * this->m_max_faces_per_patch + 1  // EE output
+                 ) *
+                sizeof(uint16_t);
         }
 
         if (op == Op::VV && oriented) {
@@ -253,6 +1850,14 @@ class RXMeshStatic : public RXMesh<patchSize>
                 break;
             }
             case Op::EE: {
+                if (is_higher_query) {
+                    CUDA_ERROR(cudaFuncGetAttributes(
+                        &func_attr,
+                        detail::higher_query_prototype<Op::EE, threads>));
+                } else {
+                    CUDA_ERROR(cudaFuncGetAttributes(
+                        &func_attr, detail::query_prototype<Op::EE, threads>));
+                }
                 break;
             }
             case Op::EF: {
@@ -334,5 +1939,40 @@ class RXMeshStatic : public RXMesh<patchSize>
         }
         return static_cast<uint32_t>(smem_bytes_static);
     }
+
+    // patch coloring
+    uint32_t              m_num_patch_colors = 0;
+    std::vector<uint32_t> m_h_patch_color;
+    // patches grouped by color where color c patches are
+    // m_h_color_patches[m_h_color_offset[c]:m_h_color_offset[c+1]]
+    std::vector<uint32_t> m_h_color_patches, m_h_color_offset;
+    uint32_t*             m_d_color_patches = nullptr;
+
+    // patch adjacency in compressed format i.e., the patches adjacent to p
+    // are m_h_patch_adjacency[m_h_patch_adjacency_offset[p]:
+    // m_h_patch_adjacency_offset[p+1]]
+    bool                  m_is_patch_adjacency_computed = false;
+    std::vector<uint32_t> m_h_patch_adjacency, m_h_patch_adjacency_offset;
+
+    // patch order (indexed by ELEMENT): global id -> patch-ordered id on the
+    // host and device, the ltog maps with patch-ordered ids, and
+    // patch-ordered id -> patch
+    bool                  m_is_patch_order_computed = false;
+    std::vector<uint32_t> m_h_patch_order[3];
+    uint32_t*             m_d_patch_order[3] = {nullptr, nullptr, nullptr};
+    uint32_t* m_d_patch_order_ltog[3] = {nullptr, nullptr, nullptr};
+    uint32_t* m_d_patch_order_patch[3] = {nullptr, nullptr, nullptr};
+
+    // attribute registry. The arena should outlive the attributes
+    struct AttributeEntry
+    {
+        ELEMENT                           ele;
+        std::type_index                   type;
+        uint32_t                          num_attributes;
+        std::shared_ptr<void>             attr;
+        std::function<double(locationT)> storage_mb;
+    };
+    AttributeArena                                  m_attribute_arena;
+    std::unordered_map<std::string, AttributeEntry> m_attributes;
 };
 }  // namespace RXMESH
\ No newline at end of file
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <omp.h>
+#include <stdint.h>
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "rxmesh/util/log.h"
+
+namespace RXMESH {
+
+/**
+ * format_number()
+ */
+template <typename T>
+inline char* format_number(char* first, char* last, const T value)
+{
+    // write value into [first, last) and return the end of the written
+    // characters. Floating point values are written with the shortest
+    // representation that reads back to the same value (%.9g/%.17g where
+    // the standard library has no floating point std::to_chars)
+    static_assert(std::is_arithmetic<T>::value,
+                  "format_number() T should be an arithmetic type");
+    if constexpr (std::is_floating_point<T>::value) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        return std::to_chars(first, last, value).ptr;
+#else
+        const int len = snprintf(first, size_t(last - first),
+                                 std::is_same<T, float>::value ? "%.9g" :
+                                                                 "%.17g",
+                                 static_cast<double>(value));
+        return first + len;
+#endif
+    } else if constexpr (std::is_same<T, bool>::value) {
+        *first = value ? '1' : '0';
+        return first + 1;
+    } else {
+        return std::to_chars(first, last, value).ptr;
+    }
+}
+
+/**
+ * append_number()
+ */
+template <typename T>
+inline void append_number(std::string& out, const T value)
+{
+    char buf[32];
+    out.append(buf, format_number(buf, buf + sizeof(buf), value));
+}
+
+/**
+ * BufferedWriter
+ * Writes a file with few large sequential writes instead of formatting and
+ * flushing line by line. Text of many records is formatted in parallel into
+ * per-thread buffers (see write_records()) and appended to the file in the
+ * record order. Used by the OBJ/VTK exporters in export_tools.h
+ */
+class BufferedWriter
+{
+   public:
+    BufferedWriter(size_t buffer_bytes = size_t(1) << 24)
+        : m_file(nullptr), m_buffer_bytes(buffer_bytes), m_good(false)
+    {
+    }
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    ~BufferedWriter()
+    {
+        close();
+    }
+
+    /**
+     * open()
+     */
+    bool open(const std::string& file_name)
+    {
+        close();
+        m_file = fopen(file_name.c_str(), "wb");
+        if (m_file == nullptr) {
+            RXMESH_ERROR("BufferedWriter::open() can not open {}", file_name);
+            return false;
+        }
+        m_buffer.clear();
+        m_buffer.reserve(m_buffer_bytes);
+        m_good = true;
+        return true;
+    }
+
+    /**
+     * append()
+     */
+    void append(const char* data, const size_t bytes)
+    {
+        if (m_buffer.size() + bytes > m_buffer_bytes) {
+            flush();
+        }
+        if (bytes >= m_buffer_bytes) {
+            write(data, bytes);
+        } else {
+            m_buffer.append(data, bytes);
+        }
+    }
+
+    void append(const std::string& str)
+    {
+        append(str.data(), str.size());
+    }
+
+    /**
+     * write_records()
+     */
+    template <typename FormatT>
+    void write_records(const int64_t num_records, FormatT format)
+    {
+        // format(i, out) appends the text of record i to out. Records are
+        // processed in blocks. Each thread formats a contiguous range of a
+        // block into its own buffer and the buffers are written in order so
+        // the output matches a sequential loop. format is called
+        // concurrently and so should only read shared data
+        const int64_t num_threads = std::max(omp_get_max_threads(), 1);
+        const int64_t block_size = num_threads * m_records_per_thread;
+        if (m_thread_buffers.size() < size_t(num_threads)) {
+            m_thread_buffers.resize(num_threads);
+        }
+
+        for (int64_t block = 0; block < num_records; block += block_size) {
+            const int64_t block_end =
+                std::min(block + block_size, num_records);
+            const int64_t chunk =
+                (block_end - block + num_threads - 1) / num_threads;
+#pragma omp parallel for schedule(static, 1)
+            for (int64_t t = 0; t < num_threads; ++t) {
+                std::string& out = m_thread_buffers[t];
+                out.clear();
+                const int64_t end =
+                    std::min(block + (t + 1) * chunk, block_end);
+                for (int64_t i = block + t * chunk; i < end; ++i) {
+                    format(i, out);
+                }
+            }
+            for (int64_t t = 0; t < num_threads; ++t) {
+                append(m_thread_buffers[t]);
+            }
+        }
+    }
+
+    /**
+     * flush()
+     */
+    void flush()
+    {
+        if (!m_buffer.empty()) {
+            write(m_buffer.data(), m_buffer.size());
+            m_buffer.clear();
+        }
+    }
+
+    /**
+     * close()
+     */
+    bool close()
+    {
+        // returns false if any write failed
+        if (m_file == nullptr) {
+            return m_good;
+        }
+        flush();
+        if (fclose(m_file) != 0) {
+            m_good = false;
+        }
+        m_file = nullptr;
+        m_thread_buffers.clear();
+        m_thread_buffers.shrink_to_fit();
+        std::string().swap(m_buffer);
+        return m_good;
+    }
+
+    bool is_good() const
+    {
+        return m_good;
+    }
+
+   private:
+    void write(const char* data, const size_t bytes)
+    {
+        if (m_file != nullptr && fwrite(data, 1, bytes, m_file) != bytes) {
+            m_good = false;
+        }
+    }
+
+    // records a thread formats before its buffer is appended to the file
+    static constexpr int64_t m_records_per_thread = 1 << 16;
+
+    FILE*                    m_file;
+    size_t                   m_buffer_bytes;
+    bool                     m_good;
+    std::string              m_buffer;
+    std::vector<std::string> m_thread_buffers;
+};
+}  // namespace RXMESH
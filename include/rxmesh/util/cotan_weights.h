@@ -1,6 +1,10 @@
 #pragma once
+#include <assert.h>
+#include <limits>
 #include "rxmesh/util/vector.h"
 
+namespace RXMESH {
+
 /**
  * clamp_cot()
  */
@@ -18,14 +22,13 @@ __host__ __device__ __forceinline__ void clamp_cot(T& v)
  */
 template <typename T>
 __host__ __device__ __forceinline__ T
-partial_voronoi_area(const RXMESH::Vector<3, T>& p,  // center
-                     const RXMESH::Vector<3, T>& q,  // before center
-                     const RXMESH::Vector<3, T>& r)  // after center
+partial_voronoi_area(const Vector<3, T>& p,  // center
+                     const Vector<3, T>& q,  // before center
+                     const Vector<3, T>& r)  // after center
 
 {
     // compute partial Voronoi area of the center vertex that is associated with
     // the triangle p->q->r (oriented ccw)
-    using namespace RXMESH;
 
     // Edge vector p->q
     const Vector<3, T> pq = q - p;
@@ -78,15 +81,13 @@ partial_voronoi_area(const RXMESH::Vector<3, T>& p,  // center
  */
 template <typename T>
 __host__ __device__ __forceinline__ T
-edge_cotan_weight(const RXMESH::Vector<3, T>& p,
-                  const RXMESH::Vector<3, T>& r,
-                  const RXMESH::Vector<3, T>& q,
-                  const RXMESH::Vector<3, T>& s)
+edge_cotan_weight(const Vector<3, T>& p,
+                  const Vector<3, T>& r,
+                  const Vector<3, T>& q,
+                  const Vector<3, T>& s)
 {
     // Get the edge weight between the two vertices p-r where
     // q and s composes the diamond around p-r
-    using namespace RXMESH;
-
     auto partial_weight = [&](const Vector<3, T>& v) -> T {
         const Vector<3, T> d0 = p - v;
         const Vector<3, T> d1 = r - v;
@@ -108,4 +109,58 @@ edge_cotan_weight(const RXMESH::Vector<3, T>& p,
     assert(!isinf(eweight));
 
     return eweight;
-}
\ No newline at end of file
+}
+
+/**
+ * cotan_one_ring()
+ */
+template <typename T, typename ringT, typename coordT, typename weightT>
+__host__ __device__ __forceinline__ T cotan_one_ring(const uint32_t p_id,
+                                                     const ringT&   ring,
+                                                     const coordT&  coords,
+                                                     weightT        weight)
+{
+    // Walk the one ring of p_id (ring[0], ..., ring[ring.size() - 1] oriented
+    // ccw as given by an oriented Op::VV query) and call weight(v, r_id, w)
+    // for every ring vertex r_id = ring[v] where w is the (unclamped) cotan
+    // weight of the edge p-r. Returns the Voronoi area of p_id i.e., the sum
+    // of the non-negative partial Voronoi areas of its triangles.
+    // For every r, q is the vertex before it and s is the one after it
+    /*       r
+          /  |  \
+         /   |   \
+        s    |    q
+         \   |   /
+           \ |  /
+             p
+    */
+    auto vertex = [&](const uint32_t id) {
+        return Vector<3, T>(coords(id, 0), coords(id, 1), coords(id, 2));
+    };
+    const Vector<3, T> p = vertex(p_id);
+
+    T area(0);
+
+    // this is the last vertex in the one-ring (before r_id)
+    uint32_t q_id = ring[ring.size() - 1];
+
+    for (uint32_t v = 0; v < ring.size(); ++v) {
+        // the current one ring vertex
+        const uint32_t r_id = ring[v];
+
+        // the second vertex in the one ring (after r_id)
+        const uint32_t s_id = (v == ring.size() - 1) ? ring[0] : ring[v + 1];
+
+        const Vector<3, T> q = vertex(q_id);
+        const Vector<3, T> r = vertex(r_id);
+
+        weight(v, r_id, edge_cotan_weight(p, r, q, vertex(s_id)));
+
+        const T tri_area = partial_voronoi_area(p, q, r);
+        area += (tri_area > 0) ? tri_area : 0;
+
+        q_id = r_id;
+    }
+    return area;
+}
+}  // namespace RXMESH
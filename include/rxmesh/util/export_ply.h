@@ -0,0 +1,248 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "rxmesh/util/buffered_writer.h"
+#include "rxmesh/util/import_ply.h"
+#include "rxmesh/util/log.h"
+#include "rxmesh/util/macros.h"
+
+namespace RXMESH {
+
+namespace detail {
+
+/**
+ * ply_format_ascii()
+ */
+inline void ply_format_ascii(std::string&  out,
+                             const char*   src,
+                             const PlyType type)
+{
+    // floats are written with the shortest text that reads back the same
+    if (type == PlyType::FLOAT32) {
+        append_number(out, ply_get<float>(src, type));
+    } else if (type == PlyType::FLOAT64) {
+        append_number(out, ply_get<double>(src, type));
+    } else {
+        append_number(out, ply_get<int64_t>(src, type));
+    }
+}
+
+/**
+ * ply_write_binary_element()
+ */
+inline bool ply_write_binary_element(FILE*             file,
+                                     const PlyElement& ele,
+                                     const bool        swap)
+{
+    // every record is formatted into one buffer at its own offset (in
+    // parallel) and the buffer is written with a single fwrite
+    const int64_t num = ele.count;
+
+    std::vector<uint64_t> record_offset(num + 1, 0);
+    uint32_t              fixed_size = 0;
+    for (const PlyProperty& prop : ele.properties) {
+        if (prop.is_list()) {
+            fixed_size += ply_type_size(prop.count_type);
+        } else {
+            fixed_size += ply_type_size(prop.type);
+        }
+    }
+    for (int64_t i = 0; i < num; ++i) {
+        uint64_t size = fixed_size;
+        for (const PlyProperty& prop : ele.properties) {
+            if (prop.is_list()) {
+                size += uint64_t(prop.get_list_size(uint32_t(i))) *
+                        ply_type_size(prop.type);
+            }
+        }
+        record_offset[i + 1] = record_offset[i] + size;
+    }
+
+    std::vector<char> buffer(record_offset[num]);
+#pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < num; ++i) {
+        char* dst = buffer.data() + record_offset[i];
+        for (const PlyProperty& prop : ele.properties) {
+            const uint32_t size = ply_type_size(prop.type);
+            uint64_t       first = uint64_t(i);
+            uint32_t       list_size = 1;
+            if (prop.is_list()) {
+                const uint32_t count_size = ply_type_size(prop.count_type);
+                list_size = prop.get_list_size(uint32_t(i));
+                ply_set(dst, prop.count_type, list_size);
+                if (swap) {
+                    ply_swap_bytes(dst, count_size);
+                }
+                dst += count_size;
+                first = prop.offset[i];
+            }
+            std::memcpy(dst, prop.data.data() + first * size,
+                        size_t(list_size) * size);
+            if (swap) {
+                for (uint32_t j = 0; j < list_size; ++j) {
+                    ply_swap_bytes(dst + j * size, size);
+                }
+            }
+            dst += size_t(list_size) * size;
+        }
+    }
+    return fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+}
+
+/**
+ * ply_write_ascii_element()
+ */
+inline bool ply_write_ascii_element(FILE* file, const PlyElement& ele)
+{
+    // one line per record flushed to the file in large chunks
+    constexpr size_t chunk = 1 << 22;
+    std::string      out;
+    out.reserve(chunk + 1024);
+    for (uint32_t i = 0; i < ele.count; ++i) {
+        for (uint32_t p = 0; p < ele.properties.size(); ++p) {
+            const PlyProperty& prop = ele.properties[p];
+            const uint32_t     size = ply_type_size(prop.type);
+            if (p > 0) {
+                out.push_back(' ');
+            }
+            if (!prop.is_list()) {
+                ply_format_ascii(out, prop.data.data() + size_t(i) * size,
+                                 prop.type);
+                continue;
+            }
+            const uint32_t list_size = prop.get_list_size(i);
+            out.append(std::to_string(list_size));
+            for (uint32_t j = 0; j < list_size; ++j) {
+                out.push_back(' ');
+                ply_format_ascii(
+                    out, prop.data.data() + (size_t(prop.offset[i]) + j) * size,
+                    prop.type);
+            }
+        }
+        out.push_back('\n');
+        if (out.size() >= chunk) {
+            if (fwrite(out.data(), 1, out.size(), file) != out.size()) {
+                return false;
+            }
+            out.clear();
+        }
+    }
+    return fwrite(out.data(), 1, out.size(), file) == out.size();
+}
+}  // namespace detail
+
+/**
+ * export_ply()
+ */
+inline bool export_ply(
+    const std::string& file_name,
+    const PlyData&     ply,
+    const PlyFormat    format = PlyFormat::BINARY_LITTLE_ENDIAN)
+{
+    // write every element and property of ply in the given format (not
+    // ply.format which is the format ply was read from)
+    for (const PlyElement& ele : ply.elements) {
+        for (const PlyProperty& prop : ele.properties) {
+            bool   valid = true;
+            size_t num_values = ele.count;
+            if (prop.is_list()) {
+                valid = prop.offset.size() == size_t(ele.count) + 1;
+                num_values = valid ? prop.offset.back() : 0;
+            }
+            if (!valid || prop.data.size() !=
+                              num_values * detail::ply_type_size(prop.type)) {
+                RXMESH_ERROR(
+                    "export_ply() property {} does not match the {} instances "
+                    "of element {}",
+                    prop.name, ele.count, ele.name);
+                return false;
+            }
+        }
+    }
+
+    FILE* file = fopen(file_name.c_str(), "wb");
+    if (file == NULL) {
+        RXMESH_ERROR("export_ply() can not open {}", file_name);
+        return false;
+    }
+
+    std::string header = "ply\nformat ";
+    header += (format == PlyFormat::ASCII) ? "ascii" :
+              (format == PlyFormat::BINARY_LITTLE_ENDIAN) ?
+                                             "binary_little_endian" :
+                                             "binary_big_endian";
+    header += " 1.0\n";
+    for (const std::string& comment : ply.comments) {
+        header += "comment " + comment + "\n";
+    }
+    for (const PlyElement& ele : ply.elements) {
+        header +=
+            "element " + ele.name + " " + std::to_string(ele.count) + "\n";
+        for (const PlyProperty& prop : ele.properties) {
+            header += "property ";
+            if (prop.is_list()) {
+                header += "list ";
+                header += detail::ply_type_to_string(prop.count_type);
+                header += " ";
+            }
+            header += detail::ply_type_to_string(prop.type);
+            header += " " + prop.name + "\n";
+        }
+    }
+    header += "end_header\n";
+    bool ok = fwrite(header.data(), 1, header.size(), file) == header.size();
+
+    const bool swap = format != PlyFormat::ASCII &&
+                      format != detail::ply_host_format();
+    for (const PlyElement& ele : ply.elements) {
+        if (!ok) {
+            break;
+        }
+        ok = (format == PlyFormat::ASCII) ?
+                 detail::ply_write_ascii_element(file, ele) :
+                 detail::ply_write_binary_element(file, ele, swap);
+    }
+    fclose(file);
+    if (!ok) {
+        RXMESH_ERROR("export_ply() writing {} failed", file_name);
+    }
+    return ok;
+}
+
+/**
+ * export_ply()
+ */
+template <typename T_d, typename T>
+bool export_ply(const std::vector<std::vector<T>>&   Faces,
+                const std::vector<std::vector<T_d>>& Verts,
+                std::string                          filename,
+                const PlyFormat format = PlyFormat::BINARY_LITTLE_ENDIAN,
+                bool            default_folder = true)
+{
+    // the PLY counterpart of export_obj()
+    if (default_folder) {
+        filename = STRINGIFY(OUTPUT_DIR) + filename;
+    }
+
+    PlyData     ply;
+    PlyElement& vertex =
+        ply.add_element("vertex", static_cast<uint32_t>(Verts.size()));
+    const char* names[3] = {"x", "y", "z"};
+    for (uint32_t i = 0; i < 3; ++i) {
+        PlyProperty& prop = vertex.add_property<T_d>(names[i]);
+        for (uint32_t v = 0; v < Verts.size(); ++v) {
+            prop.set(v, Verts[v][i]);
+        }
+    }
+    ply.add_element("face", static_cast<uint32_t>(Faces.size()))
+        .add_list_property<uint32_t>("vertex_indices", Faces);
+
+    RXMESH_TRACE(" Exporting to {}", filename);
+    return export_ply(filename, ply, format);
+}
+}  // namespace RXMESH
@@ -1,9 +1,16 @@
 #pragma once
 
 #include <stdint.h>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "rxmesh/util/buffered_writer.h"
 #include "rxmesh/util/log.h"
+#include "rxmesh/util/macros.h"
 
 template <typename CubeX, typename CubeY, typename CubeZ>
 void export_as_cubes(std::string    filename,
@@ -93,88 +100,97 @@ void export_as_cubes_VTK(std::string    filename,
 {
 
     // draw samples as cubes with attibutes/colors in vtk file
-    // funX, funY, and funZ should return the sample
+    // funX, funY, and funZ should return the sample (they are called
+    // concurrently)
     // vertex_att is an array of lengh num_cubes with the attibures for each
     // point
 
     filename = STRINGIFY(OUTPUT_DIR) + filename;
-    std::fstream file_vtk(filename.c_str(), std::ios::out);
-    file_vtk.precision(15);
-
-    file_vtk << "# vtk DataFile Version 2.0" << std::endl;
-    file_vtk << "Voxel Grid" << std::endl;
-    file_vtk << "ASCII" << std::endl;
-    file_vtk << "DATASET UNSTRUCTURED_GRID" << std::endl;
-    file_vtk << "POINTS " << num_cubes * 8 << " float" << std::endl;
-
-    float half_len = cube_len / 2.0f;
-
-    for (uint32_t v = 0; v < num_cubes; ++v) {
-        double lowerLeft_X = funX(v) - half_len;
-        double lowerLeft_Y = funY(v) - half_len;
-        double lowerLeft_Z = funZ(v) - half_len;
-
-        file_vtk << lowerLeft_X << " " << lowerLeft_Y << " " << lowerLeft_Z
-                 << std::endl;  // 0
-        file_vtk << lowerLeft_X + cube_len << " " << lowerLeft_Y << " "
-                 << lowerLeft_Z << std::endl;  // 1
-        file_vtk << lowerLeft_X + cube_len << " " << lowerLeft_Y << " "
-                 << lowerLeft_Z + cube_len << std::endl;  // 2
-        file_vtk << lowerLeft_X << " " << lowerLeft_Y << " "
-                 << lowerLeft_Z + cube_len << std::endl;  // 3
-
-        file_vtk << lowerLeft_X << " " << lowerLeft_Y + cube_len << " "
-                 << lowerLeft_Z << std::endl;  // 4
-        file_vtk << lowerLeft_X + cube_len << " " << lowerLeft_Y + cube_len
-                 << " " << lowerLeft_Z << std::endl;  // 5
-        file_vtk << lowerLeft_X + cube_len << " " << lowerLeft_Y + cube_len
-                 << " " << lowerLeft_Z + cube_len << std::endl;  // 6
-        file_vtk << lowerLeft_X << " " << lowerLeft_Y + cube_len << " "
-                 << lowerLeft_Z + cube_len << std::endl;  // 7
+    RXMESH::BufferedWriter file_vtk;
+    if (!file_vtk.open(filename)) {
+        return;
     }
 
-    file_vtk << "CELLS " << num_cubes << " " << num_cubes * 9 << std::endl;
-    for (uint32_t v = 0; v < num_cubes * 8; v += 8) {
-        file_vtk << "8 ";
+    file_vtk.append(
+        "# vtk DataFile Version 2.0\nVoxel Grid\nASCII\n"
+        "DATASET UNSTRUCTURED_GRID\nPOINTS " +
+        std::to_string(uint64_t(num_cubes) * 8) + " float\n");
+
+    const float half_len = cube_len / 2.0f;
+
+    // the 8 corners of a cube relative to its lower left corner
+    const uint32_t dx[8] = {0, 1, 1, 0, 0, 1, 1, 0};
+    const uint32_t dy[8] = {0, 0, 0, 0, 1, 1, 1, 1};
+    const uint32_t dz[8] = {0, 0, 1, 1, 0, 0, 1, 1};
+    file_vtk.write_records(num_cubes, [&](int64_t v, std::string& out) {
+        const double lowerLeft_X = funX(uint32_t(v)) - half_len;
+        const double lowerLeft_Y = funY(uint32_t(v)) - half_len;
+        const double lowerLeft_Z = funZ(uint32_t(v)) - half_len;
+        for (uint32_t c = 0; c < 8; ++c) {
+            RXMESH::append_number(out, float(lowerLeft_X + dx[c] * cube_len));
+            out.push_back(' ');
+            RXMESH::append_number(out, float(lowerLeft_Y + dy[c] * cube_len));
+            out.push_back(' ');
+            RXMESH::append_number(out, float(lowerLeft_Z + dz[c] * cube_len));
+            out.push_back('\n');
+        }
+    });
+
+    file_vtk.append("CELLS " + std::to_string(num_cubes) + " " +
+                    std::to_string(uint64_t(num_cubes) * 9) + "\n");
+    file_vtk.write_records(num_cubes, [&](int64_t v, std::string& out) {
+        out.push_back('8');
         for (uint32_t i = 0; i < 8; ++i) {
-            file_vtk << v + i << " ";
+            out.push_back(' ');
+            RXMESH::append_number(out, uint64_t(v) * 8 + i);
         }
-        file_vtk << std::endl;
-    }
+        out.push_back('\n');
+    });
 
-    file_vtk << "CELL_TYPES " << num_cubes << std::endl;
-    for (uint32_t v = 0; v < num_cubes; ++v) {
-        file_vtk << 12 << std::endl;
-    }
+    file_vtk.append("CELL_TYPES " + std::to_string(num_cubes) + "\n");
+    file_vtk.write_records(num_cubes, [&](int64_t, std::string& out) {
+        out.append("12\n");
+    });
 
-    file_vtk << "POINT_DATA " << num_cubes * 8 << std::endl;
-    file_vtk << "SCALARS scalars float 1" << std::endl;
-    file_vtk << "LOOKUP_TABLE default" << std::endl;
+    file_vtk.append("POINT_DATA " + std::to_string(uint64_t(num_cubes) * 8) +
+                    "\nSCALARS scalars float 1\nLOOKUP_TABLE default\n");
 
+    bool own_randomness = false;
     if (randomize && randomness == (float*)nullptr) {
         randomness = (float*)malloc(num_att * sizeof(float));
+        own_randomness = true;
         for (uint32_t i = 0; i < num_att; i++) {
             randomness[i] = 1.0f;
         }
     }
 
+    // the random values depend on the order they are drawn in so they are
+    // computed before formatting
+    std::vector<float> val(num_cubes);
     for (uint32_t v = 0; v < num_cubes; ++v) {
-        float val = static_cast<float>(vertex_att[v]);
+        val[v] = static_cast<float>(vertex_att[v]);
 
         if (randomize) {
             if (fabs(randomness[vertex_att[v]] - 1.0f) < 0.0001f) {
                 randomness[vertex_att[v]] *= float(rand()) / float(RAND_MAX);
             }
-            val = randomness[vertex_att[v]];
+            val[v] = randomness[vertex_att[v]];
         }
+    }
+    if (own_randomness) {
+        free(randomness);
+    }
 
-
+    file_vtk.write_records(num_cubes, [&](int64_t v, std::string& out) {
         for (uint32_t i = 0; i < 8; ++i) {
-            file_vtk << val << std::endl;
+            RXMESH::append_number(out, val[v]);
+            out.push_back('\n');
         }
-    }
+    });
 
-    file_vtk.close();
+    if (!file_vtk.close()) {
+        RXMESH_ERROR("export_as_cubes_VTK() writing {} failed", filename);
+    }
 }
 
 
@@ -190,40 +206,246 @@ void export_obj(const std::vector<std::vector<T>>&   Faces,
 
     RXMESH_TRACE(" Exporting to {}", filename);
 
-    // std::ofstream file;
-    FILE* file;
-    file = fopen(filename.c_str(), "w");
-    if (file == NULL) {
+    RXMESH::BufferedWriter file;
+    if (!file.open(filename)) {
         RXMESH_ERROR("export_obj() can not open {}", filename);
+        return;
     }
-    // file.open(filename);
-    // file.precision(16);
 
     // write vertices
-    for (uint32_t v = 0; v < Verts.size(); v++) {
-        // file << "v  ";
-        fprintf(file, "v  ");
+    file.write_records(Verts.size(), [&](int64_t v, std::string& out) {
+        out.push_back('v');
         for (uint32_t iv = 0; iv < Verts[v].size(); iv++) {
-            // file << Verts[v][iv] << "  ";
-            fprintf(file, "%f ", Verts[v][iv]);
+            out.push_back(' ');
+            RXMESH::append_number(out, Verts[v][iv]);
         }
-        // file << std::endl;
-        fprintf(file, "\n");
-    }
+        out.push_back('\n');
+    });
 
     // write faces
-    for (uint32_t f = 0; f < Faces.size(); f++) {
-        // file << "f  ";
-        fprintf(file, "f  ");
+    file.write_records(Faces.size(), [&](int64_t f, std::string& out) {
+        out.push_back('f');
         for (uint32_t fi = 0; fi < Faces[f].size(); fi++) {
-            // file << Faces[f][fi] + 1 << "		";
-            fprintf(file, "%u ", Faces[f][fi] + 1);
+            out.push_back(' ');
+            RXMESH::append_number(out, uint64_t(Faces[f][fi]) + 1);
+        }
+        out.push_back('\n');
+    });
+
+    if (!file.close()) {
+        RXMESH_ERROR("export_obj() writing {} failed", filename);
+    }
+}
+
+
+// One point or cell data array of a VTK XML file (see export_vtk_xml())
+struct VTKDataArray
+{
+    std::string       name;
+    // VTK type name e.g., Float32
+    std::string       type;
+    uint32_t          num_components = 1;
+    uint64_t          num_tuples = 0;
+    std::vector<char> data;
+};
+
+/**
+ * vtk_type_name()
+ */
+template <typename T>
+constexpr const char* vtk_type_name()
+{
+    return std::is_same<T, int8_t>::value   ? "Int8" :
+           std::is_same<T, uint8_t>::value  ? "UInt8" :
+           std::is_same<T, int16_t>::value  ? "Int16" :
+           std::is_same<T, uint16_t>::value ? "UInt16" :
+           std::is_same<T, int32_t>::value  ? "Int32" :
+           std::is_same<T, uint32_t>::value ? "UInt32" :
+           std::is_same<T, int64_t>::value  ? "Int64" :
+           std::is_same<T, uint64_t>::value ? "UInt64" :
+           std::is_same<T, float>::value    ? "Float32" :
+           std::is_same<T, double>::value   ? "Float64" :
+                                              nullptr;
+}
+
+/**
+ * make_vtk_array()
+ */
+template <typename attrT>
+VTKDataArray make_vtk_array(const std::string& name,
+                            const attrT*       values,
+                            const uint64_t     num_tuples,
+                            const uint32_t     num_components = 1)
+{
+    // values holds num_components values per tuple (point or cell)
+    static_assert(vtk_type_name<attrT>() != nullptr,
+                  "make_vtk_array() attrT is not a VTK type");
+    VTKDataArray arr;
+    arr.name = name;
+    arr.type = vtk_type_name<attrT>();
+    arr.num_components = num_components;
+    arr.num_tuples = num_tuples;
+    arr.data.resize(num_tuples * num_components * sizeof(attrT));
+    std::memcpy(arr.data.data(), values, arr.data.size());
+    return arr;
+}
+
+/**
+ * export_vtk_xml()
+ */
+template <typename T, typename dataT>
+bool export_vtk_xml(std::string                            filename,
+                    const std::vector<std::vector<T>>&     Faces,
+                    const std::vector<std::vector<dataT>>& Verts,
+                    const std::vector<VTKDataArray>&       point_data = {},
+                    const std::vector<VTKDataArray>&       cell_data = {},
+                    bool default_folder = true)
+{
+    // write a VTK XML file with all arrays in raw binary appended data which
+    // ParaView loads much faster than the legacy ASCII .vtk. The extension
+    // selects the dataset: .vtp (PolyData) or .vtu (UnstructuredGrid)
+    if (default_folder) {
+        filename = STRINGIFY(OUTPUT_DIR) + filename;
+    }
+    const std::string ext =
+        filename.size() >= 4 ? filename.substr(filename.size() - 4) : "";
+    if (ext != ".vtp" && ext != ".vtu") {
+        RXMESH_ERROR("export_vtk_xml() {} is not a .vtp or .vtu file",
+                     filename);
+        return false;
+    }
+    const bool poly = (ext == ".vtp");
+
+    const int64_t num_vertices = Verts.size();
+    const int64_t num_faces = Faces.size();
+    for (const VTKDataArray& arr : point_data) {
+        if (arr.num_tuples != uint64_t(num_vertices)) {
+            RXMESH_ERROR("export_vtk_xml() point data {} does not match {} "
+                         "vertices",
+                         arr.name, num_vertices);
+            return false;
+        }
+    }
+    for (const VTKDataArray& arr : cell_data) {
+        if (arr.num_tuples != uint64_t(num_faces)) {
+            RXMESH_ERROR("export_vtk_xml() cell data {} does not match {} "
+                         "faces",
+                         arr.name, num_faces);
+            return false;
+        }
+    }
+
+    RXMESH_TRACE(" Exporting to {}", filename);
+
+    // points (always 3 components), connectivity, offsets, and cell types
+    using pointT = std::conditional_t<std::is_same<dataT, double>::value,
+                                      double,
+                                      float>;
+    std::vector<pointT>   points(num_vertices * 3, pointT(0));
+    std::vector<int64_t>  offsets(num_faces);
+    std::vector<uint8_t>  types(num_faces);
+    std::vector<uint64_t> face_start(num_faces + 1, 0);
+    for (int64_t f = 0; f < num_faces; ++f) {
+        face_start[f + 1] = face_start[f] + Faces[f].size();
+    }
+    std::vector<int64_t> connectivity(face_start[num_faces]);
+#pragma omp parallel for schedule(static)
+    for (int64_t v = 0; v < num_vertices; ++v) {
+        for (uint32_t i = 0; i < std::min<size_t>(Verts[v].size(), 3); ++i) {
+            points[3 * v + i] = static_cast<pointT>(Verts[v][i]);
+        }
+    }
+#pragma omp parallel for schedule(static)
+    for (int64_t f = 0; f < num_faces; ++f) {
+        for (uint32_t i = 0; i < Faces[f].size(); ++i) {
+            connectivity[face_start[f] + i] = static_cast<int64_t>(Faces[f][i]);
         }
-        // file << std::endl;
-        fprintf(file, "\n");
+        offsets[f] = static_cast<int64_t>(face_start[f + 1]);
+        // triangle, quad, or polygon
+        types[f] = Faces[f].size() == 3 ? 5 : (Faces[f].size() == 4 ? 9 : 7);
+    }
+
+    // every array is appended as its size in bytes (UInt64) and its data
+    struct Block
+    {
+        const void* data;
+        uint64_t    bytes;
+    };
+    std::vector<Block> blocks;
+    uint64_t           offset = 0;
+    auto data_array = [&](const std::string& attr, const void* data,
+                          const uint64_t bytes) {
+        blocks.push_back({data, bytes});
+        std::string str = "<DataArray " + attr +
+                          " format=\"appended\" offset=\"" +
+                          std::to_string(offset) + "\"/>\n";
+        offset += sizeof(uint64_t) + bytes;
+        return str;
+    };
+    auto named_array = [&](const VTKDataArray& arr) {
+        return data_array("type=\"" + arr.type + "\" Name=\"" + arr.name +
+                              "\" NumberOfComponents=\"" +
+                              std::to_string(arr.num_components) + "\"",
+                          arr.data.data(), arr.data.size());
+    };
+
+    const uint16_t one = 1;
+    uint8_t        first_byte;
+    std::memcpy(&first_byte, &one, 1);
+    const char* dataset = poly ? "PolyData" : "UnstructuredGrid";
+
+    std::string xml = "<?xml version=\"1.0\"?>\n<VTKFile type=\"";
+    xml += dataset;
+    xml += "\" version=\"1.0\" byte_order=\"";
+    xml += (first_byte == 1) ? "LittleEndian" : "BigEndian";
+    xml += "\" header_type=\"UInt64\">\n<";
+    xml += dataset;
+    xml += ">\n<Piece NumberOfPoints=\"" + std::to_string(num_vertices) +
+           (poly ? "\" NumberOfPolys=\"" : "\" NumberOfCells=\"") +
+           std::to_string(num_faces) + "\">\n";
+    xml += "<PointData>\n";
+    for (const VTKDataArray& arr : point_data) {
+        xml += named_array(arr);
+    }
+    xml += "</PointData>\n<CellData>\n";
+    for (const VTKDataArray& arr : cell_data) {
+        xml += named_array(arr);
+    }
+    xml += "</CellData>\n<Points>\n";
+    xml += data_array(std::string("type=\"") + vtk_type_name<pointT>() +
+                          "\" NumberOfComponents=\"3\"",
+                      points.data(), points.size() * sizeof(pointT));
+    xml += poly ? "</Points>\n<Polys>\n" : "</Points>\n<Cells>\n";
+    xml += data_array("type=\"Int64\" Name=\"connectivity\"",
+                      connectivity.data(),
+                      connectivity.size() * sizeof(int64_t));
+    xml += data_array("type=\"Int64\" Name=\"offsets\"", offsets.data(),
+                      offsets.size() * sizeof(int64_t));
+    if (!poly) {
+        xml += data_array("type=\"UInt8\" Name=\"types\"", types.data(),
+                          types.size() * sizeof(uint8_t));
+    }
+    xml += poly ? "</Polys>\n" : "</Cells>\n";
+    xml += "</Piece>\n</";
+    xml += dataset;
+    xml += ">\n<AppendedData encoding=\"raw\">\n_";
+
+    RXMESH::BufferedWriter file;
+    if (!file.open(filename)) {
+        return false;
+    }
+    file.append(xml);
+    for (const Block& block : blocks) {
+        file.append(reinterpret_cast<const char*>(&block.bytes),
+                    sizeof(uint64_t));
+        file.append(static_cast<const char*>(block.data), block.bytes);
     }
-    fclose(file);
-    // file.close();
+    file.append("\n</AppendedData>\n</VTKFile>\n");
+    if (!file.close()) {
+        RXMESH_ERROR("export_vtk_xml() writing {} failed", filename);
+        return false;
+    }
+    return true;
 }
 
 
@@ -237,82 +459,119 @@ void export_attribute_VTK(
     const attrT* vertex_att,
     bool         randomize = false)
 {
-    // write vtk files such that each patch has a different color
+    // write vtk files such that each patch has a different color. A .vtu or
+    // .vtp filename writes a binary VTK XML file (see export_vtk_xml())
+    // instead of the legacy ASCII format
+
+    const T num_faces = fvn.size();
+    const T num_vertices = Verts.size();
+
+    // the random values depend on the order they are drawn in so they are
+    // computed before formatting
+    std::vector<double> rand_val;
+    if (randomize) {
+        const attrT*            att = per_face ? face_att : vertex_att;
+        const T                 num = per_face ? num_faces : num_vertices;
+        std::map<attrT, double> rand_map;
+        rand_val.resize(num);
+        for (T id = 0; id < num; id++) {
+            typename std::map<attrT, double>::iterator rand_map_it =
+                rand_map.find(att[id]);
+            if (rand_map_it != rand_map.end()) {
+                rand_val[id] = rand_map_it->second;
+            } else {
+                double val = double(rand()) / double(RAND_MAX);
+                rand_map[att[id]] = val;
+                rand_val[id] = val;
+            }
+        }
+    }
+
+    const std::string ext =
+        filename.size() >= 4 ? filename.substr(filename.size() - 4) : "";
+    if (ext == ".vtu" || ext == ".vtp") {
+        const T      num = per_face ? num_faces : num_vertices;
+        VTKDataArray arr;
+        if (randomize) {
+            arr = make_vtk_array(per_face ? "cell_scalars" : "rad",
+                                 rand_val.data(), num);
+        } else {
+            std::vector<double> val(num);
+            const attrT*        att = per_face ? face_att : vertex_att;
+            for (T id = 0; id < num; id++) {
+                val[id] = double(att[id]);
+            }
+            arr = make_vtk_array(per_face ? "cell_scalars" : "rad",
+                                 val.data(), num);
+        }
+        if (per_face) {
+            export_vtk_xml(filename, fvn, Verts, {}, {arr});
+        } else {
+            export_vtk_xml(filename, fvn, Verts, {arr}, {});
+        }
+        return;
+    }
 
     filename = STRINGIFY(OUTPUT_DIR) + filename;
 
     RXMESH_TRACE(" Exporting to {}", filename);
 
-    std::fstream file_vtk(filename, std::ios::out);
-    file_vtk << "# vtk DataFile Version 2.5" << std::endl;
-    file_vtk << "Unstructured Grid" << std::endl;
-    file_vtk << "ASCII" << std::endl;
-    file_vtk << "DATASET UNSTRUCTURED_GRID" << std::endl;
-    file_vtk << "POINTS " << Verts.size() << " double" << std::endl;
-    for (T ipoint = 0; ipoint < Verts.size(); ipoint++) {
-        file_vtk << Verts[ipoint][0] << " " << Verts[ipoint][1] << " "
-                 << Verts[ipoint][2] << std::endl;
+    RXMESH::BufferedWriter file_vtk;
+    if (!file_vtk.open(filename)) {
+        return;
     }
-
-    T num_faces = fvn.size();
-
-    T num_entry = num_faces * (3 + 1);  // assume all triangles
-
-    file_vtk << "CELLS " << num_faces << " " << num_entry << std::endl;
-    std::vector<T> face_vert;
-    for (T f = 0; f < num_faces; f++) {
-        face_vert = fvn[f];
-        file_vtk << 3 << " ";
-        for (T fi = 0; fi < 3 /*face_vert.size()*/; fi++) {
-            file_vtk << face_vert[fi] << "  ";
+    file_vtk.append(
+        "# vtk DataFile Version 2.5\nUnstructured Grid\nASCII\n"
+        "DATASET UNSTRUCTURED_GRID\nPOINTS " +
+        std::to_string(num_vertices) + " double\n");
+    file_vtk.write_records(num_vertices, [&](int64_t v, std::string& out) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            RXMESH::append_number(out, Verts[v][i]);
+            out.push_back(i < 2 ? ' ' : '\n');
         }
-        file_vtk << std::endl;
-    }
+    });
 
-    file_vtk << "CELL_TYPES  " << num_faces << std::endl;
-    for (T f = 0; f < num_faces; f++) {
-        file_vtk << "7" << std::endl;
-    }
+    T num_entry = num_faces * (3 + 1);  // assume all triangles
 
-    std::map<attrT, double> rand_map;
-    auto randomize_func = [&rand_map](const attrT* att, const T id) {
-        typename std::map<attrT, double>::iterator rand_map_it =
-            rand_map.find(att[id]);
-        if (rand_map_it != rand_map.end()) {
-            return rand_map[att[id]];
-        } else {
-            double val = double(rand()) / double(RAND_MAX);
-            rand_map[att[id]] = val;
-            return val;
+    file_vtk.append("CELLS " + std::to_string(num_faces) + " " +
+                    std::to_string(num_entry) + "\n");
+    file_vtk.write_records(num_faces, [&](int64_t f, std::string& out) {
+        out.push_back('3');
+        for (T fi = 0; fi < 3 /*fvn[f].size()*/; fi++) {
+            out.push_back(' ');
+            RXMESH::append_number(out, fvn[f][fi]);
         }
+        out.push_back('\n');
+    });
+
+    file_vtk.append("CELL_TYPES  " + std::to_string(num_faces) + "\n");
+    file_vtk.write_records(num_faces, [&](int64_t, std::string& out) {
+        out.append("7\n");
+    });
+
+    auto write_att = [&](const attrT* att, const T num) {
+        file_vtk.write_records(num, [&](int64_t id, std::string& out) {
+            RXMESH::append_number(out,
+                                  randomize ? rand_val[id] : double(att[id]));
+            out.push_back('\n');
+        });
     };
 
     if (per_face) {
         // face attribute
-        file_vtk << "CELL_DATA  " << num_faces << std::endl;
-        file_vtk << "SCALARS cell_scalars float  " << 1 << std::endl;
-        file_vtk << "LOOKUP_TABLE default" << std::endl;
-        for (T f = 0; f < num_faces; f++) {
-            double val = double(face_att[f]);
-            if (randomize) {
-                val = randomize_func(face_att, f);
-            }
-            file_vtk << val << std::endl;
-        }
+        file_vtk.append("CELL_DATA  " + std::to_string(num_faces) +
+                        "\nSCALARS cell_scalars float  1\n"
+                        "LOOKUP_TABLE default\n");
+        write_att(face_att, num_faces);
     } else {
         // vertex attribute
-        file_vtk << "POINT_DATA  " << Verts.size() << std::endl;
-        file_vtk << "SCALARS rad double " << 1 << std::endl;
-        file_vtk << "LOOKUP_TABLE default" << std::endl;
-        for (T v = 0; v < Verts.size(); v++) {
-            double val = double(vertex_att[v]);
-            if (randomize) {
-                val = randomize_func(vertex_att, v);
-            }
-            file_vtk << val << std::endl;
-        }
+        file_vtk.append("POINT_DATA  " + std::to_string(num_vertices) +
+                        "\nSCALARS rad double 1\nLOOKUP_TABLE default\n");
+        write_att(vertex_att, num_vertices);
+    }
+    if (!file_vtk.close()) {
+        RXMESH_ERROR("export_attribute_VTK() writing {} failed", filename);
     }
-    file_vtk.close();
 }
 
 
@@ -0,0 +1,990 @@
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "rxmesh/util/log.h"
+#include "rxmesh/util/mapped_file.h"
+
+namespace RXMESH {
+
+// Encoding of the body of a PLY file
+enum class PlyFormat : uint8_t
+{
+    ASCII = 0,
+    BINARY_LITTLE_ENDIAN = 1,
+    BINARY_BIG_ENDIAN = 2,
+};
+
+// Scalar types of the PLY properties
+enum class PlyType : uint8_t
+{
+    INVALID = 0,
+    INT8 = 1,
+    UINT8 = 2,
+    INT16 = 3,
+    UINT16 = 4,
+    INT32 = 5,
+    UINT32 = 6,
+    FLOAT32 = 7,
+    FLOAT64 = 8,
+};
+
+namespace detail {
+
+/**
+ * ply_type_size()
+ */
+inline uint32_t ply_type_size(const PlyType type)
+{
+    switch (type) {
+        case PlyType::INT8:
+        case PlyType::UINT8:
+            return 1;
+        case PlyType::INT16:
+        case PlyType::UINT16:
+            return 2;
+        case PlyType::INT32:
+        case PlyType::UINT32:
+        case PlyType::FLOAT32:
+            return 4;
+        case PlyType::FLOAT64:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * ply_type_from_string()
+ */
+inline PlyType ply_type_from_string(const std::string& str)
+{
+    // both the original names and the sized names are used in the wild
+    if (str == "char" || str == "int8") {
+        return PlyType::INT8;
+    } else if (str == "uchar" || str == "uint8") {
+        return PlyType::UINT8;
+    } else if (str == "short" || str == "int16") {
+        return PlyType::INT16;
+    } else if (str == "ushort" || str == "uint16") {
+        return PlyType::UINT16;
+    } else if (str == "int" || str == "int32") {
+        return PlyType::INT32;
+    } else if (str == "uint" || str == "uint32") {
+        return PlyType::UINT32;
+    } else if (str == "float" || str == "float32") {
+        return PlyType::FLOAT32;
+    } else if (str == "double" || str == "float64") {
+        return PlyType::FLOAT64;
+    }
+    return PlyType::INVALID;
+}
+
+/**
+ * ply_type_to_string()
+ */
+inline const char* ply_type_to_string(const PlyType type)
+{
+    switch (type) {
+        case PlyType::INT8:
+            return "char";
+        case PlyType::UINT8:
+            return "uchar";
+        case PlyType::INT16:
+            return "short";
+        case PlyType::UINT16:
+            return "ushort";
+        case PlyType::INT32:
+            return "int";
+        case PlyType::UINT32:
+            return "uint";
+        case PlyType::FLOAT32:
+            return "float";
+        case PlyType::FLOAT64:
+            return "double";
+        default:
+            return "invalid";
+    }
+}
+
+/**
+ * ply_type_of()
+ */
+template <typename T>
+constexpr PlyType ply_type_of()
+{
+    return std::is_same<T, int8_t>::value   ? PlyType::INT8 :
+           std::is_same<T, uint8_t>::value  ? PlyType::UINT8 :
+           std::is_same<T, int16_t>::value  ? PlyType::INT16 :
+           std::is_same<T, uint16_t>::value ? PlyType::UINT16 :
+           std::is_same<T, int32_t>::value  ? PlyType::INT32 :
+           std::is_same<T, uint32_t>::value ? PlyType::UINT32 :
+           std::is_same<T, float>::value    ? PlyType::FLOAT32 :
+           std::is_same<T, double>::value   ? PlyType::FLOAT64 :
+                                              PlyType::INVALID;
+}
+
+/**
+ * ply_host_format()
+ */
+inline PlyFormat ply_host_format()
+{
+    const uint16_t one = 1;
+    uint8_t        first;
+    std::memcpy(&first, &one, 1);
+    return first == 1 ? PlyFormat::BINARY_LITTLE_ENDIAN :
+                        PlyFormat::BINARY_BIG_ENDIAN;
+}
+
+/**
+ * ply_swap_bytes()
+ */
+inline void ply_swap_bytes(char* ptr, const uint32_t size)
+{
+    std::reverse(ptr, ptr + size);
+}
+
+/**
+ * ply_get()
+ */
+template <typename T>
+inline T ply_get(const char* src, const PlyType type)
+{
+    // read a value stored in native byte order as type and cast it to T
+    switch (type) {
+        case PlyType::INT8: {
+            int8_t val;
+            std::memcpy(&val, src, sizeof(val));
+            return static_cast<T>(val);
+        }
+        case PlyType::UINT8: {
+            uint8_t val;
+            std::memcpy(&val, src, sizeof(val));
+            return static_cast<T>(val);
+        }
+        case PlyType::INT16: {
+            int16_t val;
+            std::memcpy(&val, src, sizeof(val));
+            return static_cast<T>(val);
+        }
+        case PlyType::UINT16: {
+            uint16_t val;
+            std::memcpy(&val, src, sizeof(val));
+            return static_cast<T>(val);
+        }
+        case PlyType::INT32: {
+            int32_t val;
+            std::memcpy(&val, src, sizeof(val));
+            return static_cast<T>(val);
+        }
+        case PlyType::UINT32: {
+            uint32_t val;
+            std::memcpy(&val, src, sizeof(val));
+            return static_cast<T>(val);
+        }
+        case PlyType::FLOAT32: {
+            float val;
+            std::memcpy(&val, src, sizeof(val));
+            return static_cast<T>(val);
+        }
+        case PlyType::FLOAT64: {
+            double val;
+            std::memcpy(&val, src, sizeof(val));
+            return static_cast<T>(val);
+        }
+        default:
+            return T(0);
+    }
+}
+
+/**
+ * ply_set()
+ */
+template <typename T>
+inline void ply_set(char* dst, const PlyType type, const T value)
+{
+    // cast value to type and store it in native byte order
+    switch (type) {
+        case PlyType::INT8: {
+            const int8_t val = static_cast<int8_t>(value);
+            std::memcpy(dst, &val, sizeof(val));
+            break;
+        }
+        case PlyType::UINT8: {
+            const uint8_t val = static_cast<uint8_t>(value);
+            std::memcpy(dst, &val, sizeof(val));
+            break;
+        }
+        case PlyType::INT16: {
+            const int16_t val = static_cast<int16_t>(value);
+            std::memcpy(dst, &val, sizeof(val));
+            break;
+        }
+        case PlyType::UINT16: {
+            const uint16_t val = static_cast<uint16_t>(value);
+            std::memcpy(dst, &val, sizeof(val));
+            break;
+        }
+        case PlyType::INT32: {
+            const int32_t val = static_cast<int32_t>(value);
+            std::memcpy(dst, &val, sizeof(val));
+            break;
+        }
+        case PlyType::UINT32: {
+            const uint32_t val = static_cast<uint32_t>(value);
+            std::memcpy(dst, &val, sizeof(val));
+            break;
+        }
+        case PlyType::FLOAT32: {
+            const float val = static_cast<float>(value);
+            std::memcpy(dst, &val, sizeof(val));
+            break;
+        }
+        case PlyType::FLOAT64: {
+            const double val = static_cast<double>(value);
+            std::memcpy(dst, &val, sizeof(val));
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/**
+ * ply_is_float()
+ */
+inline bool ply_is_float(const PlyType type)
+{
+    return type == PlyType::FLOAT32 || type == PlyType::FLOAT64;
+}
+}  // namespace detail
+
+/**
+ * PlyProperty
+ * One property of a PLY element for all the element instances. Values are
+ * stored packed with the size of their type in native byte order. For list
+ * properties (e.g., the face vertex indices), the values of all the lists
+ * are concatenated and m_offset[i] is where the list of instance i starts
+ * i.e., the lists are kept flat as CSR
+ */
+struct PlyProperty
+{
+    std::string name;
+    // type of the values (the list items for list properties)
+    PlyType type = PlyType::INVALID;
+    // type of the list size. INVALID for scalar properties
+    PlyType count_type = PlyType::INVALID;
+
+    std::vector<char>     data;
+    std::vector<uint32_t> offset;
+
+    bool is_list() const
+    {
+        return count_type != PlyType::INVALID;
+    }
+
+    /**
+     * get_list_size()
+     */
+    uint32_t get_list_size(const uint32_t i) const
+    {
+        return is_list() ? offset[i + 1] - offset[i] : 1;
+    }
+
+    /**
+     * get()
+     */
+    template <typename T>
+    T get(const uint32_t i, const uint32_t j = 0) const
+    {
+        // value of instance i (the j-th list item for list properties)
+        const size_t id = is_list() ? size_t(offset[i]) + j : size_t(i);
+        return detail::ply_get<T>(
+            data.data() + id * detail::ply_type_size(type), type);
+    }
+
+    /**
+     * set()
+     */
+    template <typename T>
+    void set(const uint32_t i, const T value, const uint32_t j = 0)
+    {
+        const size_t id = is_list() ? size_t(offset[i]) + j : size_t(i);
+        detail::ply_set(data.data() + id * detail::ply_type_size(type), type,
+                        value);
+    }
+};
+
+/**
+ * PlyElement
+ */
+struct PlyElement
+{
+    std::string              name;
+    uint32_t                 count = 0;
+    std::vector<PlyProperty> properties;
+
+    /**
+     * find_property()
+     */
+    const PlyProperty* find_property(const std::string& prop_name) const
+    {
+        for (const PlyProperty& prop : properties) {
+            if (prop.name == prop_name) {
+                return &prop;
+            }
+        }
+        return nullptr;
+    }
+
+    PlyProperty* find_property(const std::string& prop_name)
+    {
+        return const_cast<PlyProperty*>(
+            static_cast<const PlyElement*>(this)->find_property(prop_name));
+    }
+
+    /**
+     * add_property()
+     */
+    template <typename T>
+    PlyProperty& add_property(const std::string& prop_name)
+    {
+        // add (or replace) a scalar property of type T. Values are zero
+        // until set with PlyProperty::set()
+        static_assert(detail::ply_type_of<T>() != PlyType::INVALID,
+                      "PlyElement::add_property() T is not a PLY type");
+        PlyProperty* prop = find_property(prop_name);
+        if (prop == nullptr) {
+            properties.emplace_back();
+            prop = &properties.back();
+            prop->name = prop_name;
+        }
+        prop->type = detail::ply_type_of<T>();
+        prop->count_type = PlyType::INVALID;
+        prop->offset.clear();
+        prop->data.assign(size_t(count) * sizeof(T), 0);
+        return *prop;
+    }
+
+    /**
+     * add_list_property()
+     */
+    template <typename T, typename CountT = uint8_t, typename ListT>
+    PlyProperty& add_list_property(const std::string&              prop_name,
+                                   const std::vector<std::vector<ListT>>& lists)
+    {
+        // add (or replace) a list property of type T with the list size
+        // stored as CountT e.g., the face vertex indices from the faces used
+        // to construct RXMesh
+        static_assert(detail::ply_type_of<T>() != PlyType::INVALID &&
+                          detail::ply_type_of<CountT>() != PlyType::INVALID,
+                      "PlyElement::add_list_property() T or CountT is not a "
+                      "PLY type");
+        if (lists.size() != count) {
+            RXMESH_ERROR(
+                "PlyElement::add_list_property() {} lists do not match the "
+                "{} instances of {}",
+                lists.size(), count, name);
+        }
+        PlyProperty* prop = find_property(prop_name);
+        if (prop == nullptr) {
+            properties.emplace_back();
+            prop = &properties.back();
+            prop->name = prop_name;
+        }
+        prop->type = detail::ply_type_of<T>();
+        prop->count_type = detail::ply_type_of<CountT>();
+        prop->offset.resize(size_t(count) + 1);
+        prop->offset[0] = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            const size_t size = i < lists.size() ? lists[i].size() : 0;
+            prop->offset[i + 1] = prop->offset[i] + uint32_t(size);
+        }
+        prop->data.resize(size_t(prop->offset[count]) * sizeof(T));
+
+        const int64_t num_lists = std::min<size_t>(count, lists.size());
+#pragma omp parallel for schedule(static)
+        for (int64_t i = 0; i < num_lists; ++i) {
+            for (uint32_t j = 0; j < lists[i].size(); ++j) {
+                const T val = static_cast<T>(lists[i][j]);
+                std::memcpy(prop->data.data() +
+                                (size_t(prop->offset[i]) + j) * sizeof(T),
+                            &val, sizeof(T));
+            }
+        }
+        return *prop;
+    }
+};
+
+/**
+ * PlyData
+ * Content of a PLY file: every element with all its properties. Filled by
+ * import_ply() and written by export_ply()
+ */
+struct PlyData
+{
+    PlyFormat                format = PlyFormat::BINARY_LITTLE_ENDIAN;
+    std::vector<std::string> comments;
+    std::vector<PlyElement>  elements;
+
+    /**
+     * find_element()
+     */
+    const PlyElement* find_element(const std::string& ele_name) const
+    {
+        for (const PlyElement& ele : elements) {
+            if (ele.name == ele_name) {
+                return &ele;
+            }
+        }
+        return nullptr;
+    }
+
+    PlyElement* find_element(const std::string& ele_name)
+    {
+        return const_cast<PlyElement*>(
+            static_cast<const PlyData*>(this)->find_element(ele_name));
+    }
+
+    /**
+     * add_element()
+     */
+    PlyElement& add_element(const std::string& ele_name, const uint32_t count)
+    {
+        // return the element if it exists with the same count. Otherwise,
+        // (re)create it with no properties
+        PlyElement* ele = find_element(ele_name);
+        if (ele == nullptr) {
+            elements.emplace_back();
+            ele = &elements.back();
+            ele->name = ele_name;
+        } else if (ele->count != count) {
+            ele->properties.clear();
+        }
+        ele->count = count;
+        return *ele;
+    }
+
+    void clear()
+    {
+        comments.clear();
+        elements.clear();
+    }
+};
+
+namespace detail {
+
+/**
+ * ply_next_token()
+ */
+inline bool ply_next_token(const char*& ptr,
+                           const char*  end,
+                           char*        token,
+                           const size_t max_len)
+{
+    // copy the next white-space separated token of an ASCII body into token
+    // (null terminated) since the mapped file is not
+    while (ptr < end && (*ptr == ' ' || *ptr == '\t' || *ptr == '\n' ||
+                         *ptr == '\r')) {
+        ++ptr;
+    }
+    size_t len = 0;
+    while (ptr < end && *ptr != ' ' && *ptr != '\t' && *ptr != '\n' &&
+           *ptr != '\r') {
+        if (len + 1 < max_len) {
+            token[len++] = *ptr;
+        }
+        ++ptr;
+    }
+    token[len] = '\0';
+    return len > 0;
+}
+
+/**
+ * ply_parse_ascii()
+ */
+inline bool ply_parse_ascii(const char*&  ptr,
+                            const char*   end,
+                            const PlyType type,
+                            char*         dst)
+{
+    // parse one ASCII value into dst with its type
+    char token[128];
+    if (!ply_next_token(ptr, end, token, sizeof(token))) {
+        return false;
+    }
+    char* token_end = nullptr;
+    if (ply_is_float(type)) {
+        const double val = std::strtod(token, &token_end);
+        ply_set(dst, type, val);
+    } else {
+        const long long val = std::strtoll(token, &token_end, 10);
+        ply_set(dst, type, val);
+    }
+    return token_end != token && *token_end == '\0';
+}
+
+/**
+ * ply_parse_header()
+ */
+inline bool ply_parse_header(const char*        begin,
+                             const char*        end,
+                             PlyData&           ply,
+                             const char*&       body,
+                             const std::string& file_name)
+{
+    // parse the header and point body to the first byte after end_header
+    const char* ptr = begin;
+    auto        next_line = [&](std::string& line) {
+        if (ptr >= end) {
+            return false;
+        }
+        const char* line_end = static_cast<const char*>(
+            std::memchr(ptr, '\n', size_t(end - ptr)));
+        if (line_end == nullptr) {
+            line_end = end;
+        }
+        line.assign(ptr, line_end);
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        ptr = (line_end < end) ? line_end + 1 : end;
+        return true;
+    };
+
+    std::string line;
+    if (!next_line(line) || line != "ply") {
+        RXMESH_ERROR("import_ply() {} is not a PLY file", file_name);
+        return false;
+    }
+
+    bool has_format = false;
+    while (next_line(line)) {
+        std::istringstream ls(line);
+        std::string        keyword;
+        if (!(ls >> keyword)) {
+            continue;
+        }
+        if (keyword == "format") {
+            std::string format, version;
+            ls >> format >> version;
+            if (format == "ascii") {
+                ply.format = PlyFormat::ASCII;
+            } else if (format == "binary_little_endian") {
+                ply.format = PlyFormat::BINARY_LITTLE_ENDIAN;
+            } else if (format == "binary_big_endian") {
+                ply.format = PlyFormat::BINARY_BIG_ENDIAN;
+            } else {
+                RXMESH_ERROR("import_ply() unknown format {} in {}", format,
+                             file_name);
+                return false;
+            }
+            has_format = true;
+        } else if (keyword == "comment" || keyword == "obj_info") {
+            const size_t start = line.find(keyword) + keyword.size();
+            ply.comments.push_back(
+                start < line.size() ? line.substr(start + 1) : "");
+        } else if (keyword == "element") {
+            PlyElement ele;
+            long long  count = -1;
+            ls >> ele.name >> count;
+            if (ele.name.empty() || count < 0 || count > UINT32_MAX) {
+                RXMESH_ERROR("import_ply() invalid element line \"{}\" in {}",
+                             line, file_name);
+                return false;
+            }
+            ele.count = static_cast<uint32_t>(count);
+            ply.elements.push_back(ele);
+        } else if (keyword == "property") {
+            if (ply.elements.empty()) {
+                RXMESH_ERROR("import_ply() property before any element in {}",
+                             file_name);
+                return false;
+            }
+            PlyProperty prop;
+            std::string type;
+            ls >> type;
+            if (type == "list") {
+                std::string count_type;
+                ls >> count_type >> type;
+                prop.count_type = ply_type_from_string(count_type);
+                if (prop.count_type == PlyType::INVALID ||
+                    ply_is_float(prop.count_type)) {
+                    RXMESH_ERROR(
+                        "import_ply() invalid list size type \"{}\" in {}",
+                        line, file_name);
+                    return false;
+                }
+            }
+            prop.type = ply_type_from_string(type);
+            ls >> prop.name;
+            if (prop.type == PlyType::INVALID || prop.name.empty()) {
+                RXMESH_ERROR("import_ply() invalid property \"{}\" in {}",
+                             line, file_name);
+                return false;
+            }
+            ply.elements.back().properties.push_back(prop);
+        } else if (keyword == "end_header") {
+            if (!has_format) {
+                RXMESH_ERROR("import_ply() {} has no format line", file_name);
+                return false;
+            }
+            body = ptr;
+            return true;
+        } else {
+            RXMESH_ERROR("import_ply() invalid header line \"{}\" in {}",
+                         line, file_name);
+            return false;
+        }
+    }
+    RXMESH_ERROR("import_ply() {} has no end_header", file_name);
+    return false;
+}
+
+/**
+ * ply_read_binary_element()
+ */
+inline bool ply_read_binary_element(const char*&       ptr,
+                                    const char*        end,
+                                    PlyElement&        ele,
+                                    const bool         swap,
+                                    const std::string& file_name)
+{
+    const size_t num = ele.count;
+
+    // every record takes at least its scalar properties plus the size of
+    // every list. Check the count against what is left in the file before
+    // allocating anything (dividing so that num * bytes can not overflow)
+    size_t min_record_bytes = 0;
+    for (const PlyProperty& prop : ele.properties) {
+        min_record_bytes += prop.is_list() ? ply_type_size(prop.count_type) :
+                                             ply_type_size(prop.type);
+    }
+    if (min_record_bytes > 0 &&
+        num > size_t(end - ptr) / min_record_bytes) {
+        RXMESH_ERROR(
+            "import_ply() {} declares {} {} elements which do not fit in the "
+            "remaining {} bytes of the file",
+            file_name, num, ele.name, size_t(end - ptr));
+        return false;
+    }
+
+    bool     has_list = false;
+    uint32_t stride = 0;
+    for (PlyProperty& prop : ele.properties) {
+        const uint32_t size = ply_type_size(prop.type);
+        if (prop.is_list()) {
+            has_list = true;
+            prop.offset.assign(num + 1, 0);
+            // most lists are triangles
+            prop.data.reserve(num * 3 * size);
+        } else {
+            prop.data.resize(num * size);
+            stride += size;
+        }
+    }
+
+    if (!has_list) {
+        // fixed-size records (e.g., the vertices) are decoded in parallel
+        if (size_t(end - ptr) < num * stride) {
+            RXMESH_ERROR("import_ply() {} is truncated in element {}",
+                         file_name, ele.name);
+            return false;
+        }
+        const char* base = ptr;
+#pragma omp parallel for schedule(static)
+        for (int64_t i = 0; i < int64_t(num); ++i) {
+            const char* src = base + i * stride;
+            for (PlyProperty& prop : ele.properties) {
+                const uint32_t size = ply_type_size(prop.type);
+                char*          dst = prop.data.data() + i * size;
+                std::memcpy(dst, src, size);
+                if (swap) {
+                    ply_swap_bytes(dst, size);
+                }
+                src += size;
+            }
+        }
+        ptr += num * stride;
+        return true;
+    }
+
+    // variable-size records are read sequentially. List items are appended
+    // to the flat list storage
+    for (size_t i = 0; i < num; ++i) {
+        for (PlyProperty& prop : ele.properties) {
+            const uint32_t size = ply_type_size(prop.type);
+            if (!prop.is_list()) {
+                if (ptr + size > end) {
+                    RXMESH_ERROR("import_ply() {} is truncated in element {}",
+                                 file_name, ele.name);
+                    return false;
+                }
+                char* dst = prop.data.data() + i * size;
+                std::memcpy(dst, ptr, size);
+                if (swap) {
+                    ply_swap_bytes(dst, size);
+                }
+                ptr += size;
+                continue;
+            }
+            const uint32_t count_size = ply_type_size(prop.count_type);
+            if (ptr + count_size > end) {
+                RXMESH_ERROR("import_ply() {} is truncated in element {}",
+                             file_name, ele.name);
+                return false;
+            }
+            char count_bytes[8];
+            std::memcpy(count_bytes, ptr, count_size);
+            if (swap) {
+                ply_swap_bytes(count_bytes, count_size);
+            }
+            ptr += count_size;
+            const int64_t list_size =
+                ply_get<int64_t>(count_bytes, prop.count_type);
+            if (list_size < 0 || size_t(list_size) > size_t(end - ptr) / size) {
+                RXMESH_ERROR(
+                    "import_ply() {} has an invalid list in element {}",
+                    file_name, ele.name);
+                return false;
+            }
+            const size_t list_bytes = size_t(list_size) * size;
+            const size_t first = prop.data.size();
+            prop.data.resize(first + list_bytes);
+            std::memcpy(prop.data.data() + first, ptr, list_bytes);
+            if (swap) {
+                for (int64_t j = 0; j < list_size; ++j) {
+                    ply_swap_bytes(prop.data.data() + first + j * size, size);
+                }
+            }
+            ptr += list_bytes;
+            prop.offset[i + 1] = prop.offset[i] + uint32_t(list_size);
+        }
+    }
+    return true;
+}
+
+/**
+ * ply_read_ascii_element()
+ */
+inline bool ply_read_ascii_element(const char*&       ptr,
+                                   const char*        end,
+                                   PlyElement&        ele,
+                                   const std::string& file_name)
+{
+    const size_t num = ele.count;
+    for (PlyProperty& prop : ele.properties) {
+        const uint32_t size = ply_type_size(prop.type);
+        if (prop.is_list()) {
+            prop.offset.assign(num + 1, 0);
+            prop.data.reserve(num * 3 * size);
+        } else {
+            prop.data.resize(num * size);
+        }
+    }
+
+    for (size_t i = 0; i < num; ++i) {
+        for (PlyProperty& prop : ele.properties) {
+            const uint32_t size = ply_type_size(prop.type);
+            if (!prop.is_list()) {
+                if (!ply_parse_ascii(
+                        ptr, end, prop.type, prop.data.data() + i * size)) {
+                    RXMESH_ERROR(
+                        "import_ply() invalid value of {} in element {} [{}] "
+                        "in {}",
+                        prop.name, ele.name, i, file_name);
+                    return false;
+                }
+                continue;
+            }
+            char count_bytes[8];
+            if (!ply_parse_ascii(ptr, end, prop.count_type, count_bytes)) {
+                RXMESH_ERROR(
+                    "import_ply() invalid list size of {} in element {} [{}] "
+                    "in {}",
+                    prop.name, ele.name, i, file_name);
+                return false;
+            }
+            const int64_t list_size =
+                ply_get<int64_t>(count_bytes, prop.count_type);
+            if (list_size < 0) {
+                RXMESH_ERROR(
+                    "import_ply() invalid list size of {} in element {} [{}] "
+                    "in {}",
+                    prop.name, ele.name, i, file_name);
+                return false;
+            }
+            const size_t first = prop.data.size();
+            prop.data.resize(first + size_t(list_size) * size);
+            for (int64_t j = 0; j < list_size; ++j) {
+                if (!ply_parse_ascii(ptr, end, prop.type,
+                                     prop.data.data() + first + j * size)) {
+                    RXMESH_ERROR(
+                        "import_ply() invalid list of {} in element {} [{}] "
+                        "in {}",
+                        prop.name, ele.name, i, file_name);
+                    return false;
+                }
+            }
+            prop.offset[i + 1] = prop.offset[i] + uint32_t(list_size);
+        }
+    }
+    return true;
+}
+}  // namespace detail
+
+/**
+ * import_ply()
+ */
+inline bool import_ply(const std::string& fileName,
+                       PlyData&           ply,
+                       bool               quite = false)
+{
+    // Read every element and property of an ASCII or binary (little or big
+    // endian) PLY file. The file is memory mapped and binary elements with
+    // no list properties are decoded in parallel
+    ply.clear();
+
+    MappedFile file;
+    if (!file.open(fileName)) {
+        RXMESH_ERROR("import_ply() can not open {}", fileName);
+        return false;
+    }
+    if (!quite) {
+        RXMESH_TRACE("Reading {}", fileName);
+    }
+
+    const char* begin = file.data();
+    const char* end = begin + file.size();
+    const char* ptr = nullptr;
+    if (!detail::ply_parse_header(begin, end, ply, ptr, fileName)) {
+        ply.clear();
+        return false;
+    }
+
+    const bool swap = ply.format != PlyFormat::ASCII &&
+                      ply.format != detail::ply_host_format();
+    for (PlyElement& ele : ply.elements) {
+        const bool ok =
+            (ply.format == PlyFormat::ASCII) ?
+                detail::ply_read_ascii_element(ptr, end, ele, fileName) :
+                detail::ply_read_binary_element(ptr, end, ele, swap, fileName);
+        if (!ok) {
+            ply.clear();
+            return false;
+        }
+    }
+
+    if (!quite) {
+        for (const PlyElement& ele : ply.elements) {
+            RXMESH_TRACE("import_ply() #{}= {} with {} properties", ele.name,
+                         ele.count, ele.properties.size());
+        }
+    }
+    return true;
+}
+
+/**
+ * import_ply()
+ */
+template <typename DATA_T, typename INDEX_T>
+bool import_ply(const std::string                  fileName,
+                std::vector<std::vector<DATA_T>>&  Verts,
+                std::vector<std::vector<INDEX_T>>& Faces,
+                PlyData&                           ply,
+                bool                               quite = false)
+{
+    // Read the mesh in the same form as import_obj() i.e., what RXMesh is
+    // constructed from. Vertices are the x, y, and z properties of the
+    // vertex element and faces are the vertex_indices (or vertex_index)
+    // list of the face element. ply keeps all the properties to be loaded
+    // into attributes (see RXMeshStatic::import_ply_attribute())
+    Verts.clear();
+    Faces.clear();
+    if (!import_ply(fileName, ply, quite)) {
+        return false;
+    }
+
+    const PlyElement* vertex = ply.find_element("vertex");
+    if (vertex == nullptr) {
+        RXMESH_ERROR("import_ply() {} has no vertex element", fileName);
+        return false;
+    }
+    const PlyProperty* coord[3] = {vertex->find_property("x"),
+                                   vertex->find_property("y"),
+                                   vertex->find_property("z")};
+    for (uint32_t i = 0; i < 3; ++i) {
+        if (coord[i] == nullptr || coord[i]->is_list()) {
+            RXMESH_ERROR("import_ply() {} has no x, y, and z properties",
+                         fileName);
+            return false;
+        }
+    }
+    const uint32_t num_vertices = vertex->count;
+    Verts.resize(num_vertices);
+#pragma omp parallel for schedule(static)
+    for (int64_t v = 0; v < int64_t(num_vertices); ++v) {
+        Verts[v] = {coord[0]->get<DATA_T>(uint32_t(v)),
+                    coord[1]->get<DATA_T>(uint32_t(v)),
+                    coord[2]->get<DATA_T>(uint32_t(v))};
+    }
+
+    const PlyElement* face = ply.find_element("face");
+    if (face == nullptr) {
+        // point cloud
+        return true;
+    }
+    const PlyProperty* fv = face->find_property("vertex_indices");
+    if (fv == nullptr) {
+        fv = face->find_property("vertex_index");
+    }
+    if (fv == nullptr || !fv->is_list() || detail::ply_is_float(fv->type)) {
+        RXMESH_ERROR("import_ply() {} has no vertex_indices face property",
+                     fileName);
+        Verts.clear();
+        return false;
+    }
+
+    const uint32_t num_faces = face->count;
+    Faces.resize(num_faces);
+    bool valid = true;
+#pragma omp parallel for schedule(static) reduction(&& : valid)
+    for (int64_t f = 0; f < int64_t(num_faces); ++f) {
+        const uint32_t size = fv->get_list_size(uint32_t(f));
+        Faces[f].resize(size);
+        for (uint32_t j = 0; j < size; ++j) {
+            const int64_t id = fv->get<int64_t>(uint32_t(f), j);
+            valid = valid && id >= 0 && id < int64_t(num_vertices);
+            Faces[f][j] = static_cast<INDEX_T>(id);
+        }
+    }
+    if (!valid) {
+        RXMESH_ERROR("import_ply() {} has a face with an invalid vertex index",
+                     fileName);
+        Verts.clear();
+        Faces.clear();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * import_ply()
+ */
+template <typename DATA_T, typename INDEX_T>
+bool import_ply(const std::string                  fileName,
+                std::vector<std::vector<DATA_T>>&  Verts,
+                std::vector<std::vector<INDEX_T>>& Faces,
+                bool                               quite = false)
+{
+    PlyData ply;
+    return import_ply(fileName, Verts, Faces, ply, quite);
+}
+}  // namespace RXMESH
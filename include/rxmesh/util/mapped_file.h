@@ -0,0 +1,179 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include "rxmesh/util/log.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace RXMESH {
+
+/**
+ * checksum64()
+ */
+inline uint64_t checksum64(const void* data, const size_t bytes)
+{
+    // FNV-1a over 8-byte words (and the trailing bytes) followed by a final
+    // avalanche. Not cryptographic. Only meant to catch truncated or
+    // corrupted files
+    constexpr uint64_t prime = 0x100000001b3ull;
+    uint64_t           hash = 0xcbf29ce484222325ull ^ uint64_t(bytes);
+
+    const unsigned char* ptr = static_cast<const unsigned char*>(data);
+    const size_t         num_words = bytes / sizeof(uint64_t);
+    for (size_t i = 0; i < num_words; ++i) {
+        uint64_t word;
+        std::memcpy(&word, ptr + i * sizeof(uint64_t), sizeof(uint64_t));
+        hash = (hash ^ word) * prime;
+    }
+    for (size_t i = num_words * sizeof(uint64_t); i < bytes; ++i) {
+        hash = (hash ^ uint64_t(ptr[i])) * prime;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+class MappedFile
+{
+    // Read-only file mapped into memory with copy-on-write pages i.e., the
+    // mapped data can be modified without touching the file. Pages are
+    // brought in by the OS on first access so mapping a large file is cheap
+
+   public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile()
+    {
+        close();
+    }
+
+    /**
+     * open()
+     */
+    bool open(const std::string& file_name)
+    {
+        close();
+#ifdef _WIN32
+        m_file = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                             NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (m_file == INVALID_HANDLE_VALUE) {
+            RXMESH_ERROR("MappedFile::open() can not open {}", file_name);
+            return false;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+            RXMESH_ERROR("MappedFile::open() {} is empty", file_name);
+            close();
+            return false;
+        }
+        m_size = static_cast<size_t>(size.QuadPart);
+        m_mapping =
+            CreateFileMappingA(m_file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+        if (m_mapping != NULL) {
+            m_data = MapViewOfFile(m_mapping, FILE_MAP_COPY, 0, 0, 0);
+        }
+#else
+        m_file = ::open(file_name.c_str(), O_RDONLY);
+        if (m_file < 0) {
+            RXMESH_ERROR("MappedFile::open() can not open {}", file_name);
+            return false;
+        }
+        struct stat st;
+        if (fstat(m_file, &st) != 0 || st.st_size == 0) {
+            RXMESH_ERROR("MappedFile::open() {} is empty", file_name);
+            close();
+            return false;
+        }
+        m_size = static_cast<size_t>(st.st_size);
+        void* ptr = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                         m_file, 0);
+        m_data = (ptr == MAP_FAILED) ? nullptr : ptr;
+#endif
+        if (m_data == nullptr) {
+            RXMESH_ERROR("MappedFile::open() can not map {}", file_name);
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * close()
+     */
+    void close()
+    {
+#ifdef _WIN32
+        if (m_data != nullptr) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping != NULL) {
+            CloseHandle(m_mapping);
+            m_mapping = NULL;
+        }
+        if (m_file != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_file);
+            m_file = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (m_data != nullptr) {
+            munmap(m_data, m_size);
+        }
+        if (m_file >= 0) {
+            ::close(m_file);
+            m_file = -1;
+        }
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    bool is_open() const
+    {
+        return m_data != nullptr;
+    }
+
+    char* data() const
+    {
+        return static_cast<char*>(m_data);
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    bool contains(const void* ptr) const
+    {
+        return m_data != nullptr && ptr >= m_data &&
+               static_cast<const char*>(ptr) < data() + m_size;
+    }
+
+   private:
+#ifdef _WIN32
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = NULL;
+#else
+    int m_file = -1;
+#endif
+    void*  m_data = nullptr;
+    size_t m_size = 0;
+};
+}  // namespace RXMESH
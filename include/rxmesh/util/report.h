@@ -300,6 +300,21 @@ struct Report
                    subdoc);
         add_member("total_gpu_storage (mb)", rxmesh.get_gpu_storage_mb(),
                    subdoc);
+        add_member("total_host_storage (mb)", rxmesh.get_host_storage_mb(),
+                   subdoc);
+        add_member("peak_host_storage (mb)", rxmesh.get_peak_host_storage_mb(),
+                   subdoc);
+        for (auto& it : rxmesh.get_host_storage_breakdown_mb()) {
+            if (it.first == "total") {
+                continue;
+            }
+            add_member("host_storage_" + it.first + " (mb)", it.second,
+                       subdoc);
+            add_member(
+                "peak_host_storage_" + it.first + " (mb)",
+                rxmesh.get_peak_host_storage_breakdown_mb().at(it.first),
+                subdoc);
+        }
         m_doc.AddMember("Model", subdoc, m_doc.GetAllocator());
     }
 
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <numeric>
 #include <random>
+#include <vector>
 #include "rxmesh/util/macros.h"
 
 namespace RXMESH {
@@ -47,6 +48,32 @@ inline void print_device_memory_usage()
     RXMESH_TRACE(" device memory mem used: {} (MB)", used_m);
 }
 
+/**
+ * get_host_bytes()
+ */
+template <typename T>
+inline size_t get_host_bytes(const std::vector<T>& vect)
+{
+    // number of bytes reserved by the vector on the host (counting its
+    // capacity and not only its size)
+    return vect.capacity() * sizeof(T);
+}
+
+/**
+ * get_host_bytes()
+ */
+template <typename T>
+inline size_t get_host_bytes(const std::vector<std::vector<T>>& vect)
+{
+    // number of bytes reserved by a vector of vectors i.e., the outer vector
+    // plus every inner vector
+    size_t bytes = vect.capacity() * sizeof(std::vector<T>);
+    for (size_t i = 0; i < vect.size(); ++i) {
+        bytes += get_host_bytes(vect[i]);
+    }
+    return bytes;
+}
+
 /**
  * find_index()
  */
@@ -357,4 +384,41 @@ void in_place_matrix_transpose(RandomIterator first,
         } while ((first + a) != cycle);
     }
 }
+
+
+/**
+ * matrix_transpose()
+ */
+template <typename T>
+void matrix_transpose(const T* const in,
+                      T*             out,
+                      const uint64_t num_rows,
+                      const uint64_t num_cols)
+{
+    // out-of-place transpose of the row-major num_rows x num_cols matrix in
+    // into out (which is then num_cols x num_rows row-major). The matrix is
+    // processed in square tiles small enough to stay in L1 so that the strided
+    // side of the transpose (reads or writes) reuses the cache lines it
+    // touches. Tiles are distributed over OpenMP threads in row-major order so
+    // every thread works on a contiguous part of in (for tall matrices) or
+    // out (for wide matrices)
+    constexpr uint64_t tile = std::max<uint64_t>(8, 128 / sizeof(T));
+
+    const uint64_t row_tiles = DIVIDE_UP(num_rows, tile);
+    const uint64_t col_tiles = DIVIDE_UP(num_cols, tile);
+    const int64_t  num_tiles = static_cast<int64_t>(row_tiles * col_tiles);
+
+#pragma omp parallel for schedule(static)
+    for (int64_t t = 0; t < num_tiles; ++t) {
+        const uint64_t r0 = (uint64_t(t) / col_tiles) * tile;
+        const uint64_t c0 = (uint64_t(t) % col_tiles) * tile;
+        const uint64_t r1 = std::min(r0 + tile, num_rows);
+        const uint64_t c1 = std::min(c0 + tile, num_cols);
+        for (uint64_t c = c0; c < c1; ++c) {
+            for (uint64_t r = r0; r < r1; ++r) {
+                out[c * num_rows + r] = in[r * num_cols + c];
+            }
+        }
+    }
+}
 }  // namespace RXMESH
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "rxmesh/kernels/rxmesh_iterator.cuh"
+#include "rxmesh/kernels/rxmesh_query_dispatcher.cuh"
+#include "rxmesh/rxmesh_context.h"
+
+/**
+ * face_visit()
+ */
+template <uint32_t blockThreads, typename visitT>
+__launch_bounds__(blockThreads) __global__
+    static void face_visit(const RXMESH::RXMeshContext context,
+                           uint32_t*                   d_face_visits,
+                           visitT                      visit)
+{
+    using namespace RXMESH;
+
+    // count how many times each face of the dispatched patches is visited
+    // and call visit(face_id, fv) for every visit
+    auto count = [&](uint32_t face_id, RXMeshIterator& fv) {
+        atomicAdd(d_face_visits + face_id, 1u);
+        visit(face_id, fv);
+    };
+
+    query_block_dispatcher<Op::FV, blockThreads>(context, count);
+}
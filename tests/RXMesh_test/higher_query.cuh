@@ -21,7 +21,7 @@ __launch_bounds__(blockThreads) __global__
 {
     using namespace RXMESH;
     uint32_t block_offset = 0;
-    if constexpr (op == Op::EV || op == Op::EF) {
+    if constexpr (op == Op::EV || op == Op::EE || op == Op::EF) {
         block_offset = context.get_edge_distribution()[blockIdx.x];
     } else if constexpr (op == Op::FV || op == Op::FE || op == Op::FF) {
         block_offset = context.get_face_distribution()[blockIdx.x];
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stdint.h>
+#include <queue>
+#include <vector>
+
+#include "rxmesh/util/macros.h"
+
+/**
+ * host_bfs()
+ */
+inline std::vector<uint32_t> host_bfs(
+    const std::vector<std::vector<uint32_t>>& Faces,
+    const uint32_t                            num_vertices,
+    const std::vector<uint32_t>&              seeds)
+{
+    // serial BFS on the host used as a reference. Returns the number of
+    // edges between every vertex and its closest seed (INVALID32 for
+    // vertices that can not be reached). Repeated seeds are fine
+    std::vector<std::vector<uint32_t>> vv(num_vertices);
+    for (const auto& f : Faces) {
+        for (uint32_t i = 0; i < f.size(); ++i) {
+            vv[f[i]].push_back(f[(i + 1) % f.size()]);
+            vv[f[(i + 1) % f.size()]].push_back(f[i]);
+        }
+    }
+    std::vector<uint32_t> level(num_vertices, INVALID32);
+    std::queue<uint32_t>  queue;
+    for (uint32_t s : seeds) {
+        if (level[s] == INVALID32) {
+            level[s] = 0;
+            queue.push(s);
+        }
+    }
+    while (!queue.empty()) {
+        uint32_t v = queue.front();
+        queue.pop();
+        for (uint32_t n : vv[v]) {
+            if (level[n] == INVALID32) {
+                level[n] = level[v] + 1;
+                queue.push(n);
+            }
+        }
+    }
+    return level;
+}
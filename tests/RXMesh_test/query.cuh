@@ -21,12 +21,10 @@ __launch_bounds__(blockThreads) __global__
 {
     using namespace RXMESH;
 
-    static_assert(op != Op::EE, "Op::EE is not supported!");
-
     assert(output_container.is_device_allocated());
 
     uint32_t block_offset = 0;
-    if constexpr (op == Op::EV || op == Op::EF) {
+    if constexpr (op == Op::EV || op == Op::EE || op == Op::EF) {
         block_offset = context.get_edge_distribution()[blockIdx.x];
     } else if constexpr (op == Op::FV || op == Op::FE || op == Op::FF) {
         block_offset = context.get_face_distribution()[blockIdx.x];
@@ -58,6 +58,9 @@ class RXMeshTest
             case RXMESH::Op::EV:
                 return test_EV(rxmesh, input_container, output_container);
                 break;
+            case RXMESH::Op::EE:
+                return test_EE(rxmesh, input_container, output_container);
+                break;
             case RXMESH::Op::EF:
                 return test_EF(rxmesh, input_container, output_container);
                 break;
@@ -133,9 +136,9 @@ class RXMeshTest
 
             for (uint32_t j = 0; j < 3; ++j) {
 
-                uint32_t v0 = rxmesh.m_fvn[i][j];
+                uint32_t v0 = rxmesh.m_fv[i][j];
                 uint32_t v1 =
-                    (j != 2) ? rxmesh.m_fvn[i][j + 1] : rxmesh.m_fvn[i][0];
+                    (j != 2) ? rxmesh.m_fv[i][j + 1] : rxmesh.m_fv[i][0];
                 std::pair<uint32_t, uint32_t> my_edge = rxmesh.edge_key(v0, v1);
                 uint32_t edge_id = rxmesh.get_edge_id(my_edge);
                 ff[j] = edge_id;
@@ -262,13 +265,13 @@ class RXMeshTest
         std::vector<std::vector<uint32_t>> v_f(rxmesh.m_num_vertices,
                                                std::vector<uint32_t>(0));
 
-        // TODO this depends on m_fvn which does not record any changes
+        // TODO this depends on m_fv which does not record any changes
         // but it is what the user has passed. Should compute v_f based on
         // m_edge_map for consistency
         uint32_t f_deg = rxmesh.m_face_degree;
         for (uint32_t f = 0; f < rxmesh.m_num_faces; f++) {
             for (uint32_t v = 0; v < f_deg; v++) {
-                uint32_t vert = rxmesh.m_fvn[f][v];
+                uint32_t vert = rxmesh.m_fv[f][v];
                 v_f[vert].push_back(f);
             }
         }
@@ -293,7 +296,7 @@ class RXMeshTest
 
         for (uint32_t f = 0; f < rxmesh.m_num_faces; f++) {
 
-            std::memcpy(f_v[f].data(), rxmesh.m_fvn[f].data(),
+            std::memcpy(f_v[f].data(), rxmesh.m_fv[f].data(),
                         f_deg * sizeof(uint32_t));
         }
 
@@ -429,6 +432,37 @@ class RXMeshTest
                         input_container, output_container);
     }
 
+    template <uint32_t patchSize>
+    bool test_EE(const RXMESH::RXMeshStatic<patchSize>&   rxmesh,
+                 const RXMESH::RXMeshAttribute<uint32_t>& input_container,
+                 const RXMESH::RXMeshAttribute<uint32_t>& output_container)
+    {
+
+        // construct EE as the other edges of the faces incident to an edge
+
+        std::vector<std::vector<uint32_t>> e_e(rxmesh.m_num_edges,
+                                               std::vector<uint32_t>(0));
+
+        uint32_t f_deg = rxmesh.m_face_degree;
+        for (uint32_t f = 0; f < rxmesh.m_num_faces; f++) {
+            for (uint32_t e = 0; e < f_deg; e++) {
+                uint32_t edge = m_h_FE[f][e];
+                for (uint32_t n = 0; n < f_deg; n++) {
+                    uint32_t n_edge = m_h_FE[f][n];
+                    if (n_edge != edge &&
+                        RXMESH::find_index(n_edge, e_e[edge]) ==
+                            std::numeric_limits<uint32_t>::max()) {
+                        e_e[edge].push_back(n_edge);
+                    }
+                }
+            }
+        }
+
+        // two-way verification
+        return verifier(rxmesh.get_patcher()->get_edge_patch().data(), e_e,
+                        input_container, output_container);
+    }
+
     bool verifier(const uint32_t*                           element_patch,
                   const std::vector<std::vector<uint32_t>>& mesh_ele,
                   const RXMESH::RXMeshAttribute<uint32_t>&  input_container,
@@ -20,8 +20,25 @@ struct RXMeshTestArg
     char**      argv = argv;
 } rxmesh_args;
 
+#include "test_attribute_expr.h"
+#include "test_attribute_io.h"
+#include "test_attribute_layout.h"
+#include "test_attribute_registry.h"
+#include "test_dirty_patches.h"
+#include "test_export.h"
+#include "test_frontier.h"
 #include "test_higher_queries.h"
+#include "test_host_queries.h"
+#include "test_host_storage.h"
+#include "test_kring.h"
+#include "test_laplacian.h"
+#include "test_packed_attribute.h"
+#include "test_patch_coloring.h"
+#include "test_patch_order.h"
+#include "test_patch_scheduler.h"
+#include "test_ply.h"
 #include "test_queries.h"
+#include "test_toplesets.h"
 
 
 int main(int argc, char** argv)
@@ -0,0 +1,187 @@
+#include <cmath>
+#include <vector>
+#include "gtest/gtest.h"
+#include "rxmesh/rxmesh_attribute.h"
+#include "rxmesh/rxmesh_attribute_expr.h"
+#include "rxmesh/util/report.h"
+#include "rxmesh/util/timer.h"
+
+/**
+ * fill_expr_attribute()
+ */
+template <typename T>
+inline void fill_expr_attribute(RXMESH::RXMeshAttribute<T>& attr,
+                                const uint32_t              seed)
+{
+    for (uint32_t i = 0; i < attr.get_num_mesh_elements(); ++i) {
+        for (uint32_t j = 0; j < attr.get_num_attribute_per_element(); ++j) {
+            attr(i, j) = T(std::sin(0.01 * i + j + seed));
+        }
+    }
+    if (attr.is_device_allocated()) {
+        attr.move(RXMESH::HOST, RXMESH::DEVICE);
+    }
+}
+
+TEST(RXMesh, AttributeExpr)
+{
+    using namespace RXMESH;
+
+    const uint32_t         num_elements = 1u << 20;
+    const Vector<3, dataT> alpha(0.5, -0.25, 2.0), beta(0.75, 1.5, -1.0),
+        ones(1.0);
+
+    // reference of one CG update computed serially on the host
+    auto reference = [&](RXMeshAttribute<dataT>&       X,
+                         RXMeshAttribute<dataT>&       R,
+                         RXMeshAttribute<dataT>&       P,
+                         const RXMeshAttribute<dataT>& S,
+                         Vector<3, double>&            delta) {
+        delta = Vector<3, double>(0.0);
+        for (uint32_t i = 0; i < num_elements; ++i) {
+            for (uint32_t j = 0; j < 3; ++j) {
+                X(i, j) += alpha[j] * P(i, j);
+                R(i, j) -= alpha[j] * S(i, j);
+                delta[j] += double(R(i, j)) * double(R(i, j));
+                P(i, j) = R(i, j) + beta[j] * P(i, j);
+            }
+        }
+    };
+
+    auto close = [](const Vector<3, dataT>& a, const Vector<3, double>& b) {
+        bool passed = true;
+        for (uint32_t j = 0; j < 3; ++j) {
+            passed = passed &&
+                     std::abs(double(a[j]) - b[j]) <= 1e-4 * std::abs(b[j]);
+        }
+        return passed;
+    };
+
+    FusedEvaluator<dataT> fused;
+
+    // host and device evaluation in every layout
+    for (layoutT layout : {RXMESH::AoS, RXMESH::SoA, RXMESH::AoSoA}) {
+        RXMeshAttribute<dataT>  X, R, P, S, X_ref, R_ref, P_ref;
+        RXMeshAttribute<dataT>* all[] = {&X,     &R,     &P,    &S,
+                                         &X_ref, &R_ref, &P_ref};
+        for (uint32_t k = 0; k < 7; ++k) {
+            all[k]->init(num_elements, 3u, RXMESH::LOCATION_ALL, layout);
+            fill_expr_attribute(*all[k], k % 4);
+        }
+        Vector<3, double> delta_ref;
+        reference(X_ref, R_ref, P_ref, S, delta_ref);
+
+        auto same = [&](RXMeshAttribute<dataT>& a,
+                        RXMeshAttribute<dataT>& b) {
+            for (uint32_t i = 0; i < num_elements; ++i) {
+                for (uint32_t j = 0; j < 3; ++j) {
+                    if (std::abs(a(i, j) - b(i, j)) >
+                        1e-5 * (1 + std::abs(b(i, j)))) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        };
+
+        // device
+        Vector<3, dataT> delta(dataT(0));
+        fused.evaluate(RXMESH::DEVICE, fused_add(X, alpha * P),
+                       fused_sub(R, alpha * S), fused_norm2(R, delta));
+        fused.evaluate(RXMESH::DEVICE, fused_assign(P, R + beta * P));
+        EXPECT_TRUE(close(delta, delta_ref)) << "layout= " << layout;
+        for (RXMeshAttribute<dataT>* attr : {&X, &R, &P}) {
+            attr->move(RXMESH::DEVICE, RXMESH::HOST);
+        }
+        EXPECT_TRUE(same(X, X_ref) && same(R, R_ref) && same(P, P_ref))
+            << "layout= " << layout;
+
+        // host
+        for (uint32_t k = 0; k < 3; ++k) {
+            fill_expr_attribute(*all[k], k % 4);
+        }
+        delta = Vector<3, dataT>(dataT(0));
+        fused.evaluate(RXMESH::HOST, fused_add(X, alpha * P),
+                       fused_sub(R, alpha * S), fused_norm2(R, delta),
+                       fused_assign(P, R + beta * P));
+        EXPECT_TRUE(close(delta, delta_ref)) << "layout= " << layout;
+        EXPECT_TRUE(same(X, X_ref) && same(R, R_ref) && same(P, P_ref))
+            << "layout= " << layout;
+
+        for (uint32_t k = 0; k < 7; ++k) {
+            all[k]->release();
+        }
+    }
+
+    // Benchmark one CG update as separate axpy/reduce calls and as fused
+    // passes on the device
+    Report report("AttributeExpr_RXMesh");
+    report.command_line(rxmesh_args.argc, rxmesh_args.argv);
+    report.device();
+    report.system();
+    report.add_member("num_elements", num_elements);
+
+    RXMeshAttribute<dataT>  X, R, P, S;
+    RXMeshAttribute<dataT>* all[] = {&X, &R, &P, &S};
+    for (uint32_t k = 0; k < 4; ++k) {
+        all[k]->init(num_elements, 3u, RXMESH::LOCATION_ALL, RXMESH::SoA);
+        fill_expr_attribute(*all[k], k);
+    }
+
+    TestData td_separate, td_fused;
+    td_separate.test_name = "cg_update_separate";
+    td_fused.test_name = "cg_update_fused";
+    Vector<3, dataT> delta_separate(dataT(0)), delta_fused(dataT(0));
+    for (uint32_t itr = 0; itr < rxmesh_args.num_run; itr++) {
+        GPUTimer timer;
+        timer.start();
+        X.axpy(P, alpha, ones);
+        R.axpy(S, -alpha, ones);
+        R.reduce(delta_separate, RXMESH::NORM2);
+        P.axpy(R, ones, beta);
+        timer.stop();
+        CUDA_ERROR(cudaDeviceSynchronize());
+        td_separate.time_ms.push_back(timer.elapsed_millis());
+
+        // undo the update so both variants see the same input
+        for (uint32_t k = 0; k < 3; ++k) {
+            fill_expr_attribute(*all[k], k);
+        }
+
+        timer.start();
+        fused.evaluate(RXMESH::DEVICE, fused_add(X, alpha * P),
+                       fused_sub(R, alpha * S), fused_norm2(R, delta_fused));
+        fused.evaluate(RXMESH::DEVICE, fused_assign(P, R + beta * P));
+        timer.stop();
+        CUDA_ERROR(cudaDeviceSynchronize());
+        td_fused.time_ms.push_back(timer.elapsed_millis());
+
+        for (uint32_t k = 0; k < 3; ++k) {
+            fill_expr_attribute(*all[k], k);
+        }
+    }
+    CUDA_ERROR(cudaGetLastError());
+
+    bool passed = true;
+    for (uint32_t j = 0; j < 3; ++j) {
+        passed = passed && std::abs(delta_separate[j] - delta_fused[j]) <=
+                               1e-4 * std::abs(delta_separate[j]);
+    }
+    td_separate.passed.push_back(true);
+    td_fused.passed.push_back(passed);
+    EXPECT_TRUE(passed);
+
+    report.add_test(td_separate);
+    report.add_test(td_fused);
+    if (!rxmesh_args.quite) {
+        RXMESH_TRACE(" AttributeExpr CG update: separate= {} (ms), fused= {} "
+                     "(ms)",
+                     td_separate.time_ms.back(), td_fused.time_ms.back());
+    }
+    report.write(rxmesh_args.output_folder + "/rxmesh", "AttributeExpr");
+
+    for (uint32_t k = 0; k < 4; ++k) {
+        all[k]->release();
+    }
+    fused.release();
+}
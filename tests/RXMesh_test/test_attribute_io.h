@@ -0,0 +1,225 @@
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include "gtest/gtest.h"
+#include "rxmesh/rxmesh_attribute.h"
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+#include "rxmesh/util/report.h"
+#include "rxmesh/util/timer.h"
+
+/**
+ * attribute_io_path()
+ */
+inline std::string attribute_io_path(const std::string& name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+TEST(RXMesh, AttributeIO)
+{
+    using namespace RXMESH;
+
+    std::vector<std::vector<uint32_t>> Faces;
+    std::vector<std::vector<dataT>>    Vertices;
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Vertices, Faces, true));
+
+    RXMeshStatic<PATCH_SIZE> rxmesh_static(Faces, Vertices, false,
+                                           rxmesh_args.quite);
+    const uint32_t num_vertices = rxmesh_static.get_num_vertices();
+
+    RXMeshAttribute<dataT> coords;
+    coords.set_name("coords");
+    coords.init(num_vertices, 3u, RXMESH::LOCATION_ALL);
+    for (uint32_t v = 0; v < num_vertices; ++v) {
+        for (uint32_t j = 0; j < 3; ++j) {
+            coords(v, j) = Vertices[v][j];
+        }
+    }
+    coords.move(RXMESH::HOST, RXMESH::DEVICE);
+
+    const std::string file_name = attribute_io_path("rxmesh_coords.rxa");
+
+    // round trip in every layout. The host side is mapped from the file
+    for (layoutT layout : {RXMESH::AoS, RXMESH::SoA, RXMESH::AoSoA}) {
+        RXMeshAttribute<dataT> saved;
+        saved.set_name("saved");
+        saved.init(num_vertices, 3u, RXMESH::LOCATION_ALL, layout);
+        saved.copy(coords, RXMESH::HOST, RXMESH::HOST);
+        saved.move(RXMESH::HOST, RXMESH::DEVICE);
+        // from the device when the host is not allocated
+        saved.release(RXMESH::HOST);
+        ASSERT_TRUE(saved.save(file_name));
+        saved.release();
+
+        RXMeshAttribute<dataT> loaded;
+        ASSERT_TRUE(loaded.load(file_name, RXMESH::HOST | RXMESH::DEVICE));
+        EXPECT_TRUE(loaded.is_host_mapped());
+        EXPECT_EQ(std::string(loaded.get_name()), "saved");
+        EXPECT_EQ(loaded.get_layout(), layout);
+        EXPECT_EQ(loaded.get_num_mesh_elements(), num_vertices);
+        EXPECT_EQ(loaded.get_num_attribute_per_element(), 3u);
+        bool passed = true;
+        for (uint32_t v = 0; v < num_vertices; ++v) {
+            for (uint32_t j = 0; j < 3; ++j) {
+                passed = passed && (loaded(v, j) == coords(v, j));
+            }
+        }
+        EXPECT_TRUE(passed) << "layout= " << layout;
+
+        // writing to the mapped host buffer does not change the file and
+        // the device copy agrees with the file
+        loaded.reset(0, RXMESH::HOST);
+        loaded.move(RXMESH::DEVICE, RXMESH::HOST);
+        passed = true;
+        for (uint32_t v = 0; v < num_vertices; ++v) {
+            for (uint32_t j = 0; j < 3; ++j) {
+                passed = passed && (loaded(v, j) == coords(v, j));
+            }
+        }
+        EXPECT_TRUE(passed) << "layout= " << layout;
+
+        // the mapped buffer can be re-laid out like any other
+        loaded.change_layout(RXMESH::HOST);
+        EXPECT_FALSE(loaded.is_host_mapped());
+        loaded.release();
+    }
+
+    // wrong type, corrupted data, and truncated file
+    ASSERT_TRUE(coords.save(file_name));
+    {
+        RXMeshAttribute<uint32_t> wrong_type;
+        EXPECT_FALSE(wrong_type.load(file_name));
+
+        std::fstream file(file_name,
+                          std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(AttributeFileHeader::DATA_ALIGNMENT + 5);
+        file.put(char(0x5A));
+        file.close();
+        RXMeshAttribute<dataT> corrupted;
+        EXPECT_FALSE(corrupted.load(file_name));
+        EXPECT_TRUE(corrupted.load(file_name, RXMESH::HOST, false));
+        corrupted.release();
+
+        std::filesystem::resize_file(file_name,
+                                     AttributeFileHeader::DATA_ALIGNMENT + 8);
+        RXMeshAttribute<dataT> truncated;
+        EXPECT_FALSE(truncated.load(file_name, RXMESH::HOST, false));
+    }
+
+    // patch order
+    {
+        const std::vector<uint32_t>& v_order =
+            rxmesh_static.get_patch_order(ELEMENT::VERTEX);
+        ASSERT_TRUE(rxmesh_static.save_attribute(ELEMENT::VERTEX, coords,
+                                                 file_name, PATCH_ORDER));
+        AttributeFileHeader header;
+        ASSERT_TRUE(RXMeshAttribute<dataT>::read_header(file_name, header));
+        EXPECT_EQ(header.order, PATCH_ORDER);
+
+        // kept in patch order (mapped with no copy)
+        RXMeshAttribute<dataT> patch_coords;
+        ASSERT_TRUE(rxmesh_static.load_attribute(
+            ELEMENT::VERTEX, patch_coords, file_name, PATCH_ORDER));
+        EXPECT_TRUE(patch_coords.is_host_mapped());
+        bool passed = true;
+        for (uint32_t v = 0; v < num_vertices; ++v) {
+            for (uint32_t j = 0; j < 3; ++j) {
+                passed =
+                    passed && (patch_coords(v_order[v], j) == coords(v, j));
+            }
+        }
+        EXPECT_TRUE(passed);
+        patch_coords.release();
+
+        // back to global order on the device
+        RXMeshAttribute<dataT> global_coords;
+        ASSERT_TRUE(rxmesh_static.load_attribute(
+            ELEMENT::VERTEX, global_coords, file_name, GLOBAL_ORDER,
+            RXMESH::LOCATION_ALL));
+        global_coords.reset(0, RXMESH::HOST);
+        global_coords.move(RXMESH::DEVICE, RXMESH::HOST);
+        passed = true;
+        for (uint32_t v = 0; v < num_vertices; ++v) {
+            for (uint32_t j = 0; j < 3; ++j) {
+                passed = passed && (global_coords(v, j) == coords(v, j));
+            }
+        }
+        EXPECT_TRUE(passed);
+        global_coords.release();
+
+        // the number of elements has to match
+        RXMeshAttribute<dataT> faces_attr;
+        EXPECT_FALSE(rxmesh_static.load_attribute(ELEMENT::FACE, faces_attr,
+                                                  file_name));
+    }
+
+    // Benchmark writing/reading a field as text and as a binary attribute
+    Report report("AttributeIO_RXMesh");
+    report.command_line(rxmesh_args.argc, rxmesh_args.argv);
+    report.device();
+    report.system();
+    report.model_data(rxmesh_args.obj_file_name, rxmesh_static);
+
+    const std::string text_name = attribute_io_path("rxmesh_coords.txt");
+    TestData          td_text, td_binary;
+    td_text.test_name = "text_save_load";
+    td_binary.test_name = "binary_save_load";
+    bool text_passed = true, binary_passed = true;
+    for (uint32_t itr = 0; itr < rxmesh_args.num_run; itr++) {
+        CPUTimer timer;
+        timer.start();
+        {
+            std::ofstream file(text_name);
+            for (uint32_t v = 0; v < num_vertices; ++v) {
+                file << coords(v, 0) << " " << coords(v, 1) << " "
+                     << coords(v, 2) << "\n";
+            }
+        }
+        RXMeshAttribute<dataT> text_coords;
+        text_coords.init(num_vertices, 3u, RXMESH::HOST, RXMESH::AoS, false,
+                         false);
+        {
+            std::ifstream file(text_name);
+            for (uint32_t v = 0; v < num_vertices; ++v) {
+                file >> text_coords(v, 0) >> text_coords(v, 1) >>
+                    text_coords(v, 2);
+            }
+        }
+        timer.stop();
+        td_text.time_ms.push_back(timer.elapsed_millis());
+        // text is only accurate to the printed digits
+        text_passed =
+            text_passed && (std::abs(text_coords(num_vertices - 1, 2) -
+                                     coords(num_vertices - 1, 2)) <
+                            1e-4 * (1 + std::abs(coords(num_vertices - 1, 2))));
+        text_coords.release();
+
+        timer.start();
+        coords.save(file_name);
+        RXMeshAttribute<dataT> binary_coords;
+        binary_coords.load(file_name, RXMESH::HOST, true, false, false);
+        timer.stop();
+        td_binary.time_ms.push_back(timer.elapsed_millis());
+        binary_passed = binary_passed && (binary_coords(num_vertices - 1, 2) ==
+                                          coords(num_vertices - 1, 2));
+        binary_coords.release();
+    }
+    td_text.passed.push_back(text_passed);
+    td_binary.passed.push_back(binary_passed);
+    EXPECT_TRUE(binary_passed);
+
+    report.add_test(td_text);
+    report.add_test(td_binary);
+    if (!rxmesh_args.quite) {
+        RXMESH_TRACE(" AttributeIO text= {} (ms), binary= {} (ms)",
+                     td_text.time_ms.back(), td_binary.time_ms.back());
+    }
+    report.write(
+        rxmesh_args.output_folder + "/rxmesh",
+        "AttributeIO_RXMesh_" + extract_file_name(rxmesh_args.obj_file_name));
+
+    std::filesystem::remove(text_name);
+    std::filesystem::remove(file_name);
+    coords.release();
+}
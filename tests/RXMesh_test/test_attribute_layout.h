@@ -0,0 +1,210 @@
+#include <vector>
+#include "gtest/gtest.h"
+#include "rxmesh/rxmesh_attribute.h"
+#include "rxmesh/util/report.h"
+#include "rxmesh/util/timer.h"
+#include "rxmesh/util/util.h"
+
+/**
+ * check_layout()
+ */
+template <typename T>
+inline bool check_layout(RXMESH::RXMeshAttribute<T>& attr)
+{
+    // the values were set to i * num_attributes + j
+    const uint32_t num_attr = attr.get_num_attribute_per_element();
+    for (uint32_t i = 0; i < attr.get_num_mesh_elements(); ++i) {
+        for (uint32_t j = 0; j < num_attr; ++j) {
+            if (attr(i, j) != T(i * num_attr + j)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+TEST(RXMesh, AttributeLayout)
+{
+    using namespace RXMESH;
+
+    // Benchmark (and verify) AoS <-> SoA layout changes on the host and the
+    // device for different number of elements and attributes per element.
+    // For the host, we also time the serial in-place transpose that
+    // change_layout() used to do
+    Report report("AttributeLayout_RXMesh");
+    report.command_line(rxmesh_args.argc, rxmesh_args.argv);
+    report.device();
+    report.system();
+
+    for (uint32_t num_elements : {1u << 10, 1u << 16, 1u << 22}) {
+        for (uint32_t num_attr : {2u, 3u, 8u, 64u}) {
+            if (uint64_t(num_elements) * num_attr > (1u << 24)) {
+                continue;
+            }
+            const std::string suffix = "_" + std::to_string(num_elements) +
+                                       "x" + std::to_string(num_attr);
+
+            RXMeshAttribute<uint32_t> attr;
+            attr.init(num_elements, num_attr, RXMESH::LOCATION_ALL,
+                      RXMESH::AoS, false, false);
+            for (uint32_t i = 0; i < num_elements; ++i) {
+                for (uint32_t j = 0; j < num_attr; ++j) {
+                    attr(i, j) = i * num_attr + j;
+                }
+            }
+            attr.move(RXMESH::HOST, RXMESH::DEVICE);
+
+            // host: AoS -> SoA -> AoS
+            TestData td_host;
+            td_host.test_name = "host" + suffix;
+            for (uint32_t itr = 0; itr < 2; ++itr) {
+                CPUTimer timer;
+                timer.start();
+                attr.change_layout(RXMESH::HOST);
+                timer.stop();
+                td_host.time_ms.push_back(timer.elapsed_millis());
+                td_host.passed.push_back(check_layout(attr));
+                EXPECT_TRUE(td_host.passed.back()) << td_host.test_name;
+            }
+            report.add_test(td_host);
+
+            // device: AoS -> SoA -> AoS without going through the host. We
+            // check the device side by moving it to the host after every
+            // change
+            TestData td_device;
+            td_device.test_name = "device" + suffix;
+            for (uint32_t itr = 0; itr < 2; ++itr) {
+                GPUTimer timer;
+                timer.start();
+                attr.change_layout(RXMESH::DEVICE);
+                timer.stop();
+                td_device.time_ms.push_back(timer.elapsed_millis());
+                attr.move(RXMESH::DEVICE, RXMESH::HOST);
+                td_device.passed.push_back(check_layout(attr));
+                EXPECT_TRUE(td_device.passed.back()) << td_device.test_name;
+            }
+            report.add_test(td_device);
+
+            // both sides at once
+            attr.change_layout(RXMESH::HOST | RXMESH::DEVICE);
+            EXPECT_TRUE(check_layout(attr));
+            attr.move(RXMESH::DEVICE, RXMESH::HOST);
+            EXPECT_TRUE(check_layout(attr));
+
+            // serial in-place baseline
+            TestData td_in_place;
+            td_in_place.test_name = "host_in_place" + suffix;
+            {
+                uint32_t* h_ptr = attr.get_pointer(RXMESH::HOST);
+                CPUTimer  timer;
+                timer.start();
+                in_place_matrix_transpose(
+                    h_ptr, h_ptr + uint64_t(num_elements) * num_attr,
+                    uint64_t(num_attr));
+                timer.stop();
+                td_in_place.time_ms.push_back(timer.elapsed_millis());
+            }
+            report.add_test(td_in_place);
+
+            if (!rxmesh_args.quite) {
+                RXMESH_TRACE(
+                    " AttributeLayout {} host= {} (ms), device= {} (ms), "
+                    "in-place= {} (ms)",
+                    suffix, td_host.time_ms[0], td_device.time_ms[0],
+                    td_in_place.time_ms[0]);
+            }
+
+            attr.release();
+        }
+    }
+
+    report.write(rxmesh_args.output_folder + "/rxmesh", "AttributeLayout");
+}
+
+TEST(RXMesh, AttributeAoSoA)
+{
+    using namespace RXMESH;
+
+    // element counts that are smaller than, equal to, and not a multiple of
+    // the tile size
+    for (uint32_t num_elements : {1u, 7u, 8u, 1000u, 1029u}) {
+        for (uint32_t num_attr : {1u, 3u}) {
+            RXMeshAttribute<float> attr;
+            attr.init(num_elements, num_attr, RXMESH::LOCATION_ALL,
+                      RXMESH::AoSoA);
+            for (uint32_t i = 0; i < num_elements; ++i) {
+                for (uint32_t j = 0; j < num_attr; ++j) {
+                    attr(i, j) = float(i * num_attr + j);
+                }
+            }
+            // the components of an element are AOSOA_TILE_SIZE apart
+            if (num_attr > 1) {
+                EXPECT_EQ(&attr(0, 1) - &attr(0, 0),
+                          ptrdiff_t(AOSOA_TILE_SIZE));
+            }
+            attr.move(RXMESH::HOST, RXMESH::DEVICE);
+
+            // AoSoA -> AoS -> SoA -> AoSoA on both sides
+            for (layoutT layout : {RXMESH::AoS, RXMESH::SoA, RXMESH::AoSoA}) {
+                attr.change_layout(RXMESH::HOST | RXMESH::DEVICE, layout);
+                EXPECT_EQ(attr.get_layout(), layout);
+                EXPECT_TRUE(check_layout(attr));
+                attr.move(RXMESH::DEVICE, RXMESH::HOST);
+                EXPECT_TRUE(check_layout(attr));
+            }
+
+            // changing only the host reallocates the device
+            attr.change_layout(RXMESH::HOST, RXMESH::SoA);
+            EXPECT_TRUE(check_layout(attr));
+            attr.move(RXMESH::HOST, RXMESH::DEVICE);
+            attr.change_layout(RXMESH::DEVICE, RXMESH::AoSoA);
+            attr.move(RXMESH::DEVICE, RXMESH::HOST);
+            EXPECT_TRUE(check_layout(attr));
+
+            // copy from a different layout on the host and on the device
+            RXMeshAttribute<float> other;
+            other.init(num_elements, num_attr, RXMESH::LOCATION_ALL,
+                       RXMESH::SoA);
+            other.copy(attr, RXMESH::HOST, RXMESH::HOST);
+            EXPECT_TRUE(check_layout(other));
+            other.reset(0, RXMESH::LOCATION_ALL);
+            attr.move(RXMESH::HOST, RXMESH::DEVICE);
+            other.copy(attr, RXMESH::DEVICE, RXMESH::DEVICE);
+            other.move(RXMESH::DEVICE, RXMESH::HOST);
+            EXPECT_TRUE(check_layout(other));
+
+            // axpy: attr = 2 * attr - 1 * attr on both sides
+            Vector<3, float> alpha(2.f), beta(-1.f);
+            attr.axpy(attr, alpha, beta, RXMESH::HOST | RXMESH::DEVICE);
+            EXPECT_TRUE(check_layout(attr));
+            attr.move(RXMESH::DEVICE, RXMESH::HOST);
+            EXPECT_TRUE(check_layout(attr));
+
+            // axpy on the host on one attribute: double the first attribute
+            // and scale it back. The other attributes are left untouched
+            Vector<1, float> one(1.f), quarter(0.25f);
+            attr.axpy(attr, one, one, RXMESH::HOST, 0u);
+            bool passed = true;
+            for (uint32_t i = 0; i < num_elements; ++i) {
+                passed = passed && (attr(i, 0) == 2.f * float(i * num_attr));
+            }
+            EXPECT_TRUE(passed);
+            attr.axpy(attr, quarter, quarter, RXMESH::HOST, 0u);
+            EXPECT_TRUE(check_layout(attr));
+
+            // reduce
+            Vector<3, float> sum;
+            attr.reduce(sum, RXMESH::SUM);
+            for (uint32_t j = 0; j < num_attr; ++j) {
+                float expected = 0;
+                for (uint32_t i = 0; i < num_elements; ++i) {
+                    expected += float(i * num_attr + j);
+                }
+                EXPECT_NEAR(sum[j], expected, 1e-3f * expected);
+            }
+
+            other.release();
+            attr.release();
+        }
+    }
+}
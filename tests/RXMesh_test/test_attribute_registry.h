@@ -0,0 +1,158 @@
+#include <string>
+#include "gtest/gtest.h"
+#include "rxmesh/rxmesh_attribute.h"
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+#include "rxmesh/util/report.h"
+#include "rxmesh/util/timer.h"
+
+TEST(RXMesh, AttributeRegistry)
+{
+    using namespace RXMESH;
+
+    std::vector<std::vector<uint32_t>> Faces;
+    std::vector<std::vector<dataT>>    Vertices;
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Vertices, Faces, true));
+
+    RXMeshStatic<PATCH_SIZE> rxmesh_static(Faces, Vertices, false,
+                                           rxmesh_args.quite);
+
+    // attributes are sized by the element type they are bound to
+    auto& v_attr = rxmesh_static.add_vertex_attribute<dataT>(
+        "v_attr", 3u, RXMESH::LOCATION_ALL);
+    auto& e_attr = rxmesh_static.add_edge_attribute<uint32_t>(
+        "e_attr", 1u, RXMESH::DEVICE, RXMESH::SoA);
+    auto& f_attr = rxmesh_static.add_face_attribute<dataT>(
+        "f_attr", 2u, RXMESH::HOST, RXMESH::AoS, false, false);
+    EXPECT_EQ(v_attr.get_num_mesh_elements(), rxmesh_static.get_num_vertices());
+    EXPECT_EQ(e_attr.get_num_mesh_elements(), rxmesh_static.get_num_edges());
+    EXPECT_EQ(f_attr.get_num_mesh_elements(), rxmesh_static.get_num_faces());
+    EXPECT_EQ(f_attr.get_num_attribute_per_element(), 2u);
+
+    // named lookup
+    EXPECT_TRUE(rxmesh_static.has_attribute("v_attr"));
+    EXPECT_FALSE(rxmesh_static.has_attribute("none"));
+    EXPECT_EQ(rxmesh_static.get_attribute<dataT>("v_attr"), &v_attr);
+    EXPECT_EQ(rxmesh_static.get_attribute<uint32_t>("e_attr"), &e_attr);
+    EXPECT_EQ(rxmesh_static.get_attribute<dataT>("none"), nullptr);
+    EXPECT_EQ(rxmesh_static.get_attribute<uint32_t>("v_attr"), nullptr);
+    EXPECT_EQ(&rxmesh_static.add_vertex_attribute<dataT>("v_attr", 3u),
+              &v_attr);
+
+    // values written through the registry survive the round trip
+    for (uint32_t v = 0; v < rxmesh_static.get_num_vertices(); ++v) {
+        for (uint32_t j = 0; j < 3; ++j) {
+            v_attr(v, j) = Vertices[v][j];
+        }
+    }
+    v_attr.move(RXMESH::HOST, RXMESH::DEVICE);
+    v_attr.reset(0, RXMESH::HOST);
+    v_attr.move(RXMESH::DEVICE, RXMESH::HOST);
+    bool passed = true;
+    for (uint32_t v = 0; v < rxmesh_static.get_num_vertices(); ++v) {
+        for (uint32_t j = 0; j < 3; ++j) {
+            passed = passed && (v_attr(v, j) == Vertices[v][j]);
+        }
+    }
+    EXPECT_TRUE(passed);
+
+    // accounting
+    AttributeArena& arena = rxmesh_static.get_attribute_arena();
+    EXPECT_GE(double(arena.get_bytes_in_use(RXMESH::DEVICE)) / 1048576.0,
+              rxmesh_static.get_attributes_storage_mb(RXMESH::DEVICE) -
+                  1e-9);
+    EXPECT_GT(arena.get_bytes_in_use(RXMESH::HOST), 0u);
+    EXPECT_DOUBLE_EQ(
+        rxmesh_static.get_host_storage_breakdown_mb().at("attributes"),
+        double(arena.get_bytes_in_use(RXMESH::HOST) +
+               arena.get_bytes_pooled(RXMESH::HOST)) /
+            1048576.0);
+    if (!rxmesh_args.quite) {
+        rxmesh_static.log_attributes_memory();
+    }
+
+    // removing and adding an attribute of the same shape reuses the buffers
+    rxmesh_static.remove_attribute("e_attr");
+    EXPECT_FALSE(rxmesh_static.has_attribute("e_attr"));
+    const size_t num_alloc = arena.get_num_system_allocations(RXMESH::DEVICE);
+    const size_t num_reuses = arena.get_num_reuses(RXMESH::DEVICE);
+    rxmesh_static.add_edge_attribute<uint32_t>("e_attr_2", 1u,
+                                               RXMESH::DEVICE, RXMESH::SoA);
+    EXPECT_EQ(arena.get_num_system_allocations(RXMESH::DEVICE), num_alloc);
+    EXPECT_GT(arena.get_num_reuses(RXMESH::DEVICE), num_reuses);
+    rxmesh_static.remove_attribute("e_attr_2");
+    rxmesh_static.remove_attribute("f_attr");
+    rxmesh_static.remove_attribute("v_attr");
+    EXPECT_EQ(arena.get_bytes_in_use(RXMESH::HOST), 0u);
+    EXPECT_EQ(arena.get_bytes_in_use(RXMESH::DEVICE), 0u);
+
+    // Benchmark create/release cycles of the CG vectors of a vertex
+    // attribute with and without the arena
+    Report report("AttributeRegistry_RXMesh");
+    report.command_line(rxmesh_args.argc, rxmesh_args.argv);
+    report.device();
+    report.system();
+    report.model_data(rxmesh_args.obj_file_name, rxmesh_static);
+
+    const uint32_t num_cycles = 100;
+    const char*    names[] = {"S", "P", "R", "B", "X"};
+
+    TestData td_system;
+    td_system.test_name = "create_release_system";
+    for (uint32_t itr = 0; itr < rxmesh_args.num_run; itr++) {
+        CPUTimer timer;
+        timer.start();
+        for (uint32_t c = 0; c < num_cycles; ++c) {
+            RXMeshAttribute<dataT> attr[5];
+            for (uint32_t k = 0; k < 5; ++k) {
+                attr[k].init(rxmesh_static.get_num_vertices(), 3u,
+                             RXMESH::DEVICE, RXMESH::SoA);
+            }
+            for (uint32_t k = 0; k < 5; ++k) {
+                attr[k].release();
+            }
+        }
+        timer.stop();
+        td_system.time_ms.push_back(timer.elapsed_millis());
+    }
+    td_system.passed.push_back(true);
+
+    TestData td_arena;
+    td_arena.test_name = "create_release_arena";
+    size_t num_alloc_first_cycle = 0;
+    for (uint32_t itr = 0; itr < rxmesh_args.num_run; itr++) {
+        CPUTimer timer;
+        timer.start();
+        for (uint32_t c = 0; c < num_cycles; ++c) {
+            for (uint32_t k = 0; k < 5; ++k) {
+                rxmesh_static.add_vertex_attribute<dataT>(
+                    names[k], 3u, RXMESH::DEVICE, RXMESH::SoA);
+            }
+            for (uint32_t k = 0; k < 5; ++k) {
+                rxmesh_static.remove_attribute(names[k]);
+            }
+            if (itr == 0 && c == 0) {
+                num_alloc_first_cycle =
+                    arena.get_num_system_allocations(RXMESH::DEVICE);
+            }
+        }
+        timer.stop();
+        td_arena.time_ms.push_back(timer.elapsed_millis());
+    }
+    // only the first cycle should go to cudaMalloc
+    td_arena.passed.push_back(arena.get_num_system_allocations(
+                                  RXMESH::DEVICE) == num_alloc_first_cycle);
+    EXPECT_TRUE(td_arena.passed.back());
+
+    report.add_test(td_system);
+    report.add_test(td_arena);
+    if (!rxmesh_args.quite) {
+        RXMESH_TRACE(
+            " AttributeRegistry {} create/release cycles: system= {} (ms), "
+            "arena= {} (ms)",
+            num_cycles, td_system.time_ms.back(), td_arena.time_ms.back());
+    }
+    report.write(rxmesh_args.output_folder + "/rxmesh",
+                 "AttributeRegistry_RXMesh_" +
+                     extract_file_name(rxmesh_args.obj_file_name));
+}
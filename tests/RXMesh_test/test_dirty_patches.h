@@ -0,0 +1,132 @@
+#include <algorithm>
+#include "face_visit.cuh"
+#include "gtest/gtest.h"
+#include "rxmesh/rxmesh_attribute.h"
+#include "rxmesh/rxmesh_patch_set.h"
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+
+/**
+ * OutsideCount
+ */
+struct OutsideCount
+{
+    // count the visited faces owned by a patch outside of the set
+    RXMESH::RXMeshContext context;
+    RXMESH::PatchSet      patch_set;
+    uint32_t*             d_num_outside;
+
+    __device__ void operator()(uint32_t face_id, RXMESH::RXMeshIterator&) const
+    {
+        if (!patch_set.contains(context.get_face_patch()[face_id])) {
+            atomicAdd(d_num_outside, 1u);
+        }
+    }
+};
+
+TEST(RXMesh, DirtyPatches)
+{
+    using namespace RXMESH;
+
+    constexpr uint32_t blockThreads = 256;
+
+    std::vector<std::vector<uint32_t>> Faces;
+    std::vector<std::vector<dataT>>    Vertices;
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Vertices, Faces, true));
+
+    RXMeshStatic<PATCH_SIZE> rxmesh_static(Faces, Vertices, false,
+                                           rxmesh_args.quite);
+
+    const uint32_t num_vertices = rxmesh_static.get_num_vertices();
+    const uint32_t num_faces = rxmesh_static.get_num_faces();
+
+    RXMeshAttribute<dataT> v_attr;
+    v_attr.set_name("v_attr");
+    v_attr.init(num_vertices, 3u, RXMESH::DEVICE);
+    rxmesh_static.enable_dirty_tracking(ELEMENT::VERTEX, v_attr);
+    EXPECT_TRUE(v_attr.is_dirty_tracking_enabled());
+    EXPECT_TRUE(v_attr.get_dirty_patches().empty());
+
+    // the dirty patches are the owners of the marked vertices
+    const std::vector<uint32_t> marked = {0, num_vertices / 2,
+                                          num_vertices - 1};
+    std::vector<uint32_t>       expected;
+    for (const uint32_t v : marked) {
+        expected.push_back(rxmesh_static.get_patcher()->get_vertex_patch_id(v));
+    }
+    std::sort(expected.begin(), expected.end());
+    expected.erase(std::unique(expected.begin(), expected.end()),
+                   expected.end());
+    v_attr.mark_dirty(marked);
+    const std::vector<uint32_t> dirty = v_attr.get_dirty_patches();
+    EXPECT_EQ(dirty, expected);
+
+    // expanding by one ring adds exactly the neighbour patches
+    EXPECT_EQ(rxmesh_static.expand_patches(dirty, 0), dirty);
+    std::vector<uint32_t> ring = dirty;
+    for (const uint32_t p : dirty) {
+        std::vector<uint32_t> nb = rxmesh_static.get_patch_neighbours(p);
+        ring.insert(ring.end(), nb.begin(), nb.end());
+    }
+    std::sort(ring.begin(), ring.end());
+    ring.erase(std::unique(ring.begin(), ring.end()), ring.end());
+    const std::vector<uint32_t> expanded =
+        rxmesh_static.expand_patches(dirty, 1);
+    EXPECT_EQ(expanded, ring);
+    const std::vector<uint32_t> expanded_2 =
+        rxmesh_static.expand_patches(dirty, 2);
+    EXPECT_TRUE(std::includes(expanded_2.begin(), expanded_2.end(),
+                              expanded.begin(), expanded.end()));
+
+    v_attr.clear_dirty();
+    EXPECT_TRUE(v_attr.get_dirty_patches().empty());
+
+    // dispatching a patch set visits exactly the faces owned by its patches
+    PatchSet patch_set;
+    rxmesh_static.init_patch_set(patch_set);
+    patch_set.set(expanded);
+    EXPECT_EQ(patch_set.get_num_active_patches(), expanded.size());
+
+    uint32_t *d_face_visits(nullptr), *d_num_outside(nullptr);
+    CUDA_ERROR(
+        cudaMalloc((void**)&d_face_visits, num_faces * sizeof(uint32_t)));
+    CUDA_ERROR(cudaMalloc((void**)&d_num_outside, sizeof(uint32_t)));
+    CUDA_ERROR(cudaMemset(d_face_visits, 0, num_faces * sizeof(uint32_t)));
+    CUDA_ERROR(cudaMemset(d_num_outside, 0, sizeof(uint32_t)));
+
+    LaunchBox<blockThreads> launch_box;
+    rxmesh_static.prepare_launch_box(Op::FV, launch_box);
+
+    const RXMeshContext context =
+        rxmesh_static.get_patch_set_context(patch_set);
+    OutsideCount        count_outside{context, patch_set, d_num_outside};
+    face_visit<blockThreads>
+        <<<patch_set.get_num_active_patches(), blockThreads,
+           launch_box.smem_bytes_dyn>>>(context, d_face_visits, count_outside);
+    CUDA_ERROR(cudaDeviceSynchronize());
+    CUDA_ERROR(cudaGetLastError());
+
+    std::vector<uint32_t> h_face_visits(num_faces);
+    uint32_t              h_num_outside = 0;
+    CUDA_ERROR(cudaMemcpy(h_face_visits.data(), d_face_visits,
+                          num_faces * sizeof(uint32_t),
+                          cudaMemcpyDeviceToHost));
+    CUDA_ERROR(cudaMemcpy(&h_num_outside, d_num_outside, sizeof(uint32_t),
+                          cudaMemcpyDeviceToHost));
+
+    EXPECT_EQ(h_num_outside, 0u);
+    bool passed = true;
+    for (uint32_t f = 0; f < num_faces; ++f) {
+        const bool in_set = std::binary_search(
+            expanded.begin(), expanded.end(),
+            rxmesh_static.get_patcher()->get_face_patch_id(f));
+        passed = passed && (h_face_visits[f] == (in_set ? 1u : 0u));
+    }
+    EXPECT_TRUE(passed);
+
+    GPU_FREE(d_face_visits);
+    GPU_FREE(d_num_outside);
+    patch_set.release();
+    v_attr.release();
+    EXPECT_FALSE(v_attr.is_dirty_tracking_enabled());
+}
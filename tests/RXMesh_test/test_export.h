@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include "gtest/gtest.h"
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/export_tools.h"
+#include "rxmesh/util/import_obj.h"
+#include "rxmesh/util/report.h"
+#include "rxmesh/util/timer.h"
+
+/**
+ * export_path()
+ */
+inline std::string export_path(const std::string& name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+/**
+ * read_vtk_xml_array()
+ */
+template <typename T>
+inline std::vector<T> read_vtk_xml_array(const std::string& content,
+                                         const std::string& tag)
+{
+    // read the first appended DataArray after tag in a file written by
+    // export_vtk_xml()
+    const std::string appended = "<AppendedData encoding=\"raw\">\n_";
+    const size_t      base = content.find(appended) + appended.size();
+    const size_t      array = content.find("offset=\"", content.find(tag));
+    const size_t      offset = std::stoull(content.substr(array + 8));
+    uint64_t          bytes = 0;
+    std::memcpy(&bytes, content.data() + base + offset, sizeof(uint64_t));
+    std::vector<T> ret(bytes / sizeof(T));
+    std::memcpy(ret.data(), content.data() + base + offset + sizeof(uint64_t),
+                bytes);
+    return ret;
+}
+
+TEST(RXMesh, Export)
+{
+    using namespace RXMESH;
+
+    std::vector<std::vector<uint32_t>> Faces;
+    std::vector<std::vector<dataT>>    Vertices;
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Vertices, Faces, true));
+
+    // the shortest float formatting reads back exactly
+    const std::string obj_name = export_path("rxmesh_export.obj");
+    {
+        export_obj(Faces, Vertices, obj_name, false);
+        std::vector<std::vector<uint32_t>> read_faces;
+        std::vector<std::vector<dataT>>    read_vertices;
+        ASSERT_TRUE(import_obj(obj_name, read_vertices, read_faces, true));
+        EXPECT_TRUE(read_vertices == Vertices);
+        EXPECT_TRUE(read_faces == Faces);
+    }
+
+    // RXMesh writes the faces patch by patch
+    RXMeshStatic<PATCH_SIZE> rxmesh_static(Faces, Vertices, false,
+                                           rxmesh_args.quite);
+    {
+        rxmesh_static.exportOBJ("rxmesh_export.obj",
+                                [&](uint32_t v, uint32_t i) {
+                                    return Vertices[v][i];
+                                });
+        std::vector<std::vector<uint32_t>> read_faces;
+        std::vector<std::vector<dataT>>    read_vertices;
+        ASSERT_TRUE(import_obj(STRINGIFY(OUTPUT_DIR) +
+                                   std::string("rxmesh_export.obj"),
+                               read_vertices, read_faces, true));
+        EXPECT_TRUE(read_vertices == Vertices);
+
+        // same faces (with the same orientation) in any order
+        auto canonical = [](std::vector<std::vector<uint32_t>> faces) {
+            for (auto& f : faces) {
+                std::rotate(f.begin(), std::min_element(f.begin(), f.end()),
+                            f.end());
+            }
+            std::sort(faces.begin(), faces.end());
+            return faces;
+        };
+        EXPECT_TRUE(canonical(read_faces) == canonical(Faces));
+    }
+
+    // binary VTK XML
+    for (const std::string ext : {".vtp", ".vtu"}) {
+        const std::string vtk_name = export_path("rxmesh_export" + ext);
+        std::vector<dataT> v_att(Vertices.size());
+        for (uint32_t v = 0; v < v_att.size(); ++v) {
+            v_att[v] = dataT(v % 13);
+        }
+        ASSERT_TRUE(export_vtk_xml(
+            vtk_name, Faces, Vertices,
+            {make_vtk_array("v_att", v_att.data(), v_att.size())}, {},
+            false));
+
+        std::ifstream     file(vtk_name, std::ios::binary);
+        const std::string content((std::istreambuf_iterator<char>(file)),
+                                  std::istreambuf_iterator<char>());
+        file.close();
+
+        EXPECT_TRUE(read_vtk_xml_array<dataT>(content, "<PointData>") ==
+                    v_att);
+        const std::vector<dataT> points =
+            read_vtk_xml_array<dataT>(content, "<Points>");
+        const std::vector<int64_t> connectivity =
+            read_vtk_xml_array<int64_t>(content, "Name=\"connectivity\"");
+        ASSERT_EQ(points.size(), 3 * Vertices.size());
+        ASSERT_EQ(connectivity.size(), 3 * Faces.size());
+        bool passed = true;
+        for (uint32_t v = 0; v < Vertices.size(); ++v) {
+            for (uint32_t i = 0; i < 3; ++i) {
+                passed = passed && (points[3 * v + i] == Vertices[v][i]);
+            }
+        }
+        for (uint32_t f = 0; f < Faces.size(); ++f) {
+            for (uint32_t i = 0; i < 3; ++i) {
+                passed = passed &&
+                         (connectivity[3 * f + i] == int64_t(Faces[f][i]));
+            }
+        }
+        EXPECT_TRUE(passed) << ext;
+        std::filesystem::remove(vtk_name);
+    }
+
+    // Benchmark writing an OBJ line by line with std::fstream against the
+    // buffered writer
+    Report report("Export_RXMesh");
+    report.command_line(rxmesh_args.argc, rxmesh_args.argv);
+    report.device();
+    report.system();
+    report.model_data(rxmesh_args.obj_file_name, rxmesh_static);
+
+    TestData td_fstream, td_buffered;
+    td_fstream.test_name = "fstream_export_obj";
+    td_buffered.test_name = "buffered_export_obj";
+    for (uint32_t itr = 0; itr < rxmesh_args.num_run; itr++) {
+        CPUTimer timer;
+        timer.start();
+        {
+            std::fstream file(obj_name, std::ios::out);
+            file.precision(30);
+            for (uint32_t v = 0; v < Vertices.size(); ++v) {
+                file << "v  ";
+                for (uint32_t i = 0; i < 3; ++i) {
+                    file << Vertices[v][i] << "  ";
+                }
+                file << std::endl;
+            }
+            for (uint32_t f = 0; f < Faces.size(); ++f) {
+                file << "f ";
+                for (uint32_t i = 0; i < 3; ++i) {
+                    file << Faces[f][i] + 1 << " ";
+                }
+                file << std::endl;
+            }
+        }
+        timer.stop();
+        td_fstream.time_ms.push_back(timer.elapsed_millis());
+        td_fstream.passed.push_back(true);
+
+        timer.start();
+        export_obj(Faces, Vertices, obj_name, false);
+        timer.stop();
+        td_buffered.time_ms.push_back(timer.elapsed_millis());
+        td_buffered.passed.push_back(true);
+    }
+
+    report.add_test(td_fstream);
+    report.add_test(td_buffered);
+    if (!rxmesh_args.quite) {
+        RXMESH_TRACE(" Export OBJ fstream= {} (ms), buffered= {} (ms)",
+                     td_fstream.time_ms.back(), td_buffered.time_ms.back());
+    }
+    report.write(rxmesh_args.output_folder + "/rxmesh", "Export");
+
+    std::filesystem::remove(obj_name);
+}
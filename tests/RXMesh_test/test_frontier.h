@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+#include "host_bfs.h"
+#include "rxmesh/rxmesh_attribute.h"
+#include "rxmesh/rxmesh_frontier.h"
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+
+/**
+ * frontier_grow()
+ */
+template <uint32_t blockThreads>
+__launch_bounds__(blockThreads) __global__
+    static void frontier_grow(const RXMESH::RXMeshContext context,
+                              uint32_t*                   d_region,
+                              const RXMESH::Frontier      frontier)
+{
+    // region growing where every active vertex hands its region to its
+    // unassigned neighbours
+    using namespace RXMESH;
+    auto is_active = [&](uint32_t v_id) { return frontier.is_active(v_id); };
+
+    auto grow = [&](uint32_t v_id, RXMeshIterator& iter) {
+        for (uint32_t i = 0; i < iter.size(); ++i) {
+            const uint32_t n = iter[i];
+            if (atomicCAS(d_region + n, INVALID32, d_region[v_id]) ==
+                INVALID32) {
+                frontier.activate(n);
+            }
+        }
+    };
+
+    query_block_dispatcher<Op::VV, blockThreads>(context, grow, is_active);
+}
+
+TEST(RXMesh, Frontier)
+{
+    using namespace RXMESH;
+    constexpr uint32_t blockThreads = 256;
+
+    std::vector<std::vector<uint32_t>> Faces;
+    std::vector<std::vector<dataT>>    Vertices;
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Vertices, Faces, true));
+
+    RXMeshStatic<PATCH_SIZE> rxmesh_static(Faces, Vertices, false,
+                                           rxmesh_args.quite);
+
+    const uint32_t num_vertices = rxmesh_static.get_num_vertices();
+    const uint32_t num_patches = rxmesh_static.get_num_patches();
+
+    // the seed's region is its own id
+    const uint32_t        seed = num_vertices / 3;
+    const uint32_t        num_rounds = 4;
+    std::vector<uint32_t> seeds = {seed, seed};
+
+    RXMeshAttribute<uint32_t> region("region");
+    region.init(num_vertices, 1u, RXMESH::LOCATION_ALL);
+    region.reset(INVALID32, RXMESH::HOST);
+    region(seed) = seed;
+    region.move(RXMESH::HOST, RXMESH::DEVICE);
+
+    Frontier frontier;
+    rxmesh_static.init_frontier(frontier);
+    frontier.add(seeds);
+
+    LaunchBox<blockThreads> launch_box;
+    rxmesh_static.prepare_launch_box(Op::VV, launch_box);
+
+    std::vector<uint32_t> active_vertices, active_patches;
+    const uint32_t        rounds = rxmesh_static.for_each_frontier_round(
+        frontier,
+        [&](const RXMeshContext& context, uint32_t num_blocks) {
+            active_vertices.push_back(frontier.get_num_active_vertices());
+            active_patches.push_back(num_blocks);
+            frontier_grow<blockThreads>
+                <<<num_blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+                    context, region.get_pointer(RXMESH::DEVICE), frontier);
+        },
+        num_rounds);
+    CUDA_ERROR(cudaDeviceSynchronize());
+    region.move(RXMESH::DEVICE, RXMESH::HOST);
+
+    // serial BFS on the host as reference
+    const std::vector<uint32_t> level = host_bfs(Faces, num_vertices, seeds);
+
+    // round r processes the vertices of level r so after num_rounds rounds,
+    // the region covers the vertices up to level num_rounds
+    EXPECT_EQ(rounds, num_rounds);
+    std::vector<uint32_t> level_count(num_rounds, 0);
+    bool                  passed = true;
+    for (uint32_t v = 0; v < num_vertices; ++v) {
+        const uint32_t expected = (level[v] <= num_rounds) ? seed : INVALID32;
+        passed = passed && (region(v) == expected);
+        if (level[v] < num_rounds) {
+            level_count[level[v]]++;
+        }
+    }
+    EXPECT_TRUE(passed) << " region does not match the host BFS";
+
+    // duplicate seeds are only activated once, and a round only launches the
+    // patches with active vertices
+    ASSERT_EQ(active_vertices.size(), num_rounds);
+    for (uint32_t r = 0; r < num_rounds; ++r) {
+        EXPECT_EQ(active_vertices[r], level_count[r]);
+        EXPECT_GE(active_patches[r], 1u);
+        EXPECT_LE(active_patches[r], std::min(num_patches, level_count[r]));
+    }
+    EXPECT_EQ(active_patches[0], 1u);
+
+    // the last round's activations are pending
+    uint32_t num_pending = 0;
+    for (uint32_t v = 0; v < num_vertices; ++v) {
+        num_pending += (level[v] == num_rounds);
+    }
+    frontier.advance();
+    EXPECT_EQ(frontier.get_num_active_vertices(), num_pending);
+
+    frontier.release();
+    region.release();
+}
@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include "gtest/gtest.h"
+#include "rxmesh/rxmesh_host_queries.h"
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+
+/**
+ * host_query_compare()
+ */
+template <RXMESH::Op op>
+inline void host_query_compare(
+    RXMESH::RXMeshStatic<PATCH_SIZE>&         rxmesh_static,
+    const std::vector<std::vector<uint32_t>>& expected)
+{
+    // run the host query and compare every source element's output (as a
+    // set) against expected
+    std::vector<std::vector<uint32_t>> output(expected.size());
+    std::vector<uint32_t>              num_calls(expected.size(), 0);
+    std::mutex                         lock;
+    rxmesh_static.query_host<op>(
+        [&](uint32_t id, const uint32_t* out, uint32_t size) {
+            std::lock_guard<std::mutex> guard(lock);
+            num_calls[id]++;
+            output[id].assign(out, out + size);
+        });
+
+    for (uint32_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(num_calls[i], 1u);
+        std::vector<uint32_t> res = output[i], gold = expected[i];
+        std::sort(res.begin(), res.end());
+        std::sort(gold.begin(), gold.end());
+        EXPECT_EQ(res, gold) << RXMESH::op_to_string(op) << " " << i;
+    }
+}
+
+TEST(RXMesh, HostMatTranspose)
+{
+    using namespace RXMESH;
+
+    // random EV-like (rowOffset 2) and FE-like (rowOffset 3 with a one-bit
+    // shift) matrices against a serial reference
+    std::mt19937          gen(7);
+    std::vector<uint16_t> scratch;
+    for (uint32_t num_rows : {1u, 7u, 33u, 511u}) {
+        for (uint32_t num_cols : {1u, 15u, 17u, 64u, 700u}) {
+            for (uint32_t row_offset : {2u, 3u}) {
+                const int             shift = (row_offset == 3) ? 1 : 0;
+                std::vector<uint16_t> mat(num_rows * row_offset);
+                for (auto& m : mat) {
+                    m = static_cast<uint16_t>(((gen() % num_cols) << shift) |
+                                              (gen() & shift));
+                }
+                std::vector<uint16_t> offset(num_cols + 1), value(mat.size());
+                if (row_offset == 2) {
+                    host_mat_transpose<2>(num_rows, num_cols, mat.data(),
+                                          offset.data(), value.data(),
+                                          scratch, shift);
+                } else {
+                    host_mat_transpose<3>(num_rows, num_cols, mat.data(),
+                                          offset.data(), value.data(),
+                                          scratch, shift);
+                }
+
+                std::vector<uint16_t> gold_offset(1, 0), gold_value;
+                for (uint32_t c = 0; c < num_cols; ++c) {
+                    for (uint32_t i = 0; i < mat.size(); ++i) {
+                        if ((mat[i] >> shift) == c) {
+                            gold_value.push_back(
+                                static_cast<uint16_t>(i / row_offset));
+                        }
+                    }
+                    gold_offset.push_back(
+                        static_cast<uint16_t>(gold_value.size()));
+                }
+                EXPECT_EQ(offset, gold_offset);
+                EXPECT_EQ(value, gold_value);
+            }
+        }
+    }
+}
+
+TEST(RXMesh, HostSIMD)
+{
+    using namespace RXMESH;
+
+    // the SIMD paths of the sub-histogram merge and the prefix sum that the
+    // host CPU supports against the scalar ones
+#if !defined(RXMESH_HOST_X86_SIMD)
+    GTEST_SKIP() << "no x86 SIMD paths for this host compiler";
+#else
+    if (!detail::host_has_avx2()) {
+        GTEST_SKIP() << "the host CPU does not support AVX2";
+    }
+    std::mt19937 gen(11);
+    bool         passed = true;
+    for (uint32_t num_cols : {1u, 15u, 16u, 17u, 31u, 64u, 700u, 4099u}) {
+        const uint32_t stride = DIVIDE_UP(num_cols, 32) * 32;
+        std::vector<uint16_t> hist(detail::host_num_sub_hist * stride);
+        for (auto& h : hist) {
+            h = static_cast<uint16_t>(gen());
+        }
+        std::vector<uint16_t> gold_hist = hist;
+        detail::host_merge_hist_scalar(num_cols, gold_hist.data());
+        if (detail::host_has_avx512bw()) {
+            std::vector<uint16_t> avx512_hist = hist;
+            detail::host_merge_hist_avx512(num_cols, avx512_hist.data());
+            passed = passed && (avx512_hist == gold_hist);
+        }
+        std::vector<uint16_t> avx2_hist = hist;
+        detail::host_merge_hist_avx2(num_cols, avx2_hist.data());
+        passed = passed && (avx2_hist == gold_hist);
+
+        // exclusive sum out of place and in place (the counts are random
+        // so the sums wrap around the same way in both)
+        std::vector<uint16_t> gold_sum(num_cols + 1), sum(num_cols + 1);
+        detail::host_exclusive_sum_scalar(num_cols, hist.data(),
+                                          gold_sum.data());
+        detail::host_exclusive_sum_avx2(num_cols, hist.data(), sum.data());
+        passed = passed && (sum == gold_sum);
+        std::vector<uint16_t> in_place(hist.begin(),
+                                       hist.begin() + num_cols + 1);
+        detail::host_exclusive_sum_avx2(num_cols, in_place.data(),
+                                        in_place.data());
+        passed = passed && (in_place == gold_sum);
+    }
+    EXPECT_TRUE(passed);
+#endif
+}
+
+TEST(RXMesh, HostQueries)
+{
+    using namespace RXMESH;
+
+    std::vector<std::vector<uint32_t>> Faces;
+    std::vector<std::vector<dataT>>    Vertices;
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Vertices, Faces, true));
+
+    RXMeshStatic<PATCH_SIZE> rxmesh_static(Faces, Vertices, false,
+                                           rxmesh_args.quite);
+
+    const uint32_t num_vertices = rxmesh_static.get_num_vertices();
+    const uint32_t num_edges = rxmesh_static.get_num_edges();
+
+    // reference from the input faces
+    std::vector<std::vector<uint32_t>> vv(num_vertices), ve(num_vertices),
+        vf(num_vertices), ef(num_edges);
+    for (uint32_t f = 0; f < Faces.size(); ++f) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            const uint32_t v0 = Faces[f][i], v1 = Faces[f][(i + 1) % 3];
+            const uint32_t e = rxmesh_static.get_edge_id(v0, v1);
+            vf[v0].push_back(f);
+            ef[e].push_back(f);
+            if (std::find(vv[v0].begin(), vv[v0].end(), v1) == vv[v0].end()) {
+                vv[v0].push_back(v1);
+                vv[v1].push_back(v0);
+                ve[v0].push_back(e);
+                ve[v1].push_back(e);
+            }
+        }
+    }
+
+    host_query_compare<Op::VV>(rxmesh_static, vv);
+    host_query_compare<Op::VE>(rxmesh_static, ve);
+    host_query_compare<Op::VF>(rxmesh_static, vf);
+    host_query_compare<Op::EF>(rxmesh_static, ef);
+}
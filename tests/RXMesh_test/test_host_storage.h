@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+
+TEST(RXMesh, HostStorage)
+{
+    using namespace RXMESH;
+
+    std::vector<std::vector<uint32_t>> Faces;
+    std::vector<std::vector<dataT>>    Vertices;
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Vertices, Faces, true));
+
+    RXMeshStatic<PATCH_SIZE> rxmesh_static(Faces, Vertices, false,
+                                           rxmesh_args.quite);
+
+    const double live_mb = rxmesh_static.get_host_storage_mb();
+    const double peak_mb = rxmesh_static.get_peak_host_storage_mb();
+    EXPECT_GT(live_mb, 0.0);
+    EXPECT_GE(peak_mb, live_mb);
+
+    // the live total should be the sum of its components and no component
+    // should exceed its own peak
+    double sum = 0;
+    for (auto& it : rxmesh_static.get_host_storage_breakdown_mb()) {
+        EXPECT_LE(it.second,
+                  rxmesh_static.get_peak_host_storage_breakdown_mb().at(
+                      it.first));
+        if (it.first != "total") {
+            sum += it.second;
+        }
+    }
+    EXPECT_NEAR(sum, live_mb, 1e-9);
+    EXPECT_GT(rxmesh_static.get_host_storage_breakdown_mb().at("edges_map"),
+              0.0);
+    EXPECT_GT(rxmesh_static.get_host_storage_breakdown_mb().at("fv"), 0.0);
+
+    // releasing the build temporaries should drop the edge map and the face
+    // list without touching the peak
+    rxmesh_static.release_build_temporaries();
+    EXPECT_LT(rxmesh_static.get_host_storage_mb(), live_mb);
+    EXPECT_EQ(rxmesh_static.get_host_storage_breakdown_mb().at("edges_map"),
+              0.0);
+    EXPECT_EQ(rxmesh_static.get_host_storage_breakdown_mb().at("fv"), 0.0);
+    EXPECT_EQ(rxmesh_static.get_peak_host_storage_mb(), peak_mb);
+}
+
+TEST(RXMesh, MoveConstruction)
+{
+    using namespace RXMESH;
+
+    std::vector<std::vector<uint32_t>> Faces;
+    std::vector<std::vector<dataT>>    Vertices;
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Vertices, Faces, true));
+
+    // build once from a copy (faces are kept by the caller) and once by
+    // moving the faces in. Both should end up with the same mesh
+    std::vector<std::vector<dataT>> Vertices_copy(Vertices);
+    RXMeshStatic<PATCH_SIZE>        rxmesh_copy(Faces, Vertices_copy, false,
+                                         rxmesh_args.quite);
+
+    std::vector<std::vector<uint32_t>> Faces_to_move(Faces);
+    RXMeshStatic<PATCH_SIZE> rxmesh_move(std::move(Faces_to_move), Vertices,
+                                         false, rxmesh_args.quite);
+
+    EXPECT_EQ(rxmesh_copy.get_num_vertices(), rxmesh_move.get_num_vertices());
+    EXPECT_EQ(rxmesh_copy.get_num_edges(), rxmesh_move.get_num_edges());
+    EXPECT_EQ(rxmesh_copy.get_num_faces(), rxmesh_move.get_num_faces());
+    EXPECT_EQ(rxmesh_move.get_faces(), Faces);
+    EXPECT_GT(rxmesh_move.get_host_storage_breakdown_mb().at("ff"), 0.0);
+}
@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <map>
+#include "gtest/gtest.h"
+#include "rxmesh/kernels/rxmesh_kring.cuh"
+#include "rxmesh/rxmesh_kring.h"
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+
+/**
+ * kring_bfs()
+ */
+inline void kring_bfs(const std::vector<std::vector<uint32_t>>& adjacency,
+                      const uint32_t                            k,
+                      std::vector<uint32_t>&                    size,
+                      std::vector<unsigned long long int>&      sum,
+                      std::vector<uint32_t>&                    level_sum)
+{
+    // size of the k-ring (including the center), the sum of the squared
+    // ids in it, and the sum of the levels for every element
+    size.resize(adjacency.size());
+    sum.resize(adjacency.size());
+    level_sum.resize(adjacency.size());
+    for (uint32_t v = 0; v < adjacency.size(); ++v) {
+        std::vector<uint32_t> ring(1, v), frontier(1, v);
+        level_sum[v] = 0;
+        for (uint32_t l = 0; l < k; ++l) {
+            std::vector<uint32_t> next;
+            for (uint32_t f : frontier) {
+                for (uint32_t n : adjacency[f]) {
+                    if (std::find(ring.begin(), ring.end(), n) == ring.end()) {
+                        ring.push_back(n);
+                        next.push_back(n);
+                        level_sum[v] += l + 1;
+                    }
+                }
+            }
+            frontier.swap(next);
+        }
+        size[v] = ring.size();
+        sum[v] = 0;
+        for (uint32_t r : ring) {
+            sum[v] += static_cast<unsigned long long int>(r) * r;
+        }
+    }
+}
+
+/**
+ * kring_test()
+ */
+template <uint32_t blockThreads>
+__launch_bounds__(blockThreads) __global__
+    static void kring_test(const RXMESH::RXMeshContext context,
+                           const RXMESH::KRingArena    arena,
+                           const uint32_t              k,
+                           uint32_t*                   d_size,
+                           unsigned long long int*     d_sum)
+{
+    using namespace RXMESH;
+
+    // every vertex records the size of its k-ring and the sum of the squared
+    // ids in it which is independent of the gather order
+    KRing ring(arena);
+    kring_gather<blockThreads>(
+        context, ring, k, [](uint32_t, RXMeshIterator&) {},
+        [](uint32_t, uint32_t) { return true; });
+
+    if (ring.is_valid()) {
+        unsigned long long int sum = 0;
+        ring.for_each([&](uint32_t v) {
+            sum += static_cast<unsigned long long int>(v) * v;
+        });
+        d_size[ring.center()] = ring.size();
+        d_sum[ring.center()] = sum;
+    }
+}
+
+TEST(RXMesh, KRing)
+{
+    using namespace RXMESH;
+
+    constexpr uint32_t blockThreads = 512;
+
+    std::vector<std::vector<uint32_t>> Faces;
+    std::vector<std::vector<dataT>>    Vertices;
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Vertices, Faces, true));
+
+    RXMeshStatic<PATCH_SIZE> rxmesh_static(Faces, Vertices, false,
+                                           rxmesh_args.quite);
+    ASSERT_GE(blockThreads, rxmesh_static.get_per_patch_max_owned_vertices());
+
+    const uint32_t num_vertices = rxmesh_static.get_num_vertices();
+
+    // one ring from the input faces
+    std::vector<std::vector<uint32_t>> one_ring(num_vertices);
+    for (auto& f : Faces) {
+        for (uint32_t i = 0; i < f.size(); ++i) {
+            one_ring[f[i]].push_back(f[(i + 1) % f.size()]);
+            one_ring[f[(i + 1) % f.size()]].push_back(f[i]);
+        }
+    }
+
+    uint32_t*               d_size(nullptr);
+    unsigned long long int* d_sum(nullptr);
+    CUDA_ERROR(cudaMalloc((void**)&d_size, num_vertices * sizeof(uint32_t)));
+    CUDA_ERROR(cudaMalloc((void**)&d_sum,
+                          num_vertices * sizeof(unsigned long long int)));
+
+    LaunchBox<blockThreads> launch_box;
+    rxmesh_static.prepare_launch_box(Op::VV, launch_box, true);
+
+    // start with a tiny arena so that the overflow path is exercised
+    KRingArena arena;
+    arena.init(rxmesh_static.get_num_patches(),
+               rxmesh_static.get_per_patch_max_owned_vertices(), 1);
+
+    for (uint32_t k = 1; k <= 3; ++k) {
+        while (true) {
+            arena.reset();
+            kring_test<blockThreads>
+                <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+                    rxmesh_static.get_context(), arena, k, d_size, d_sum);
+            CUDA_ERROR(cudaDeviceSynchronize());
+            CUDA_ERROR(cudaGetLastError());
+            if (!arena.is_overflown()) {
+                break;
+            }
+            arena.grow();
+        }
+
+        std::vector<uint32_t>               h_size(num_vertices);
+        std::vector<unsigned long long int> h_sum(num_vertices);
+        CUDA_ERROR(cudaMemcpy(h_size.data(), d_size,
+                              num_vertices * sizeof(uint32_t),
+                              cudaMemcpyDeviceToHost));
+        CUDA_ERROR(cudaMemcpy(h_sum.data(), d_sum,
+                              num_vertices * sizeof(unsigned long long int),
+                              cudaMemcpyDeviceToHost));
+
+        // host BFS up to k hops
+        std::vector<uint32_t>               gt_size, gt_level_sum;
+        std::vector<unsigned long long int> gt_sum;
+        kring_bfs(one_ring, k, gt_size, gt_sum, gt_level_sum);
+        EXPECT_TRUE(h_size == gt_size && h_sum == gt_sum)
+            << " k-ring with k= " << k << " does not match the host BFS";
+    }
+
+    arena.release();
+    GPU_FREE(d_size);
+    GPU_FREE(d_sum);
+}
+
+/**
+ * RecordKRing
+ */
+struct RecordKRing
+{
+    // query_kring() compute_op that records the size, the sum of the squared
+    // ids, and the sum of the levels of every ring along with how many times
+    // it was called for every element
+    uint32_t*               d_size;
+    unsigned long long int* d_sum;
+    uint32_t*               d_level_sum;
+    uint32_t*               d_calls;
+
+    __device__ void operator()(uint32_t id, const RXMESH::KRing& ring) const
+    {
+        unsigned long long int sum = 0;
+        uint32_t               level_sum = 0;
+        ring.for_each_level([&](uint32_t r, uint32_t level) {
+            sum += static_cast<unsigned long long int>(r) * r;
+            level_sum += level;
+        });
+        d_size[id] = ring.size();
+        d_sum[id] = sum;
+        d_level_sum[id] = level_sum;
+        ::atomicAdd(d_calls + id, 1u);
+    }
+};
+
+TEST(RXMesh, QueryKRing)
+{
+    using namespace RXMESH;
+
+    constexpr uint32_t blockThreads = 512;
+
+    std::vector<std::vector<uint32_t>> Faces;
+    std::vector<std::vector<dataT>>    Vertices;
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Vertices, Faces, true));
+
+    RXMeshStatic<PATCH_SIZE> rxmesh_static(Faces, Vertices, false,
+                                           rxmesh_args.quite);
+
+    const uint32_t num_vertices = rxmesh_static.get_num_vertices();
+    const uint32_t num_faces = rxmesh_static.get_num_faces();
+
+    // VV and FF (faces sharing an edge) adjacency from the input faces
+    std::vector<std::vector<uint32_t>> vv(num_vertices), ff(num_faces);
+    std::map<std::pair<uint32_t, uint32_t>, std::vector<uint32_t>> edge_faces;
+    for (uint32_t f = 0; f < Faces.size(); ++f) {
+        for (uint32_t i = 0; i < Faces[f].size(); ++i) {
+            uint32_t v0 = Faces[f][i];
+            uint32_t v1 = Faces[f][(i + 1) % Faces[f].size()];
+            vv[v0].push_back(v1);
+            vv[v1].push_back(v0);
+            edge_faces[{std::min(v0, v1), std::max(v0, v1)}].push_back(f);
+        }
+    }
+    for (auto& it : edge_faces) {
+        for (uint32_t a = 0; a < it.second.size(); ++a) {
+            for (uint32_t b = 0; b < it.second.size(); ++b) {
+                if (a != b) {
+                    ff[it.second[a]].push_back(it.second[b]);
+                }
+            }
+        }
+    }
+
+    const uint32_t          num_elements = std::max(num_vertices, num_faces);
+    uint32_t *d_size(nullptr), *d_level_sum(nullptr), *d_calls(nullptr);
+    unsigned long long int* d_sum(nullptr);
+    CUDA_ERROR(cudaMalloc((void**)&d_size, num_elements * sizeof(uint32_t)));
+    CUDA_ERROR(cudaMalloc((void**)&d_calls, num_elements * sizeof(uint32_t)));
+    CUDA_ERROR(
+        cudaMalloc((void**)&d_level_sum, num_elements * sizeof(uint32_t)));
+    CUDA_ERROR(cudaMalloc((void**)&d_sum,
+                          num_elements * sizeof(unsigned long long int)));
+
+    const RecordKRing record{d_size, d_sum, d_level_sum, d_calls};
+
+    auto verify = [&](const std::vector<std::vector<uint32_t>>& adjacency,
+                      const uint32_t                            k) {
+        const uint32_t                      n = adjacency.size();
+        std::vector<uint32_t> h_size(n), h_level_sum(n), gt_size, gt_level_sum;
+        std::vector<unsigned long long int> h_sum(n), gt_sum;
+        CUDA_ERROR(cudaMemcpy(h_size.data(), d_size, n * sizeof(uint32_t),
+                              cudaMemcpyDeviceToHost));
+        CUDA_ERROR(cudaMemcpy(h_sum.data(), d_sum,
+                              n * sizeof(unsigned long long int),
+                              cudaMemcpyDeviceToHost));
+        CUDA_ERROR(cudaMemcpy(h_level_sum.data(), d_level_sum,
+                              n * sizeof(uint32_t), cudaMemcpyDeviceToHost));
+        kring_bfs(adjacency, k, gt_size, gt_sum, gt_level_sum);
+        EXPECT_TRUE(h_size == gt_size && h_sum == gt_sum &&
+                    h_level_sum == gt_level_sum)
+            << " k-ring with k= " << k << " does not match the host BFS";
+
+        // compute_op is called once per element even if the arena
+        // overflows and the query is re-launched
+        std::vector<uint32_t> h_calls(n);
+        CUDA_ERROR(cudaMemcpy(h_calls.data(), d_calls, n * sizeof(uint32_t),
+                              cudaMemcpyDeviceToHost));
+        EXPECT_TRUE(std::all_of(h_calls.begin(), h_calls.end(),
+                                [](uint32_t c) { return c == 1; }));
+        CUDA_ERROR(cudaMemset(d_calls, 0, num_elements * sizeof(uint32_t)));
+    };
+    CUDA_ERROR(cudaMemset(d_calls, 0, num_elements * sizeof(uint32_t)));
+
+    // start with a tiny arena so that the re-launch path is exercised
+    KRingArena arena;
+    arena.init(rxmesh_static.get_num_patches(),
+               rxmesh_static.get_per_patch_max_owned_vertices(), 1);
+    for (uint32_t k = 2; k <= 4; k += 2) {
+        rxmesh_static.query_kring<Op::VV, blockThreads>(k, arena, record);
+        CUDA_ERROR(cudaDeviceSynchronize());
+        verify(vv, k);
+    }
+    arena.release();
+
+    KRingArena face_arena;
+    rxmesh_static.query_kring<Op::FF, blockThreads>(2, face_arena, record);
+    CUDA_ERROR(cudaDeviceSynchronize());
+    verify(ff, 2);
+    face_arena.release();
+
+    GPU_FREE(d_size);
+    GPU_FREE(d_sum);
+    GPU_FREE(d_level_sum);
+    GPU_FREE(d_calls);
+}
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include "gtest/gtest.h"
+#include "rxmesh/rxmesh_attribute.h"
+#include "rxmesh/rxmesh_csr.h"
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+
+TEST(RXMesh, Laplacian)
+{
+    using namespace RXMESH;
+
+    std::vector<std::vector<uint32_t>> Faces;
+    std::vector<std::vector<dataT>>    Vertices;
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Vertices, Faces, true));
+
+    RXMeshStatic<PATCH_SIZE> rxmesh_static(Faces, Vertices, false,
+                                           rxmesh_args.quite);
+
+    const uint32_t num_vertices = rxmesh_static.get_num_vertices();
+
+    RXMeshAttribute<dataT> coords;
+    coords.set_name("coords");
+    coords.init(num_vertices, 3u, RXMESH::LOCATION_ALL);
+    for (uint32_t i = 0; i < num_vertices; ++i) {
+        for (uint32_t j = 0; j < 3; ++j) {
+            coords(i, j) = Vertices[i][j];
+        }
+    }
+    coords.move(RXMESH::HOST, RXMESH::DEVICE);
+
+    // vertex valence from the input faces
+    std::vector<std::vector<uint32_t>> one_ring(num_vertices);
+    for (auto& f : Faces) {
+        for (uint32_t i = 0; i < f.size(); ++i) {
+            uint32_t v0 = f[i];
+            uint32_t v1 = f[(i + 1) % f.size()];
+            one_ring[v0].push_back(v1);
+            one_ring[v1].push_back(v0);
+        }
+    }
+    for (auto& r : one_ring) {
+        std::sort(r.begin(), r.end());
+        r.erase(std::unique(r.begin(), r.end()), r.end());
+    }
+
+    CSRMatrix<dataT> laplacian;
+    rxmesh_static.assemble_laplacian(coords, laplacian, nullptr, true);
+
+    std::vector<uint32_t> row_ptr, col_idx, row_vertex;
+    std::vector<dataT>    val;
+    laplacian.copy_to_host(row_ptr, col_idx, val, row_vertex);
+
+    ASSERT_EQ(row_ptr.size(), num_vertices + 1);
+    EXPECT_EQ(row_ptr.back(), laplacian.get_nnz());
+
+    // every vertex appears as exactly one row
+    std::vector<uint32_t> seen(num_vertices, 0);
+    for (uint32_t r = 0; r < num_vertices; ++r) {
+        ASSERT_LT(row_vertex[r], num_vertices);
+        seen[row_vertex[r]]++;
+    }
+    bool passed = std::all_of(seen.begin(), seen.end(),
+                              [](uint32_t s) { return s == 1; });
+    EXPECT_TRUE(passed) << " every vertex should be exactly one row";
+
+    // uniform Laplacian: rows sum to zero, the diagonal is the valence, and
+    // the off-diagonal columns are exactly the one ring (sorted)
+    passed = true;
+    for (uint32_t r = 0; r < num_vertices; ++r) {
+        const uint32_t v = row_vertex[r];
+        passed = passed &&
+                 (row_ptr[r + 1] - row_ptr[r] == one_ring[v].size() + 1);
+
+        dataT                 sum = 0;
+        std::vector<uint32_t> ring;
+        for (uint32_t j = row_ptr[r]; j < row_ptr[r + 1]; ++j) {
+            sum += val[j];
+            if (j > row_ptr[r]) {
+                passed = passed && (col_idx[j - 1] < col_idx[j]);
+            }
+            if (col_idx[j] == r) {
+                passed = passed && (val[j] == dataT(one_ring[v].size()));
+            } else {
+                passed = passed && (val[j] == dataT(-1));
+                ring.push_back(row_vertex[col_idx[j]]);
+            }
+        }
+        std::sort(ring.begin(), ring.end());
+        passed = passed && (sum == dataT(0)) && (ring == one_ring[v]);
+    }
+    EXPECT_TRUE(passed) << " the uniform Laplacian rows are wrong";
+
+    laplacian.release();
+    coords.release();
+}
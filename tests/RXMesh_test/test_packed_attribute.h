@@ -0,0 +1,214 @@
+#include <cmath>
+#include <random>
+#include "gtest/gtest.h"
+#include "rxmesh/rxmesh_attribute.h"
+#include "rxmesh/rxmesh_packed_attribute.h"
+#include "rxmesh/util/report.h"
+#include "rxmesh/util/timer.h"
+
+/**
+ * packed_scale()
+ */
+template <typename inT, typename outT>
+__global__ static void packed_scale(const inT  X,
+                                    outT       Y,
+                                    const float alpha)
+{
+    // Y = alpha * X where either could be packed. Bandwidth bound
+    const uint32_t num_attr = X.get_num_attribute_per_element();
+    for (uint32_t i = blockIdx.x * blockDim.x + threadIdx.x;
+         i < X.get_num_mesh_elements(); i += blockDim.x * gridDim.x) {
+        for (uint32_t j = 0; j < num_attr; ++j) {
+            Y(i, j) = alpha * X(i, j);
+        }
+    }
+}
+
+/**
+ * check_packed()
+ */
+template <typename codecT>
+inline void check_packed(const RXMESH::RXMeshAttribute<float>& source,
+                         const float                           tolerance,
+                         const bool                            relative)
+{
+    using namespace RXMESH;
+
+    const uint32_t num_elements = source.get_num_mesh_elements();
+    const uint32_t num_attr = source.get_num_attribute_per_element();
+
+    for (layoutT layout : {RXMESH::AoS, RXMESH::SoA, RXMESH::AoSoA}) {
+        RXMeshPackedAttribute<codecT> packed;
+        packed.init(num_elements, num_attr, RXMESH::LOCATION_ALL, layout);
+        packed.set_range(source);
+        packed.encode(source, RXMESH::HOST | RXMESH::DEVICE);
+
+        // host access converts on the fly and agrees with the device
+        RXMeshAttribute<float> decoded;
+        decoded.init(num_elements, num_attr, RXMESH::LOCATION_ALL,
+                     RXMESH::AoS, false, false);
+        packed.decode(decoded, RXMESH::DEVICE);
+        decoded.move(RXMESH::DEVICE, RXMESH::HOST);
+        bool passed = true;
+        for (uint32_t i = 0; i < num_elements; ++i) {
+            for (uint32_t j = 0; j < num_attr; ++j) {
+                const float val = packed(i, j);
+                const float err = std::abs(val - source(i, j));
+                const float bound =
+                    relative ? tolerance * std::abs(source(i, j)) + 1e-7f :
+                               tolerance;
+                passed = passed && (val == decoded(i, j)) && (err <= bound);
+            }
+        }
+        EXPECT_TRUE(passed) << "layout= " << layout;
+
+        // bulk host decode (SIMD for the same layout)
+        decoded.reset(0, RXMESH::HOST);
+        packed.decode(decoded, RXMESH::HOST);
+        passed = true;
+        for (uint32_t i = 0; i < num_elements; ++i) {
+            for (uint32_t j = 0; j < num_attr; ++j) {
+                passed = passed && (decoded(i, j) == float(packed(i, j)));
+            }
+        }
+        EXPECT_TRUE(passed) << "layout= " << layout;
+
+        // write through operator()
+        packed(0, 0) = source(1, 0);
+        EXPECT_EQ(float(packed(0, 0)), float(packed(1, 0)));
+
+        decoded.release();
+        packed.release();
+    }
+}
+
+TEST(RXMesh, PackedAttribute)
+{
+    using namespace RXMESH;
+
+    const uint32_t num_elements = 1u << 22;
+    const uint32_t num_attr = 3;
+
+    std::mt19937                          gen(17);
+    std::uniform_real_distribution<float> dist(-10.f, 10.f);
+
+    RXMeshAttribute<float> source;
+    source.init(num_elements, num_attr, RXMESH::LOCATION_ALL, RXMESH::AoS,
+                false, false);
+    for (uint32_t i = 0; i < num_elements; ++i) {
+        for (uint32_t j = 0; j < num_attr; ++j) {
+            source(i, j) = dist(gen);
+        }
+    }
+    source.move(RXMESH::HOST, RXMESH::DEVICE);
+
+    check_packed<HalfCodec>(source, 1.f / 2048.f, true);
+    check_packed<BFloat16Codec>(source, 1.f / 256.f, true);
+    // half a quantization step of the [-10, 10] range
+    check_packed<Quantized16Codec>(source, 10.f / 32767.f, false);
+    check_packed<Quantized8Codec>(source, 10.f / 127.f, false);
+
+    // exactly representable values survive the round trip
+    for (float val : {0.f, -0.f, 1.f, -2.5f, 65504.f, 6.1035156e-05f,
+                      5.9604645e-08f}) {
+        EXPECT_EQ(HalfCodec::decode(HalfCodec::encode(val, 1, 0), 1, 0), val);
+    }
+    for (float val : {0.f, -0.f, 1.f, -2.5f, 6.1035156e-05f, 3.3895314e+38f}) {
+        EXPECT_EQ(BFloat16Codec::decode(BFloat16Codec::encode(val, 1, 0), 1, 0),
+                  val);
+    }
+    EXPECT_TRUE(std::isinf(
+        HalfCodec::decode(HalfCodec::encode(65520.f, 1, 0), 1, 0)));
+    EXPECT_TRUE(std::isnan(
+        HalfCodec::decode(HalfCodec::encode(std::nanf(""), 1, 0), 1, 0)));
+    EXPECT_TRUE(std::isnan(BFloat16Codec::decode(
+        BFloat16Codec::encode(std::nanf(""), 1, 0), 1, 0)));
+
+    // NaN is quantized to zero by the bulk (SIMD) and the scalar encode
+    {
+        std::vector<float> in(19);
+        for (uint32_t i = 0; i < in.size(); ++i) {
+            in[i] = float(i) - 9.f;
+        }
+        in[3] = in[17] = std::nanf("");
+        std::vector<int16_t> out(in.size());
+        Quantized16Codec::encode_n(in.data(), out.data(), in.size(), 0.01f,
+                                   0.f);
+        bool passed = (out[3] == 0 && out[17] == 0);
+        for (uint32_t i = 0; i < in.size(); ++i) {
+            passed = passed &&
+                     (out[i] == Quantized16Codec::encode(in[i], 0.01f, 0.f));
+        }
+        EXPECT_TRUE(passed);
+    }
+
+    // Bandwidth: Y = 2 * X with fp32 and packed storage
+    Report report("PackedAttribute_RXMesh");
+    report.command_line(rxmesh_args.argc, rxmesh_args.argv);
+    report.device();
+    report.system();
+
+    const uint32_t threads = 256;
+    const uint32_t blocks = DIVIDE_UP(num_elements, threads);
+
+    RXMeshAttribute<float> Y;
+    Y.init(num_elements, num_attr, RXMESH::DEVICE, RXMESH::AoS, false, false);
+
+    auto bench = [&](const std::string& name, auto& X, auto& Z) {
+        TestData td;
+        td.test_name = name;
+        td.num_threads = threads;
+        td.num_blocks = blocks;
+        for (uint32_t itr = 0; itr < rxmesh_args.num_run; itr++) {
+            GPUTimer timer;
+            timer.start();
+            packed_scale<<<blocks, threads>>>(X, Z, 2.f);
+            timer.stop();
+            CUDA_ERROR(cudaDeviceSynchronize());
+            CUDA_ERROR(cudaGetLastError());
+            td.time_ms.push_back(timer.elapsed_millis());
+        }
+        td.passed.push_back(true);
+        report.add_test(td);
+        if (!rxmesh_args.quite) {
+            RXMESH_TRACE(" PackedAttribute {} = {} (ms)", name,
+                         td.time_ms.back());
+        }
+    };
+
+    bench("fp32", source, Y);
+    {
+        RXMeshPackedAttribute<HalfCodec> X, Z;
+        X.init(num_elements, num_attr, RXMESH::DEVICE);
+        Z.init(num_elements, num_attr, RXMESH::DEVICE);
+        X.encode(source, RXMESH::DEVICE);
+        bench("fp16", X, Z);
+        Z.release();
+        X.release();
+    }
+    {
+        RXMeshPackedAttribute<BFloat16Codec> X, Z;
+        X.init(num_elements, num_attr, RXMESH::DEVICE);
+        Z.init(num_elements, num_attr, RXMESH::DEVICE);
+        X.encode(source, RXMESH::DEVICE);
+        bench("bf16", X, Z);
+        Z.release();
+        X.release();
+    }
+    {
+        RXMeshPackedAttribute<Quantized8Codec> X, Z;
+        X.init(num_elements, num_attr, RXMESH::DEVICE);
+        Z.init(num_elements, num_attr, RXMESH::DEVICE);
+        X.set_range(-10.f, 10.f);
+        Z.set_range(-20.f, 20.f);
+        X.encode(source, RXMESH::DEVICE);
+        bench("q8", X, Z);
+        Z.release();
+        X.release();
+    }
+
+    report.write(rxmesh_args.output_folder + "/rxmesh", "PackedAttribute");
+
+    Y.release();
+    source.release();
+}
@@ -0,0 +1,105 @@
+#include "face_visit.cuh"
+#include "gtest/gtest.h"
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+
+/**
+ * ColorConflict
+ */
+struct ColorConflict
+{
+    // record which block touches which vertex. Within one color, a vertex
+    // touched by two different blocks means that two patches of the same
+    // color overlap
+    uint32_t* d_vertex_block;
+    uint32_t* d_num_conflicts;
+
+    __device__ void operator()(uint32_t, RXMESH::RXMeshIterator& fv) const
+    {
+        for (uint32_t v = 0; v < fv.size(); ++v) {
+            uint32_t prv = atomicCAS(d_vertex_block + fv[v], INVALID32,
+                                     uint32_t(blockIdx.x));
+            if (prv != INVALID32 && prv != blockIdx.x) {
+                atomicAdd(d_num_conflicts, 1u);
+            }
+        }
+    }
+};
+
+TEST(RXMesh, PatchColoring)
+{
+    using namespace RXMESH;
+
+    constexpr uint32_t blockThreads = 256;
+
+    std::vector<std::vector<uint32_t>> Faces;
+    std::vector<std::vector<dataT>>    Vertices;
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Vertices, Faces, true));
+
+    RXMeshStatic<PATCH_SIZE> rxmesh_static(Faces, Vertices, false,
+                                           rxmesh_args.quite);
+
+    rxmesh_static.compute_patch_coloring();
+
+    const uint32_t num_colors = rxmesh_static.get_num_patch_colors();
+    EXPECT_GT(num_colors, 0u);
+    EXPECT_LE(num_colors, rxmesh_static.get_num_patches());
+
+    // every patch is assigned exactly one valid color
+    uint32_t sum = 0;
+    for (uint32_t c = 0; c < num_colors; ++c) {
+        sum += rxmesh_static.get_num_patches_in_color(c);
+    }
+    EXPECT_EQ(sum, rxmesh_static.get_num_patches());
+    for (uint32_t p = 0; p < rxmesh_static.get_num_patches(); ++p) {
+        EXPECT_LT(rxmesh_static.get_patch_color(p), num_colors);
+    }
+
+    const uint32_t num_faces = rxmesh_static.get_num_faces();
+    const uint32_t num_vertices = rxmesh_static.get_num_vertices();
+
+    uint32_t *d_face_visits(nullptr), *d_vertex_block(nullptr),
+        *d_num_conflicts(nullptr);
+    CUDA_ERROR(
+        cudaMalloc((void**)&d_face_visits, num_faces * sizeof(uint32_t)));
+    CUDA_ERROR(
+        cudaMalloc((void**)&d_vertex_block, num_vertices * sizeof(uint32_t)));
+    CUDA_ERROR(cudaMalloc((void**)&d_num_conflicts, sizeof(uint32_t)));
+    CUDA_ERROR(cudaMemset(d_face_visits, 0, num_faces * sizeof(uint32_t)));
+    CUDA_ERROR(cudaMemset(d_num_conflicts, 0, sizeof(uint32_t)));
+
+    LaunchBox<blockThreads> launch_box;
+    rxmesh_static.prepare_launch_box(Op::FV, launch_box);
+
+    ColorConflict record_block{d_vertex_block, d_num_conflicts};
+    rxmesh_static.for_each_color(
+        [&](const RXMeshContext& context, uint32_t num_blocks) {
+            CUDA_ERROR(cudaMemset(d_vertex_block, 0xFF,
+                                  num_vertices * sizeof(uint32_t)));
+            face_visit<blockThreads>
+                <<<num_blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+                    context, d_face_visits, record_block);
+        });
+    CUDA_ERROR(cudaDeviceSynchronize());
+    CUDA_ERROR(cudaGetLastError());
+
+    std::vector<uint32_t> h_face_visits(num_faces);
+    uint32_t              h_num_conflicts = 0;
+    CUDA_ERROR(cudaMemcpy(h_face_visits.data(), d_face_visits,
+                          num_faces * sizeof(uint32_t),
+                          cudaMemcpyDeviceToHost));
+    CUDA_ERROR(cudaMemcpy(&h_num_conflicts, d_num_conflicts, sizeof(uint32_t),
+                          cudaMemcpyDeviceToHost));
+
+    // all colors together cover every face exactly once
+    bool passed = true;
+    for (uint32_t f = 0; f < num_faces; ++f) {
+        passed = passed && (h_face_visits[f] == 1u);
+    }
+    EXPECT_TRUE(passed);
+    EXPECT_EQ(h_num_conflicts, 0u);
+
+    GPU_FREE(d_face_visits);
+    GPU_FREE(d_vertex_block);
+    GPU_FREE(d_num_conflicts);
+}
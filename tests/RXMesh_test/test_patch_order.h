@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <numeric>
+#include "gtest/gtest.h"
+#include "rxmesh/kernels/rxmesh_query_dispatcher.cuh"
+#include "rxmesh/rxmesh_attribute.h"
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+#include "rxmesh/util/report.h"
+#include "rxmesh/util/timer.h"
+
+/**
+ * face_centroid()
+ */
+template <typename T, uint32_t blockThreads>
+__launch_bounds__(blockThreads) __global__
+    static void face_centroid(const RXMESH::RXMeshContext context,
+                              const RXMESH::RXMeshAttribute<T> coords,
+                              RXMESH::RXMeshAttribute<T>       centroid,
+                              uint32_t*                        d_num_mismatch)
+{
+    using namespace RXMESH;
+
+    // centroid of every face where coords and centroid use the same order as
+    // context. With the patch order context, every face id should also be
+    // its (patch, local id) position
+    const uint32_t patch_id = context.get_dispatch_patch(blockIdx.x);
+    auto centroid_lambda = [&](uint32_t face_id, RXMeshIterator& fv) {
+        if (d_num_mismatch != nullptr &&
+            face_id != context.get_patch_ordered_face(patch_id,
+                                                      fv.local_id())) {
+            atomicAdd(d_num_mismatch, 1u);
+        }
+        for (uint32_t j = 0; j < 3; ++j) {
+            centroid(face_id, j) =
+                (coords(fv[0], j) + coords(fv[1], j) + coords(fv[2], j)) /
+                T(3);
+        }
+    };
+
+    query_block_dispatcher<Op::FV, blockThreads>(context, centroid_lambda);
+}
+
+TEST(RXMesh, PatchOrder)
+{
+    using namespace RXMESH;
+
+    constexpr uint32_t blockThreads = 256;
+
+    std::vector<std::vector<uint32_t>> Faces;
+    std::vector<std::vector<dataT>>    Vertices;
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Vertices, Faces, true));
+
+    RXMeshStatic<PATCH_SIZE> rxmesh_static(Faces, Vertices, false,
+                                           rxmesh_args.quite);
+
+    const uint32_t num_vertices = rxmesh_static.get_num_vertices();
+    const uint32_t num_faces = rxmesh_static.get_num_faces();
+
+    // the patch order is a permutation of the global ids
+    for (ELEMENT ele : {ELEMENT::VERTEX, ELEMENT::EDGE, ELEMENT::FACE}) {
+        std::vector<uint32_t> order = rxmesh_static.get_patch_order(ele);
+        std::sort(order.begin(), order.end());
+        std::vector<uint32_t> gold(order.size());
+        std::iota(gold.begin(), gold.end(), 0);
+        EXPECT_EQ(order, gold);
+    }
+
+    RXMeshAttribute<dataT> coords;
+    coords.set_name("coords");
+    coords.init(num_vertices, 3u, RXMESH::LOCATION_ALL);
+    for (uint32_t i = 0; i < num_vertices; ++i) {
+        for (uint32_t j = 0; j < 3; ++j) {
+            coords(i, j) = Vertices[i][j];
+        }
+    }
+    coords.move(RXMESH::HOST, RXMESH::DEVICE);
+
+    // round trip on both sides. The patch-ordered copy uses another layout
+    RXMeshAttribute<dataT> patch_coords;
+    patch_coords.set_name("patch_coords");
+    patch_coords.init(num_vertices, 3u, RXMESH::LOCATION_ALL, RXMESH::SoA);
+    rxmesh_static.to_patch_order(ELEMENT::VERTEX, coords, patch_coords,
+                                 RXMESH::HOST | RXMESH::DEVICE);
+    const std::vector<uint32_t>& v_order =
+        rxmesh_static.get_patch_order(ELEMENT::VERTEX);
+    bool passed = true;
+    for (uint32_t i = 0; i < num_vertices; ++i) {
+        for (uint32_t j = 0; j < 3; ++j) {
+            passed = passed && (patch_coords(v_order[i], j) == coords(i, j));
+        }
+    }
+    EXPECT_TRUE(passed) << " to_patch_order() moved the wrong values";
+    RXMeshAttribute<dataT> round_trip;
+    round_trip.init(num_vertices, 3u, RXMESH::LOCATION_ALL);
+    rxmesh_static.to_global_order(ELEMENT::VERTEX, patch_coords, round_trip,
+                                  RXMESH::DEVICE);
+    round_trip.move(RXMESH::DEVICE, RXMESH::HOST);
+    passed = true;
+    for (uint32_t i = 0; i < num_vertices; ++i) {
+        for (uint32_t j = 0; j < 3; ++j) {
+            passed = passed && (round_trip(i, j) == coords(i, j));
+        }
+    }
+    EXPECT_TRUE(passed) << " to_global_order() did not restore the values";
+    round_trip.release();
+    patch_coords.change_layout(RXMESH::HOST | RXMESH::DEVICE, RXMESH::AoS);
+
+    RXMeshAttribute<dataT> centroid, patch_centroid;
+    centroid.init(num_faces, 3u, RXMESH::LOCATION_ALL);
+    patch_centroid.init(num_faces, 3u, RXMESH::LOCATION_ALL);
+
+    uint32_t* d_num_mismatch(nullptr);
+    CUDA_ERROR(cudaMalloc((void**)&d_num_mismatch, sizeof(uint32_t)));
+    CUDA_ERROR(cudaMemset(d_num_mismatch, 0, sizeof(uint32_t)));
+
+    LaunchBox<blockThreads> launch_box;
+    rxmesh_static.prepare_launch_box(Op::FV, launch_box);
+
+    Report report("PatchOrder_RXMesh");
+    report.command_line(rxmesh_args.argc, rxmesh_args.argv);
+    report.device();
+    report.system();
+    report.model_data(rxmesh_args.obj_file_name, rxmesh_static);
+
+    // global order
+    TestData td_global;
+    td_global.test_name = "centroid_global_order";
+    td_global.num_threads = launch_box.num_threads;
+    td_global.num_blocks = launch_box.blocks;
+    td_global.dyn_smem = launch_box.smem_bytes_dyn;
+    td_global.static_smem = launch_box.smem_bytes_static;
+    for (uint32_t itr = 0; itr < rxmesh_args.num_run; itr++) {
+        GPUTimer timer;
+        timer.start();
+        face_centroid<dataT, blockThreads>
+            <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+                rxmesh_static.get_context(), coords, centroid, nullptr);
+        timer.stop();
+        CUDA_ERROR(cudaDeviceSynchronize());
+        CUDA_ERROR(cudaGetLastError());
+        td_global.time_ms.push_back(timer.elapsed_millis());
+    }
+
+    // patch order
+    const RXMeshContext patch_context = rxmesh_static.get_patch_order_context();
+    TestData td_patch;
+    td_patch.test_name = "centroid_patch_order";
+    td_patch.num_threads = launch_box.num_threads;
+    td_patch.num_blocks = launch_box.blocks;
+    td_patch.dyn_smem = launch_box.smem_bytes_dyn;
+    td_patch.static_smem = launch_box.smem_bytes_static;
+    for (uint32_t itr = 0; itr < rxmesh_args.num_run; itr++) {
+        GPUTimer timer;
+        timer.start();
+        face_centroid<dataT, blockThreads>
+            <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+                patch_context, patch_coords, patch_centroid, d_num_mismatch);
+        timer.stop();
+        CUDA_ERROR(cudaDeviceSynchronize());
+        CUDA_ERROR(cudaGetLastError());
+        td_patch.time_ms.push_back(timer.elapsed_millis());
+    }
+
+    uint32_t h_num_mismatch = 0;
+    CUDA_ERROR(cudaMemcpy(&h_num_mismatch, d_num_mismatch, sizeof(uint32_t),
+                          cudaMemcpyDeviceToHost));
+    EXPECT_EQ(h_num_mismatch, 0u);
+
+    // both should agree once the patch-ordered result is brought back to
+    // global order
+    RXMeshAttribute<dataT> result;
+    result.init(num_faces, 3u, RXMESH::LOCATION_ALL);
+    rxmesh_static.to_global_order(ELEMENT::FACE, patch_centroid, result);
+    result.move(RXMESH::DEVICE, RXMESH::HOST);
+    centroid.move(RXMESH::DEVICE, RXMESH::HOST);
+    passed = (h_num_mismatch == 0);
+    for (uint32_t f = 0; f < num_faces; ++f) {
+        for (uint32_t j = 0; j < 3; ++j) {
+            passed = passed && (result(f, j) == centroid(f, j));
+        }
+    }
+    EXPECT_TRUE(passed);
+    td_global.passed.push_back(passed);
+    td_patch.passed.push_back(passed);
+
+    report.add_test(td_global);
+    report.add_test(td_patch);
+    if (!rxmesh_args.quite) {
+        RXMESH_TRACE(
+            " PatchOrder centroid global order = {} (ms), patch order = {} "
+            "(ms)",
+            std::accumulate(td_global.time_ms.begin(), td_global.time_ms.end(),
+                            0.0f) /
+                float(rxmesh_args.num_run),
+            std::accumulate(td_patch.time_ms.begin(), td_patch.time_ms.end(),
+                            0.0f) /
+                float(rxmesh_args.num_run));
+    }
+    report.write(
+        rxmesh_args.output_folder + "/rxmesh",
+        "PatchOrder_RXMesh_" + extract_file_name(rxmesh_args.obj_file_name));
+
+    GPU_FREE(d_num_mismatch);
+    result.release();
+    patch_centroid.release();
+    centroid.release();
+    patch_coords.release();
+    coords.release();
+}
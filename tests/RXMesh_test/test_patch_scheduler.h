@@ -0,0 +1,94 @@
+#include <atomic>
+#include <numeric>
+#include "gtest/gtest.h"
+#include "rxmesh/rxmesh_scheduler.h"
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+
+TEST(RXMesh, PatchScheduler)
+{
+    using namespace RXMESH;
+
+    // one very expensive patch among cheap ones
+    const uint32_t        num_patches = 50;
+    std::vector<uint64_t> cost(num_patches, 10);
+    std::vector<uint32_t> size(num_patches, 20);
+    cost[7] = 5000;
+    size[7] = 400;
+    size[13] = 0;
+    cost[13] = 0;
+
+    std::vector<uint32_t> offset(num_patches + 1, 0);
+    std::partial_sum(size.begin(), size.end(), offset.begin() + 1);
+
+    for (uint32_t num_workers : {1u, 3u, 8u}) {
+        PatchScheduler scheduler(num_workers);
+        scheduler.build(cost, size);
+
+        // the heavy patch is split and the empty one is skipped
+        uint32_t num_heavy = 0;
+        for (const auto& task : scheduler.get_tasks()) {
+            EXPECT_NE(task.patch_id, 13u);
+            EXPECT_LT(task.begin, task.end);
+            num_heavy += (task.patch_id == 7);
+        }
+        if (num_workers > 1) {
+            EXPECT_GT(num_heavy, 1u);
+        }
+
+        std::vector<std::atomic<uint32_t>> visited(offset.back());
+        for (auto& v : visited) {
+            v = 0;
+        }
+        std::atomic<uint32_t> bad_worker(0);
+        scheduler.run([&](uint32_t worker, uint32_t patch_id, uint32_t begin,
+                          uint32_t end) {
+            if (worker >= num_workers) {
+                bad_worker++;
+            }
+            for (uint32_t i = begin; i < end; ++i) {
+                visited[offset[patch_id] + i]++;
+            }
+        });
+
+        EXPECT_EQ(bad_worker, 0u);
+        bool passed = true;
+        for (const auto& v : visited) {
+            passed = passed && (v == 1u);
+        }
+        EXPECT_TRUE(passed) << " every element should be visited once";
+    }
+
+    // dispatch over the mesh patches: every owned vertex is visited once
+    std::vector<std::vector<uint32_t>> Faces;
+    std::vector<std::vector<dataT>>    Vertices;
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Vertices, Faces, true));
+
+    RXMeshStatic<PATCH_SIZE> rxmesh_static(Faces, Vertices, false,
+                                           rxmesh_args.quite);
+
+    std::vector<uint64_t> patch_cost;
+    std::vector<uint32_t> num_owned;
+    rxmesh_static.get_patch_cost(Op::VV, patch_cost, num_owned);
+    ASSERT_EQ(std::accumulate(num_owned.begin(), num_owned.end(), 0u),
+              rxmesh_static.get_num_vertices());
+
+    std::vector<uint32_t> patch_offset(num_owned.size() + 1, 0);
+    std::partial_sum(num_owned.begin(), num_owned.end(),
+                     patch_offset.begin() + 1);
+    std::vector<std::atomic<uint32_t>> visited(patch_offset.back());
+    for (auto& v : visited) {
+        v = 0;
+    }
+    rxmesh_static.for_each_patch_host(
+        Op::VV, [&](uint32_t, uint32_t patch_id, uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                visited[patch_offset[patch_id] + i]++;
+            }
+        });
+    bool passed = true;
+    for (const auto& v : visited) {
+        passed = passed && (v == 1u);
+    }
+    EXPECT_TRUE(passed) << " every owned vertex should be visited once";
+}
@@ -0,0 +1,222 @@
+#include <filesystem>
+#include <fstream>
+#include "gtest/gtest.h"
+#include "rxmesh/rxmesh_attribute.h"
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/export_ply.h"
+#include "rxmesh/util/import_obj.h"
+#include "rxmesh/util/import_ply.h"
+#include "rxmesh/util/report.h"
+#include "rxmesh/util/timer.h"
+
+/**
+ * ply_path()
+ */
+inline std::string ply_path(const std::string& name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+TEST(RXMesh, PLY)
+{
+    using namespace RXMESH;
+
+    std::vector<std::vector<uint32_t>> Faces;
+    std::vector<std::vector<dataT>>    Vertices;
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Vertices, Faces, true));
+
+    const std::string file_name = ply_path("rxmesh_mesh.ply");
+
+    // the mesh round trip is exact in every format
+    for (PlyFormat format :
+         {PlyFormat::ASCII, PlyFormat::BINARY_LITTLE_ENDIAN,
+          PlyFormat::BINARY_BIG_ENDIAN}) {
+        ASSERT_TRUE(export_ply(Faces, Vertices, file_name, format, false));
+        std::vector<std::vector<uint32_t>> ply_faces;
+        std::vector<std::vector<dataT>>    ply_vertices;
+        PlyData                            ply;
+        ASSERT_TRUE(import_ply(file_name, ply_vertices, ply_faces, ply, true));
+        EXPECT_EQ(ply.format, format);
+        EXPECT_TRUE(ply_vertices == Vertices) << "format= " << int(format);
+        EXPECT_TRUE(ply_faces == Faces) << "format= " << int(format);
+    }
+
+    // truncated binary files are rejected
+    {
+        std::filesystem::resize_file(
+            file_name, std::filesystem::file_size(file_name) - 1);
+        std::vector<std::vector<uint32_t>> ply_faces;
+        std::vector<std::vector<dataT>>    ply_vertices;
+        EXPECT_FALSE(import_ply(file_name, ply_vertices, ply_faces, true));
+    }
+
+    // an element count that does not fit in the file is rejected before
+    // anything is allocated for it
+    {
+        std::ofstream file(file_name, std::ios::binary);
+        file << "ply\nformat binary_little_endian 1.0\n"
+             << "element vertex 4000000000\n"
+             << "property float x\nproperty float y\nproperty float z\n"
+             << "end_header\n";
+        const float xyz[3] = {0.f, 1.f, 2.f};
+        file.write(reinterpret_cast<const char*>(xyz), sizeof(xyz));
+        file.close();
+        PlyData ply;
+        EXPECT_FALSE(import_ply(file_name, ply, true));
+    }
+
+    RXMeshStatic<PATCH_SIZE> rxmesh_static(Faces, Vertices, false,
+                                           rxmesh_args.quite);
+    const uint32_t num_vertices = rxmesh_static.get_num_vertices();
+    const uint32_t num_edges = rxmesh_static.get_num_edges();
+    const uint32_t num_faces = rxmesh_static.get_num_faces();
+
+    // per-vertex color (stored as uchar) and confidence, per-edge weight,
+    // and per-face quality
+    RXMeshAttribute<dataT>    coords, confidence, weight, quality;
+    RXMeshAttribute<uint32_t> color;
+    coords.init(num_vertices, 3u, RXMESH::HOST);
+    color.init(num_vertices, 3u, RXMESH::HOST);
+    confidence.init(num_vertices, 1u, RXMESH::HOST);
+    weight.init(num_edges, 1u, RXMESH::HOST);
+    quality.init(num_faces, 1u, RXMESH::HOST);
+    for (uint32_t v = 0; v < num_vertices; ++v) {
+        for (uint32_t j = 0; j < 3; ++j) {
+            coords(v, j) = Vertices[v][j];
+            color(v, j) = (v * 7 + j * 31) % 256;
+        }
+        confidence(v, 0) = dataT(v % 100) / dataT(100);
+    }
+    for (uint32_t e = 0; e < num_edges; ++e) {
+        weight(e, 0) = dataT(e % 23);
+    }
+    for (uint32_t f = 0; f < num_faces; ++f) {
+        quality(f, 0) = dataT(f % 17);
+    }
+
+    for (PlyFormat format :
+         {PlyFormat::ASCII, PlyFormat::BINARY_LITTLE_ENDIAN,
+          PlyFormat::BINARY_BIG_ENDIAN}) {
+        PlyData ply;
+        ASSERT_TRUE(rxmesh_static.init_ply_data(coords, ply));
+        ASSERT_TRUE(rxmesh_static.export_ply_attribute<uint8_t>(
+            ELEMENT::VERTEX, color, {"red", "green", "blue"}, ply));
+        ASSERT_TRUE(rxmesh_static.export_ply_attribute(
+            ELEMENT::VERTEX, confidence, {"confidence"}, ply));
+        ASSERT_TRUE(rxmesh_static.export_ply_attribute(
+            ELEMENT::FACE, quality, {"quality"}, ply));
+        ASSERT_TRUE(rxmesh_static.export_ply_attribute(
+            ELEMENT::EDGE, weight, {"weight"}, ply));
+
+        // PLY has no edge order so the edges are matched by their vertices
+        for (PlyProperty& prop : ply.find_element("edge")->properties) {
+            const PlyProperty edge_prop = prop;
+            for (uint32_t e = 0; e < num_edges; ++e) {
+                prop.set(e, edge_prop.get<double>(num_edges - 1 - e));
+            }
+        }
+        ASSERT_TRUE(export_ply(file_name, ply, format));
+
+        std::vector<std::vector<uint32_t>> ply_faces;
+        std::vector<std::vector<dataT>>    ply_vertices;
+        PlyData                            read_ply;
+        ASSERT_TRUE(
+            import_ply(file_name, ply_vertices, ply_faces, read_ply, true));
+        EXPECT_TRUE(ply_vertices == Vertices) << "format= " << int(format);
+        EXPECT_TRUE(ply_faces == Faces) << "format= " << int(format);
+        EXPECT_EQ(read_ply.find_element("vertex")->find_property("red")->type,
+                  PlyType::UINT8);
+
+        // colors through the device, confidence and quality on the host
+        RXMeshAttribute<uint32_t> read_color;
+        RXMeshAttribute<dataT>    read_confidence, read_weight, read_quality;
+        ASSERT_TRUE(rxmesh_static.import_ply_attribute(
+            ELEMENT::VERTEX, read_ply, {"red", "green", "blue"}, read_color,
+            RXMESH::DEVICE));
+        EXPECT_FALSE(read_color.is_host_allocated());
+        ASSERT_TRUE(rxmesh_static.import_ply_attribute(
+            ELEMENT::VERTEX, read_ply, {"confidence"}, read_confidence,
+            RXMESH::HOST));
+        ASSERT_TRUE(rxmesh_static.import_ply_attribute(
+            ELEMENT::FACE, read_ply, {"quality"}, read_quality, RXMESH::HOST,
+            RXMESH::SoA));
+        ASSERT_TRUE(rxmesh_static.import_ply_attribute(
+            ELEMENT::EDGE, read_ply, {"weight"}, read_weight, RXMESH::HOST));
+        EXPECT_FALSE(rxmesh_static.import_ply_attribute(
+            ELEMENT::FACE, read_ply, {"confidence"}, read_quality,
+            RXMESH::HOST));
+
+        ASSERT_TRUE(rxmesh_static.import_ply_attribute(
+            ELEMENT::VERTEX, read_ply, {"red", "green", "blue"}, read_color,
+            RXMESH::LOCATION_ALL));
+        read_color.reset(0, RXMESH::HOST);
+        read_color.move(RXMESH::DEVICE, RXMESH::HOST);
+
+        bool passed = true;
+        for (uint32_t v = 0; v < num_vertices; ++v) {
+            for (uint32_t j = 0; j < 3; ++j) {
+                passed = passed && (read_color(v, j) == color(v, j));
+            }
+            passed = passed && (read_confidence(v, 0) == confidence(v, 0));
+        }
+        for (uint32_t e = 0; e < num_edges; ++e) {
+            passed = passed && (read_weight(e, 0) == weight(e, 0));
+        }
+        for (uint32_t f = 0; f < num_faces; ++f) {
+            passed = passed && (read_quality(f, 0) == quality(f, 0));
+        }
+        EXPECT_TRUE(passed) << "format= " << int(format);
+
+        read_color.release();
+        read_confidence.release();
+        read_weight.release();
+        read_quality.release();
+    }
+
+    // Benchmark reading the mesh from OBJ and from binary PLY
+    Report report("PLY_RXMesh");
+    report.command_line(rxmesh_args.argc, rxmesh_args.argv);
+    report.device();
+    report.system();
+    report.model_data(rxmesh_args.obj_file_name, rxmesh_static);
+
+    ASSERT_TRUE(export_ply(Faces, Vertices, file_name,
+                           PlyFormat::BINARY_LITTLE_ENDIAN, false));
+    TestData td_obj, td_ply;
+    td_obj.test_name = "import_obj";
+    td_ply.test_name = "import_ply";
+    for (uint32_t itr = 0; itr < rxmesh_args.num_run; itr++) {
+        std::vector<std::vector<uint32_t>> read_faces;
+        std::vector<std::vector<dataT>>    read_vertices;
+
+        CPUTimer timer;
+        timer.start();
+        bool obj_passed = import_obj(rxmesh_args.obj_file_name, read_vertices,
+                                     read_faces, true);
+        timer.stop();
+        td_obj.time_ms.push_back(timer.elapsed_millis());
+        td_obj.passed.push_back(obj_passed && read_faces == Faces);
+
+        timer.start();
+        bool ply_passed =
+            import_ply(file_name, read_vertices, read_faces, true);
+        timer.stop();
+        td_ply.time_ms.push_back(timer.elapsed_millis());
+        td_ply.passed.push_back(ply_passed && read_faces == Faces);
+    }
+
+    report.add_test(td_obj);
+    report.add_test(td_ply);
+    if (!rxmesh_args.quite) {
+        RXMESH_TRACE(" PLY import obj= {} (ms), binary ply= {} (ms)",
+                     td_obj.time_ms.back(), td_ply.time_ms.back());
+    }
+    report.write(rxmesh_args.output_folder + "/rxmesh", "PLY");
+
+    std::filesystem::remove(file_name);
+    coords.release();
+    color.release();
+    confidence.release();
+    weight.release();
+    quality.release();
+}
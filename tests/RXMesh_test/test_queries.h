@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <numeric>
 #include <vector>
 #include "gtest/gtest.h"
 #include "query.cuh"
@@ -51,9 +53,10 @@ float launcher(const RXMeshContext&       context,
                                                 output_container);
             break;
         case Op::EE:
-            RXMESH_ERROR(
-                "RXMeshStatic::launcher_no_src() Op::EE is not "
-                "supported!!");
+            query<Op::EE, blockThreads>
+                <<<launch_box.blocks, blockThreads,
+                   launch_box.smem_bytes_dyn>>>(context, input_container,
+                                                output_container);
             break;
         case Op::EF:
             query<Op::EF, blockThreads>
@@ -99,6 +102,8 @@ inline uint32_t max_output_per_element(const RXMeshStatic<patchSize>& rxmesh,
         return 2;
     } else if (op == Op::EF) {
         return rxmesh.get_max_edge_incident_faces();
+    } else if (op == Op::EE) {
+        return 2 * rxmesh.get_max_edge_incident_faces();
     } else if (op == Op::FV || op == Op::FE) {
         return rxmesh.get_face_degree();
     } else if (op == Op::FF) {
@@ -190,6 +195,248 @@ TEST(RXMesh, Oriented_VV)
 }
 
 
+/**
+ * ee_global_baseline()
+ */
+__global__ static void ee_global_baseline(const uint32_t  num_edges,
+                                          const uint32_t* d_FE,
+                                          const uint32_t* d_EF_offset,
+                                          const uint32_t* d_EF,
+                                          const uint32_t  output_stride,
+                                          uint32_t*       d_output)
+{
+    // one thread per edge composes EF and FE from global CSR arrays. Every
+    // access goes to global memory and neighbor edges are scattered across
+    // the whole mesh which is what the patch-local EE query avoids
+    const uint32_t e = blockIdx.x * blockDim.x + threadIdx.x;
+    if (e >= num_edges) {
+        return;
+    }
+    uint32_t* out = &d_output[e * output_stride];
+    uint32_t  count = 0;
+    for (uint32_t i = d_EF_offset[e]; i < d_EF_offset[e + 1]; ++i) {
+        const uint32_t f = d_EF[i];
+        for (uint32_t j = 0; j < 3; ++j) {
+            const uint32_t n = d_FE[3 * f + j];
+            bool           is_unique = (n != e);
+            for (uint32_t k = 0; k < count && is_unique; ++k) {
+                is_unique = (out[k + 1] != n);
+            }
+            if (is_unique) {
+                out[++count] = n;
+            }
+        }
+    }
+    out[0] = count;
+}
+
+TEST(RXMesh, EE)
+{
+    // Select device
+    cuda_query(rxmesh_args.device_id, rxmesh_args.quite);
+
+    // 1) orientation: on a closed manifold mesh, every edge has four
+    // adjacent edges that form the boundary of its two incident faces in
+    // order i.e., every two consecutive edges (cyclically) share a vertex
+    {
+        std::vector<std::vector<uint32_t>> Faces;
+        std::vector<std::vector<dataT>>    Vertices;
+        ASSERT_TRUE(import_obj(STRINGIFY(INPUT_DIR) "cube.obj", Vertices,
+                               Faces, true));
+
+        RXMeshStatic<PATCH_SIZE> rxmesh_static(Faces, Vertices, false,
+                                               rxmesh_args.quite);
+        EXPECT_TRUE(rxmesh_static.is_closed());
+
+        std::vector<std::pair<uint32_t, uint32_t>> ev(
+            rxmesh_static.get_num_edges());
+        for (auto& f : Faces) {
+            for (uint32_t i = 0; i < 3; ++i) {
+                ev[rxmesh_static.get_edge_id(f[i], f[(i + 1) % 3])] = {
+                    f[i], f[(i + 1) % 3]};
+            }
+        }
+        auto share_vertex = [&](uint32_t a, uint32_t b) {
+            return ev[a].first == ev[b].first || ev[a].first == ev[b].second ||
+                   ev[a].second == ev[b].first || ev[a].second == ev[b].second;
+        };
+
+        RXMeshAttribute<uint32_t> input_container;
+        input_container.init(rxmesh_static.get_num_edges(), 1u, RXMESH::DEVICE,
+                             RXMESH::AoS, false, false);
+
+        RXMeshAttribute<uint32_t> output_container;
+        output_container.init(rxmesh_static.get_num_edges(),
+                              max_output_per_element(rxmesh_static, Op::EE) + 1,
+                              RXMESH::DEVICE, RXMESH::SoA, false, false);
+
+        LaunchBox<256> launch_box;
+        rxmesh_static.prepare_launch_box(Op::EE, launch_box, false, false);
+
+        launcher(rxmesh_static.get_context(), Op::EE, input_container,
+                 output_container, launch_box);
+
+        output_container.move(RXMESH::DEVICE, RXMESH::HOST);
+        input_container.move(RXMESH::DEVICE, RXMESH::HOST);
+
+        RXMeshTest tester(true);
+        EXPECT_TRUE(tester.run_query_verifier(
+            rxmesh_static, Op::EE, input_container, output_container));
+
+        for (uint32_t e = 0; e < rxmesh_static.get_num_edges(); ++e) {
+            ASSERT_EQ(output_container(e, 0), 4u);
+            for (uint32_t i = 0; i < 4; ++i) {
+                const uint32_t a = output_container(e, i + 1);
+                const uint32_t b = output_container(e, (i + 1) % 4 + 1);
+                EXPECT_TRUE(share_vertex(a, b))
+                    << " edge " << input_container(e) << " neighbors " << a
+                    << " and " << b << " are not consecutive";
+            }
+        }
+
+        input_container.release();
+        output_container.release();
+    }
+
+    // 2) performance against composing EF and FE from global arrays
+    std::vector<std::vector<uint32_t>> Faces;
+    std::vector<std::vector<dataT>>    Vertices;
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Vertices, Faces,
+                           rxmesh_args.quite));
+
+    RXMeshStatic<PATCH_SIZE> rxmesh_static(Faces, Vertices, false,
+                                           rxmesh_args.quite);
+
+    const uint32_t num_edges = rxmesh_static.get_num_edges();
+    const uint32_t num_faces = rxmesh_static.get_num_faces();
+    const uint32_t output_stride =
+        max_output_per_element(rxmesh_static, Op::EE) + 1;
+
+    // global FE and its transpose (EF) as CSR
+    std::vector<uint32_t> h_FE(3 * num_faces);
+    std::vector<uint32_t> h_EF_offset(num_edges + 1, 0), h_EF(3 * num_faces);
+    for (uint32_t f = 0; f < num_faces; ++f) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            h_FE[3 * f + i] =
+                rxmesh_static.get_edge_id(Faces[f][i], Faces[f][(i + 1) % 3]);
+            h_EF_offset[h_FE[3 * f + i] + 1]++;
+        }
+    }
+    for (uint32_t e = 0; e < num_edges; ++e) {
+        h_EF_offset[e + 1] += h_EF_offset[e];
+    }
+    std::vector<uint32_t> cursor(h_EF_offset.begin(), h_EF_offset.end() - 1);
+    for (uint32_t i = 0; i < h_FE.size(); ++i) {
+        h_EF[cursor[h_FE[i]]++] = i / 3;
+    }
+
+    uint32_t *d_FE(nullptr), *d_EF_offset(nullptr), *d_EF(nullptr),
+        *d_output(nullptr);
+    CUDA_ERROR(cudaMalloc((void**)&d_FE, h_FE.size() * sizeof(uint32_t)));
+    CUDA_ERROR(cudaMalloc((void**)&d_EF_offset,
+                          h_EF_offset.size() * sizeof(uint32_t)));
+    CUDA_ERROR(cudaMalloc((void**)&d_EF, h_EF.size() * sizeof(uint32_t)));
+    CUDA_ERROR(cudaMalloc((void**)&d_output,
+                          num_edges * output_stride * sizeof(uint32_t)));
+    CUDA_ERROR(cudaMemcpy(d_FE, h_FE.data(), h_FE.size() * sizeof(uint32_t),
+                          cudaMemcpyHostToDevice));
+    CUDA_ERROR(cudaMemcpy(d_EF_offset, h_EF_offset.data(),
+                          h_EF_offset.size() * sizeof(uint32_t),
+                          cudaMemcpyHostToDevice));
+    CUDA_ERROR(cudaMemcpy(d_EF, h_EF.data(), h_EF.size() * sizeof(uint32_t),
+                          cudaMemcpyHostToDevice));
+
+    Report report("EE_RXMesh");
+    report.command_line(rxmesh_args.argc, rxmesh_args.argv);
+    report.device();
+    report.system();
+    report.model_data(rxmesh_args.obj_file_name, rxmesh_static);
+
+    TestData td_global;
+    td_global.test_name = "EE_global";
+    td_global.num_threads = 256;
+    td_global.num_blocks = DIVIDE_UP(num_edges, 256);
+    for (uint32_t itr = 0; itr < rxmesh_args.num_run; itr++) {
+        GPUTimer timer;
+        timer.start();
+        ee_global_baseline<<<td_global.num_blocks, td_global.num_threads>>>(
+            num_edges, d_FE, d_EF_offset, d_EF, output_stride, d_output);
+        timer.stop();
+        CUDA_ERROR(cudaDeviceSynchronize());
+        CUDA_ERROR(cudaGetLastError());
+        td_global.time_ms.push_back(timer.elapsed_millis());
+    }
+    std::vector<uint32_t> h_output(num_edges * output_stride);
+    CUDA_ERROR(cudaMemcpy(h_output.data(), d_output,
+                          h_output.size() * sizeof(uint32_t),
+                          cudaMemcpyDeviceToHost));
+
+    RXMeshAttribute<uint32_t> input_container;
+    input_container.init(num_edges, 1u, RXMESH::DEVICE, RXMESH::AoS, false,
+                         false);
+    RXMeshAttribute<uint32_t> output_container;
+    output_container.init(num_edges, output_stride, RXMESH::DEVICE,
+                          RXMESH::SoA, false, false);
+
+    LaunchBox<256> launch_box;
+    rxmesh_static.prepare_launch_box(Op::EE, launch_box, false, false);
+
+    TestData td_rxmesh;
+    td_rxmesh.test_name = "EE_RXMesh";
+    td_rxmesh.num_threads = launch_box.num_threads;
+    td_rxmesh.num_blocks = launch_box.blocks;
+    td_rxmesh.dyn_smem = launch_box.smem_bytes_dyn;
+    td_rxmesh.static_smem = launch_box.smem_bytes_static;
+    for (uint32_t itr = 0; itr < rxmesh_args.num_run; itr++) {
+        td_rxmesh.time_ms.push_back(launcher(rxmesh_static.get_context(),
+                                             Op::EE, input_container,
+                                             output_container, launch_box));
+    }
+    output_container.move(RXMESH::DEVICE, RXMESH::HOST);
+    input_container.move(RXMESH::DEVICE, RXMESH::HOST);
+
+    // both should agree (as sets) on every edge
+    bool passed = true;
+    for (uint32_t i = 0; i < num_edges && passed; ++i) {
+        const uint32_t e = input_container(i);
+        const uint32_t size = output_container(i, 0);
+        passed = (size == h_output[e * output_stride]);
+        std::vector<uint32_t> res(size), gold(size);
+        for (uint32_t j = 0; j < size && passed; ++j) {
+            res[j] = output_container(i, j + 1);
+            gold[j] = h_output[e * output_stride + j + 1];
+        }
+        std::sort(res.begin(), res.end());
+        std::sort(gold.begin(), gold.end());
+        passed = passed && (res == gold);
+    }
+    EXPECT_TRUE(passed);
+    td_global.passed.push_back(passed);
+    td_rxmesh.passed.push_back(passed);
+
+    report.add_test(td_global);
+    report.add_test(td_rxmesh);
+    if (!rxmesh_args.quite) {
+        RXMESH_TRACE(" EE global time = {} (ms), RXMesh time = {} (ms)",
+                     std::accumulate(td_global.time_ms.begin(),
+                                     td_global.time_ms.end(), 0.0f) /
+                         float(rxmesh_args.num_run),
+                     std::accumulate(td_rxmesh.time_ms.begin(),
+                                     td_rxmesh.time_ms.end(), 0.0f) /
+                         float(rxmesh_args.num_run));
+    }
+    report.write(rxmesh_args.output_folder + "/rxmesh",
+                 "EE_RXMesh_" + extract_file_name(rxmesh_args.obj_file_name));
+
+    input_container.release();
+    output_container.release();
+    GPU_FREE(d_FE);
+    GPU_FREE(d_EF_offset);
+    GPU_FREE(d_EF);
+    GPU_FREE(d_output);
+}
+
+
 TEST(RXMesh, Queries)
 {
     if (rxmesh_args.shuffle) {
@@ -246,7 +493,7 @@ TEST(RXMesh, Queries)
     // adding query that we want to test
     std::vector<Op> ops = {Op::VV, Op::VE, Op::VF,  //
                            Op::FV, Op::FE, Op::FF,  //
-                           Op::EV, Op::EF};
+                           Op::EV, Op::EE, Op::EF};
 
 
     for (auto& ops_it : ops) {
@@ -0,0 +1,53 @@
+#include "gtest/gtest.h"
+#include "host_bfs.h"
+#include "rxmesh/rxmesh_attribute.h"
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+
+TEST(RXMesh, Toplesets)
+{
+    using namespace RXMESH;
+
+    std::vector<std::vector<uint32_t>> Faces;
+    std::vector<std::vector<dataT>>    Vertices;
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Vertices, Faces, true));
+
+    RXMeshStatic<PATCH_SIZE> rxmesh_static(Faces, Vertices, false,
+                                           rxmesh_args.quite);
+
+    const uint32_t num_vertices = rxmesh_static.get_num_vertices();
+
+    // two seeds where one is repeated
+    std::vector<uint32_t> seeds = {0, num_vertices / 2, 0};
+
+    RXMeshAttribute<uint32_t> toplesets("toplesets");
+    toplesets.init(num_vertices, 1u, RXMESH::LOCATION_ALL);
+    std::vector<uint32_t> sorted_index, limits;
+    rxmesh_static.compute_toplesets(seeds, toplesets, sorted_index, limits);
+
+    // serial BFS on the host as reference
+    const std::vector<uint32_t> level = host_bfs(Faces, num_vertices, seeds);
+
+    bool passed = true;
+    for (uint32_t v = 0; v < num_vertices; ++v) {
+        passed = passed && (toplesets(v) == level[v]);
+    }
+    EXPECT_TRUE(passed) << " toplesets do not match the host BFS";
+
+    // every vertex shows up once and in its level range
+    ASSERT_EQ(limits.front(), 0u);
+    ASSERT_EQ(limits.back(), num_vertices);
+    ASSERT_EQ(sorted_index.size(), num_vertices);
+    std::vector<bool> seen(num_vertices, false);
+    passed = true;
+    for (uint32_t l = 0; l + 1 < limits.size(); ++l) {
+        for (uint32_t i = limits[l]; i < limits[l + 1]; ++i) {
+            const uint32_t v = sorted_index[i];
+            passed = passed && !seen[v] && level[v] == l;
+            seen[v] = true;
+        }
+    }
+    EXPECT_TRUE(passed) << " sorted_index does not match the levels";
+
+    toplesets.release();
+}